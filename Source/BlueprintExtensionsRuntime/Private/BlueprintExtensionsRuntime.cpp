@@ -4,6 +4,7 @@
 */
 
 #include "BlueprintExtensionsRuntime.h"
+#include "Libraries/TraceTypeTable.h"
 
 #define LOCTEXT_NAMESPACE "FBlueprintExtensionsRuntimeModule"
 
@@ -11,11 +12,15 @@ DEFINE_LOG_CATEGORY(LogBlueprintExtensionsRuntime);
 
 void FBlueprintExtensionsRuntimeModule::StartupModule()
 {
+	XToolsTraceTypes::Startup();
+
 	UE_LOG(LogBlueprintExtensionsRuntime, Log, TEXT("BlueprintExtensionsRuntime module started"));
 }
 
 void FBlueprintExtensionsRuntimeModule::ShutdownModule()
 {
+	XToolsTraceTypes::Shutdown();
+
 	UE_LOG(LogBlueprintExtensionsRuntime, Log, TEXT("BlueprintExtensionsRuntime module shutdown"));
 }
 
@@ -25,6 +25,34 @@ namespace
 		return FMath::IsFinite(RandomFactor) ? FMath::Clamp(RandomFactor, -MaxRocketRandomFactorMagnitude, MaxRocketRandomFactorMagnitude) : 0.0f;
 	}
 
+	/**
+	 * 用起点与终点一次性重建两点样条，取代逐点添加后再逐点设置切线
+	 * 切线为世界空间，传nullptr时该点使用自动切线
+	 */
+	void WriteTrajectoryPoints(USplineComponent* SplineComponent, const FVector& StartLocation, const FVector& EndLocation, const FVector* StartTangent, const FVector* EndTangent)
+	{
+		const FTransform& ComponentTransform = SplineComponent->GetComponentTransform();
+		auto MakePoint = [&ComponentTransform](float InputKey, const FVector& Location, const FVector* Tangent)
+		{
+			const FVector LocalLocation = ComponentTransform.InverseTransformPosition(Location);
+			if (!Tangent)
+			{
+				return FSplinePoint(InputKey, LocalLocation, ESplinePointType::Curve);
+			}
+
+			const FVector LocalTangent = ComponentTransform.InverseTransformVector(*Tangent);
+			return FSplinePoint(InputKey, LocalLocation, LocalTangent, LocalTangent);
+		};
+
+		const TArray<FSplinePoint> SplinePoints = {
+			MakePoint(0.0f, StartLocation, StartTangent),
+			MakePoint(1.0f, EndLocation, EndTangent)
+		};
+
+		SplineComponent->ClearSplinePoints(false);
+		SplineComponent->AddPoints(SplinePoints, true);
+	}
+
 	void BuildRocketTrajectory(USplineComponent* SplineComponent, const FTransform& MuzzleTransform, const FVector& TargetLocation, float Curvature, float RandomFactor, FRandomStream* RandomStream)
 	{
 		if (!IsValidTrajectoryInput(SplineComponent, MuzzleTransform, TargetLocation))
@@ -42,21 +70,15 @@ namespace
 		const FVector CLocation = EndLocation + FVector(0.0f, 0.0f, CurvatureOffset);
 		const FVector DLocation = StartLocation + FVector(0.0f, 0.0f, CurvatureOffset);
 
-		SplineComponent->ClearSplinePoints(false);
-		SplineComponent->AddSplinePoint(StartLocation, ESplineCoordinateSpace::World, false);
-		SplineComponent->AddSplinePoint(EndLocation, ESplineCoordinateSpace::World, false);
-
 		const FVector ForwardTangent = MuzzleTransform.GetUnitAxis(EAxis::X) * Distance;
 		const FVector StartTangent = FMath::Lerp(CLocation - StartLocation, ForwardTangent, 0.5f);
-		SplineComponent->SetTangentAtSplinePoint(0, StartTangent, ESplineCoordinateSpace::World, false);
 
 		FVector EndTangent = EndLocation - DLocation;
 		const float MaxYawOffset = SafeRandomFactor * MaxRocketRandomYawDegrees;
 		const float YawOffset = RandomStream ? RandomStream->FRandRange(0.0f, MaxYawOffset) : FMath::FRandRange(0.0f, MaxYawOffset);
 		EndTangent = FRotator(0.0f, YawOffset, 0.0f).RotateVector(EndTangent);
-		SplineComponent->SetTangentAtSplinePoint(1, EndTangent, ESplineCoordinateSpace::World, false);
 
-		SplineComponent->UpdateSpline();
+		WriteTrajectoryPoints(SplineComponent, StartLocation, EndLocation, &StartTangent, &EndTangent);
 	}
 }
 
@@ -67,12 +89,7 @@ void USplineTrajectoryLibrary::SplineTrajectoryFlat(USplineComponent* SplineComp
 		return;
 	}
 
-	const FVector StartLocation = MuzzleTransform.GetLocation();
-
-	SplineComponent->ClearSplinePoints(false);
-	SplineComponent->AddSplinePoint(StartLocation, ESplineCoordinateSpace::World, false);
-	SplineComponent->AddSplinePoint(TargetLocation, ESplineCoordinateSpace::World, false);
-	SplineComponent->UpdateSpline();
+	WriteTrajectoryPoints(SplineComponent, MuzzleTransform.GetLocation(), TargetLocation, nullptr, nullptr);
 }
 
 void USplineTrajectoryLibrary::SplineTrajectoryBallistic(USplineComponent* SplineComponent, const FTransform& MuzzleTransform, const FVector& TargetLocation, float Curvature)
@@ -90,12 +107,9 @@ void USplineTrajectoryLibrary::SplineTrajectoryBallistic(USplineComponent* Splin
 	const FVector CLocation = EndLocation + FVector(0.0f, 0.0f, CurvatureOffset);
 	const FVector DLocation = StartLocation + FVector(0.0f, 0.0f, CurvatureOffset);
 
-	SplineComponent->ClearSplinePoints(false);
-	SplineComponent->AddSplinePoint(StartLocation, ESplineCoordinateSpace::World, false);
-	SplineComponent->AddSplinePoint(EndLocation, ESplineCoordinateSpace::World, false);
-	SplineComponent->SetTangentAtSplinePoint(0, CLocation - StartLocation, ESplineCoordinateSpace::World, false);
-	SplineComponent->SetTangentAtSplinePoint(1, EndLocation - DLocation, ESplineCoordinateSpace::World, false);
-	SplineComponent->UpdateSpline();
+	const FVector StartTangent = CLocation - StartLocation;
+	const FVector EndTangent = EndLocation - DLocation;
+	WriteTrajectoryPoints(SplineComponent, StartLocation, EndLocation, &StartTangent, &EndTangent);
 }
 
 void USplineTrajectoryLibrary::SplineTrajectoryRocket(USplineComponent* SplineComponent, const FTransform& MuzzleTransform, const FVector& TargetLocation, float Curvature, float RandomFactor)
@@ -1,4 +1,5 @@
 #include "Libraries/BulletHomingLibrary.h"
+#include "Libraries/BulletHomingSimulation.h"
 
 #include "Components/SceneComponent.h"
 #if defined(ENABLE_DRAW_DEBUG) && ENABLE_DRAW_DEBUG
@@ -10,14 +11,9 @@
 
 namespace
 {
-	struct FBulletTargetInfo
-	{
-		bool bHasLocation = false;
-		bool bHasLiveTarget = false;
-		bool bUsesTargetComponent = false;
-		FVector Location = FVector::ZeroVector;
-		FVector Velocity = FVector::ZeroVector;
-	};
+	using XToolsBulletHoming::FBulletTargetInfo;
+	using XToolsBulletHoming::FStepInputs;
+	using XToolsBulletHoming::FStepResult;
 
 	bool IsFiniteVector(const FVector& Value)
 	{
@@ -202,12 +198,12 @@ namespace
 	}
 
 	FVector ResolveCurrentVelocityForGuidance(
-		const UProjectileMovementComponent* ProjectileMovement,
+		const FStepInputs& Inputs,
 		const FXToolsBulletHomingState& State)
 	{
-		if (IsValid(ProjectileMovement) && !ProjectileMovement->Velocity.IsNearlyZero() && IsFiniteVector(ProjectileMovement->Velocity))
+		if (!Inputs.MovementVelocity.IsNearlyZero() && IsFiniteVector(Inputs.MovementVelocity))
 		{
-			return ProjectileMovement->Velocity;
+			return Inputs.MovementVelocity;
 		}
 
 		const FVector StateVelocity = State.CurrentDirection * State.CurrentSpeed;
@@ -235,7 +231,7 @@ namespace
 	}
 
 	float InitialSpeedFromInputs(
-		const UProjectileMovementComponent* ProjectileMovement,
+		const FStepInputs& Inputs,
 		const FXToolsBulletHomingOptions& Options)
 	{
 		const float ExplicitInitialSpeed = PositiveFiniteOrZero(Options.InitialSpeed);
@@ -244,18 +240,15 @@ namespace
 			return ExplicitInitialSpeed;
 		}
 
-		if (IsValid(ProjectileMovement) && !ProjectileMovement->Velocity.IsNearlyZero() && IsFiniteVector(ProjectileMovement->Velocity))
+		if (!Inputs.MovementVelocity.IsNearlyZero() && IsFiniteVector(Inputs.MovementVelocity))
 		{
-			return ProjectileMovement->Velocity.Size();
+			return Inputs.MovementVelocity.Size();
 		}
 
-		if (IsValid(ProjectileMovement))
+		const float ProjectileInitialSpeed = PositiveFiniteOrZero(Inputs.MovementInitialSpeed);
+		if (ProjectileInitialSpeed > 0.0f)
 		{
-			const float ProjectileInitialSpeed = PositiveFiniteOrZero(ProjectileMovement->InitialSpeed);
-			if (ProjectileInitialSpeed > 0.0f)
-			{
-				return ProjectileInitialSpeed;
-			}
+			return ProjectileInitialSpeed;
 		}
 
 		return PositiveFiniteOrZero(Options.TargetSpeed);
@@ -769,8 +762,48 @@ namespace
 		State.TerminalStoppedProjectileMovement.Reset();
 	}
 
+	/** 计算阶段的恢复：只记录恢复参数，组件写入由ApplyDeferredTerminalRestore在游戏线程完成 */
+	void DeferRestoreTerminalStoppedProjectileMovement(FXToolsBulletHomingState& State, FStepResult& Result)
+	{
+		// 同一帧内再次恢复时组件已恢复过，与立即恢复的行为一致
+		if (!Result.bRestoreTerminalStop)
+		{
+			Result.bRestoreTerminalStop = true;
+			Result.bRestoreSimulation = State.bSimulationPausedByTerminalStatus;
+			Result.RestoreVelocity = State.SpeedBeforeTerminalStop > KINDA_SMALL_NUMBER
+				? SafeDirectionOrFallback(State.CurrentDirection, FVector::ForwardVector) * State.SpeedBeforeTerminalStop
+				: FVector::ZeroVector;
+		}
+
+		State.bSimulationPausedByTerminalStatus = false;
+	}
+
+	void ApplyDeferredTerminalRestore(const FStepResult& Result, FXToolsBulletHomingState& State)
+	{
+		if (!Result.bRestoreTerminalStop)
+		{
+			return;
+		}
+
+		if (UProjectileMovementComponent* StoppedProjectileMovement = State.TerminalStoppedProjectileMovement.Get())
+		{
+			if (!Result.RestoreVelocity.IsNearlyZero() && StoppedProjectileMovement->Velocity.IsNearlyZero())
+			{
+				StoppedProjectileMovement->Velocity = StoppedProjectileMovement->LimitVelocity(Result.RestoreVelocity);
+				StoppedProjectileMovement->UpdateComponentVelocity();
+			}
+
+			if (Result.bRestoreSimulation)
+			{
+				StoppedProjectileMovement->bSimulationEnabled = true;
+			}
+		}
+
+		State.TerminalStoppedProjectileMovement.Reset();
+	}
+
 	void RestoreTerminalStoppedSpeed(
-		const UProjectileMovementComponent* ProjectileMovement,
+		const FStepInputs& Inputs,
 		const FXToolsBulletHomingOptions& Options,
 		FXToolsBulletHomingState& State)
 	{
@@ -778,7 +811,7 @@ namespace
 		{
 			const float ResumeSpeed = State.SpeedBeforeTerminalStop > KINDA_SMALL_NUMBER
 				? State.SpeedBeforeTerminalStop
-				: InitialSpeedFromInputs(ProjectileMovement, Options);
+				: InitialSpeedFromInputs(Inputs, Options);
 			State.CurrentSpeed = ClampSpeed(ResumeSpeed, Options.MaxSpeed);
 		}
 
@@ -786,24 +819,17 @@ namespace
 	}
 }
 
-bool UBulletHomingLibrary::UpdateHomingProjectileMovement(
+
+bool XToolsBulletHoming::GatherStepInputs(
 	AActor* ProjectileActor,
 	UProjectileMovementComponent* ProjectileMovement,
 	AActor* TargetActor,
 	USceneComponent* TargetComponent,
-	USceneComponent* VisualComponent,
 	float DeltaTime,
 	const FXToolsBulletHomingOptions& Options,
 	FXToolsBulletHomingState& State,
-	EXToolsBulletHomingStatus& OutStatus,
-	FVector& OutWorldVelocity,
-	FRotator& OutActorRotation,
-	FRotator& OutVisualRotation)
+	FStepInputs& OutInputs)
 {
-	OutStatus = EXToolsBulletHomingStatus::Invalid;
-	OutWorldVelocity = FVector::ZeroVector;
-	OutActorRotation = IsValid(ProjectileActor) ? ProjectileActor->GetActorRotation() : FRotator::ZeroRotator;
-	OutVisualRotation = IsValid(VisualComponent) ? VisualComponent->GetComponentRotation() : FRotator::ZeroRotator;
 	if (!Options.bApplyVelocityToProjectileMovement)
 	{
 		RestoreTerminalStoppedProjectileMovement(State);
@@ -875,32 +901,53 @@ bool UBulletHomingLibrary::UpdateHomingProjectileMovement(
 			UpdateCachedTargetIdentity(TargetActor, TargetComponent, State);
 		}
 	}
+
+	OutInputs.CurrentLocation = CurrentLocation;
+	OutInputs.MovementVelocity = bHasProjectileMovement ? ProjectileMovement->Velocity : FVector::ZeroVector;
+	OutInputs.MovementInitialSpeed = bHasProjectileMovement ? ProjectileMovement->InitialSpeed : 0.0f;
+	OutInputs.InitialDirection = InitialDirectionFromInputs(ProjectileActor, ProjectileMovement);
+	OutInputs.TargetInfo = TargetInfo;
+	OutInputs.bTargetChanged = bTargetChanged;
+	OutInputs.DeltaTime = SafeDeltaTime;
+	return true;
+}
+
+void XToolsBulletHoming::ComputeStep(
+	const FStepInputs& Inputs,
+	const FXToolsBulletHomingOptions& Options,
+	FXToolsBulletHomingState& State,
+	FStepResult& OutResult)
+{
+	OutResult = FStepResult();
+	const FVector& CurrentLocation = Inputs.CurrentLocation;
+	const FBulletTargetInfo& TargetInfo = Inputs.TargetInfo;
+	const float SafeDeltaTime = Inputs.DeltaTime;
+
 	if (!TargetInfo.bHasLocation && !Options.bContinueAfterTargetInvalid && !IsTerminalStatus(State.LatchedTerminalStatus))
 	{
-		OutStatus = EXToolsBulletHomingStatus::TargetInvalid;
-		SetOutputsFromState(ProjectileActor, VisualComponent, Options, State, OutWorldVelocity, OutActorRotation, OutVisualRotation);
+		OutResult.Outcome = EStepOutcome::TargetInvalid;
+		OutResult.Status = EXToolsBulletHomingStatus::TargetInvalid;
 		UpdateDebugTrail(CurrentLocation, Options, State);
 		State.LastProjectileLocation = CurrentLocation;
 		State.bHasLastProjectileLocation = true;
-		return false;
+		return;
 	}
 
-	const FVector InitialDirection = InitialDirectionFromInputs(ProjectileActor, ProjectileMovement);
 	if (!State.bInitialized)
 	{
-		State.CurrentDirection = SafeDirectionOrFallback(InitialDirection, FVector::ForwardVector);
-		State.CurrentSpeed = ClampSpeed(InitialSpeedFromInputs(ProjectileMovement, Options), Options.MaxSpeed);
+		State.CurrentDirection = SafeDirectionOrFallback(Inputs.InitialDirection, FVector::ForwardVector);
+		State.CurrentSpeed = ClampSpeed(InitialSpeedFromInputs(Inputs, Options), Options.MaxSpeed);
 		State.CurrentSpeedInterpRate = PositiveFiniteOrZero(Options.SpeedInterpRate);
 		State.CurrentDirectionInterpRate = PositiveFiniteOrZero(Options.DirectionInterpRate);
 		State.bInitialized = true;
 	}
-	if (TargetInfo.bHasLiveTarget && (!State.bTrackingStarted || bTargetChanged))
+	if (TargetInfo.bHasLiveTarget && (!State.bTrackingStarted || Inputs.bTargetChanged))
 	{
 		const bool bWasStoppedOnTerminalStatus = IsTerminalStatus(State.LatchedTerminalStatus);
-		RestoreTerminalStoppedProjectileMovement(State);
+		DeferRestoreTerminalStoppedProjectileMovement(State, OutResult);
 		if (bWasStoppedOnTerminalStatus)
 		{
-			RestoreTerminalStoppedSpeed(ProjectileMovement, Options, State);
+			RestoreTerminalStoppedSpeed(Inputs, Options, State);
 		}
 
 		State.ElapsedTime = 0.0f;
@@ -918,10 +965,10 @@ bool UBulletHomingLibrary::UpdateHomingProjectileMovement(
 	if (!Options.bStopMovementOnTerminalStatus)
 	{
 		const bool bWasStoppedOnTerminalStatus = IsTerminalStatus(State.LatchedTerminalStatus);
-		RestoreTerminalStoppedProjectileMovement(State);
+		DeferRestoreTerminalStoppedProjectileMovement(State, OutResult);
 		if (bWasStoppedOnTerminalStatus)
 		{
-			RestoreTerminalStoppedSpeed(ProjectileMovement, Options, State);
+			RestoreTerminalStoppedSpeed(Inputs, Options, State);
 		}
 		State.LatchedTerminalStatus = EXToolsBulletHomingStatus::Tracking;
 	}
@@ -967,6 +1014,7 @@ bool UBulletHomingLibrary::UpdateHomingProjectileMovement(
 
 		TargetDirection = SafeDirectionOrFallback(AimLocation - CurrentLocation, State.CurrentDirection);
 	}
+	OutResult.AimLocation = AimLocation;
 
 	if (Options.bStopMovementOnTerminalStatus && IsTerminalStatus(State.LatchedTerminalStatus))
 	{
@@ -976,34 +1024,18 @@ bool UBulletHomingLibrary::UpdateHomingProjectileMovement(
 	if (Options.bStopMovementOnTerminalStatus && IsTerminalStatus(TerminalStatus))
 	{
 		State.LatchedTerminalStatus = TerminalStatus;
-		OutStatus = TerminalStatus;
-		OutWorldVelocity = FVector::ZeroVector;
+		OutResult.Outcome = EStepOutcome::TerminalStop;
+		OutResult.Status = TerminalStatus;
 		if (State.CurrentSpeed > KINDA_SMALL_NUMBER)
 		{
 			State.SpeedBeforeTerminalStop = State.CurrentSpeed;
 		}
 		State.CurrentSpeed = 0.0f;
-		const FRotator CurrentRotation = SafeDirectionOrFallback(State.CurrentDirection, FVector::ForwardVector).Rotation();
-		OutActorRotation = IsValid(ProjectileActor) ? ProjectileActor->GetActorRotation() : CurrentRotation;
-		OutVisualRotation = IsValid(VisualComponent) ? VisualComponent->GetComponentRotation() : ComposeVisualRotation(CurrentRotation, Options.VisualRotationOffset);
-
-		if (Options.bApplyVelocityToProjectileMovement && IsValid(ProjectileMovement))
-		{
-			ApplyProjectileMovementVelocity(ProjectileMovement, FVector::ZeroVector, Options);
-			State.TerminalStoppedProjectileMovement = ProjectileMovement;
-			if (ProjectileMovement->bSimulationEnabled)
-			{
-				ProjectileMovement->bSimulationEnabled = false;
-				State.bSimulationPausedByTerminalStatus = true;
-			}
-		}
 
 		UpdateDebugTrail(CurrentLocation, Options, State);
-		DrawHomingDebug(ProjectileActor, ProjectileMovement, Options, CurrentLocation, TargetInfo, AimLocation, OutWorldVelocity, State.DebugTrailPoints);
-
 		State.LastProjectileLocation = CurrentLocation;
 		State.bHasLastProjectileLocation = true;
-		return true;
+		return;
 	}
 
 	const float RequestedTargetSpeed = Options.TargetSpeed > 0.0f ? Options.TargetSpeed : State.CurrentSpeed;
@@ -1044,7 +1076,7 @@ bool UBulletHomingLibrary::UpdateHomingProjectileMovement(
 		DistanceToTarget / State.InitialDistanceToTarget <= FullGuidanceDistanceRatio &&
 		GuidanceScale >= 1.0f - KINDA_SMALL_NUMBER;
 	const FVector GuidanceCurrentDirection = SafeDirectionOrFallback(
-		ResolveCurrentVelocityForGuidance(ProjectileMovement, State),
+		ResolveCurrentVelocityForGuidance(Inputs, State),
 		State.CurrentDirection);
 	const FVector CurrentVelocity = GuidanceCurrentDirection * State.CurrentSpeed;
 	const FVector GuidanceTargetDirection = TargetInfo.bHasLocation ? TargetDirection : GuidanceCurrentDirection;
@@ -1131,17 +1163,80 @@ bool UBulletHomingLibrary::UpdateHomingProjectileMovement(
 			SafeDeltaTime);
 	}
 
-	OutWorldVelocity = State.CurrentDirection * State.CurrentSpeed;
-	if (!IsFiniteVector(OutWorldVelocity))
+	UpdateDebugTrail(CurrentLocation, Options, State);
+	State.LastProjectileLocation = CurrentLocation;
+	State.bHasLastProjectileLocation = true;
+
+	const FVector WorldVelocity = State.CurrentDirection * State.CurrentSpeed;
+	if (!IsFiniteVector(WorldVelocity))
 	{
-		OutWorldVelocity = FVector::ZeroVector;
-		OutStatus = EXToolsBulletHomingStatus::Invalid;
-		UpdateDebugTrail(CurrentLocation, Options, State);
-		State.LastProjectileLocation = CurrentLocation;
-		State.bHasLastProjectileLocation = true;
+		OutResult.Outcome = EStepOutcome::InvalidVelocity;
+		OutResult.Status = EXToolsBulletHomingStatus::Invalid;
+		return;
+	}
+
+	OutResult.Outcome = EStepOutcome::Guided;
+	OutResult.WorldVelocity = WorldVelocity;
+	OutResult.Status = TargetInfo.bHasLiveTarget ? TerminalStatus : EXToolsBulletHomingStatus::TargetInvalid;
+}
+
+bool XToolsBulletHoming::ApplyStepResult(
+	AActor* ProjectileActor,
+	UProjectileMovementComponent* ProjectileMovement,
+	USceneComponent* VisualComponent,
+	const FStepInputs& Inputs,
+	const FXToolsBulletHomingOptions& Options,
+	const FStepResult& Result,
+	FXToolsBulletHomingState& State,
+	EXToolsBulletHomingStatus& OutStatus,
+	FVector& OutWorldVelocity,
+	FRotator& OutActorRotation,
+	FRotator& OutVisualRotation)
+{
+	OutStatus = Result.Status;
+	OutWorldVelocity = FVector::ZeroVector;
+	OutActorRotation = IsValid(ProjectileActor) ? ProjectileActor->GetActorRotation() : FRotator::ZeroRotator;
+	OutVisualRotation = IsValid(VisualComponent) ? VisualComponent->GetComponentRotation() : FRotator::ZeroRotator;
+	ApplyDeferredTerminalRestore(Result, State);
+
+	const FVector& CurrentLocation = Inputs.CurrentLocation;
+	const float SafeDeltaTime = Inputs.DeltaTime;
+	switch (Result.Outcome)
+	{
+	case EStepOutcome::TargetInvalid:
+		SetOutputsFromState(ProjectileActor, VisualComponent, Options, State, OutWorldVelocity, OutActorRotation, OutVisualRotation);
+		return false;
+
+	case EStepOutcome::InvalidVelocity:
 		return false;
+
+	case EStepOutcome::TerminalStop:
+	{
+		const FRotator CurrentRotation = SafeDirectionOrFallback(State.CurrentDirection, FVector::ForwardVector).Rotation();
+		OutActorRotation = IsValid(ProjectileActor) ? ProjectileActor->GetActorRotation() : CurrentRotation;
+		OutVisualRotation = IsValid(VisualComponent) ? VisualComponent->GetComponentRotation() : ComposeVisualRotation(CurrentRotation, Options.VisualRotationOffset);
+
+		if (Options.bApplyVelocityToProjectileMovement && IsValid(ProjectileMovement))
+		{
+			ApplyProjectileMovementVelocity(ProjectileMovement, FVector::ZeroVector, Options);
+			State.TerminalStoppedProjectileMovement = ProjectileMovement;
+			if (ProjectileMovement->bSimulationEnabled)
+			{
+				ProjectileMovement->bSimulationEnabled = false;
+				State.bSimulationPausedByTerminalStatus = true;
+			}
+		}
+
+		DrawHomingDebug(ProjectileActor, ProjectileMovement, Options, CurrentLocation, Inputs.TargetInfo, Result.AimLocation, OutWorldVelocity, State.DebugTrailPoints);
+		return true;
 	}
 
+	case EStepOutcome::Guided:
+	default:
+		break;
+	}
+
+	OutWorldVelocity = Result.WorldVelocity;
 	if (Options.bApplyVelocityToProjectileMovement && IsValid(ProjectileMovement))
 	{
 		ApplyProjectileMovementVelocity(ProjectileMovement, OutWorldVelocity, Options);
@@ -1202,14 +1297,48 @@ bool UBulletHomingLibrary::UpdateHomingProjectileMovement(
 		OutVisualRotation = ComposeVisualRotation(TargetRotation, Options.VisualRotationOffset);
 	}
 
-	UpdateDebugTrail(CurrentLocation, Options, State);
-	DrawHomingDebug(ProjectileActor, ProjectileMovement, Options, CurrentLocation, TargetInfo, AimLocation, OutWorldVelocity, State.DebugTrailPoints);
+	DrawHomingDebug(ProjectileActor, ProjectileMovement, Options, CurrentLocation, Inputs.TargetInfo, Result.AimLocation, OutWorldVelocity, State.DebugTrailPoints);
+	return true;
+}
 
-	State.LastProjectileLocation = CurrentLocation;
-	State.bHasLastProjectileLocation = true;
+bool UBulletHomingLibrary::UpdateHomingProjectileMovement(
+	AActor* ProjectileActor,
+	UProjectileMovementComponent* ProjectileMovement,
+	AActor* TargetActor,
+	USceneComponent* TargetComponent,
+	USceneComponent* VisualComponent,
+	float DeltaTime,
+	const FXToolsBulletHomingOptions& Options,
+	FXToolsBulletHomingState& State,
+	EXToolsBulletHomingStatus& OutStatus,
+	FVector& OutWorldVelocity,
+	FRotator& OutActorRotation,
+	FRotator& OutVisualRotation)
+{
+	XToolsBulletHoming::FStepInputs Inputs;
+	if (!XToolsBulletHoming::GatherStepInputs(ProjectileActor, ProjectileMovement, TargetActor, TargetComponent, DeltaTime, Options, State, Inputs))
+	{
+		OutStatus = EXToolsBulletHomingStatus::Invalid;
+		OutWorldVelocity = FVector::ZeroVector;
+		OutActorRotation = IsValid(ProjectileActor) ? ProjectileActor->GetActorRotation() : FRotator::ZeroRotator;
+		OutVisualRotation = IsValid(VisualComponent) ? VisualComponent->GetComponentRotation() : FRotator::ZeroRotator;
+		return false;
+	}
 
-	OutStatus = TargetInfo.bHasLiveTarget ? TerminalStatus : EXToolsBulletHomingStatus::TargetInvalid;
-	return true;
+	XToolsBulletHoming::FStepResult Result;
+	XToolsBulletHoming::ComputeStep(Inputs, Options, State, Result);
+	return XToolsBulletHoming::ApplyStepResult(
+		ProjectileActor,
+		ProjectileMovement,
+		VisualComponent,
+		Inputs,
+		Options,
+		Result,
+		State,
+		OutStatus,
+		OutWorldVelocity,
+		OutActorRotation,
+		OutVisualRotation);
 }
 
 void UBulletHomingLibrary::ResetHomingProjectileState(FXToolsBulletHomingState& State)
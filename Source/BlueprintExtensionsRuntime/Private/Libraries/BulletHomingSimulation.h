@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Libraries/BulletHomingLibrary.h"
+
+class AActor;
+class UProjectileMovementComponent;
+class USceneComponent;
+
+/**
+ * 追踪弹单步更新的三个阶段
+ * 更新追踪弹运动节点与追踪弹子系统共用：采集与写回访问UObject，只能在游戏线程执行；
+ * 计算阶段只读写输入、选项、状态和结果，不访问任何UObject，可以在工作线程上并行。
+ */
+namespace XToolsBulletHoming
+{
+	struct FBulletTargetInfo
+	{
+		bool bHasLocation = false;
+		bool bHasLiveTarget = false;
+		bool bUsesTargetComponent = false;
+		FVector Location = FVector::ZeroVector;
+		FVector Velocity = FVector::ZeroVector;
+	};
+
+	struct FStepInputs
+	{
+		FVector CurrentLocation = FVector::ZeroVector;
+
+		/** ProjectileMovement当前速度，没有组件时为零 */
+		FVector MovementVelocity = FVector::ZeroVector;
+
+		/** ProjectileMovement的InitialSpeed，没有组件时为0 */
+		float MovementInitialSpeed = 0.0f;
+
+		/** 状态首次初始化时使用的飞行方向 */
+		FVector InitialDirection = FVector::ForwardVector;
+
+		FBulletTargetInfo TargetInfo;
+		bool bTargetChanged = false;
+
+		/** 已过滤非法值的DeltaTime */
+		float DeltaTime = 0.0f;
+	};
+
+	enum class EStepOutcome : uint8
+	{
+		/** 目标无效且不继续飞行，保持当前状态输出 */
+		TargetInvalid,
+		/** 进入终端状态，输出零速度并停止移动组件 */
+		TerminalStop,
+		/** 正常制导，写回速度与旋转 */
+		Guided,
+		/** 计算出的速度非法，不写回 */
+		InvalidVelocity
+	};
+
+	struct FStepResult
+	{
+		EStepOutcome Outcome = EStepOutcome::InvalidVelocity;
+		EXToolsBulletHomingStatus Status = EXToolsBulletHomingStatus::Invalid;
+		FVector WorldVelocity = FVector::ZeroVector;
+		FVector AimLocation = FVector::ZeroVector;
+
+		/** 计算阶段不能访问组件，恢复终端停止的ProjectileMovement推迟到写回阶段执行 */
+		bool bRestoreTerminalStop = false;
+		bool bRestoreSimulation = false;
+		FVector RestoreVelocity = FVector::ZeroVector;
+	};
+
+	/**
+	 * 游戏线程：校验输入，读取弹体与目标位置，处理目标切换
+	 * @return 输入无效时返回false，此时不应继续计算
+	 */
+	bool GatherStepInputs(
+		AActor* ProjectileActor,
+		UProjectileMovementComponent* ProjectileMovement,
+		AActor* TargetActor,
+		USceneComponent* TargetComponent,
+		float DeltaTime,
+		const FXToolsBulletHomingOptions& Options,
+		FXToolsBulletHomingState& State,
+		FStepInputs& OutInputs);
+
+	/** 任意线程：推进制导状态并得出本帧速度，不访问UObject */
+	void ComputeStep(
+		const FStepInputs& Inputs,
+		const FXToolsBulletHomingOptions& Options,
+		FXToolsBulletHomingState& State,
+		FStepResult& OutResult);
+
+	/**
+	 * 游戏线程：把计算结果写回ProjectileMovement、Actor与外观组件，并绘制调试
+	 * @return 与更新追踪弹运动节点的返回值一致
+	 */
+	bool ApplyStepResult(
+		AActor* ProjectileActor,
+		UProjectileMovementComponent* ProjectileMovement,
+		USceneComponent* VisualComponent,
+		const FStepInputs& Inputs,
+		const FXToolsBulletHomingOptions& Options,
+		const FStepResult& Result,
+		FXToolsBulletHomingState& State,
+		EXToolsBulletHomingStatus& OutStatus,
+		FVector& OutWorldVelocity,
+		FRotator& OutActorRotation,
+		FRotator& OutVisualRotation);
+}
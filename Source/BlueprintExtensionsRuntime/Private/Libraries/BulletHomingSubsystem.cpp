@@ -0,0 +1,402 @@
+#include "Libraries/BulletHomingSubsystem.h"
+
+#include "Async/ParallelFor.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "Libraries/BulletHomingSimulation.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "XToolsVersionCompat.h"
+
+namespace
+{
+	/** 少于该数量时单线程计算，任务调度开销高于制导计算本身 */
+	constexpr int32 ParallelGuidanceThreshold = 128;
+
+	enum EFrameInputFlags : uint8
+	{
+		InputValid = 1 << 0,
+		InputHasTargetLocation = 1 << 1,
+		InputHasLiveTarget = 1 << 2,
+		InputUsesTargetComponent = 1 << 3,
+		InputTargetChanged = 1 << 4
+	};
+
+	enum EFrameResultFlags : uint8
+	{
+		/** 低两位存放EStepOutcome */
+		ResultOutcomeMask = 0x3,
+		ResultRestoreTerminalStop = 1 << 2,
+		ResultRestoreSimulation = 1 << 3
+	};
+
+	template <typename ElementType>
+	void RemoveAtSwapNoShrink(TArray<ElementType>& Array, int32 Index)
+	{
+#if XTOOLS_ENGINE_5_8_OR_LATER
+		Array.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+#else
+		Array.RemoveAtSwap(Index, 1, false);
+#endif
+	}
+}
+
+UBulletHomingSubsystem* UBulletHomingSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UBulletHomingSubsystem>() : nullptr;
+}
+
+void UBulletHomingSubsystem::Deinitialize()
+{
+	for (FXToolsBulletHomingState& State : HomingStates)
+	{
+		UBulletHomingLibrary::ResetHomingProjectileState(State);
+	}
+
+	SlotToDense.Empty();
+	SlotSerials.Empty();
+	FreeSlots.Empty();
+	DenseSlots.Empty();
+	ProjectileActors.Empty();
+	ProjectileMovements.Empty();
+	TargetActors.Empty();
+	TargetComponents.Empty();
+	VisualComponents.Empty();
+	HomingOptions.Empty();
+	HomingStates.Empty();
+	HomingStatuses.Empty();
+	ResizeFrameBuffers(0);
+	PendingStatusChanges.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UBulletHomingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBulletHomingSubsystem, STATGROUP_Tickables);
+}
+
+void UBulletHomingSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	UpdateHomingProjectiles(DeltaTime);
+}
+
+FXToolsBulletHomingHandle UBulletHomingSubsystem::RegisterHomingProjectile(
+	AActor* ProjectileActor,
+	UProjectileMovementComponent* ProjectileMovement,
+	AActor* TargetActor,
+	USceneComponent* TargetComponent,
+	USceneComponent* VisualComponent,
+	const FXToolsBulletHomingOptions& Options)
+{
+	if (!IsValid(ProjectileActor) && !IsValid(ProjectileMovement))
+	{
+		return FXToolsBulletHomingHandle();
+	}
+
+	int32 SlotIndex = INDEX_NONE;
+	if (FreeSlots.Num() > 0)
+	{
+#if XTOOLS_ENGINE_5_8_OR_LATER
+		SlotIndex = FreeSlots.Pop(EAllowShrinking::No);
+#else
+		SlotIndex = FreeSlots.Pop(false);
+#endif
+	}
+	else
+	{
+		SlotIndex = SlotToDense.Add(INDEX_NONE);
+		SlotSerials.Add(0);
+	}
+
+	const int32 DenseIndex = DenseSlots.Add(SlotIndex);
+	SlotToDense[SlotIndex] = DenseIndex;
+	ProjectileActors.Add(ProjectileActor);
+	ProjectileMovements.Add(ProjectileMovement);
+	TargetActors.Add(TargetActor);
+	TargetComponents.Add(TargetComponent);
+	VisualComponents.Add(VisualComponent);
+	HomingOptions.Add(Options);
+	HomingStates.AddDefaulted();
+	HomingStatuses.Add(EXToolsBulletHomingStatus::Tracking);
+
+	FXToolsBulletHomingHandle Handle;
+	Handle.Index = SlotIndex;
+	Handle.Serial = SlotSerials[SlotIndex];
+	return Handle;
+}
+
+bool UBulletHomingSubsystem::UnregisterHomingProjectile(FXToolsBulletHomingHandle Handle)
+{
+	const int32 DenseIndex = FindDenseIndex(Handle);
+	if (DenseIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	UBulletHomingLibrary::ResetHomingProjectileState(HomingStates[DenseIndex]);
+	RemoveAtDense(DenseIndex);
+	return true;
+}
+
+bool UBulletHomingSubsystem::SetHomingTarget(FXToolsBulletHomingHandle Handle, AActor* TargetActor, USceneComponent* TargetComponent)
+{
+	const int32 DenseIndex = FindDenseIndex(Handle);
+	if (DenseIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	TargetActors[DenseIndex] = TargetActor;
+	TargetComponents[DenseIndex] = TargetComponent;
+	return true;
+}
+
+bool UBulletHomingSubsystem::SetHomingOptions(FXToolsBulletHomingHandle Handle, const FXToolsBulletHomingOptions& Options)
+{
+	const int32 DenseIndex = FindDenseIndex(Handle);
+	if (DenseIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	HomingOptions[DenseIndex] = Options;
+	return true;
+}
+
+bool UBulletHomingSubsystem::IsHomingProjectileRegistered(FXToolsBulletHomingHandle Handle) const
+{
+	return FindDenseIndex(Handle) != INDEX_NONE;
+}
+
+EXToolsBulletHomingStatus UBulletHomingSubsystem::GetHomingStatus(FXToolsBulletHomingHandle Handle) const
+{
+	const int32 DenseIndex = FindDenseIndex(Handle);
+	return DenseIndex != INDEX_NONE ? HomingStatuses[DenseIndex] : EXToolsBulletHomingStatus::Invalid;
+}
+
+bool UBulletHomingSubsystem::GetHomingState(FXToolsBulletHomingHandle Handle, FXToolsBulletHomingState& OutState) const
+{
+	const int32 DenseIndex = FindDenseIndex(Handle);
+	if (DenseIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutState = HomingStates[DenseIndex];
+	return true;
+}
+
+void UBulletHomingSubsystem::UpdateHomingProjectiles(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBulletHomingSubsystem::UpdateHomingProjectiles);
+
+	// 注册对象已销毁的弹体直接注销，不再恢复其移动组件
+	for (int32 DenseIndex = DenseSlots.Num() - 1; DenseIndex >= 0; --DenseIndex)
+	{
+		if (ProjectileActors[DenseIndex].IsStale() || ProjectileMovements[DenseIndex].IsStale())
+		{
+			RemoveAtDense(DenseIndex);
+		}
+	}
+
+	const int32 NumProjectiles = DenseSlots.Num();
+	if (NumProjectiles == 0)
+	{
+		return;
+	}
+
+	ResizeFrameBuffers(NumProjectiles);
+	const float SafeDeltaTime = FMath::Max(0.0f, FMath::IsFinite(DeltaTime) ? DeltaTime : 0.0f);
+
+	// 采集：读取弹体与目标的世界状态
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(BulletHoming_Gather);
+		for (int32 DenseIndex = 0; DenseIndex < NumProjectiles; ++DenseIndex)
+		{
+			XToolsBulletHoming::FStepInputs Inputs;
+			const bool bValid = XToolsBulletHoming::GatherStepInputs(
+				ProjectileActors[DenseIndex].Get(),
+				ProjectileMovements[DenseIndex].Get(),
+				TargetActors[DenseIndex].Get(),
+				TargetComponents[DenseIndex].Get(),
+				SafeDeltaTime,
+				HomingOptions[DenseIndex],
+				HomingStates[DenseIndex],
+				Inputs);
+
+			const XToolsBulletHoming::FBulletTargetInfo& TargetInfo = Inputs.TargetInfo;
+			FrameInputFlags[DenseIndex] =
+				(bValid ? InputValid : 0) |
+				(TargetInfo.bHasLocation ? InputHasTargetLocation : 0) |
+				(TargetInfo.bHasLiveTarget ? InputHasLiveTarget : 0) |
+				(TargetInfo.bUsesTargetComponent ? InputUsesTargetComponent : 0) |
+				(Inputs.bTargetChanged ? InputTargetChanged : 0);
+			FrameLocations[DenseIndex] = Inputs.CurrentLocation;
+			FrameMovementVelocities[DenseIndex] = Inputs.MovementVelocity;
+			FrameMovementInitialSpeeds[DenseIndex] = Inputs.MovementInitialSpeed;
+			FrameInitialDirections[DenseIndex] = Inputs.InitialDirection;
+			FrameTargetLocations[DenseIndex] = TargetInfo.Location;
+			FrameTargetVelocities[DenseIndex] = TargetInfo.Velocity;
+		}
+	}
+
+	// 计算：只读写紧凑数组，不访问UObject
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(BulletHoming_Guidance);
+		ParallelFor(NumProjectiles, [this, SafeDeltaTime](int32 DenseIndex)
+		{
+			const uint8 InputFlags = FrameInputFlags[DenseIndex];
+			if ((InputFlags & InputValid) == 0)
+			{
+				FrameResultFlags[DenseIndex] = 0;
+				FrameStatuses[DenseIndex] = EXToolsBulletHomingStatus::Invalid;
+				return;
+			}
+
+			XToolsBulletHoming::FStepInputs Inputs;
+			Inputs.CurrentLocation = FrameLocations[DenseIndex];
+			Inputs.MovementVelocity = FrameMovementVelocities[DenseIndex];
+			Inputs.MovementInitialSpeed = FrameMovementInitialSpeeds[DenseIndex];
+			Inputs.InitialDirection = FrameInitialDirections[DenseIndex];
+			Inputs.TargetInfo.bHasLocation = (InputFlags & InputHasTargetLocation) != 0;
+			Inputs.TargetInfo.bHasLiveTarget = (InputFlags & InputHasLiveTarget) != 0;
+			Inputs.TargetInfo.bUsesTargetComponent = (InputFlags & InputUsesTargetComponent) != 0;
+			Inputs.TargetInfo.Location = FrameTargetLocations[DenseIndex];
+			Inputs.TargetInfo.Velocity = FrameTargetVelocities[DenseIndex];
+			Inputs.bTargetChanged = (InputFlags & InputTargetChanged) != 0;
+			Inputs.DeltaTime = SafeDeltaTime;
+
+			XToolsBulletHoming::FStepResult Result;
+			XToolsBulletHoming::ComputeStep(Inputs, HomingOptions[DenseIndex], HomingStates[DenseIndex], Result);
+
+			FrameResultFlags[DenseIndex] =
+				(static_cast<uint8>(Result.Outcome) & ResultOutcomeMask) |
+				(Result.bRestoreTerminalStop ? ResultRestoreTerminalStop : 0) |
+				(Result.bRestoreSimulation ? ResultRestoreSimulation : 0);
+			FrameStatuses[DenseIndex] = Result.Status;
+			FrameVelocities[DenseIndex] = Result.WorldVelocity;
+			FrameAimLocations[DenseIndex] = Result.AimLocation;
+			FrameRestoreVelocities[DenseIndex] = Result.RestoreVelocity;
+		}, NumProjectiles < ParallelGuidanceThreshold ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+	}
+
+	// 写回：统一写入移动组件、Actor与外观组件
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(BulletHoming_Apply);
+		PendingStatusChanges.Reset();
+		for (int32 DenseIndex = 0; DenseIndex < NumProjectiles; ++DenseIndex)
+		{
+			EXToolsBulletHomingStatus NewStatus = EXToolsBulletHomingStatus::Invalid;
+			if ((FrameInputFlags[DenseIndex] & InputValid) != 0)
+			{
+				XToolsBulletHoming::FStepInputs Inputs;
+				Inputs.CurrentLocation = FrameLocations[DenseIndex];
+				Inputs.TargetInfo.bHasLocation = (FrameInputFlags[DenseIndex] & InputHasTargetLocation) != 0;
+				Inputs.TargetInfo.bHasLiveTarget = (FrameInputFlags[DenseIndex] & InputHasLiveTarget) != 0;
+				Inputs.TargetInfo.Location = FrameTargetLocations[DenseIndex];
+				Inputs.DeltaTime = SafeDeltaTime;
+
+				const uint8 ResultFlags = FrameResultFlags[DenseIndex];
+				XToolsBulletHoming::FStepResult Result;
+				Result.Outcome = static_cast<XToolsBulletHoming::EStepOutcome>(ResultFlags & ResultOutcomeMask);
+				Result.Status = FrameStatuses[DenseIndex];
+				Result.WorldVelocity = FrameVelocities[DenseIndex];
+				Result.AimLocation = FrameAimLocations[DenseIndex];
+				Result.bRestoreTerminalStop = (ResultFlags & ResultRestoreTerminalStop) != 0;
+				Result.bRestoreSimulation = (ResultFlags & ResultRestoreSimulation) != 0;
+				Result.RestoreVelocity = FrameRestoreVelocities[DenseIndex];
+
+				FVector WorldVelocity;
+				FRotator ActorRotation;
+				FRotator VisualRotation;
+				XToolsBulletHoming::ApplyStepResult(
+					ProjectileActors[DenseIndex].Get(),
+					ProjectileMovements[DenseIndex].Get(),
+					VisualComponents[DenseIndex].Get(),
+					Inputs,
+					HomingOptions[DenseIndex],
+					Result,
+					HomingStates[DenseIndex],
+					NewStatus,
+					WorldVelocity,
+					ActorRotation,
+					VisualRotation);
+			}
+
+			if (HomingStatuses[DenseIndex] != NewStatus)
+			{
+				HomingStatuses[DenseIndex] = NewStatus;
+
+				FXToolsBulletHomingHandle Handle;
+				Handle.Index = DenseSlots[DenseIndex];
+				Handle.Serial = SlotSerials[Handle.Index];
+				PendingStatusChanges.Emplace(Handle, NewStatus);
+			}
+		}
+	}
+
+	// 回调中可能注销或注册追踪弹，写回全部完成后再广播
+	if (PendingStatusChanges.Num() > 0 && OnHomingStatusChanged.IsBound())
+	{
+		const TArray<TPair<FXToolsBulletHomingHandle, EXToolsBulletHomingStatus>> StatusChanges = MoveTemp(PendingStatusChanges);
+		for (const TPair<FXToolsBulletHomingHandle, EXToolsBulletHomingStatus>& StatusChange : StatusChanges)
+		{
+			OnHomingStatusChanged.Broadcast(StatusChange.Key, StatusChange.Value);
+		}
+	}
+}
+
+int32 UBulletHomingSubsystem::FindDenseIndex(FXToolsBulletHomingHandle Handle) const
+{
+	if (!SlotToDense.IsValidIndex(Handle.Index) || SlotSerials[Handle.Index] != Handle.Serial)
+	{
+		return INDEX_NONE;
+	}
+
+	return SlotToDense[Handle.Index];
+}
+
+void UBulletHomingSubsystem::RemoveAtDense(int32 DenseIndex)
+{
+	const int32 SlotIndex = DenseSlots[DenseIndex];
+	SlotToDense[SlotIndex] = INDEX_NONE;
+	++SlotSerials[SlotIndex];
+	FreeSlots.Add(SlotIndex);
+
+	const int32 LastDenseIndex = DenseSlots.Num() - 1;
+	if (DenseIndex != LastDenseIndex)
+	{
+		SlotToDense[DenseSlots[LastDenseIndex]] = DenseIndex;
+	}
+
+	RemoveAtSwapNoShrink(DenseSlots, DenseIndex);
+	RemoveAtSwapNoShrink(ProjectileActors, DenseIndex);
+	RemoveAtSwapNoShrink(ProjectileMovements, DenseIndex);
+	RemoveAtSwapNoShrink(TargetActors, DenseIndex);
+	RemoveAtSwapNoShrink(TargetComponents, DenseIndex);
+	RemoveAtSwapNoShrink(VisualComponents, DenseIndex);
+	RemoveAtSwapNoShrink(HomingOptions, DenseIndex);
+	RemoveAtSwapNoShrink(HomingStates, DenseIndex);
+	RemoveAtSwapNoShrink(HomingStatuses, DenseIndex);
+}
+
+void UBulletHomingSubsystem::ResizeFrameBuffers(int32 Num)
+{
+	FrameInputFlags.SetNumUninitialized(Num);
+	FrameLocations.SetNumUninitialized(Num);
+	FrameMovementVelocities.SetNumUninitialized(Num);
+	FrameMovementInitialSpeeds.SetNumUninitialized(Num);
+	FrameInitialDirections.SetNumUninitialized(Num);
+	FrameTargetLocations.SetNumUninitialized(Num);
+	FrameTargetVelocities.SetNumUninitialized(Num);
+	FrameResultFlags.SetNumUninitialized(Num);
+	FrameStatuses.SetNumUninitialized(Num);
+	FrameVelocities.SetNumUninitialized(Num);
+	FrameAimLocations.SetNumUninitialized(Num);
+	FrameRestoreVelocities.SetNumUninitialized(Num);
+}
@@ -58,6 +58,416 @@ void InitializeScriptValue(const FProperty* Property, void* ValuePtr)
 	}
 }
 
+// ============================================================================
+// Map索引表：逻辑索引 -> 内部稀疏索引
+// ============================================================================
+
+/**
+ * 删除过元素的Map内部存在空洞，FindInternalIndex需要从头扫描，按索引遍历整个Map是O(n²)。
+ * 索引表一次扫描记录所有有效的内部索引，之后按逻辑索引查表即可。
+ *
+ * 脚本Map没有修改计数，先加后删一个元素会保持长度与最大索引不变但改变空洞位置，
+ * 函数内的局部Map也可能在同一地址上被重新创建，因此签名一致也不能直接信任索引表：
+ * - 索引0、非相邻索引或跨帧访问时完整校验一次，不一致则重建
+ * - 本帧内与上次相同的索引（同一轮循环中先取键再取值）只检查该槽位仍然有效
+ * - 本帧内紧接上次索引的访问（正序或倒序循环）只检查两个索引之间的槽位，均摊O(1)
+ * 本库中增删元素的节点直接使索引表失效。
+ */
+struct FMapIndexTable
+{
+	const void* MapAddr = nullptr;
+	const FMapProperty* MapProperty = nullptr;
+	int32 Num = 0;
+	int32 MaxIndex = 0;
+	int32 Revision = 0;
+	uint64 VerifiedFrame = 0;
+
+	/** 上次查找的逻辑索引，用于识别顺序访问；重建后为INDEX_NONE */
+	int32 LastLookupIndex = INDEX_NONE;
+	TArray<int32> InternalIndices;
+};
+
+/** 每个线程缓存的索引表数量，满了按轮换替换 */
+constexpr int32 MaxCachedMapIndexTables = 8;
+
+struct FMapIndexTableCache
+{
+	TArray<FMapIndexTable, TInlineAllocator<MaxCachedMapIndexTables>> Tables;
+	int32 NextReplaceIndex = 0;
+	int32 NextRevision = 1;
+
+	/** 完整校验（含重建）的次数，供自动化测试确认按索引遍历不会逐次校验 */
+	int32 NumFullChecks = 0;
+};
+
+FMapIndexTableCache& GetMapIndexTableCache()
+{
+	// 蓝图可能在多个线程上执行，每个线程各自缓存，无需加锁
+	static thread_local FMapIndexTableCache Cache;
+	return Cache;
+}
+
+bool DoesMapIndexTableMatchLayout(const FMapIndexTable& Table, const FScriptMapHelper& MapHelper)
+{
+	if (Table.Num != MapHelper.Num() || Table.MaxIndex != MapHelper.GetMaxIndex())
+	{
+		return false;
+	}
+
+	int32 TableIndex = 0;
+	for (int32 InternalIndex = 0; InternalIndex < Table.MaxIndex; ++InternalIndex)
+	{
+		if (MapHelper.IsValidIndex(InternalIndex))
+		{
+			if (TableIndex >= Table.InternalIndices.Num() || Table.InternalIndices[TableIndex] != InternalIndex)
+			{
+				return false;
+			}
+			++TableIndex;
+		}
+	}
+
+	return TableIndex == Table.InternalIndices.Num();
+}
+
+void RebuildMapIndexTable(FMapIndexTable& Table, const FScriptMapHelper& MapHelper)
+{
+	Table.Num = MapHelper.Num();
+	Table.MaxIndex = MapHelper.GetMaxIndex();
+	Table.Revision = GetMapIndexTableCache().NextRevision++;
+	Table.VerifiedFrame = GFrameCounter;
+	Table.LastLookupIndex = INDEX_NONE;
+	Table.InternalIndices.Reset(Table.Num);
+	for (int32 InternalIndex = 0; InternalIndex < Table.MaxIndex; ++InternalIndex)
+	{
+		if (MapHelper.IsValidIndex(InternalIndex))
+		{
+			Table.InternalIndices.Add(InternalIndex);
+		}
+	}
+}
+
+FMapIndexTable* FindMapIndexTable(const void* MapAddr, const FMapProperty* MapProperty)
+{
+	for (FMapIndexTable& Table : GetMapIndexTableCache().Tables)
+	{
+		if (Table.MapAddr == MapAddr && Table.MapProperty == MapProperty)
+		{
+			return &Table;
+		}
+	}
+	return nullptr;
+}
+
+/** 完整校验后获取与Map当前结构一致的索引表，必要时重建 */
+FMapIndexTable& FindOrBuildMapIndexTable(const void* MapAddr, const FMapProperty* MapProperty, const FScriptMapHelper& MapHelper)
+{
+	++GetMapIndexTableCache().NumFullChecks;
+
+	FMapIndexTable* Table = FindMapIndexTable(MapAddr, MapProperty);
+	if (Table)
+	{
+		if (DoesMapIndexTableMatchLayout(*Table, MapHelper))
+		{
+			Table->VerifiedFrame = GFrameCounter;
+			return *Table;
+		}
+	}
+	else
+	{
+		FMapIndexTableCache& Cache = GetMapIndexTableCache();
+		if (Cache.Tables.Num() < MaxCachedMapIndexTables)
+		{
+			Table = &Cache.Tables.AddDefaulted_GetRef();
+		}
+		else
+		{
+			Table = &Cache.Tables[Cache.NextReplaceIndex];
+			Cache.NextReplaceIndex = (Cache.NextReplaceIndex + 1) % MaxCachedMapIndexTables;
+		}
+		Table->MapAddr = MapAddr;
+		Table->MapProperty = MapProperty;
+	}
+
+	RebuildMapIndexTable(*Table, MapHelper);
+	return *Table;
+}
+
+// ============================================================================
+// Map值查找：按值反查键
+// ============================================================================
+
+/** 整数与枚举的Identical等价于逐字节比较，省去每个元素一次虚函数调用 */
+bool IsBitwiseComparableValue(const FProperty* Property)
+{
+	if (!Property || Property->ArrayDim != 1)
+	{
+		return false;
+	}
+
+	if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+	{
+		return NumericProperty->IsInteger();
+	}
+
+	return Property->IsA<FEnumProperty>();
+}
+
+/**
+ * 值 -> 内部索引 的哈希索引，由缓存Map值查找节点按需构建
+ * 每个哈希桶内的内部索引按升序排列，查找结果与顺序遍历一致。
+ * 值可能被引擎节点原地修改而无从察觉（例如引擎的Map Add覆盖已有键的值，长度与最大索引都不变），因此：
+ * - 索引只在构建的这一帧内有效，Map增删元素或本库节点修改值时立即失效
+ * - 查找时先核对桶内元素的值哈希仍与构建时一致，不一致说明索引已过期，丢弃并顺序遍历
+ * - 桶为空时顺序遍历确认，遍历找到匹配说明索引已过期，同样丢弃
+ */
+struct FMapValueIndex
+{
+	const void* MapAddr = nullptr;
+	const FMapProperty* MapProperty = nullptr;
+	int32 Num = 0;
+	int32 MaxIndex = 0;
+	uint64 BuiltFrame = 0;
+	TMap<uint32, TArray<int32, TInlineAllocator<1>>> InternalIndicesByHash;
+};
+
+/** 每个线程缓存的值索引数量，满了按轮换替换 */
+constexpr int32 MaxCachedMapValueIndices = 4;
+
+struct FMapValueIndexCache
+{
+	TArray<FMapValueIndex, TInlineAllocator<MaxCachedMapValueIndices>> Indices;
+	int32 NextReplaceIndex = 0;
+};
+
+FMapValueIndexCache& GetMapValueIndexCache()
+{
+	static thread_local FMapValueIndexCache Cache;
+	return Cache;
+}
+
+FMapValueIndex* FindMapValueIndexSlot(const void* MapAddr, const FMapProperty* MapProperty)
+{
+	for (FMapValueIndex& ValueIndex : GetMapValueIndexCache().Indices)
+	{
+		if (ValueIndex.MapAddr == MapAddr && ValueIndex.MapProperty == MapProperty)
+		{
+			return &ValueIndex;
+		}
+	}
+	return nullptr;
+}
+
+/** 查找本帧内构建且Map结构未变的值索引，没有则返回nullptr，调用方退回顺序遍历 */
+const FMapValueIndex* FindValidMapValueIndex(const void* MapAddr, const FMapProperty* MapProperty, const FScriptMapHelper& MapHelper)
+{
+	const FMapValueIndex* ValueIndex = FindMapValueIndexSlot(MapAddr, MapProperty);
+	if (ValueIndex
+		&& ValueIndex->BuiltFrame == GFrameCounter
+		&& ValueIndex->Num == MapHelper.Num()
+		&& ValueIndex->MaxIndex == MapHelper.GetMaxIndex())
+	{
+		return ValueIndex;
+	}
+	return nullptr;
+}
+
+bool BuildMapValueIndex(const void* MapAddr, const FMapProperty* MapProperty, const FScriptMapHelper& MapHelper)
+{
+	const FProperty* ValueProp = MapProperty->ValueProp;
+	if (!ValueProp || !(ValueProp->PropertyFlags & CPF_HasGetValueTypeHash))
+	{
+		return false;
+	}
+
+	FMapValueIndex* ValueIndex = FindMapValueIndexSlot(MapAddr, MapProperty);
+	if (!ValueIndex)
+	{
+		FMapValueIndexCache& Cache = GetMapValueIndexCache();
+		if (Cache.Indices.Num() < MaxCachedMapValueIndices)
+		{
+			ValueIndex = &Cache.Indices.AddDefaulted_GetRef();
+		}
+		else
+		{
+			ValueIndex = &Cache.Indices[Cache.NextReplaceIndex];
+			Cache.NextReplaceIndex = (Cache.NextReplaceIndex + 1) % MaxCachedMapValueIndices;
+		}
+		ValueIndex->MapAddr = MapAddr;
+		ValueIndex->MapProperty = MapProperty;
+	}
+
+	ValueIndex->Num = MapHelper.Num();
+	ValueIndex->MaxIndex = MapHelper.GetMaxIndex();
+	ValueIndex->BuiltFrame = GFrameCounter;
+	ValueIndex->InternalIndicesByHash.Reset();
+	for (int32 InternalIndex = 0; InternalIndex < ValueIndex->MaxIndex; ++InternalIndex)
+	{
+		if (MapHelper.IsValidIndex(InternalIndex))
+		{
+			const uint32 Hash = ValueProp->GetValueTypeHash(MapHelper.GetValuePtr(InternalIndex));
+			ValueIndex->InternalIndicesByHash.FindOrAdd(Hash).Add(InternalIndex);
+		}
+	}
+	return true;
+}
+
+void InvalidateMapValueIndex(const void* MapAddr, const FMapProperty* MapProperty)
+{
+	if (FMapValueIndex* ValueIndex = FindMapValueIndexSlot(MapAddr, MapProperty))
+	{
+		ValueIndex->BuiltFrame = 0;
+		ValueIndex->InternalIndicesByHash.Reset();
+	}
+}
+
+/**
+ * 按升序对值与ValuePtr相同的每个元素调用Visitor(InternalIndex)，Visitor返回false时停止
+ * 有值索引且桶内元素的值未变化时只比较同一哈希桶内的元素，否则顺序遍历并尽量逐字节比较
+ */
+template<typename VisitorType>
+void ForEachMatchingValue(const void* MapAddr, const FMapProperty* MapProperty, const FScriptMapHelper& MapHelper, const FProperty* ValueProperty, const void* ValuePtr, VisitorType&& Visitor)
+{
+	const bool bBitwise = IsBitwiseComparableValue(ValueProperty);
+	const int32 ValueSize = XTOOLS_GET_ELEMENT_SIZE(ValueProperty);
+	auto IsMatch = [&](int32 InternalIndex)
+	{
+		const void* MapValuePtr = MapHelper.GetValuePtr(InternalIndex);
+		return bBitwise
+			? FMemory::Memcmp(ValuePtr, MapValuePtr, ValueSize) == 0
+			: ValueProperty->Identical(ValuePtr, MapValuePtr, PPF_None);
+	};
+
+	bool bVerifyIndexMiss = false;
+	if (const FMapValueIndex* ValueIndex = FindValidMapValueIndex(MapAddr, MapProperty, MapHelper))
+	{
+		const uint32 Hash = ValueProperty->GetValueTypeHash(ValuePtr);
+		const auto* Candidates = ValueIndex->InternalIndicesByHash.Find(Hash);
+
+		// 桶内元素的值哈希与构建时不同，说明值已被原地修改，索引整体不可信
+		bool bStale = false;
+		for (int32 CandidateIndex = 0; Candidates && !bStale && CandidateIndex < Candidates->Num(); ++CandidateIndex)
+		{
+			const int32 InternalIndex = (*Candidates)[CandidateIndex];
+			bStale = !MapHelper.IsValidIndex(InternalIndex) || ValueProperty->GetValueTypeHash(MapHelper.GetValuePtr(InternalIndex)) != Hash;
+		}
+
+		if (Candidates && !bStale)
+		{
+			for (const int32 InternalIndex : *Candidates)
+			{
+				if (IsMatch(InternalIndex) && !Visitor(InternalIndex))
+				{
+					return;
+				}
+			}
+			return;
+		}
+
+		if (bStale)
+		{
+			InvalidateMapValueIndex(MapAddr, MapProperty);
+		}
+		else
+		{
+			// 桶为空时其他元素的值可能被改成了目标值，顺序遍历确认
+			bVerifyIndexMiss = true;
+		}
+	}
+
+	for (int32 InternalIndex = 0; InternalIndex < MapHelper.GetMaxIndex(); ++InternalIndex)
+	{
+		if (MapHelper.IsValidIndex(InternalIndex) && IsMatch(InternalIndex))
+		{
+			if (bVerifyIndexMiss)
+			{
+				InvalidateMapValueIndex(MapAddr, MapProperty);
+				bVerifyIndexMiss = false;
+			}
+
+			if (!Visitor(InternalIndex))
+			{
+				return;
+			}
+		}
+	}
+}
+
+void InvalidateMapIndexTable(const void* MapAddr, const FMapProperty* MapProperty)
+{
+	if (FMapIndexTable* Table = FindMapIndexTable(MapAddr, MapProperty))
+	{
+		// 保留槽位，下次访问时按新结构重建
+		Table->Num = INDEX_NONE;
+	}
+	InvalidateMapValueIndex(MapAddr, MapProperty);
+}
+
+/**
+ * 与上次查找相同或相邻的索引能否直接使用索引表
+ * 相同索引的槽位仍有效时直接使用；相邻索引的两个槽位仍有效且之间没有新增元素时，两者之间的映射未变
+ */
+bool IsAdjacentLookupConsistent(const FMapIndexTable& Table, const FScriptMapHelper& MapHelper, int32 Index)
+{
+	if (Table.VerifiedFrame != GFrameCounter
+		|| Table.LastLookupIndex == INDEX_NONE
+		|| FMath::Abs(Index - Table.LastLookupIndex) > 1
+		|| Table.Num != MapHelper.Num()
+		|| Table.MaxIndex != MapHelper.GetMaxIndex())
+	{
+		return false;
+	}
+
+	if (Index == Table.LastLookupIndex)
+	{
+		return MapHelper.IsValidIndex(Table.InternalIndices[Index]);
+	}
+
+	const int32 LowerInternalIndex = Table.InternalIndices[FMath::Min(Index, Table.LastLookupIndex)];
+	const int32 UpperInternalIndex = Table.InternalIndices[FMath::Max(Index, Table.LastLookupIndex)];
+	if (!MapHelper.IsValidIndex(LowerInternalIndex) || !MapHelper.IsValidIndex(UpperInternalIndex))
+	{
+		return false;
+	}
+
+	for (int32 InternalIndex = LowerInternalIndex + 1; InternalIndex < UpperInternalIndex; ++InternalIndex)
+	{
+		if (MapHelper.IsValidIndex(InternalIndex))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/** FindInternalIndex的缓存版本，调用方需保证Index在[0, Num)范围内 */
+int32 FindInternalIndexCached(const void* MapAddr, const FMapProperty* MapProperty, const FScriptMapHelper& MapHelper, int32 Index)
+{
+	// 没有空洞时逻辑索引就是内部索引
+	if (MapHelper.GetMaxIndex() == MapHelper.Num())
+	{
+		return MapHelper.IsValidIndex(Index) ? Index : INDEX_NONE;
+	}
+
+	// 首次访问索引0视为一轮遍历的开始，与其他非相邻访问一样完整校验；紧接着的同一索引访问（取键后取值）不再校验
+	FMapIndexTable* Table = FindMapIndexTable(MapAddr, MapProperty);
+	if (!Table || (Index == 0 && Table->LastLookupIndex != 0) || !IsAdjacentLookupConsistent(*Table, MapHelper, Index))
+	{
+		Table = &FindOrBuildMapIndexTable(MapAddr, MapProperty, MapHelper);
+	}
+
+	Table->LastLookupIndex = Index;
+	const int32 InternalIndex = Table->InternalIndices[Index];
+	return MapHelper.IsValidIndex(InternalIndex) ? InternalIndex : INDEX_NONE;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+int32 XTools::MapExtensions::GetNumMapIndexTableFullChecks()
+{
+	return GetMapIndexTableCache().NumFullChecks;
+}
+#endif
+
 //————————————————————————————————————————————————————————————————————————————————————————————————————
 
 #pragma region GetKey
@@ -112,7 +522,7 @@ bool UMapExtensionsLibrary::GenericMap_GetKey(const void* TargetMap, const FMapP
 		// 修复：空Map时Num()-1会导致整数下溢，应使用>=检查
 		if(Index < 0 || Index >= MapHelper.Num()) return false;
 
-		const int32 InternalIndex = MapHelper.FindInternalIndex(Index);
+		const int32 InternalIndex = FindInternalIndexCached(TargetMap, MapProperty, MapHelper, Index);
 		if (InternalIndex == INDEX_NONE)
 		{
 			return false;
@@ -181,7 +591,7 @@ bool UMapExtensionsLibrary::GenericMap_GetValue(const void* TargetMap, const FMa
 		// 修复：空Map时Num()-1会导致整数下溢，应使用>=检查
 		if(Index < 0 || Index >= MapHelper.Num()) return false;
 
-		const int32 InternalIndex = MapHelper.FindInternalIndex(Index);
+		const int32 InternalIndex = FindInternalIndexCached(TargetMap, MapProperty, MapHelper, Index);
 		if (InternalIndex == INDEX_NONE)
 		{
 			return false;
@@ -346,17 +756,13 @@ bool UMapExtensionsLibrary::GenericMap_FindValue(const void* TargetMap, const FM
 	if(TargetMap && MapProperty && ValueProperty && ValuePtr)
 	{
 		FScriptMapHelper MapHelper(MapProperty, TargetMap);
-		for(int32 i = 0; i < MapHelper.GetMaxIndex(); i++)
+		bool bFound = false;
+		ForEachMatchingValue(TargetMap, MapProperty, MapHelper, ValueProperty, ValuePtr, [&bFound](int32)
 		{
-			if (!MapHelper.IsValidIndex(i))
-			{
-				continue;
-			}
-
-			const void* MapValuePtr = MapHelper.GetValuePtr(i);
-			if(!MapValuePtr) return false;
-			if(ValueProperty->Identical(ValuePtr, MapValuePtr, PPF_None)) return true;
-		}
+			bFound = true;
+			return false;
+		});
+		return bFound;
 	}
 	
 	return false;
@@ -418,23 +824,13 @@ void UMapExtensionsLibrary::GenericMap_KeysFromValue(const void* MapAddr, const
 
 		const FProperty* InnerProp = ArrayProperty->Inner;
 		
-		for(int32 i = 0; i < MapHelper.Num(); i++)
+		// 按内部索引升序访问，结果顺序与按逻辑索引遍历一致
+		ForEachMatchingValue(MapAddr, MapProperty, MapHelper, ValueProperty, ValuePtr, [&](int32 InternalIndex)
 		{
-			const int32 InternalIndex = MapHelper.FindInternalIndex(i);
-			if (InternalIndex == INDEX_NONE)
-			{
-				continue;
-			}
-
-			const void* MapValuePtr = MapHelper.GetValuePtr(InternalIndex);
-			if(!MapValuePtr) continue;
-
-			if(ValueProperty->Identical(ValuePtr, MapValuePtr, PPF_None))
-			{
-				const int32 LastIndex = ArrayHelper.AddValue();
-				InnerProp->CopySingleValueToScriptVM(ArrayHelper.GetRawPtr(LastIndex), MapHelper.GetKeyPtr(InternalIndex));
-			}
-		}
+			const int32 LastIndex = ArrayHelper.AddValue();
+			InnerProp->CopySingleValueToScriptVM(ArrayHelper.GetRawPtr(LastIndex), MapHelper.GetKeyPtr(InternalIndex));
+			return true;
+		});
 	}
 }
 #pragma endregion
@@ -482,6 +878,7 @@ bool UMapExtensionsLibrary::GenericMap_RemoveEntries(const void* MapAddr, const
 		{
 			if(!MapHelper.RemovePair(ArrayHelper.GetRawPtr(i))) bResult = false;
 		}
+		InvalidateMapIndexTable(MapAddr, MapProperty);
 
 		return bResult;
 	}
@@ -530,27 +927,21 @@ bool UMapExtensionsLibrary::GenericMap_RemoveEntriesWithValue(const void* MapAdd
 {
 	if (MapAddr && MapProperty && ValueProp && ValuePtr)
 	{
-		bool bResult = false;
 		FScriptMapHelper MapHelper(MapProperty, MapAddr);
 		
 		TArray<int32> IndicesToRemove;
-		for (int32 Index = 0; Index < MapHelper.GetMaxIndex(); ++Index)
+		ForEachMatchingValue(MapAddr, MapProperty, MapHelper, ValueProp, ValuePtr, [&IndicesToRemove](int32 InternalIndex)
 		{
-			if (MapHelper.IsValidIndex(Index))
-			{
-				uint8* ValueData = MapHelper.GetValuePtr(Index);
-				if (ValueProp->Identical(ValuePtr, ValueData, PPF_None))
-				{
-					IndicesToRemove.Add(Index);
-					bResult = true;
-				}
-			}
-		}
+			IndicesToRemove.Add(InternalIndex);
+			return true;
+		});
+		const bool bResult = IndicesToRemove.Num() > 0;
 
 		for (int32 i = IndicesToRemove.Num() - 1; i >= 0; --i)
 		{
 			MapHelper.RemoveAt(IndicesToRemove[i]);
 		}
+		InvalidateMapIndexTable(MapAddr, MapProperty);
 
 		return bResult;
 	}
@@ -604,20 +995,15 @@ bool UMapExtensionsLibrary::GenericMap_SetValueAt(const void* MapAddr, const FMa
 		
 		if (Index < 0 || Index >= MapHelper.Num()) return false;
 		
-		const FProperty* KeyProperty = MapProperty->KeyProp;
-		const int32 KeyPropertySize = XTOOLS_GET_ELEMENT_SIZE(KeyProperty) * KeyProperty->ArrayDim;
-		void* KeyStorageSpace = FMemory_Alloca(KeyPropertySize);
-		XTools::MapExtensions::FScopedInitializedPropertyValue ScopedKeyValue(KeyProperty, KeyStorageSpace);
-		
-		const int32 InternalIndex = MapHelper.FindInternalIndex(Index);
+		const int32 InternalIndex = FindInternalIndexCached(MapAddr, MapProperty, MapHelper, Index);
 		if (InternalIndex == INDEX_NONE)
 		{
 			return false;
 		}
 
-		MapHelper.KeyProp->CopyCompleteValueFromScriptVM(KeyStorageSpace, MapHelper.GetKeyPtr(InternalIndex));
-		
-		MapHelper.AddPair(KeyStorageSpace, ValuePtr);
+		// 键不变，直接覆盖值，无需拷贝键再重新哈希插入
+		MapHelper.ValueProp->CopyCompleteValue(MapHelper.GetValuePtr(InternalIndex), ValuePtr);
+		InvalidateMapValueIndex(MapAddr, MapProperty);
 		return true;
 	}
 	
@@ -627,6 +1013,105 @@ bool UMapExtensionsLibrary::GenericMap_SetValueAt(const void* MapAddr, const FMa
 
 //————————————————————————————————————————————————————————————————————————————————————————————————————
 
+#pragma region IndexView
+DEFINE_FUNCTION(UMapExtensionsLibrary::execMap_MakeIndexView)
+{
+	Stack.MostRecentProperty = nullptr;
+	Stack.StepCompiledIn<FMapProperty>(nullptr);
+	const void* MapAddr = Stack.MostRecentPropertyAddress;
+	const FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+	if (!MapProperty)
+	{
+		Stack.bArrayContextFailed = true;
+		return;
+	}
+
+	P_FINISH;
+	P_NATIVE_BEGIN;
+	*(FXToolsMapIndexView*)RESULT_PARAM = GenericMap_MakeIndexView(MapAddr, MapProperty);
+	P_NATIVE_END
+}
+
+FXToolsMapIndexView UMapExtensionsLibrary::GenericMap_MakeIndexView(const void* TargetMap, const FMapProperty* MapProperty)
+{
+	FXToolsMapIndexView IndexView;
+	if (TargetMap && MapProperty)
+	{
+		FScriptMapHelper MapHelper(MapProperty, TargetMap);
+		const FMapIndexTable& Table = FindOrBuildMapIndexTable(TargetMap, MapProperty, MapHelper);
+		IndexView.Num = Table.Num;
+		IndexView.Revision = Table.Revision;
+	}
+	return IndexView;
+}
+
+DEFINE_FUNCTION(UMapExtensionsLibrary::execMap_IsIndexViewValid)
+{
+	Stack.MostRecentProperty = nullptr;
+	Stack.StepCompiledIn<FMapProperty>(nullptr);
+	const void* MapAddr = Stack.MostRecentPropertyAddress;
+	const FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+	if (!MapProperty)
+	{
+		Stack.bArrayContextFailed = true;
+		return;
+	}
+
+	P_GET_STRUCT_REF(FXToolsMapIndexView, IndexView);
+
+	P_FINISH;
+	P_NATIVE_BEGIN;
+	*(bool*)RESULT_PARAM = GenericMap_IsIndexViewValid(MapAddr, MapProperty, IndexView);
+	P_NATIVE_END
+}
+
+bool UMapExtensionsLibrary::GenericMap_IsIndexViewValid(const void* TargetMap, const FMapProperty* MapProperty, const FXToolsMapIndexView& IndexView)
+{
+	if (!TargetMap || !MapProperty || IndexView.Revision == 0 || !FindMapIndexTable(TargetMap, MapProperty))
+	{
+		return false;
+	}
+
+	// 结构未变时复用原表，版本保持不变；增删过元素则重建并得到新版本
+	FScriptMapHelper MapHelper(MapProperty, TargetMap);
+	return FindOrBuildMapIndexTable(TargetMap, MapProperty, MapHelper).Revision == IndexView.Revision;
+}
+#pragma endregion
+
+//————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#pragma region CacheValueLookups
+DEFINE_FUNCTION(UMapExtensionsLibrary::execMap_CacheValueLookups)
+{
+	Stack.MostRecentProperty = nullptr;
+	Stack.StepCompiledIn<FMapProperty>(nullptr);
+	const void* MapAddr = Stack.MostRecentPropertyAddress;
+	const FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+	if (!MapProperty)
+	{
+		Stack.bArrayContextFailed = true;
+		return;
+	}
+
+	P_FINISH;
+	P_NATIVE_BEGIN;
+	*(bool*)RESULT_PARAM = GenericMap_CacheValueLookups(MapAddr, MapProperty);
+	P_NATIVE_END
+}
+
+bool UMapExtensionsLibrary::GenericMap_CacheValueLookups(const void* TargetMap, const FMapProperty* MapProperty)
+{
+	if (TargetMap && MapProperty)
+	{
+		FScriptMapHelper MapHelper(MapProperty, TargetMap);
+		return BuildMapValueIndex(TargetMap, MapProperty, MapHelper);
+	}
+	return false;
+}
+#pragma endregion
+
+//————————————————————————————————————————————————————————————————————————————————————————————————————
+
 #pragma region RandomMapItem
 DEFINE_FUNCTION(UMapExtensionsLibrary::execMap_RandomItem)
 {
@@ -687,7 +1172,7 @@ void UMapExtensionsLibrary::GenericMap_RandomItem(const void* MapAddr, const FMa
 			if (MapHelper.Num() > 0)
 			{
 				const int32 Index = FMath::RandRange(0, MapHelper.Num() - 1);
-				const int32 InternalIndex = MapHelper.FindInternalIndex(Index);
+				const int32 InternalIndex = FindInternalIndexCached(MapAddr, MapProperty, MapHelper, Index);
 				if (InternalIndex != INDEX_NONE)
 				{
 					MapHelper.KeyProp->CopyCompleteValueFromScriptVM(OutKeyPtr, MapHelper.GetKeyPtr(InternalIndex));
@@ -769,7 +1254,7 @@ void UMapExtensionsLibrary::GenericMap_RandomItemFromStream(const void* MapAddr,
 			if (MapHelper.Num() > 0)
 			{
 				const int32 Index = RandomStream ? RandomStream->RandRange(0, MapHelper.Num() - 1) : FMath::RandRange(0, MapHelper.Num() - 1);
-				const int32 InternalIndex = MapHelper.FindInternalIndex(Index);
+				const int32 InternalIndex = FindInternalIndexCached(MapAddr, MapProperty, MapHelper, Index);
 				if (InternalIndex != INDEX_NONE)
 				{
 					MapHelper.KeyProp->CopyCompleteValueFromScriptVM(OutKeyPtr, MapHelper.GetKeyPtr(InternalIndex));
@@ -844,12 +1329,11 @@ bool UMapExtensionsLibrary::GenericMap_Identical(const void* MapAddr, const FMap
 			const FProperty* ValueProperty = MapHelper.GetValueProperty();
 
 			// 修复：优化 O(N²) 算法，找到匹配后立即跳出内层循环
-			for(int32 MapIndex = 0; MapIndex < MapHelper.Num(); MapIndex++)
+			for(int32 InternalIndex = 0; InternalIndex < MapHelper.GetMaxIndex(); InternalIndex++)
 			{
-				const int32 InternalIndex = MapHelper.FindInternalIndex(MapIndex);
-				if (InternalIndex == INDEX_NONE)
+				if (!MapHelper.IsValidIndex(InternalIndex))
 				{
-					return false;
+					continue;
 				}
 				bool bFound = false;
 
@@ -952,6 +1436,7 @@ bool UMapExtensionsLibrary::GenericMap_Identical(const void* MapAddr, const FMap
 
             // 将构建好的结构体添加到Map中
             MapHelper.AddPair(KeyPtr, ValueStructure);
+            InvalidateMapIndexTable(TargetMap, MapProperty);
 
             // 清理临时结构体
             StructProp->DestroyValue(ValueStructure);
@@ -1065,6 +1550,7 @@ bool UMapExtensionsLibrary::GenericMap_Identical(const void* MapAddr, const FMap
 
             // 将构建好的结构体添加到Map中
             MapHelper.AddPair(KeyPtr, ValueStructure);
+            InvalidateMapIndexTable(TargetMap, MapProperty);
 
             // 清理临时结构体
             StructProp->DestroyValue(ValueStructure);
@@ -1210,6 +1696,7 @@ bool UMapExtensionsLibrary::GenericMap_Identical(const void* MapAddr, const FMap
 
             // 将构建好的结构体添加到Map中
             MapHelper.AddPair(KeyPtr, ScopedValue.Get());
+            InvalidateMapIndexTable(TargetMap, MapProperty);
         }
     }
 
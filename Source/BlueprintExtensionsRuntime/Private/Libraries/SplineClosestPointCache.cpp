@@ -0,0 +1,341 @@
+#include "Libraries/SplineClosestPointCache.h"
+
+#include "Components/SplineComponent.h"
+#include "Misc/Crc.h"
+#include "UObject/ObjectKey.h"
+
+namespace XToolsSplineClosestPoint
+{
+	namespace
+	{
+		/** 每段样条的采样数，折线边数 = 段数 * 该值 */
+		constexpr int32 SamplesPerSegment = 8;
+
+		/** 叶节点最多包含的折线边数 */
+		constexpr int32 MaxLeafEdges = 4;
+
+		/** 有上次输入键时，向两侧各搜索的样条段数 */
+		constexpr int32 HintWindowSegments = 2;
+
+		/** 曲线上细化最近点的牛顿迭代次数上限 */
+		constexpr int32 MaxRefineIterations = 4;
+
+		/** 缓存的样条数超过该值时清理已销毁样条的条目 */
+		constexpr int32 PruneThreshold = 64;
+
+		struct FBoundsNode
+		{
+			FBox Bounds = FBox(ForceInit);
+			int32 FirstEdge = 0;
+			int32 NumEdges = 0;
+
+			/** 第二个子节点的下标，第一个子节点紧跟在当前节点之后；叶节点为INDEX_NONE */
+			int32 SecondChild = INDEX_NONE;
+		};
+
+		struct FClosestPointTable
+		{
+			int32 NumPoints = 0;
+			bool bClosedLoop = false;
+			float SplineLength = 0.0f;
+			uint32 ControlPointHash = 0;
+			uint64 VerifiedFrame = 0;
+
+			/** 本地空间采样点，第i个采样点的输入键为 i / SamplesPerSegment */
+			TArray<FVector> Samples;
+			TArray<FBoundsNode> Nodes;
+
+			int32 NumEdges() const { return Samples.Num() - 1; }
+		};
+
+		struct FEdgeHit
+		{
+			int32 Edge = INDEX_NONE;
+			double Alpha = 0.0;
+			double SquaredDistance = TNumericLimits<double>::Max();
+		};
+
+		TMap<FObjectKey, FClosestPointTable>& GetTables()
+		{
+			static thread_local TMap<FObjectKey, FClosestPointTable> Tables;
+			return Tables;
+		}
+
+		uint32 HashControlPoints(const USplineComponent& SplineComponent, int32 NumPoints)
+		{
+			uint32 Hash = 0;
+			for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+			{
+				const FVector Values[3] = {
+					SplineComponent.GetLocationAtSplinePoint(PointIndex, ESplineCoordinateSpace::Local),
+					SplineComponent.GetArriveTangentAtSplinePoint(PointIndex, ESplineCoordinateSpace::Local),
+					SplineComponent.GetLeaveTangentAtSplinePoint(PointIndex, ESplineCoordinateSpace::Local)
+				};
+				const uint8 PointType = static_cast<uint8>(SplineComponent.GetSplinePointType(PointIndex));
+				Hash = FCrc::MemCrc32(Values, sizeof(Values), Hash);
+				Hash = FCrc::MemCrc32(&PointType, sizeof(PointType), Hash);
+			}
+			return Hash;
+		}
+
+		int32 BuildNode(FClosestPointTable& Table, int32 FirstEdge, int32 NumEdges)
+		{
+			const int32 NodeIndex = Table.Nodes.AddDefaulted();
+
+			FBox Bounds(ForceInit);
+			for (int32 Edge = FirstEdge; Edge < FirstEdge + NumEdges; ++Edge)
+			{
+				Bounds += Table.Samples[Edge];
+				Bounds += Table.Samples[Edge + 1];
+			}
+			Table.Nodes[NodeIndex].Bounds = Bounds;
+			Table.Nodes[NodeIndex].FirstEdge = FirstEdge;
+			Table.Nodes[NodeIndex].NumEdges = NumEdges;
+
+			// 采样点沿曲线有序，按边序号对半分即可得到空间上紧凑的子节点
+			if (NumEdges > MaxLeafEdges)
+			{
+				const int32 NumFirstEdges = NumEdges / 2;
+				BuildNode(Table, FirstEdge, NumFirstEdges);
+				const int32 SecondChild = BuildNode(Table, FirstEdge + NumFirstEdges, NumEdges - NumFirstEdges);
+				Table.Nodes[NodeIndex].SecondChild = SecondChild;
+			}
+			return NodeIndex;
+		}
+
+		void BuildTable(const USplineComponent& SplineComponent, FClosestPointTable& Table)
+		{
+			const int32 NumSegments = Table.bClosedLoop ? Table.NumPoints : Table.NumPoints - 1;
+			const int32 NumSamples = NumSegments * SamplesPerSegment + 1;
+
+			Table.Samples.SetNumUninitialized(NumSamples);
+			for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+			{
+				const float InputKey = static_cast<float>(SampleIndex) / static_cast<float>(SamplesPerSegment);
+				Table.Samples[SampleIndex] = SplineComponent.GetLocationAtSplineInputKey(InputKey, ESplineCoordinateSpace::Local);
+			}
+
+			Table.Nodes.Reset();
+			BuildNode(Table, 0, NumSamples - 1);
+		}
+
+		FClosestPointTable* FindOrBuildTable(const USplineComponent& SplineComponent)
+		{
+			TMap<FObjectKey, FClosestPointTable>& Tables = GetTables();
+			const FObjectKey SplineKey(&SplineComponent);
+
+			const int32 NumPoints = SplineComponent.GetNumberOfSplinePoints();
+			const bool bClosedLoop = SplineComponent.IsClosedLoop();
+			const float SplineLength = SplineComponent.GetSplineLength();
+
+			FClosestPointTable* Table = Tables.Find(SplineKey);
+			if (Table
+				&& Table->NumPoints == NumPoints
+				&& Table->bClosedLoop == bClosedLoop
+				&& Table->SplineLength == SplineLength)
+			{
+				// 数量与长度不变时每帧只校验一次控制点内容
+				if (Table->VerifiedFrame == GFrameCounter)
+				{
+					return Table;
+				}
+
+				Table->VerifiedFrame = GFrameCounter;
+				const uint32 ControlPointHash = HashControlPoints(SplineComponent, NumPoints);
+				if (ControlPointHash == Table->ControlPointHash)
+				{
+					return Table;
+				}
+			}
+
+			if (!Table)
+			{
+				if (Tables.Num() >= PruneThreshold)
+				{
+					for (auto It = Tables.CreateIterator(); It; ++It)
+					{
+						if (!It.Key().ResolveObjectPtr())
+						{
+							It.RemoveCurrent();
+						}
+					}
+				}
+				Table = &Tables.Add(SplineKey);
+			}
+
+			Table->NumPoints = NumPoints;
+			Table->bClosedLoop = bClosedLoop;
+			Table->SplineLength = SplineLength;
+			Table->ControlPointHash = HashControlPoints(SplineComponent, NumPoints);
+			Table->VerifiedFrame = GFrameCounter;
+			BuildTable(SplineComponent, *Table);
+			return Table;
+		}
+
+		bool TestEdge(const FClosestPointTable& Table, const FVector& LocalLocation, int32 Edge, FEdgeHit& Best)
+		{
+			const FVector& Start = Table.Samples[Edge];
+			const FVector EdgeVector = Table.Samples[Edge + 1] - Start;
+			const double EdgeSizeSquared = EdgeVector.SizeSquared();
+			const double Alpha = EdgeSizeSquared > UE_SMALL_NUMBER
+				? FMath::Clamp(FVector::DotProduct(LocalLocation - Start, EdgeVector) / EdgeSizeSquared, 0.0, 1.0)
+				: 0.0;
+			const double SquaredDistance = FVector::DistSquared(Start + EdgeVector * Alpha, LocalLocation);
+			if (SquaredDistance >= Best.SquaredDistance)
+			{
+				return false;
+			}
+
+			Best.Edge = Edge;
+			Best.Alpha = Alpha;
+			Best.SquaredDistance = SquaredDistance;
+			return true;
+		}
+
+		/**
+		 * 在上次输入键附近的折线边中搜索，得到的最近距离作为包围盒层次搜索的初始上界
+		 * 窗口只负责让剪枝更早生效，最终结果仍由层次搜索保证是全局最近边
+		 */
+		void SearchHintWindow(const FClosestPointTable& Table, const FVector& LocalLocation, float HintInputKey, FEdgeHit& Best)
+		{
+			const int32 NumEdges = Table.NumEdges();
+			const int32 WindowEdges = HintWindowSegments * SamplesPerSegment;
+			if (WindowEdges * 2 + 1 >= NumEdges)
+			{
+				return;
+			}
+
+			const int32 CenterEdge = FMath::Clamp(FMath::FloorToInt32(HintInputKey * SamplesPerSegment), 0, NumEdges - 1);
+			int32 FirstOffset = CenterEdge - WindowEdges;
+			int32 LastOffset = CenterEdge + WindowEdges;
+			if (!Table.bClosedLoop)
+			{
+				FirstOffset = FMath::Max(FirstOffset, 0);
+				LastOffset = FMath::Min(LastOffset, NumEdges - 1);
+			}
+
+			for (int32 Offset = FirstOffset; Offset <= LastOffset; ++Offset)
+			{
+				const int32 Edge = Table.bClosedLoop ? (Offset % NumEdges + NumEdges) % NumEdges : Offset;
+				TestEdge(Table, LocalLocation, Edge, Best);
+			}
+		}
+
+		void SearchTree(const FClosestPointTable& Table, const FVector& LocalLocation, FEdgeHit& Best)
+		{
+			// 深度优先且每层最多压入一个兄弟节点，栈深度不超过树高
+			int32 Stack[64];
+			int32 StackSize = 0;
+			Stack[StackSize++] = 0;
+
+			while (StackSize > 0)
+			{
+				const int32 NodeIndex = Stack[--StackSize];
+				const FBoundsNode& Node = Table.Nodes[NodeIndex];
+				if (Node.Bounds.ComputeSquaredDistanceToPoint(LocalLocation) >= Best.SquaredDistance)
+				{
+					continue;
+				}
+
+				if (Node.SecondChild == INDEX_NONE)
+				{
+					for (int32 Edge = Node.FirstEdge; Edge < Node.FirstEdge + Node.NumEdges; ++Edge)
+					{
+						TestEdge(Table, LocalLocation, Edge, Best);
+					}
+					continue;
+				}
+
+				// 先访问较近的子节点，使后续剪枝更早生效
+				const int32 FirstChild = NodeIndex + 1;
+				const int32 SecondChild = Node.SecondChild;
+				const bool bFirstIsNearer = Table.Nodes[FirstChild].Bounds.ComputeSquaredDistanceToPoint(LocalLocation)
+					<= Table.Nodes[SecondChild].Bounds.ComputeSquaredDistanceToPoint(LocalLocation);
+				Stack[StackSize++] = bFirstIsNearer ? SecondChild : FirstChild;
+				Stack[StackSize++] = bFirstIsNearer ? FirstChild : SecondChild;
+			}
+		}
+
+		/** 在最近边及其相邻边的输入键范围内，沿曲线做牛顿迭代 */
+		float RefineInputKey(const USplineComponent& SplineComponent, const FClosestPointTable& Table, const FVector& LocalLocation, const FEdgeHit& Hit)
+		{
+			const float KeyStep = 1.0f / static_cast<float>(SamplesPerSegment);
+			const float MaxInputKey = static_cast<float>(Table.NumEdges()) * KeyStep;
+			const float MinKey = FMath::Max(static_cast<float>(Hit.Edge - 1) * KeyStep, 0.0f);
+			const float MaxKey = FMath::Min(static_cast<float>(Hit.Edge + 2) * KeyStep, MaxInputKey);
+
+			float InputKey = (static_cast<float>(Hit.Edge) + static_cast<float>(Hit.Alpha)) * KeyStep;
+			float BestInputKey = InputKey;
+			double BestSquaredDistance = TNumericLimits<double>::Max();
+			for (int32 Iteration = 0; Iteration < MaxRefineIterations; ++Iteration)
+			{
+				const FVector Position = SplineComponent.GetLocationAtSplineInputKey(InputKey, ESplineCoordinateSpace::Local);
+				const double SquaredDistance = FVector::DistSquared(Position, LocalLocation);
+				if (SquaredDistance < BestSquaredDistance)
+				{
+					BestSquaredDistance = SquaredDistance;
+					BestInputKey = InputKey;
+				}
+
+				const FVector Tangent = SplineComponent.GetTangentAtSplineInputKey(InputKey, ESplineCoordinateSpace::Local);
+				const double TangentSizeSquared = Tangent.SizeSquared();
+				if (TangentSizeSquared <= UE_SMALL_NUMBER)
+				{
+					break;
+				}
+
+				const double Step = FVector::DotProduct(LocalLocation - Position, Tangent) / TangentSizeSquared;
+				const float NextInputKey = FMath::Clamp(static_cast<float>(InputKey + Step), MinKey, MaxKey);
+				if (FMath::IsNearlyEqual(NextInputKey, InputKey, UE_KINDA_SMALL_NUMBER))
+				{
+					break;
+				}
+				InputKey = NextInputKey;
+			}
+
+			const FVector Position = SplineComponent.GetLocationAtSplineInputKey(InputKey, ESplineCoordinateSpace::Local);
+			return FVector::DistSquared(Position, LocalLocation) < BestSquaredDistance ? InputKey : BestInputKey;
+		}
+	}
+
+	float FindInputKeyClosestToWorldLocation(const USplineComponent& SplineComponent, const FVector& WorldLocation, float HintInputKey)
+	{
+		if (SplineComponent.GetNumberOfSplinePoints() < 2)
+		{
+			return SplineComponent.FindInputKeyClosestToWorldLocation(WorldLocation);
+		}
+
+		const FClosestPointTable* Table = FindOrBuildTable(SplineComponent);
+		if (!Table || Table->Nodes.Num() == 0)
+		{
+			return SplineComponent.FindInputKeyClosestToWorldLocation(WorldLocation);
+		}
+
+		// 与引擎一致，在样条本地空间求最近点，组件移动不需要重建
+		const FVector LocalLocation = SplineComponent.GetComponentTransform().InverseTransformPosition(WorldLocation);
+
+		FEdgeHit Best;
+		if (HintInputKey >= 0.0f)
+		{
+			SearchHintWindow(*Table, LocalLocation, HintInputKey, Best);
+		}
+
+		// 窗口结果作为初始上界，多数子树在包围盒测试时即被剪掉；窗口只找到局部最近时由层次搜索纠正
+		SearchTree(*Table, LocalLocation, Best);
+
+		if (Best.Edge == INDEX_NONE)
+		{
+			return SplineComponent.FindInputKeyClosestToWorldLocation(WorldLocation);
+		}
+
+		return RefineInputKey(SplineComponent, *Table, LocalLocation, Best);
+	}
+
+	void Invalidate(const USplineComponent* SplineComponent)
+	{
+		if (SplineComponent)
+		{
+			GetTables().Remove(FObjectKey(SplineComponent));
+		}
+	}
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USplineComponent;
+
+/**
+ * 样条最近点加速结构
+ * 每条样条在本地空间按输入键等分采样成折线，按采样顺序二分建立包围盒层次；
+ * 查询先在折线上定位最近边，再在曲线上用牛顿迭代细化，代替逐段搜索整条样条。
+ *
+ * - 缓存按样条组件保存，只在游戏线程使用
+ * - 每次查询比较控制点数量、闭环与总长度，每帧首次查询再校验控制点内容，变化时重建
+ * - 提供上次输入键时先在其附近窗口内搜索，用窗口内的最近距离收紧层次搜索的上界
+ */
+namespace XToolsSplineClosestPoint
+{
+	/**
+	 * 查找距离世界位置最近的样条输入键，结果为近似值
+	 * 最近边在采样折线上选出，因此最近点可能比FindInputKeyClosestToWorldLocation的结果稍远，
+	 * 差距不超过样条与采样折线最大偏差的约两倍；到样条多处距离几乎相等时可能选中其中另一处
+	 * @param HintInputKey 上次查询得到的输入键，小于0表示没有；只用于加速，结果与不提供时相同
+	 */
+	float FindInputKeyClosestToWorldLocation(const USplineComponent& SplineComponent, const FVector& WorldLocation, float HintInputKey = -1.0f);
+
+	/** 丢弃样条的缓存，同一帧内修改控制点且数量与长度不变时调用 */
+	void Invalidate(const USplineComponent* SplineComponent);
+}
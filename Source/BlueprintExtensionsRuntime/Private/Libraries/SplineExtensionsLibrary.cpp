@@ -1,6 +1,128 @@
 ﻿#include "Libraries/SplineExtensionsLibrary.h"
 #include "Components/SplineComponent.h"
 
+namespace
+{
+	/** 单个快照的采样点上限，超过时放大采样间距 */
+	constexpr int32 MaxSnapshotSamples = 65536;
+
+	/** 样条距离 -> 采样段下标与段内插值系数 */
+	void LocateSnapshotSample(const FXToolsSplineSnapshot& Snapshot, double Distance, int32& OutIndex, double& OutAlpha)
+	{
+		double SafeDistance = Distance;
+		if (Snapshot.bClosedLoop)
+		{
+			SafeDistance = FMath::Fmod(SafeDistance, Snapshot.Length);
+			if (SafeDistance < 0.0)
+			{
+				SafeDistance += Snapshot.Length;
+			}
+		}
+		else
+		{
+			SafeDistance = FMath::Clamp(SafeDistance, 0.0, Snapshot.Length);
+		}
+
+		const double ScaledDistance = SafeDistance / Snapshot.SampleSpacing;
+		OutIndex = FMath::Clamp(FMath::FloorToInt32(ScaledDistance), 0, Snapshot.Locations.Num() - 2);
+		OutAlpha = FMath::Clamp(ScaledDistance - static_cast<double>(OutIndex), 0.0, 1.0);
+	}
+}
+
+FVector FXToolsSplineSnapshot::GetLocationAtDistance(double Distance) const
+{
+	if (!IsValid())
+	{
+		return Locations.Num() > 0 ? Locations[0] : FVector::ZeroVector;
+	}
+
+	int32 Index = 0;
+	double Alpha = 0.0;
+	LocateSnapshotSample(*this, Distance, Index, Alpha);
+	return FMath::Lerp(Locations[Index], Locations[Index + 1], Alpha);
+}
+
+FVector FXToolsSplineSnapshot::GetDirectionAtDistance(double Distance) const
+{
+	if (!IsValid())
+	{
+		return Directions.Num() > 0 ? Directions[0] : FVector::ForwardVector;
+	}
+
+	int32 Index = 0;
+	double Alpha = 0.0;
+	LocateSnapshotSample(*this, Distance, Index, Alpha);
+	return FMath::Lerp(Directions[Index], Directions[Index + 1], Alpha).GetSafeNormal(UE_SMALL_NUMBER, Directions[Index]);
+}
+
+void FXToolsSplineSnapshot::GetLocationsAtDistances(TConstArrayView<double> Distances, TArrayView<FVector> OutLocations, TArrayView<FVector> OutDirections) const
+{
+	check(OutLocations.Num() == Distances.Num() && OutDirections.Num() == Distances.Num());
+
+	if (!IsValid())
+	{
+		const FVector Location = Locations.Num() > 0 ? Locations[0] : FVector::ZeroVector;
+		const FVector Direction = Directions.Num() > 0 ? Directions[0] : FVector::ForwardVector;
+		for (int32 QueryIndex = 0; QueryIndex < Distances.Num(); ++QueryIndex)
+		{
+			OutLocations[QueryIndex] = Location;
+			OutDirections[QueryIndex] = Direction;
+		}
+		return;
+	}
+
+	const FVector* LocationData = Locations.GetData();
+	const FVector* DirectionData = Directions.GetData();
+	for (int32 QueryIndex = 0; QueryIndex < Distances.Num(); ++QueryIndex)
+	{
+		int32 Index = 0;
+		double Alpha = 0.0;
+		LocateSnapshotSample(*this, Distances[QueryIndex], Index, Alpha);
+		OutLocations[QueryIndex] = FMath::Lerp(LocationData[Index], LocationData[Index + 1], Alpha);
+		OutDirections[QueryIndex] = FMath::Lerp(DirectionData[Index], DirectionData[Index + 1], Alpha).GetSafeNormal(UE_SMALL_NUMBER, DirectionData[Index]);
+	}
+}
+
+double FXToolsSplineSnapshot::FindDistanceClosestToLocation(const FVector& WorldLocation) const
+{
+	if (!IsValid())
+	{
+		return 0.0;
+	}
+
+	// 顺序扫描连续内存中的采样折线，避免逐点访问样条组件
+	const FVector* LocationData = Locations.GetData();
+	double BestSquaredDistance = TNumericLimits<double>::Max();
+	double BestDistance = 0.0;
+	for (int32 Index = 0; Index < Locations.Num() - 1; ++Index)
+	{
+		const FVector Start = LocationData[Index];
+		const FVector Segment = LocationData[Index + 1] - Start;
+		const double SegmentSizeSquared = Segment.SizeSquared();
+		const double Alpha = SegmentSizeSquared > UE_SMALL_NUMBER
+			? FMath::Clamp(FVector::DotProduct(WorldLocation - Start, Segment) / SegmentSizeSquared, 0.0, 1.0)
+			: 0.0;
+		const double SquaredDistance = FVector::DistSquared(Start + Segment * Alpha, WorldLocation);
+		if (SquaredDistance < BestSquaredDistance)
+		{
+			BestSquaredDistance = SquaredDistance;
+			BestDistance = (static_cast<double>(Index) + Alpha) * SampleSpacing;
+		}
+	}
+
+	return FMath::Min(BestDistance, Length);
+}
+
+void FXToolsSplineSnapshot::FindDistancesClosestToLocations(TConstArrayView<FVector> WorldLocations, TArrayView<double> OutDistances) const
+{
+	check(OutDistances.Num() == WorldLocations.Num());
+
+	for (int32 QueryIndex = 0; QueryIndex < WorldLocations.Num(); ++QueryIndex)
+	{
+		OutDistances[QueryIndex] = FindDistanceClosestToLocation(WorldLocations[QueryIndex]);
+	}
+}
+
 bool USplineExtensionsLibrary::SplinePathValid(USplineComponent* SplineComponent)
 {
 	if (!SplineComponent)
@@ -41,11 +163,14 @@ TArray<FVector> USplineExtensionsLibrary::GetSplinePath(USplineComponent* Spline
 		return SplinePath;
 	}
 
-	int32 NumPoints = SplineComponent->GetNumberOfSplinePoints();
+	// 读取本地坐标后统一变换，组件变换只取一次
+	const FTransform& ComponentTransform = SplineComponent->GetComponentTransform();
+	const int32 NumPoints = SplineComponent->GetNumberOfSplinePoints();
+	SplinePath.SetNumUninitialized(NumPoints);
 	for (int32 i = 0; i < NumPoints; ++i)
 	{
-		FVector Location = SplineComponent->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World);
-		SplinePath.Add(Location);
+		SplinePath[i] = ComponentTransform.TransformPosition(
+			SplineComponent->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::Local));
 	}
 
 	return SplinePath;
@@ -58,50 +183,117 @@ void USplineExtensionsLibrary::SimplifySpline(USplineComponent* SplineComponent,
 		return;
 	}
 
-	// 清空现有的样条点
-	SplineComponent->ClearSplinePoints();
+	const FTransform& ComponentTransform = SplineComponent->GetComponentTransform();
 
-	// 添加新的样条点
-	for (const FVector& Location : SplinePath)
+	// 先在输入数组上完成简化，再一次性写入样条，避免逐点添加时反复更新样条
+	TArray<FSplinePoint> SplinePoints;
+	SplinePoints.Reserve(SplinePath.Num());
+
+	auto AddPoint = [&SplinePoints, &ComponentTransform](const FVector& Location, const FVector* ArriveTangent, const FVector* LeaveTangent)
 	{
-		SplineComponent->AddSplinePoint(Location, ESplineCoordinateSpace::World, true);
-	}
+		const float InputKey = static_cast<float>(SplinePoints.Num());
+		const FVector LocalLocation = ComponentTransform.InverseTransformPosition(Location);
+		if (ArriveTangent && LeaveTangent)
+		{
+			SplinePoints.Emplace(InputKey, LocalLocation,
+				ComponentTransform.InverseTransformVector(*ArriveTangent),
+				ComponentTransform.InverseTransformVector(*LeaveTangent),
+				FRotator::ZeroRotator, FVector(1.0f), ESplinePointType::CurveCustomTangent);
+		}
+		else
+		{
+			SplinePoints.Emplace(InputKey, LocalLocation, ESplinePointType::Curve);
+		}
+	};
 
-	// 更新样条曲线
-	SplineComponent->UpdateSpline();
+	AddPoint(SplinePath[0], nullptr, nullptr);
+	FVector PrevLocation = SplinePath[0];
 
-	// 简化样条点
-	for (int32 i = 1; i < SplineComponent->GetNumberOfSplinePoints() - 1; ++i)
+	// 简化样条点，前一个点取最近保留的点
+	for (int32 i = 1; i < SplinePath.Num() - 1; ++i)
 	{
-		FVector PrevLocation = SplineComponent->GetLocationAtSplinePoint(i - 1, ESplineCoordinateSpace::World);
-		FVector CurrentLocation = SplineComponent->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World);
-		FVector NextLocation = SplineComponent->GetLocationAtSplinePoint(i + 1, ESplineCoordinateSpace::World);
+		const FVector& CurrentLocation = SplinePath[i];
+		const FVector& NextLocation = SplinePath[i + 1];
 
 		// 计算前后点的切线
 		FVector PrevTangent = (CurrentLocation - PrevLocation).GetSafeNormal();
 		FVector NextTangent = (NextLocation - CurrentLocation).GetSafeNormal();
 
-		// 如果前后点的切线相同，则移除当前点
+		// 如果前后点的切线相同，则跳过当前点
 		if (PrevTangent.Equals(NextTangent, KINDA_SMALL_NUMBER))
 		{
-			SplineComponent->RemoveSplinePoint(i);
-			--i; // 调整索引以处理移除后的点
-		}
-		else
-		{
-			// 调整当前点的切线
-			FVector ArriveTangent = (CurrentLocation - PrevLocation) / 2.0f;
-			FVector LeaveTangent = (NextLocation - CurrentLocation) / 2.0f;
-
-			SplineComponent->SetTangentsAtSplinePoint(
-				i,
-				ArriveTangent,
-				LeaveTangent,
-				ESplineCoordinateSpace::World,
-				false);
+			continue;
 		}
+
+		// 调整当前点的切线
+		const FVector ArriveTangent = (CurrentLocation - PrevLocation) / 2.0f;
+		const FVector LeaveTangent = (NextLocation - CurrentLocation) / 2.0f;
+		AddPoint(CurrentLocation, &ArriveTangent, &LeaveTangent);
+		PrevLocation = CurrentLocation;
 	}
 
-	// 再次更新样条曲线
-	SplineComponent->UpdateSpline();
+	if (SplinePath.Num() > 1)
+	{
+		AddPoint(SplinePath.Last(), nullptr, nullptr);
+	}
+
+	SplineComponent->ClearSplinePoints(false);
+	SplineComponent->AddPoints(SplinePoints, true);
+}
+
+FXToolsSplineSnapshot USplineExtensionsLibrary::CaptureSplineSnapshot(USplineComponent* SplineComponent, double SampleSpacing)
+{
+	FXToolsSplineSnapshot Snapshot;
+	if (!SplineComponent || SplineComponent->GetNumberOfSplinePoints() < 2)
+	{
+		return Snapshot;
+	}
+
+	const double Length = static_cast<double>(SplineComponent->GetSplineLength());
+	if (Length <= static_cast<double>(KINDA_SMALL_NUMBER))
+	{
+		return Snapshot;
+	}
+
+	const double SafeSpacing = FMath::Max(SampleSpacing, 1.0);
+	const int32 NumSamples = static_cast<int32>(FMath::Clamp(FMath::CeilToDouble(Length / SafeSpacing), 1.0, static_cast<double>(MaxSnapshotSamples - 1))) + 1;
+
+	Snapshot.Length = Length;
+	Snapshot.SampleSpacing = Length / static_cast<double>(NumSamples - 1);
+	Snapshot.bClosedLoop = SplineComponent->IsClosedLoop();
+	Snapshot.Locations.SetNumUninitialized(NumSamples);
+	Snapshot.Directions.SetNumUninitialized(NumSamples);
+
+	// 在本地空间采样，组件变换只取一次
+	const FTransform& ComponentTransform = SplineComponent->GetComponentTransform();
+	for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+	{
+		const float Distance = static_cast<float>(FMath::Min(static_cast<double>(SampleIndex) * Snapshot.SampleSpacing, Length));
+		const FVector LocalLocation = SplineComponent->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::Local);
+		const FVector LocalDirection = SplineComponent->GetDirectionAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::Local);
+		Snapshot.Locations[SampleIndex] = ComponentTransform.TransformPosition(LocalLocation);
+		Snapshot.Directions[SampleIndex] = ComponentTransform.TransformVector(LocalDirection).GetSafeNormal();
+	}
+
+	return Snapshot;
+}
+
+void USplineExtensionsLibrary::GetSplineSnapshotLocationsAtDistances(
+	const FXToolsSplineSnapshot& Snapshot,
+	const TArray<double>& Distances,
+	TArray<FVector>& OutLocations,
+	TArray<FVector>& OutDirections)
+{
+	OutLocations.SetNumUninitialized(Distances.Num());
+	OutDirections.SetNumUninitialized(Distances.Num());
+	Snapshot.GetLocationsAtDistances(Distances, OutLocations, OutDirections);
+}
+
+void USplineExtensionsLibrary::FindSplineSnapshotDistancesClosestToLocations(
+	const FXToolsSplineSnapshot& Snapshot,
+	const TArray<FVector>& WorldLocations,
+	TArray<double>& OutDistances)
+{
+	OutDistances.SetNumUninitialized(WorldLocations.Num());
+	Snapshot.FindDistancesClosestToLocations(WorldLocations, OutDistances);
 }
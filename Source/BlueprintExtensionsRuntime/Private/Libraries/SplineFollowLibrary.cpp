@@ -7,6 +7,7 @@
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Pawn.h"
+#include "Libraries/SplineClosestPointCache.h"
 #include "XToolsErrorReporter.h"
 
 namespace
@@ -88,14 +89,21 @@ namespace
 		return WrappedDistance;
 	}
 
-	double FindSplineDistanceClosestToLocation(USplineComponent* SplineComponent, const FVector& WorldLocation)
+	double FindSplineDistanceClosestToLocation(USplineComponent* SplineComponent, const FVector& WorldLocation, FXToolsSplineFollowState* State = nullptr)
 	{
 		if (!SplineComponent)
 		{
 			return 0.0;
 		}
 
-		const float ClosestInputKey = SplineComponent->FindInputKeyClosestToWorldLocation(WorldLocation);
+		// 跟随对象逐帧移动距离很小，上次输入键附近通常就是最近点
+		const float HintInputKey = State && State->bHasInputKeyCache ? State->LastClosestInputKey : -1.0f;
+		const float ClosestInputKey = XToolsSplineClosestPoint::FindInputKeyClosestToWorldLocation(*SplineComponent, WorldLocation, HintInputKey);
+		if (State)
+		{
+			State->bHasInputKeyCache = true;
+			State->LastClosestInputKey = ClosestInputKey;
+		}
 		return static_cast<double>(SplineComponent->GetDistanceAlongSplineAtSplineInputKey(ClosestInputKey));
 	}
 
@@ -414,8 +422,7 @@ bool USplineFollowLibrary::CalculateInitialSplineRightOffset(
 		return false;
 	}
 
-	const float ClosestInputKey = SplineComponent->FindInputKeyClosestToWorldLocation(TargetActor->GetActorLocation());
-	OutDistance = static_cast<double>(SplineComponent->GetDistanceAlongSplineAtSplineInputKey(ClosestInputKey));
+	OutDistance = FindSplineDistanceClosestToLocation(SplineComponent, TargetActor->GetActorLocation());
 	OutSplineLocation = SplineComponent->GetLocationAtDistanceAlongSpline(
 		static_cast<float>(OutDistance),
 		ESplineCoordinateSpace::World);
@@ -464,6 +471,30 @@ bool USplineFollowLibrary::CalculateInitialSplineRightOffset(
 	return true;
 }
 
+float USplineFollowLibrary::FindSplineInputKeyClosestToLocation(
+	USplineComponent* SplineComponent,
+	const FVector& WorldLocation,
+	double& OutDistance,
+	float LastInputKey)
+{
+	OutDistance = 0.0;
+
+	if (!IsValid(SplineComponent))
+	{
+		XTOOLS_LOG_WARNING(LogBlueprintExtensionsRuntime, TEXT("查找样条最近输入键失败：样条组件为空或无效"));
+		return 0.0f;
+	}
+
+	const float ClosestInputKey = XToolsSplineClosestPoint::FindInputKeyClosestToWorldLocation(*SplineComponent, WorldLocation, LastInputKey);
+	OutDistance = static_cast<double>(SplineComponent->GetDistanceAlongSplineAtSplineInputKey(ClosestInputKey));
+	return ClosestInputKey;
+}
+
+void USplineFollowLibrary::InvalidateSplineClosestPointCache(USplineComponent* SplineComponent)
+{
+	XToolsSplineClosestPoint::Invalidate(SplineComponent);
+}
+
 EXToolsSplineFollowStatus USplineFollowLibrary::CalculateSplineFollowTarget(
 	AActor* TargetActor,
 	USplineComponent* SplineComponent,
@@ -500,7 +531,7 @@ EXToolsSplineFollowStatus USplineFollowLibrary::CalculateSplineFollowTarget(
 	}
 
 	const FVector ActorLocation = TargetActor->GetActorLocation();
-	const double CurrentDistance = FindSplineDistanceClosestToLocation(SplineComponent, ActorLocation);
+	const double CurrentDistance = FindSplineDistanceClosestToLocation(SplineComponent, ActorLocation, &State);
 	const FVector CurrentSplineLocation = SplineComponent->GetLocationAtDistanceAlongSpline(
 		static_cast<float>(CurrentDistance),
 		ESplineCoordinateSpace::World);
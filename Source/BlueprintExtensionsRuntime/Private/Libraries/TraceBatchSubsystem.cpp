@@ -0,0 +1,210 @@
+#include "Libraries/TraceBatchSubsystem.h"
+
+#include "CollisionQueryParams.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/HitResult.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "TimerManager.h"
+#include "WorldCollision.h"
+#include "XToolsVersionCompat.h"
+
+UTraceBatchSubsystem* UTraceBatchSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UTraceBatchSubsystem>() : nullptr;
+}
+
+void UTraceBatchSubsystem::Deinitialize()
+{
+	// 仍在进行的追踪返回时找不到批次，直接被忽略
+	Batches.Empty();
+	FreeSlots.Empty();
+
+	Super::Deinitialize();
+}
+
+FXToolsTraceBatchHandle UTraceBatchSubsystem::SubmitTraceBatch(
+	const TArray<FXToolsTraceRequest>& Requests,
+	const TArray<AActor*>& ActorsToIgnore)
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return FXToolsTraceBatchHandle();
+	}
+
+	int32 SlotIndex = INDEX_NONE;
+	if (FreeSlots.Num() > 0)
+	{
+#if XTOOLS_ENGINE_5_8_OR_LATER
+		SlotIndex = FreeSlots.Pop(EAllowShrinking::No);
+#else
+		SlotIndex = FreeSlots.Pop(false);
+#endif
+	}
+	else
+	{
+		SlotIndex = Batches.AddDefaulted();
+	}
+
+	FTraceBatch& Batch = Batches[SlotIndex];
+	Batch.bInUse = true;
+	Batch.NumPending = 0;
+	Batch.Results.Reset();
+	Batch.Results.SetNum(Requests.Num());
+
+	FXToolsTraceBatchHandle Handle;
+	Handle.Index = SlotIndex;
+	Handle.Serial = Batch.Serial;
+
+	// 整批共用两份查询参数，忽略列表只拷贝一次
+	FCollisionQueryParams SimpleParams(SCENE_QUERY_STAT(XToolsTraceBatch), false);
+	SimpleParams.AddIgnoredActors(ActorsToIgnore);
+	FCollisionQueryParams ComplexParams = SimpleParams;
+	ComplexParams.bTraceComplex = true;
+
+	const FTraceDelegate TraceDelegate = FTraceDelegate::CreateUObject(
+		this, &UTraceBatchSubsystem::HandleTraceDone, Handle.Index, Handle.Serial);
+
+	for (int32 RequestIndex = 0; RequestIndex < Requests.Num(); ++RequestIndex)
+	{
+		const FXToolsTraceRequest& Request = Requests[RequestIndex];
+		if (!Request.QueryType.IsValid())
+		{
+			continue;
+		}
+
+		const FCollisionQueryParams& Params = Request.bTraceComplex ? ComplexParams : SimpleParams;
+		const uint32 UserData = static_cast<uint32>(RequestIndex);
+		++Batch.NumPending;
+
+		if (Request.QueryType.ObjectTypesMask != 0)
+		{
+			const FCollisionObjectQueryParams ObjectParams(Request.QueryType.ObjectTypesMask);
+			if (Request.Radius > 0.0f)
+			{
+				World->AsyncSweepByObjectType(EAsyncTraceType::Single, Request.Start, Request.End, FQuat::Identity,
+					ObjectParams, FCollisionShape::MakeSphere(Request.Radius), Params, &TraceDelegate, UserData);
+			}
+			else
+			{
+				World->AsyncLineTraceByObjectType(EAsyncTraceType::Single, Request.Start, Request.End,
+					ObjectParams, Params, &TraceDelegate, UserData);
+			}
+		}
+		else if (Request.Radius > 0.0f)
+		{
+			World->AsyncSweepByChannel(EAsyncTraceType::Single, Request.Start, Request.End, FQuat::Identity,
+				Request.QueryType.TraceChannel, FCollisionShape::MakeSphere(Request.Radius), Params,
+				FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, UserData);
+		}
+		else
+		{
+			World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Request.Start, Request.End,
+				Request.QueryType.TraceChannel, Params, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, UserData);
+		}
+	}
+
+	// 没有需要执行的追踪时同样在下一帧广播完成，与正常批次的时序一致
+	if (Batch.NumPending == 0)
+	{
+		World->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(
+			this, &UTraceBatchSubsystem::BroadcastBatchCompleted, Handle));
+	}
+
+	return Handle;
+}
+
+bool UTraceBatchSubsystem::IsTraceBatchComplete(FXToolsTraceBatchHandle Handle) const
+{
+	const FTraceBatch* Batch = FindBatch(Handle);
+	return Batch && Batch->NumPending == 0;
+}
+
+bool UTraceBatchSubsystem::TakeTraceBatchResults(FXToolsTraceBatchHandle Handle, TArray<FXToolsTraceResult>& OutResults)
+{
+	FTraceBatch* Batch = FindBatch(Handle);
+	if (!Batch || Batch->NumPending > 0)
+	{
+		OutResults.Reset();
+		return false;
+	}
+
+	OutResults = MoveTemp(Batch->Results);
+	ReleaseTraceBatch(Handle);
+	return true;
+}
+
+bool UTraceBatchSubsystem::ReleaseTraceBatch(FXToolsTraceBatchHandle Handle)
+{
+	FTraceBatch* Batch = FindBatch(Handle);
+	if (!Batch)
+	{
+		return false;
+	}
+
+	Batch->bInUse = false;
+	Batch->NumPending = 0;
+	Batch->Results.Reset();
+	++Batch->Serial;
+	FreeSlots.Add(Handle.Index);
+	return true;
+}
+
+UTraceBatchSubsystem::FTraceBatch* UTraceBatchSubsystem::FindBatch(FXToolsTraceBatchHandle Handle)
+{
+	if (!Batches.IsValidIndex(Handle.Index))
+	{
+		return nullptr;
+	}
+
+	FTraceBatch& Batch = Batches[Handle.Index];
+	return Batch.bInUse && Batch.Serial == Handle.Serial ? &Batch : nullptr;
+}
+
+const UTraceBatchSubsystem::FTraceBatch* UTraceBatchSubsystem::FindBatch(FXToolsTraceBatchHandle Handle) const
+{
+	return const_cast<UTraceBatchSubsystem*>(this)->FindBatch(Handle);
+}
+
+void UTraceBatchSubsystem::HandleTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceData, int32 SlotIndex, int32 Serial)
+{
+	FXToolsTraceBatchHandle Handle;
+	Handle.Index = SlotIndex;
+	Handle.Serial = Serial;
+
+	FTraceBatch* Batch = FindBatch(Handle);
+	const int32 RequestIndex = static_cast<int32>(TraceData.UserData);
+	if (!Batch || !Batch->Results.IsValidIndex(RequestIndex) || Batch->NumPending <= 0)
+	{
+		return;
+	}
+
+	// 单次追踪最多返回一个阻挡命中
+	FXToolsTraceResult& Result = Batch->Results[RequestIndex];
+	if (TraceData.OutHits.Num() > 0 && TraceData.OutHits[0].bBlockingHit)
+	{
+		const FHitResult& Hit = TraceData.OutHits[0];
+		Result.bHit = true;
+		Result.ImpactPoint = Hit.ImpactPoint;
+		Result.ImpactNormal = Hit.ImpactNormal;
+		Result.Distance = Hit.Distance;
+		Result.HitActor = Hit.GetActor();
+		Result.HitComponent = Hit.GetComponent();
+	}
+
+	if (--Batch->NumPending == 0)
+	{
+		BroadcastBatchCompleted(Handle);
+	}
+}
+
+void UTraceBatchSubsystem::BroadcastBatchCompleted(FXToolsTraceBatchHandle Handle)
+{
+	if (FindBatch(Handle))
+	{
+		OnTraceBatchCompleted.Broadcast(Handle);
+	}
+}
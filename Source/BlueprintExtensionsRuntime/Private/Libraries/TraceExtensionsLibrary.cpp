@@ -1,5 +1,6 @@
 ﻿#include "Libraries/TraceExtensionsLibrary.h"
 #include "XToolsBlueprintHelpers.h"
+#include "Libraries/TraceTypeTable.h"
 
 #include "Engine/World.h"
 #include "Engine/HitResult.h"       // FHitResult完整定义（UE 5.4+ IWYU必需）
@@ -8,9 +9,40 @@
 #include "UObject/UnrealType.h"
 #include "Misc/ConfigCacheIni.h"
 
-// Initialize static maps
-TMap<FString, ETraceTypeQuery> UTraceExtensionsLibrary::CachedTraceChannels;
-TMap<FString, EObjectTypeQuery> UTraceExtensionsLibrary::CachedObjectTypes;
+namespace
+{
+    /** 按预解析的查询类型执行单次追踪；形状为零时引擎按射线处理 */
+    bool TraceSingleByQueryType(
+        UWorld* World,
+        FHitResult& OutHit,
+        const FVector& Start,
+        const FVector& End,
+        const FXToolsTraceQueryType& QueryType,
+        const FCollisionShape& CollisionShape,
+        const FCollisionQueryParams& Params
+    )
+    {
+        if (QueryType.ObjectTypesMask != 0)
+        {
+            return World->SweepSingleByObjectType(OutHit, Start, End, FQuat::Identity, FCollisionObjectQueryParams(QueryType.ObjectTypesMask), CollisionShape, Params);
+        }
+        return World->SweepSingleByChannel(OutHit, Start, End, FQuat::Identity, QueryType.TraceChannel, CollisionShape, Params);
+    }
+
+    /** 按名称解析对象类型，名称节点与创建请求节点共用 */
+    FXToolsTraceQueryType ResolveObjectTypeStrings(const TArray<FString>& TraceObjectType)
+    {
+        TArray<FName> ObjectTypeNames;
+        ObjectTypeNames.Reserve(TraceObjectType.Num());
+        for (const FString& TraceChannel : TraceObjectType)
+        {
+            ObjectTypeNames.Add(FName(*TraceChannel));
+        }
+
+        bool bResolved = false;
+        return UTraceExtensionsLibrary::ResolveTraceObjectTypes(ObjectTypeNames, bResolved);
+    }
+}
 
 //————————————————————————————————————————————————————————————————————————————————————————————————————
 
@@ -28,13 +60,7 @@ TMap<FString, EObjectTypeQuery> UTraceExtensionsLibrary::CachedObjectTypes;
 
     void UTraceExtensionsLibrary::TraceChannelType(FName InputName, FString& OutString)
     {
-        const TMap<FName, FString> TraceTypeQueryMap = XToolsBlueprintHelpers::BuildEnumNameMap(StaticEnum<ETraceTypeQuery>());
-
-        if (TraceTypeQueryMap.Contains(InputName))
-        {
-            OutString = TraceTypeQueryMap[InputName];
-        }
-        else
+        if (!XToolsTraceTypes::FindTraceChannelEnumName(InputName, OutString))
         {
             OutString = FString("TraceTypeQuery1");
         }
@@ -42,13 +68,7 @@ TMap<FString, EObjectTypeQuery> UTraceExtensionsLibrary::CachedObjectTypes;
 
     void UTraceExtensionsLibrary::TraceObjectType(FName InputName, FString& OutString)
     {
-        const TMap<FName, FString> ObjectTypeQueryMap = XToolsBlueprintHelpers::BuildEnumNameMap(StaticEnum<EObjectTypeQuery>());
-
-        if (ObjectTypeQueryMap.Contains(InputName))
-        {
-            OutString = ObjectTypeQueryMap[InputName];
-        }
-        else
+        if (!XToolsTraceTypes::FindObjectTypeEnumName(InputName, OutString))
         {
             OutString = FString("ObjectTypeQuery1");
         }
@@ -76,53 +96,9 @@ TMap<FString, EObjectTypeQuery> UTraceExtensionsLibrary::CachedObjectTypes;
         float DrawTime
     )
     {
-		Block = false;
-		ImpactPoint = FVector::ZeroVector;
-		OutHit = FHitResult();
-
-        UWorld* World = XToolsBlueprintHelpers::GetValidWorld(WorldContextObject);
-        if (!World) return;
-
-        // 设置碰撞查询参数
-        FCollisionQueryParams Params(SCENE_QUERY_STAT(LineTraceSingle), bTraceComplex);
-        Params.bReturnPhysicalMaterial = true;
-        Params.AddIgnoredActors(ActorsToIgnore);
-
-        // Use Cache for TraceChannelType -> Enum
-        ETraceTypeQuery TraceChannelEnum;
-        const ECollisionChannel CollisionChannel = XToolsBlueprintHelpers::TryGetCachedEnum(
-            CachedTraceChannels, TraceChannelType, StaticEnum<ETraceTypeQuery>(), TraceChannelEnum)
-            ? UEngineTypes::ConvertToCollisionChannel(TraceChannelEnum)
-            : ECC_MAX;
-        if (CollisionChannel >= ECC_MAX)
-        {
-            Block = false;
-            ImpactPoint = FVector::ZeroVector;
-            OutHit = FHitResult();
-            return;
-        }
-
-        // 执行射线检测
-        bool bHit = World->LineTraceSingleByChannel(OutHit, Start, End, CollisionChannel, Params);
-
-        // 设置输出参数
-        Block = bHit;
-        ImpactPoint = bHit ? OutHit.ImpactPoint : FVector::ZeroVector;
-
-        // 绘制调试线
-        if (DrawDebugType != EDebugTraceType::None)
-        {
-            if (bHit)
-            {
-                DrawDebugLine(World, Start, OutHit.ImpactPoint, TraceColor.ToFColor(true), false, DrawTime, 0, 0.0f);
-                DrawDebugLine(World, OutHit.ImpactPoint, End, TraceHitColor.ToFColor(true), false, DrawTime, 0, 0.0f);
-                DrawDebugPoint(World, OutHit.ImpactPoint, 10.0f, TraceHitColor.ToFColor(true), false, DrawTime);
-            }
-            else
-            {
-                DrawDebugLine(World, Start, End, TraceColor.ToFColor(true), false, DrawTime, 0, 0.0f);
-            }
-        }
+        bool bResolved = false;
+        TraceLineByQueryType(WorldContextObject, Start, End, ResolveTraceChannel(FName(*TraceChannelType), bResolved),
+            bTraceComplex, ActorsToIgnore, DrawDebugType, Block, ImpactPoint, OutHit, TraceColor, TraceHitColor, DrawTime);
     }
 
     void UTraceExtensionsLibrary::TraceLineChannelOnAxisZ(
@@ -214,63 +190,8 @@ TMap<FString, EObjectTypeQuery> UTraceExtensionsLibrary::CachedObjectTypes;
         float DrawTime
     )
     {
-		Block = false;
-		ImpactPoint = FVector::ZeroVector;
-		OutHit = FHitResult();
-
-        UWorld* World = XToolsBlueprintHelpers::GetValidWorld(WorldContextObject);
-        if (!World) return;
-
-        // 设置碰撞查询参数
-        FCollisionQueryParams Params(SCENE_QUERY_STAT(LineTraceSingle), bTraceComplex);
-        Params.AddIgnoredActors(ActorsToIgnore);
-
-        // 设置碰撞对象查询参数
-        FCollisionObjectQueryParams ObjectParams;
-        for (const FString& TraceChannel : TraceObjectType)
-        {
-            EObjectTypeQuery ObjectTypeEnum;
-            if (!XToolsBlueprintHelpers::TryGetCachedEnum(
-                CachedObjectTypes, TraceChannel, StaticEnum<EObjectTypeQuery>(), ObjectTypeEnum))
-            {
-                Block = false;
-                ImpactPoint = FVector::ZeroVector;
-                OutHit = FHitResult();
-                return;
-            }
-
-            const ECollisionChannel CollisionChannel = UEngineTypes::ConvertToCollisionChannel(ObjectTypeEnum);
-            if (CollisionChannel >= ECC_MAX)
-            {
-                Block = false;
-                ImpactPoint = FVector::ZeroVector;
-                OutHit = FHitResult();
-                return;
-            }
-            ObjectParams.AddObjectTypesToQuery(CollisionChannel);
-        }
-
-        // 执行射线检测
-        bool bHit = World->LineTraceSingleByObjectType(OutHit, Start, End, ObjectParams, Params);
-
-        // 设置输出参数
-        Block = bHit;
-        ImpactPoint = bHit ? OutHit.ImpactPoint : FVector::ZeroVector;
-
-        // 绘制调试线
-        if (DrawDebugType != EDebugTraceType::None)
-        {
-            if (bHit)
-            {
-                DrawDebugLine(World, Start, OutHit.ImpactPoint, TraceColor.ToFColor(true), false, DrawTime, 0, 0.0f);
-                DrawDebugLine(World, OutHit.ImpactPoint, End, TraceHitColor.ToFColor(true), false, DrawTime, 0, 0.0f);
-                DrawDebugPoint(World, OutHit.ImpactPoint, 10.0f, TraceHitColor.ToFColor(true), false, DrawTime);
-            }
-            else
-            {
-                DrawDebugLine(World, Start, End, TraceColor.ToFColor(true), false, DrawTime, 0, 0.0f);
-            }
-        }
+        TraceLineByQueryType(WorldContextObject, Start, End, ResolveObjectTypeStrings(TraceObjectType),
+            bTraceComplex, ActorsToIgnore, DrawDebugType, Block, ImpactPoint, OutHit, TraceColor, TraceHitColor, DrawTime);
     }
 
 #pragma endregion 
@@ -296,65 +217,9 @@ void UTraceExtensionsLibrary::TraceSphereChannel(
     float DrawTime
 )
 {
-	Block = false;
-	ImpactPoint = FVector::ZeroVector;
-	OutHit = FHitResult();
-
-    if (!WorldContextObject) return;
-
-    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
-    if (!World) return;
-
-    // 设置碰撞查询参数
-    FCollisionQueryParams Params(SCENE_QUERY_STAT(SphereTraceSingle), bTraceComplex);
-    Params.bReturnPhysicalMaterial = true;
-    Params.AddIgnoredActors(ActorsToIgnore);
-
-    // Use Cache for TraceChannelType -> Enum
-    ETraceTypeQuery TraceChannelEnum;
-    if (!XToolsBlueprintHelpers::TryGetCachedEnum(
-        CachedTraceChannels, TraceChannelType, StaticEnum<ETraceTypeQuery>(), TraceChannelEnum))
-    {
-        Block = false;
-        ImpactPoint = FVector::ZeroVector;
-        OutHit = FHitResult();
-        return;
-    }
-
-    const ECollisionChannel CollisionChannel = UEngineTypes::ConvertToCollisionChannel(TraceChannelEnum);
-    if (CollisionChannel >= ECC_MAX)
-    {
-        Block = false;
-        ImpactPoint = FVector::ZeroVector;
-        OutHit = FHitResult();
-        return;
-    }
-
-    // 执行球体检测
-    bool bHit = World->SweepSingleByChannel(OutHit, Start, End, FQuat::Identity, CollisionChannel, FCollisionShape::MakeSphere(Radius), Params);
-
-    // 设置输出参数
-    Block = bHit;
-    ImpactPoint = bHit ? OutHit.ImpactPoint : FVector::ZeroVector;
-
-    // 绘制调试线
-    if (DrawDebugType != EDebugTraceType::None)
-    {
-        if (bHit)
-        {
-            DrawDebugSphere(World, Start, Radius, 12, TraceColor.ToFColor(true), DrawDebugType == EDebugTraceType::Persistent, DrawTime);
-            DrawDebugSphere(World, OutHit.ImpactPoint, Radius, 12, TraceHitColor.ToFColor(true), DrawDebugType == EDebugTraceType::Persistent, DrawTime);
-            DrawDebugLine(World, Start, OutHit.ImpactPoint, TraceColor.ToFColor(true), DrawDebugType == EDebugTraceType::Persistent, DrawTime, 0, 0.0f);
-            DrawDebugLine(World, OutHit.ImpactPoint, End, TraceHitColor.ToFColor(true), DrawDebugType == EDebugTraceType::Persistent, DrawTime, 0, 0.0f);
-            DrawDebugPoint(World, OutHit.ImpactPoint, 10.0f, TraceHitColor.ToFColor(true), DrawDebugType == EDebugTraceType::Persistent, DrawTime);
-        }
-        else
-        {
-            DrawDebugSphere(World, Start, Radius, 12, TraceColor.ToFColor(true), DrawDebugType == EDebugTraceType::Persistent, DrawTime);
-            DrawDebugSphere(World, End, Radius, 12, TraceColor.ToFColor(true), DrawDebugType == EDebugTraceType::Persistent, DrawTime);
-            DrawDebugLine(World, Start, End, TraceColor.ToFColor(true), DrawDebugType == EDebugTraceType::Persistent, DrawTime, 0, 0.0f);
-        }
-    }
+    bool bResolved = false;
+    TraceSphereByQueryType(WorldContextObject, Start, End, Radius, ResolveTraceChannel(FName(*TraceChannelType), bResolved),
+        bTraceComplex, ActorsToIgnore, DrawDebugType, Block, ImpactPoint, OutHit, TraceColor, TraceHitColor, DrawTime);
 }
 
 void UTraceExtensionsLibrary::TraceSphereObject(
@@ -374,69 +239,210 @@ void UTraceExtensionsLibrary::TraceSphereObject(
     float DrawTime
 )
 {
-	Block = false;
-	ImpactPoint = FVector::ZeroVector;
-	OutHit = FHitResult();
+    TraceSphereByQueryType(WorldContextObject, Start, End, Radius, ResolveObjectTypeStrings(TraceObjectType),
+        bTraceComplex, ActorsToIgnore, DrawDebugType, Block, ImpactPoint, OutHit, TraceColor, TraceHitColor, DrawTime);
+}
 
-    if (!WorldContextObject) return;
+#pragma endregion
+
+//————————————————————————————————————————————————————————————————————————————————————————————————————
 
-    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
-    if (!World) return;
 
-    // 设置碰撞查询参数
-    FCollisionQueryParams Params(SCENE_QUERY_STAT(SphereTraceSingle), bTraceComplex);
-    Params.AddIgnoredActors(ActorsToIgnore);
+#pragma region ResolvedTrace
 
-    // 设置碰撞对象查询参数
-    FCollisionObjectQueryParams ObjectParams;
-    for (const FString& TraceChannel : TraceObjectType)
+    FXToolsTraceQueryType UTraceExtensionsLibrary::ResolveTraceChannel(FName ChannelName, bool& bSuccess)
     {
-        EObjectTypeQuery ObjectTypeEnum;
-        if (!XToolsBlueprintHelpers::TryGetCachedEnum(
-            CachedObjectTypes, TraceChannel, StaticEnum<EObjectTypeQuery>(), ObjectTypeEnum))
+        FXToolsTraceQueryType QueryType;
+        ETraceTypeQuery TraceChannelEnum;
+        if (XToolsTraceTypes::FindTraceChannel(ChannelName, TraceChannelEnum))
         {
-            Block = false;
-            ImpactPoint = FVector::ZeroVector;
-            OutHit = FHitResult();
-            return;
+            QueryType.TraceChannel = UEngineTypes::ConvertToCollisionChannel(TraceChannelEnum);
         }
 
-        const ECollisionChannel CollisionChannel = UEngineTypes::ConvertToCollisionChannel(ObjectTypeEnum);
-        if (CollisionChannel >= ECC_MAX)
+        bSuccess = QueryType.IsValid();
+        return QueryType;
+    }
+
+    FXToolsTraceQueryType UTraceExtensionsLibrary::ResolveTraceObjectTypes(const TArray<FName>& ObjectTypeNames, bool& bSuccess)
+    {
+        FXToolsTraceQueryType QueryType;
+        bSuccess = false;
+
+        // 与对象追踪节点一致：任一对象类型无效则整体无效
+        int32 ObjectTypesMask = 0;
+        for (const FName ObjectTypeName : ObjectTypeNames)
         {
-            Block = false;
-            ImpactPoint = FVector::ZeroVector;
-            OutHit = FHitResult();
-            return;
+            EObjectTypeQuery ObjectTypeEnum;
+            if (!XToolsTraceTypes::FindObjectType(ObjectTypeName, ObjectTypeEnum))
+            {
+                return QueryType;
+            }
+
+            const ECollisionChannel CollisionChannel = UEngineTypes::ConvertToCollisionChannel(ObjectTypeEnum);
+            if (CollisionChannel >= ECC_MAX)
+            {
+                return QueryType;
+            }
+            ObjectTypesMask |= ECC_TO_BITFIELD(CollisionChannel);
         }
-        ObjectParams.AddObjectTypesToQuery(CollisionChannel);
+
+        QueryType.ObjectTypesMask = ObjectTypesMask;
+        bSuccess = QueryType.IsValid();
+        return QueryType;
     }
 
-    // 执行球体检测
-    bool bHit = World->SweepSingleByObjectType(OutHit, Start, End, FQuat::Identity, ObjectParams, FCollisionShape::MakeSphere(Radius), Params);
+    void UTraceExtensionsLibrary::TraceLineByQueryType(
+        UObject* WorldContextObject,
+        FVector Start,
+        FVector End,
+        const FXToolsTraceQueryType& QueryType,
+        bool bTraceComplex,
+        const TArray<AActor*>& ActorsToIgnore,
+        EDebugTraceType DrawDebugType,
+        bool& Block,
+        FVector& ImpactPoint,
+        FHitResult& OutHit,
+        FLinearColor TraceColor,
+        FLinearColor TraceHitColor,
+        float DrawTime
+    )
+    {
+        Block = false;
+        ImpactPoint = FVector::ZeroVector;
+        OutHit = FHitResult();
 
-    // 设置输出参数
-    Block = bHit;
-    ImpactPoint = bHit ? OutHit.ImpactPoint : FVector::ZeroVector;
+        UWorld* World = XToolsBlueprintHelpers::GetValidWorld(WorldContextObject);
+        if (!World || !QueryType.IsValid()) return;
 
-    // 绘制调试线
-    if (DrawDebugType != EDebugTraceType::None)
-    {
-        if (bHit)
+        // 设置碰撞查询参数
+        FCollisionQueryParams Params(SCENE_QUERY_STAT(LineTraceSingle), bTraceComplex);
+        Params.bReturnPhysicalMaterial = true;
+        Params.AddIgnoredActors(ActorsToIgnore);
+
+        // 执行射线检测
+        const bool bHit = TraceSingleByQueryType(World, OutHit, Start, End, QueryType, FCollisionShape(), Params);
+
+        // 设置输出参数
+        Block = bHit;
+        ImpactPoint = bHit ? OutHit.ImpactPoint : FVector::ZeroVector;
+
+        // 绘制调试线
+        if (DrawDebugType != EDebugTraceType::None)
         {
-            DrawDebugSphere(World, Start, Radius, 12, TraceColor.ToFColor(true), DrawDebugType == EDebugTraceType::Persistent, DrawTime);
-            DrawDebugSphere(World, OutHit.ImpactPoint, Radius, 12, TraceHitColor.ToFColor(true), DrawDebugType == EDebugTraceType::Persistent, DrawTime);
-            DrawDebugLine(World, Start, OutHit.ImpactPoint, TraceColor.ToFColor(true), DrawDebugType == EDebugTraceType::Persistent, DrawTime, 0, 0.0f);
-            DrawDebugLine(World, OutHit.ImpactPoint, End, TraceHitColor.ToFColor(true), DrawDebugType == EDebugTraceType::Persistent, DrawTime, 0, 0.0f);
-            DrawDebugPoint(World, OutHit.ImpactPoint, 10.0f, TraceHitColor.ToFColor(true), DrawDebugType == EDebugTraceType::Persistent, DrawTime);
+            if (bHit)
+            {
+                DrawDebugLine(World, Start, OutHit.ImpactPoint, TraceColor.ToFColor(true), false, DrawTime, 0, 0.0f);
+                DrawDebugLine(World, OutHit.ImpactPoint, End, TraceHitColor.ToFColor(true), false, DrawTime, 0, 0.0f);
+                DrawDebugPoint(World, OutHit.ImpactPoint, 10.0f, TraceHitColor.ToFColor(true), false, DrawTime);
+            }
+            else
+            {
+                DrawDebugLine(World, Start, End, TraceColor.ToFColor(true), false, DrawTime, 0, 0.0f);
+            }
         }
-        else
+    }
+
+    void UTraceExtensionsLibrary::TraceSphereByQueryType(
+        UObject* WorldContextObject,
+        FVector Start,
+        FVector End,
+        float Radius,
+        const FXToolsTraceQueryType& QueryType,
+        bool bTraceComplex,
+        const TArray<AActor*>& ActorsToIgnore,
+        EDebugTraceType DrawDebugType,
+        bool& Block,
+        FVector& ImpactPoint,
+        FHitResult& OutHit,
+        FLinearColor TraceColor,
+        FLinearColor TraceHitColor,
+        float DrawTime
+    )
+    {
+        Block = false;
+        ImpactPoint = FVector::ZeroVector;
+        OutHit = FHitResult();
+
+        UWorld* World = XToolsBlueprintHelpers::GetValidWorld(WorldContextObject);
+        if (!World || !QueryType.IsValid()) return;
+
+        // 设置碰撞查询参数
+        FCollisionQueryParams Params(SCENE_QUERY_STAT(SphereTraceSingle), bTraceComplex);
+        Params.bReturnPhysicalMaterial = true;
+        Params.AddIgnoredActors(ActorsToIgnore);
+
+        // 执行球体检测
+        const bool bHit = TraceSingleByQueryType(World, OutHit, Start, End, QueryType, FCollisionShape::MakeSphere(Radius), Params);
+
+        // 设置输出参数
+        Block = bHit;
+        ImpactPoint = bHit ? OutHit.ImpactPoint : FVector::ZeroVector;
+
+        // 绘制调试线
+        if (DrawDebugType != EDebugTraceType::None)
         {
-            DrawDebugSphere(World, Start, Radius, 12, TraceColor.ToFColor(true), DrawDebugType == EDebugTraceType::Persistent, DrawTime);
-            DrawDebugSphere(World, End, Radius, 12, TraceColor.ToFColor(true), DrawDebugType == EDebugTraceType::Persistent, DrawTime);
-            DrawDebugLine(World, Start, End, TraceColor.ToFColor(true), DrawDebugType == EDebugTraceType::Persistent, DrawTime, 0, 0.0f);
+            const bool bPersistent = DrawDebugType == EDebugTraceType::Persistent;
+            if (bHit)
+            {
+                DrawDebugSphere(World, Start, Radius, 12, TraceColor.ToFColor(true), bPersistent, DrawTime);
+                DrawDebugSphere(World, OutHit.ImpactPoint, Radius, 12, TraceHitColor.ToFColor(true), bPersistent, DrawTime);
+                DrawDebugLine(World, Start, OutHit.ImpactPoint, TraceColor.ToFColor(true), bPersistent, DrawTime, 0, 0.0f);
+                DrawDebugLine(World, OutHit.ImpactPoint, End, TraceHitColor.ToFColor(true), bPersistent, DrawTime, 0, 0.0f);
+                DrawDebugPoint(World, OutHit.ImpactPoint, 10.0f, TraceHitColor.ToFColor(true), bPersistent, DrawTime);
+            }
+            else
+            {
+                DrawDebugSphere(World, Start, Radius, 12, TraceColor.ToFColor(true), bPersistent, DrawTime);
+                DrawDebugSphere(World, End, Radius, 12, TraceColor.ToFColor(true), bPersistent, DrawTime);
+                DrawDebugLine(World, Start, End, TraceColor.ToFColor(true), bPersistent, DrawTime, 0, 0.0f);
+            }
         }
     }
+
+#pragma endregion
+
+//————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#pragma region BatchTrace
+
+FXToolsTraceRequest UTraceExtensionsLibrary::MakeTraceRequestChannel(
+    FVector Start,
+    FVector End,
+    FString TraceChannelType,
+    bool bTraceComplex,
+    float Radius
+)
+{
+    bool bResolved = false;
+    return MakeTraceRequest(Start, End, ResolveTraceChannel(FName(*TraceChannelType), bResolved), bTraceComplex, Radius);
+}
+
+FXToolsTraceRequest UTraceExtensionsLibrary::MakeTraceRequestObject(
+    FVector Start,
+    FVector End,
+    const TArray<FString>& TraceObjectType,
+    bool bTraceComplex,
+    float Radius
+)
+{
+    return MakeTraceRequest(Start, End, ResolveObjectTypeStrings(TraceObjectType), bTraceComplex, Radius);
+}
+
+FXToolsTraceRequest UTraceExtensionsLibrary::MakeTraceRequest(
+    FVector Start,
+    FVector End,
+    const FXToolsTraceQueryType& QueryType,
+    bool bTraceComplex,
+    float Radius
+)
+{
+    FXToolsTraceRequest Request;
+    Request.Start = Start;
+    Request.End = End;
+    Request.Radius = FMath::Max(Radius, 0.0f);
+    Request.bTraceComplex = bTraceComplex;
+    Request.QueryType = QueryType;
+    return Request;
 }
 
 #pragma endregion
@@ -0,0 +1,220 @@
+#include "Libraries/TraceTypeTable.h"
+
+#include "Engine/CollisionProfile.h"
+#include "Engine/Engine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace XToolsTraceTypes
+{
+	namespace
+	{
+		struct FEnumNameTable
+		{
+			/** 枚举名、显示名、通道名 -> 枚举值 */
+			TMap<FName, uint8> ValuesByName;
+
+			/** 枚举值 -> 枚举名 */
+			TArray<FString> EnumNames;
+
+			void Build(const UEnum* Enum, const UCollisionProfile* CollisionProfile)
+			{
+				ValuesByName.Reset();
+				EnumNames.Reset();
+				if (!Enum)
+				{
+					return;
+				}
+
+				const int64 MaxValue = Enum->GetMaxEnumValue();
+				EnumNames.SetNum(static_cast<int32>(MaxValue));
+
+				// 枚举名优先，显示名与通道名不覆盖已有条目
+				for (int32 EnumIndex = 0; EnumIndex < Enum->NumEnums(); ++EnumIndex)
+				{
+					const int64 Value = Enum->GetValueByIndex(EnumIndex);
+					if (Value >= 0 && Value < MaxValue)
+					{
+						EnumNames[static_cast<int32>(Value)] = Enum->GetNameStringByIndex(EnumIndex);
+						ValuesByName.Add(FName(*EnumNames[static_cast<int32>(Value)]), static_cast<uint8>(Value));
+					}
+				}
+
+				for (int32 EnumIndex = 0; EnumIndex < Enum->NumEnums(); ++EnumIndex)
+				{
+					const int64 Value = Enum->GetValueByIndex(EnumIndex);
+					if (Value >= 0 && Value < MaxValue)
+					{
+						const FName DisplayName(*Enum->GetDisplayNameTextByIndex(EnumIndex).ToString());
+						if (!ValuesByName.Contains(DisplayName))
+						{
+							ValuesByName.Add(DisplayName, static_cast<uint8>(Value));
+						}
+					}
+				}
+
+				if (CollisionProfile)
+				{
+					for (int32 Value = 0; Value < MaxValue; ++Value)
+					{
+						const ECollisionChannel Channel = Enum == StaticEnum<ETraceTypeQuery>()
+							? UEngineTypes::ConvertToCollisionChannel(static_cast<ETraceTypeQuery>(Value))
+							: UEngineTypes::ConvertToCollisionChannel(static_cast<EObjectTypeQuery>(Value));
+						if (Channel >= ECC_MAX)
+						{
+							continue;
+						}
+
+						const FName ChannelName = CollisionProfile->ReturnChannelNameFromContainerIndex(Channel);
+						if (!ChannelName.IsNone() && !ValuesByName.Contains(ChannelName))
+						{
+							ValuesByName.Add(ChannelName, static_cast<uint8>(Value));
+						}
+					}
+				}
+			}
+		};
+
+		FRWLock TableLock;
+		FEnumNameTable TraceChannelTable;
+		FEnumNameTable ObjectTypeTable;
+		bool bTablesBuilt = false;
+
+		FDelegateHandle PostEngineInitHandle;
+		FDelegateHandle LoadProfileConfigHandle;
+
+		void HandleLoadProfileConfig(UCollisionProfile* CollisionProfile)
+		{
+			Rebuild();
+		}
+
+		void HandlePostEngineInit()
+		{
+			Rebuild();
+
+			if (UCollisionProfile* CollisionProfile = UCollisionProfile::Get())
+			{
+				LoadProfileConfigHandle = CollisionProfile->OnLoadProfileConfig.AddStatic(&HandleLoadProfileConfig);
+			}
+		}
+
+		/** 模块晚于引擎初始化加载，或在此之前就有调用时，首次查询时构建 */
+		void EnsureBuilt()
+		{
+			{
+				FReadScopeLock ReadLock(TableLock);
+				if (bTablesBuilt)
+				{
+					return;
+				}
+			}
+			Rebuild();
+		}
+
+		bool FindValue(const FEnumNameTable& Table, FName Name, uint8& OutValue)
+		{
+			EnsureBuilt();
+
+			FReadScopeLock ReadLock(TableLock);
+			if (const uint8* Value = Table.ValuesByName.Find(Name))
+			{
+				OutValue = *Value;
+				return true;
+			}
+			return false;
+		}
+
+		bool FindEnumName(const FEnumNameTable& Table, FName Name, FString& OutEnumName)
+		{
+			EnsureBuilt();
+
+			FReadScopeLock ReadLock(TableLock);
+			const uint8* Value = Table.ValuesByName.Find(Name);
+			if (Value && Table.EnumNames.IsValidIndex(*Value))
+			{
+				OutEnumName = Table.EnumNames[*Value];
+				return true;
+			}
+			return false;
+		}
+	}
+
+	void Startup()
+	{
+		if (GEngine && GEngine->IsInitialized())
+		{
+			HandlePostEngineInit();
+		}
+		else
+		{
+			PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddStatic(&HandlePostEngineInit);
+		}
+	}
+
+	void Shutdown()
+	{
+		FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+		PostEngineInitHandle.Reset();
+
+		if (LoadProfileConfigHandle.IsValid() && UObjectInitialized())
+		{
+			if (UCollisionProfile* CollisionProfile = UCollisionProfile::Get())
+			{
+				CollisionProfile->OnLoadProfileConfig.Remove(LoadProfileConfigHandle);
+			}
+		}
+		LoadProfileConfigHandle.Reset();
+
+		FWriteScopeLock WriteLock(TableLock);
+		TraceChannelTable = FEnumNameTable();
+		ObjectTypeTable = FEnumNameTable();
+		bTablesBuilt = false;
+	}
+
+	void Rebuild()
+	{
+		// 在锁外读取枚举与碰撞配置，锁内只交换结果
+		const UCollisionProfile* CollisionProfile = UObjectInitialized() ? UCollisionProfile::Get() : nullptr;
+		FEnumNameTable NewTraceChannelTable;
+		FEnumNameTable NewObjectTypeTable;
+		NewTraceChannelTable.Build(StaticEnum<ETraceTypeQuery>(), CollisionProfile);
+		NewObjectTypeTable.Build(StaticEnum<EObjectTypeQuery>(), CollisionProfile);
+
+		FWriteScopeLock WriteLock(TableLock);
+		TraceChannelTable = MoveTemp(NewTraceChannelTable);
+		ObjectTypeTable = MoveTemp(NewObjectTypeTable);
+		bTablesBuilt = true;
+	}
+
+	bool FindTraceChannel(FName Name, ETraceTypeQuery& OutTraceType)
+	{
+		uint8 Value = 0;
+		if (!FindValue(TraceChannelTable, Name, Value))
+		{
+			return false;
+		}
+		OutTraceType = static_cast<ETraceTypeQuery>(Value);
+		return true;
+	}
+
+	bool FindObjectType(FName Name, EObjectTypeQuery& OutObjectType)
+	{
+		uint8 Value = 0;
+		if (!FindValue(ObjectTypeTable, Name, Value))
+		{
+			return false;
+		}
+		OutObjectType = static_cast<EObjectTypeQuery>(Value);
+		return true;
+	}
+
+	bool FindTraceChannelEnumName(FName Name, FString& OutEnumName)
+	{
+		return FindEnumName(TraceChannelTable, Name, OutEnumName);
+	}
+
+	bool FindObjectTypeEnumName(FName Name, FString& OutEnumName)
+	{
+		return FindEnumName(ObjectTypeTable, Name, OutEnumName);
+	}
+}
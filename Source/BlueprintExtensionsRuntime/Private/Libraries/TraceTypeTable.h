@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+/**
+ * 追踪通道与对象类型的名称表
+ * 模块生命周期内只有一份：引擎初始化完成后按碰撞配置构建，碰撞配置重新加载时刷新。
+ * 枚举名（TraceTypeQuery1）、显示名与碰撞配置中的通道名都能查到对应枚举；
+ * 查询只加读锁，可以在任意线程调用。
+ */
+namespace XToolsTraceTypes
+{
+	/** 模块启动时调用，注册引擎初始化与碰撞配置加载回调 */
+	void Startup();
+
+	/** 模块关闭时调用，注销回调并清空名称表 */
+	void Shutdown();
+
+	/** 按当前碰撞配置重建名称表 */
+	void Rebuild();
+
+	bool FindTraceChannel(FName Name, ETraceTypeQuery& OutTraceType);
+	bool FindObjectType(FName Name, EObjectTypeQuery& OutObjectType);
+
+	/** 名称 -> 枚举名字符串，供追踪通道类型/追踪对象类型节点使用 */
+	bool FindTraceChannelEnumName(FName Name, FString& OutEnumName);
+	bool FindObjectTypeEnumName(FName Name, FString& OutEnumName);
+}
@@ -0,0 +1,130 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+
+#include "Libraries/BulletHomingSubsystem.h"
+
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+namespace
+{
+	AActor* SpawnLocatedActor(UWorld* World, const FVector& Location)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+		USceneComponent* Root = NewObject<USceneComponent>(Actor);
+		Actor->SetRootComponent(Root);
+		Root->RegisterComponent();
+		Actor->SetActorLocation(Location);
+		return Actor;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBulletHomingSubsystem_MatchesPerProjectileUpdate,
+	"XTools.BlueprintExtensionsRuntime.BulletHoming.SubsystemMatchesPerProjectileUpdate",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FBulletHomingSubsystem_MatchesPerProjectileUpdate::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	UBulletHomingSubsystem* Subsystem = World ? World->GetSubsystem<UBulletHomingSubsystem>() : nullptr;
+	if (!TestNotNull(TEXT("应能创建追踪弹子系统"), Subsystem))
+	{
+		if (World)
+		{
+			World->DestroyWorld(false);
+		}
+		return false;
+	}
+
+	// 数量超过并行阈值，覆盖多线程制导计算；弹体不写回组件，两条路径读到的世界状态完全相同
+	constexpr int32 NumProjectiles = 300;
+	constexpr float DeltaTime = 1.0f / 60.0f;
+	FRandomStream Stream(11);
+	TArray<AActor*> Projectiles;
+	TArray<AActor*> Targets;
+	TArray<FXToolsBulletHomingOptions> Options;
+	TArray<FXToolsBulletHomingState> ReferenceStates;
+	TArray<FXToolsBulletHomingHandle> Handles;
+	for (int32 Index = 0; Index < NumProjectiles; ++Index)
+	{
+		Projectiles.Add(SpawnLocatedActor(World, Stream.GetUnitVector() * Stream.FRandRange(0.0f, 500.0f)));
+		Targets.Add(SpawnLocatedActor(World, Stream.GetUnitVector() * Stream.FRandRange(2000.0f, 4000.0f)));
+
+		FXToolsBulletHomingOptions& ProjectileOptions = Options.AddDefaulted_GetRef();
+		ProjectileOptions.GuidanceMode = static_cast<EXToolsBulletGuidanceMode>(Index % 3);
+		ProjectileOptions.bApplyVelocityToProjectileMovement = false;
+		ProjectileOptions.bUpdateActorRotation = false;
+		ReferenceStates.AddDefaulted();
+
+		Handles.Add(Subsystem->RegisterHomingProjectile(Projectiles[Index], nullptr, Targets[Index], nullptr, nullptr, ProjectileOptions));
+	}
+	TestEqual(TEXT("已注册数量"), Subsystem->GetNumHomingProjectiles(), NumProjectiles);
+
+	bool bAllMatch = true;
+	int32 NumCaptured = 0;
+	for (int32 Step = 0; Step < 120; ++Step)
+	{
+		for (int32 Index = 0; Index < NumProjectiles; ++Index)
+		{
+			Targets[Index]->AddActorWorldOffset(FVector(200.0f, 0.0f, 0.0f) * DeltaTime);
+		}
+
+		TArray<EXToolsBulletHomingStatus> ReferenceStatuses;
+		for (int32 Index = 0; Index < NumProjectiles; ++Index)
+		{
+			EXToolsBulletHomingStatus Status;
+			FVector WorldVelocity;
+			FRotator ActorRotation;
+			FRotator VisualRotation;
+			UBulletHomingLibrary::UpdateHomingProjectileMovement(
+				Projectiles[Index], nullptr, Targets[Index], nullptr, nullptr, DeltaTime, Options[Index],
+				ReferenceStates[Index], Status, WorldVelocity, ActorRotation, VisualRotation);
+			ReferenceStatuses.Add(Status);
+		}
+
+		Subsystem->UpdateHomingProjectiles(DeltaTime);
+
+		NumCaptured = 0;
+		for (int32 Index = 0; Index < NumProjectiles; ++Index)
+		{
+			FXToolsBulletHomingState BatchState;
+			bAllMatch &= Subsystem->GetHomingState(Handles[Index], BatchState);
+			bAllMatch &= Subsystem->GetHomingStatus(Handles[Index]) == ReferenceStatuses[Index];
+			bAllMatch &= BatchState.CurrentDirection.Equals(ReferenceStates[Index].CurrentDirection, 1.0e-5f);
+			bAllMatch &= FMath::IsNearlyEqual(BatchState.CurrentSpeed, ReferenceStates[Index].CurrentSpeed, 1.0e-3f);
+			bAllMatch &= BatchState.LatchedTerminalStatus == ReferenceStates[Index].LatchedTerminalStatus;
+			NumCaptured += ReferenceStatuses[Index] == EXToolsBulletHomingStatus::Captured ? 1 : 0;
+
+			Projectiles[Index]->AddActorWorldOffset(BatchState.CurrentDirection * BatchState.CurrentSpeed * DeltaTime);
+		}
+	}
+
+	TestTrue(TEXT("批量更新结果应与逐弹调用更新追踪弹运动一致"), bAllMatch);
+	TestTrue(TEXT("追踪弹应能捕获目标"), NumCaptured > 0);
+
+	TestTrue(TEXT("注销有效句柄"), Subsystem->UnregisterHomingProjectile(Handles[0]));
+	TestFalse(TEXT("注销后句柄失效"), Subsystem->IsHomingProjectileRegistered(Handles[0]));
+	TestEqual(TEXT("注销后句柄状态为无效"), Subsystem->GetHomingStatus(Handles[0]), EXToolsBulletHomingStatus::Invalid);
+	TestTrue(TEXT("其余句柄不受交换删除影响"), Subsystem->IsHomingProjectileRegistered(Handles[NumProjectiles - 1]));
+
+	const FXToolsBulletHomingHandle ReusedHandle = Subsystem->RegisterHomingProjectile(Projectiles[0], nullptr, Targets[0], nullptr, nullptr, Options[0]);
+	TestEqual(TEXT("空闲槽位被复用"), ReusedHandle.Index, Handles[0].Index);
+	TestFalse(TEXT("复用槽位后旧句柄仍然失效"), Subsystem->IsHomingProjectileRegistered(Handles[0]));
+
+	Projectiles[1]->Destroy();
+	Subsystem->UpdateHomingProjectiles(DeltaTime);
+	TestFalse(TEXT("弹体销毁后自动注销"), Subsystem->IsHomingProjectileRegistered(Handles[1]));
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
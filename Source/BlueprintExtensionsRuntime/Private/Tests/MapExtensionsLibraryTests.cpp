@@ -0,0 +1,409 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+
+#include "Libraries/MapExtensionsLibrary.h"
+
+#include "Misc/AutomationTest.h"
+#include "UObject/UnrealType.h"
+
+namespace MapExtensionsLibraryTests
+{
+	FIntProperty* NewIntProperty(FFieldVariant Owner, const TCHAR* Name)
+	{
+		FIntProperty* IntProperty = new FIntProperty(Owner, Name, RF_NoFlags);
+		IntProperty->SetPropertyFlags(CPF_HasGetValueTypeHash);
+		return IntProperty;
+	}
+
+	FArrayProperty* NewIntArrayProperty(FFieldVariant Owner, const TCHAR* Name)
+	{
+		FArrayProperty* ArrayProperty = new FArrayProperty(Owner, Name, RF_NoFlags);
+		ArrayProperty->Inner = NewIntProperty(ArrayProperty, TEXT("Inner"));
+		return ArrayProperty;
+	}
+
+	/**
+	 * 描述TMap<int32, int32>的临时反射属性，供直接调用GenericMap_*使用
+	 * bArrayValues为true时描述TMap<int32, TArray<int32>>，值类型不可哈希
+	 */
+	struct FIntMapProperty
+	{
+		FMapProperty* MapProperty = nullptr;
+
+		explicit FIntMapProperty(bool bArrayValues = false)
+		{
+			MapProperty = new FMapProperty(FFieldVariant(), TEXT("TestMap"), RF_NoFlags);
+			MapProperty->KeyProp = NewIntProperty(MapProperty, TEXT("Key"));
+			MapProperty->ValueProp = bArrayValues
+				? static_cast<FProperty*>(NewIntArrayProperty(MapProperty, TEXT("Value")))
+				: NewIntProperty(MapProperty, TEXT("Value"));
+
+			FArchive LinkArchive;
+			MapProperty->Link(LinkArchive);
+		}
+
+		~FIntMapProperty()
+		{
+			delete MapProperty;
+		}
+	};
+
+	/** 描述TArray<int32>的临时反射属性，用于接收键数组 */
+	struct FIntArrayProperty
+	{
+		FArrayProperty* ArrayProperty = nullptr;
+
+		FIntArrayProperty()
+		{
+			ArrayProperty = NewIntArrayProperty(FFieldVariant(), TEXT("TestArray"));
+
+			FArchive LinkArchive;
+			ArrayProperty->Link(LinkArchive);
+		}
+
+		~FIntArrayProperty()
+		{
+			delete ArrayProperty;
+		}
+	};
+
+	/** 键0..Count-1依次加入，内部索引与键一致 */
+	void FillSequential(TMap<int32, int32>& Map, int32 Count)
+	{
+		Map.Reset();
+		for (int32 Key = 0; Key < Count; ++Key)
+		{
+			Map.Add(Key, Key * 10);
+		}
+	}
+
+	int32 GetKeyAt(const TMap<int32, int32>& Map, const FMapProperty* MapProperty, int32 Index)
+	{
+		int32 Key = INDEX_NONE;
+		UMapExtensionsLibrary::GenericMap_GetKey(&Map, MapProperty, Index, &Key);
+		return Key;
+	}
+
+	/** 按迭代顺序（即逻辑索引顺序）取第Index个键，作为期望值 */
+	int32 GetExpectedKeyAt(const TMap<int32, int32>& Map, int32 Index)
+	{
+		int32 LogicalIndex = 0;
+		for (const TPair<int32, int32>& Pair : Map)
+		{
+			if (LogicalIndex++ == Index)
+			{
+				return Pair.Key;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	TArray<int32> GetKeysFromValue(const TMap<int32, int32>& Map, const FMapProperty* MapProperty, const FArrayProperty* ArrayProperty, int32 Value)
+	{
+		TArray<int32> Keys;
+		UMapExtensionsLibrary::GenericMap_KeysFromValue(&Map, MapProperty, &Keys, ArrayProperty, MapProperty->ValueProp, &Value);
+		return Keys;
+	}
+
+	/** 按迭代顺序顺序遍历得到的期望结果 */
+	TArray<int32> GetExpectedKeysFromValue(const TMap<int32, int32>& Map, int32 Value)
+	{
+		TArray<int32> Keys;
+		for (const TPair<int32, int32>& Pair : Map)
+		{
+			if (Pair.Value == Value)
+			{
+				Keys.Add(Pair.Key);
+			}
+		}
+		return Keys;
+	}
+
+	bool ContainsValue(const TMap<int32, int32>& Map, const FMapProperty* MapProperty, int32 Value)
+	{
+		return UMapExtensionsLibrary::GenericMap_FindValue(&Map, MapProperty, MapProperty->ValueProp, &Value);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMapExtensionsLibrary_IndexTableFollowsHoleMoves,
+	"XTools.BlueprintExtensionsRuntime.Map.IndexTableFollowsHoleMoves",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMapExtensionsLibrary_IndexTableFollowsHoleMoves::RunTest(const FString& Parameters)
+{
+	using namespace MapExtensionsLibraryTests;
+
+	const FIntMapProperty Property;
+	TMap<int32, int32> Map;
+	FillSequential(Map, 6);
+	Map.Remove(2);
+
+	// 唯一空洞在内部索引2，按顺序遍历建立索引表
+	for (int32 Index = 0; Index < Map.Num(); ++Index)
+	{
+		TestEqual(FString::Printf(TEXT("遍历时逻辑索引%d对应的键"), Index), GetKeyAt(Map, Property.MapProperty, Index), GetExpectedKeyAt(Map, Index));
+	}
+
+	// 引擎节点先加后删：新元素填上空洞2，再删除内部索引4，长度与最大索引都不变
+	Map.Add(100, 1000);
+	Map.Remove(4);
+
+	TestEqual(TEXT("空洞移动后非相邻访问返回新元素"), GetKeyAt(Map, Property.MapProperty, 2), GetExpectedKeyAt(Map, 2));
+
+	int32 Value = 0;
+	UMapExtensionsLibrary::GenericMap_GetValue(&Map, Property.MapProperty, 2, &Value);
+	TestEqual(TEXT("空洞移动后获取值返回新元素的值"), Value, 1000);
+
+	// 循环中途结构变化：相邻访问检查到两个索引之间出现了新元素
+	Map.Remove(100);
+	GetKeyAt(Map, Property.MapProperty, 1);
+	Map.Add(200, 2000);
+	Map.Remove(5);
+	TestEqual(TEXT("循环中途空洞移动后相邻访问返回正确的键"), GetKeyAt(Map, Property.MapProperty, 2), GetExpectedKeyAt(Map, 2));
+
+	const int32 NewValue = 7;
+	UMapExtensionsLibrary::GenericMap_SetValueAt(&Map, Property.MapProperty, 2, &NewValue);
+	TestEqual(TEXT("按索引设置值写入正确的元素"), Map.FindRef(200), NewValue);
+	TestEqual(TEXT("按索引设置值不影响其他元素"), Map.FindRef(3), 30);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMapExtensionsLibrary_IndexTableRejectsReusedAddress,
+	"XTools.BlueprintExtensionsRuntime.Map.IndexTableRejectsReusedAddress",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMapExtensionsLibrary_IndexTableRejectsReusedAddress::RunTest(const FString& Parameters)
+{
+	using namespace MapExtensionsLibraryTests;
+
+	const FIntMapProperty Property;
+	TMap<int32, int32> Map;
+
+	// 第一次调用：空洞在内部索引2，遍历结束时上次访问的逻辑索引为4
+	FillSequential(Map, 6);
+	Map.Remove(2);
+	for (int32 Index = 0; Index < Map.Num(); ++Index)
+	{
+		GetKeyAt(Map, Property.MapProperty, Index);
+	}
+
+	// 第二次调用：同一地址、同一属性上重新创建的局部Map，长度与最大索引相同但空洞在内部索引4
+	FillSequential(Map, 6);
+	Map.Remove(4);
+
+	TestEqual(TEXT("重新创建后与上次相邻的访问返回正确的键"), GetKeyAt(Map, Property.MapProperty, 3), GetExpectedKeyAt(Map, 3));
+	TestEqual(TEXT("重新创建后继续倒序访问返回正确的键"), GetKeyAt(Map, Property.MapProperty, 2), GetExpectedKeyAt(Map, 2));
+
+	FillSequential(Map, 6);
+	Map.Remove(1);
+	TestEqual(TEXT("重新创建后从索引0开始的遍历返回正确的键"), GetKeyAt(Map, Property.MapProperty, 0), GetExpectedKeyAt(Map, 0));
+	TestEqual(TEXT("重新创建后遍历的下一个索引返回正确的键"), GetKeyAt(Map, Property.MapProperty, 1), GetExpectedKeyAt(Map, 1));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMapExtensionsLibrary_IndexedLoopChecksTableOnce,
+	"XTools.BlueprintExtensionsRuntime.Map.IndexedLoopChecksTableOnce",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMapExtensionsLibrary_IndexedLoopChecksTableOnce::RunTest(const FString& Parameters)
+{
+	using namespace MapExtensionsLibraryTests;
+
+	const FIntMapProperty Property;
+	TMap<int32, int32> Map;
+	FillSequential(Map, 200);
+	Map.Remove(7);
+	Map.Remove(120);
+
+	// 蓝图中常见的循环：每次迭代先取键再取值，索引相同
+	const int32 ChecksBeforeForward = XTools::MapExtensions::GetNumMapIndexTableFullChecks();
+	bool bForwardMatches = true;
+	for (int32 Index = 0; Index < Map.Num(); ++Index)
+	{
+		const int32 Key = GetKeyAt(Map, Property.MapProperty, Index);
+		int32 Value = INDEX_NONE;
+		UMapExtensionsLibrary::GenericMap_GetValue(&Map, Property.MapProperty, Index, &Value);
+		bForwardMatches &= Key == GetExpectedKeyAt(Map, Index) && Value == Map.FindRef(Key);
+	}
+	TestTrue(TEXT("正序取键取值的结果正确"), bForwardMatches);
+	TestTrue(TEXT("正序取键取值只在循环开始时完整校验"),
+		XTools::MapExtensions::GetNumMapIndexTableFullChecks() - ChecksBeforeForward <= 1);
+
+	// 倒序循环从非相邻索引开始，同样只校验一次
+	const int32 ChecksBeforeReverse = XTools::MapExtensions::GetNumMapIndexTableFullChecks();
+	bool bReverseMatches = true;
+	for (int32 Index = Map.Num() - 1; Index >= 0; --Index)
+	{
+		const int32 Key = GetKeyAt(Map, Property.MapProperty, Index);
+		int32 Value = INDEX_NONE;
+		UMapExtensionsLibrary::GenericMap_GetValue(&Map, Property.MapProperty, Index, &Value);
+		bReverseMatches &= Key == GetExpectedKeyAt(Map, Index) && Value == Map.FindRef(Key);
+	}
+	TestTrue(TEXT("倒序取键取值的结果正确"), bReverseMatches);
+	TestTrue(TEXT("倒序取键取值只在循环开始时完整校验"),
+		XTools::MapExtensions::GetNumMapIndexTableFullChecks() - ChecksBeforeReverse <= 1);
+
+	// 先加后删使同一索引上的槽位失效，长度与最大索引不变，不能继续信任索引表
+	const int32 KeyAtTen = GetKeyAt(Map, Property.MapProperty, 10);
+	Map.Add(1000, 10000);
+	Map.Remove(KeyAtTen);
+	TestEqual(TEXT("同一索引的槽位失效后返回正确的键"), GetKeyAt(Map, Property.MapProperty, 10), GetExpectedKeyAt(Map, 10));
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMapExtensionsLibrary_CachedValueLookupsMatchScan,
+	"XTools.BlueprintExtensionsRuntime.Map.CachedValueLookupsMatchScan",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMapExtensionsLibrary_CachedValueLookupsMatchScan::RunTest(const FString& Parameters)
+{
+	using namespace MapExtensionsLibraryTests;
+
+	const FIntMapProperty Property;
+	const FIntArrayProperty KeysProperty;
+	TMap<int32, int32> Map;
+	for (int32 Key = 0; Key < 24; ++Key)
+	{
+		Map.Add(Key, (Key % 3) * 10);
+	}
+	// 先删后加，让新元素填进空洞，迭代顺序不再与插入顺序一致
+	Map.Remove(4);
+	Map.Remove(13);
+	Map.Add(100, 10);
+	Map.Add(101, 0);
+	Map.Remove(20);
+
+	TestTrue(TEXT("整数值类型可以缓存"), UMapExtensionsLibrary::GenericMap_CacheValueLookups(&Map, Property.MapProperty));
+
+	for (const int32 Value : {0, 10, 20, 30})
+	{
+		TestEqual(FString::Printf(TEXT("缓存后值%d对应的键与顺序遍历顺序一致"), Value),
+			GetKeysFromValue(Map, Property.MapProperty, KeysProperty.ArrayProperty, Value), GetExpectedKeysFromValue(Map, Value));
+		TestEqual(FString::Printf(TEXT("缓存后是否包含值%d与顺序遍历一致"), Value),
+			ContainsValue(Map, Property.MapProperty, Value), GetExpectedKeysFromValue(Map, Value).Num() > 0);
+	}
+
+	const TArray<int32> RemovedKeys = GetExpectedKeysFromValue(Map, 20);
+	const int32 RemovedValue = 20;
+	TestTrue(TEXT("缓存后根据值移除条目"), UMapExtensionsLibrary::GenericMap_RemoveEntriesWithValue(&Map, Property.MapProperty, Property.MapProperty->ValueProp, &RemovedValue));
+	for (const int32 Key : RemovedKeys)
+	{
+		TestFalse(FString::Printf(TEXT("值为20的键%d已移除"), Key), Map.Contains(Key));
+	}
+	TestEqual(TEXT("只移除值为20的条目"), Map.Num(), 23 - RemovedKeys.Num());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMapExtensionsLibrary_CachedValueLookupsInvalidate,
+	"XTools.BlueprintExtensionsRuntime.Map.CachedValueLookupsInvalidate",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMapExtensionsLibrary_CachedValueLookupsInvalidate::RunTest(const FString& Parameters)
+{
+	using namespace MapExtensionsLibraryTests;
+
+	const FIntMapProperty Property;
+	const FIntArrayProperty KeysProperty;
+	TMap<int32, int32> Map;
+	FillSequential(Map, 8);
+
+	// 按索引设置值：长度与最大索引不变，只能依靠本库主动失效
+	UMapExtensionsLibrary::GenericMap_CacheValueLookups(&Map, Property.MapProperty);
+	const int32 NewValue = 999;
+	UMapExtensionsLibrary::GenericMap_SetValueAt(&Map, Property.MapProperty, 3, &NewValue);
+	TestTrue(TEXT("按索引设置值后能找到新值"), ContainsValue(Map, Property.MapProperty, NewValue));
+	TestFalse(TEXT("按索引设置值后找不到旧值"), ContainsValue(Map, Property.MapProperty, 30));
+
+	// 移除条目后引擎节点填回空洞：长度与最大索引恢复原样
+	UMapExtensionsLibrary::GenericMap_CacheValueLookups(&Map, Property.MapProperty);
+	TArray<int32> KeysToRemove = {5};
+	UMapExtensionsLibrary::GenericMap_RemoveEntries(&Map, Property.MapProperty, &KeysToRemove, KeysProperty.ArrayProperty);
+	Map.Add(50, 777);
+	TestEqual(TEXT("移除条目后填回空洞的新值可以查到"), GetKeysFromValue(Map, Property.MapProperty, KeysProperty.ArrayProperty, 777), TArray<int32>{50});
+
+	// 根据值移除条目后同样失效
+	UMapExtensionsLibrary::GenericMap_CacheValueLookups(&Map, Property.MapProperty);
+	const int32 RemovedValue = 777;
+	UMapExtensionsLibrary::GenericMap_RemoveEntriesWithValue(&Map, Property.MapProperty, Property.MapProperty->ValueProp, &RemovedValue);
+	Map.Add(60, 888);
+	TestTrue(TEXT("根据值移除条目后填回空洞的新值可以查到"), ContainsValue(Map, Property.MapProperty, 888));
+
+	// 新增元素改变长度，缓存不再使用
+	UMapExtensionsLibrary::GenericMap_CacheValueLookups(&Map, Property.MapProperty);
+	Map.Add(70, 555);
+	TestEqual(TEXT("新增元素后的值可以查到"), GetKeysFromValue(Map, Property.MapProperty, KeysProperty.ArrayProperty, 555), TArray<int32>{70});
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMapExtensionsLibrary_CachedValueLookupsDetectOverwrittenValues,
+	"XTools.BlueprintExtensionsRuntime.Map.CachedValueLookupsDetectOverwrittenValues",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMapExtensionsLibrary_CachedValueLookupsDetectOverwrittenValues::RunTest(const FString& Parameters)
+{
+	using namespace MapExtensionsLibraryTests;
+
+	const FIntMapProperty Property;
+	const FIntArrayProperty KeysProperty;
+	TMap<int32, int32> Map;
+	FillSequential(Map, 8);
+
+	// 引擎Map Add覆盖已有键：长度与最大索引不变，新值所在的桶为空
+	UMapExtensionsLibrary::GenericMap_CacheValueLookups(&Map, Property.MapProperty);
+	Map.Add(2, 999);
+	TestTrue(TEXT("覆盖后能找到新值"), ContainsValue(Map, Property.MapProperty, 999));
+	TestEqual(TEXT("覆盖后新值对应的键与顺序遍历一致"),
+		GetKeysFromValue(Map, Property.MapProperty, KeysProperty.ArrayProperty, 999), GetExpectedKeysFromValue(Map, 999));
+
+	// 覆盖后旧值所在桶里的元素已不再是旧值
+	UMapExtensionsLibrary::GenericMap_CacheValueLookups(&Map, Property.MapProperty);
+	const int32 OldValue = Map.FindChecked(4);
+	Map.Add(4, 888);
+	TestFalse(TEXT("覆盖后找不到旧值"), ContainsValue(Map, Property.MapProperty, OldValue));
+	TestEqual(TEXT("覆盖后旧值对应的键为空"),
+		GetKeysFromValue(Map, Property.MapProperty, KeysProperty.ArrayProperty, OldValue), TArray<int32>());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMapExtensionsLibrary_CacheValueLookupsRejectsUnhashableValues,
+	"XTools.BlueprintExtensionsRuntime.Map.CacheValueLookupsRejectsUnhashableValues",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMapExtensionsLibrary_CacheValueLookupsRejectsUnhashableValues::RunTest(const FString& Parameters)
+{
+	using namespace MapExtensionsLibraryTests;
+
+	const FIntMapProperty Property(true);
+	TMap<int32, TArray<int32>> Map;
+	Map.Add(1, {1, 2});
+	Map.Add(2, {3});
+
+	TestFalse(TEXT("数组值不可哈希，缓存返回false"), UMapExtensionsLibrary::GenericMap_CacheValueLookups(&Map, Property.MapProperty));
+
+	const TArray<int32> ExistingValue = {3};
+	const TArray<int32> MissingValue = {4};
+	TestTrue(TEXT("不可缓存时仍按顺序遍历找到值"), UMapExtensionsLibrary::GenericMap_FindValue(&Map, Property.MapProperty, Property.MapProperty->ValueProp, &ExistingValue));
+	TestFalse(TEXT("不可缓存时不存在的值返回false"), UMapExtensionsLibrary::GenericMap_FindValue(&Map, Property.MapProperty, Property.MapProperty->ValueProp, &MissingValue));
+
+	return true;
+}
+
+#endif
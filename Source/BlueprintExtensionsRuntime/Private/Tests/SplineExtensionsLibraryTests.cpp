@@ -6,6 +6,7 @@
 #if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
 
 #include "Components/SplineComponent.h"
+#include "Features/SplineTrajectoryLibrary.h"
 #include "Libraries/SplineExtensionsLibrary.h"
 #include "Misc/AutomationTest.h"
 
@@ -44,4 +45,47 @@ bool FSplineExtensionsLibrary_QueriesAndSimplifiesSpline::RunTest(const FString&
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSplineExtensionsLibrary_SnapshotAnswersBatchedQueries,
+	"XTools.BlueprintExtensionsRuntime.Spline.SnapshotAnswersBatchedQueries",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSplineExtensionsLibrary_SnapshotAnswersBatchedQueries::RunTest(const FString& Parameters)
+{
+	USplineComponent* Spline = NewObject<USplineComponent>(GetTransientPackage());
+	TestNotNull(TEXT("应创建瞬态样条组件"), Spline);
+	if (!Spline)
+	{
+		return false;
+	}
+
+	TestFalse(TEXT("空指针样条的快照无效"), USplineExtensionsLibrary::CaptureSplineSnapshot(nullptr).IsValid());
+
+	USplineExtensionsLibrary::SimplifySpline(Spline, { FVector::ZeroVector, FVector(1000.0f, 0.0f, 0.0f) });
+	const FXToolsSplineSnapshot Snapshot = USplineExtensionsLibrary::CaptureSplineSnapshot(Spline, 100.0);
+	TestTrue(TEXT("两点样条的快照有效"), Snapshot.IsValid());
+	TestEqual(TEXT("直线样条每100单位一个采样点"), Snapshot.Locations.Num(), 11);
+	TestTrue(TEXT("快照长度与样条一致"), FMath::IsNearlyEqual(Snapshot.Length, 1000.0, 0.1));
+
+	TArray<FVector> Locations;
+	TArray<FVector> Directions;
+	USplineExtensionsLibrary::GetSplineSnapshotLocationsAtDistances(Snapshot, { 250.0, -10.0, 5000.0 }, Locations, Directions);
+	TestEqual(TEXT("批量查询输出与输入等长"), Locations.Num(), 3);
+	TestTrue(TEXT("中间距离插值到对应位置"), Locations[0].Equals(FVector(250.0f, 0.0f, 0.0f), 1.0f));
+	TestTrue(TEXT("开放样条负距离限制到起点"), Locations[1].Equals(FVector::ZeroVector, 1.0f));
+	TestTrue(TEXT("开放样条超长距离限制到终点"), Locations[2].Equals(FVector(1000.0f, 0.0f, 0.0f), 1.0f));
+	TestTrue(TEXT("直线方向沿X轴"), Directions[0].Equals(FVector::ForwardVector, 0.01f));
+
+	TArray<double> Distances;
+	USplineExtensionsLibrary::FindSplineSnapshotDistancesClosestToLocations(Snapshot, { FVector(400.0f, 50.0f, 0.0f) }, Distances);
+	TestTrue(TEXT("最近点距离与投影一致"), Distances.Num() == 1 && FMath::IsNearlyEqual(Distances[0], 400.0, 1.0));
+
+	USplineTrajectoryLibrary::SplineTrajectoryBallistic(Spline, FTransform::Identity, FVector(1000.0f, 0.0f, 0.0f), 0.5f);
+	TestEqual(TEXT("抛射轨迹一次写入两个控制点"), Spline->GetNumberOfSplinePoints(), 2);
+	TestTrue(TEXT("抛射轨迹终点与目标一致"), USplineExtensionsLibrary::GetSplineEnd(Spline).Equals(FVector(1000.0f, 0.0f, 0.0f), UE_KINDA_SMALL_NUMBER));
+	TestTrue(TEXT("抛射轨迹起点切线朝上"), Spline->GetTangentAtSplinePoint(0, ESplineCoordinateSpace::World).Z > 0.0f);
+
+	return true;
+}
+
 #endif
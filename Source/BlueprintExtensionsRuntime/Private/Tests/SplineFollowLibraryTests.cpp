@@ -0,0 +1,109 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/SplineComponent.h"
+#include "Libraries/SplineFollowLibrary.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSplineFollowLibrary_FindsClosestInputKey,
+	"XTools.BlueprintExtensionsRuntime.Spline.FindsClosestInputKey",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSplineFollowLibrary_FindsClosestInputKey::RunTest(const FString& Parameters)
+{
+	USplineComponent* Spline = NewObject<USplineComponent>(GetTransientPackage());
+	TestNotNull(TEXT("应创建瞬态样条组件"), Spline);
+	if (!Spline)
+	{
+		return false;
+	}
+
+	Spline->ClearSplinePoints(false);
+	for (int32 PointIndex = 0; PointIndex < 40; ++PointIndex)
+	{
+		const double X = PointIndex * 200.0;
+		const double Y = FMath::Sin(PointIndex * 0.7) * 300.0;
+		Spline->AddSplinePoint(FVector(X, Y, 0.0), ESplineCoordinateSpace::Local, false);
+	}
+	Spline->UpdateSpline();
+
+	double Distance = 0.0;
+	float PreviousInputKey = -1.0f;
+	for (int32 QueryIndex = 0; QueryIndex < 64; ++QueryIndex)
+	{
+		const FVector Location(QueryIndex * 120.0, FMath::Cos(QueryIndex * 0.3) * 250.0, 50.0);
+		const float EngineInputKey = Spline->FindInputKeyClosestToWorldLocation(Location);
+		const float InputKey = USplineFollowLibrary::FindSplineInputKeyClosestToLocation(Spline, Location, Distance);
+		const float HintedInputKey = USplineFollowLibrary::FindSplineInputKeyClosestToLocation(Spline, Location, Distance, PreviousInputKey);
+		PreviousInputKey = HintedInputKey;
+
+		const double EngineDistanceToSpline = FVector::Dist(Location, Spline->GetLocationAtSplineInputKey(EngineInputKey, ESplineCoordinateSpace::World));
+		const double DistanceToSpline = FVector::Dist(Location, Spline->GetLocationAtSplineInputKey(InputKey, ESplineCoordinateSpace::World));
+		const double HintedDistanceToSpline = FVector::Dist(Location, Spline->GetLocationAtSplineInputKey(HintedInputKey, ESplineCoordinateSpace::World));
+		TestTrue(FString::Printf(TEXT("查询%d的最近点与引擎结果的差距应在折线采样误差内"), QueryIndex), DistanceToSpline <= EngineDistanceToSpline + 0.5);
+		TestTrue(FString::Printf(TEXT("查询%d带上次输入键时结果一致"), QueryIndex), FMath::IsNearlyEqual(HintedDistanceToSpline, DistanceToSpline, 0.5));
+	}
+
+	TestEqual(TEXT("输出距离与输入键对应"), Distance,
+		static_cast<double>(Spline->GetDistanceAlongSplineAtSplineInputKey(PreviousInputKey)));
+
+	// 控制点数量变化后缓存应自动重建
+	Spline->AddSplinePoint(FVector(8000.0, 2000.0, 0.0), ESplineCoordinateSpace::Local, true);
+	const float ExtendedInputKey = USplineFollowLibrary::FindSplineInputKeyClosestToLocation(Spline, FVector(8000.0, 2000.0, 0.0), Distance);
+	TestTrue(TEXT("新增控制点后应找到新的末端"), FMath::IsNearlyEqual(ExtendedInputKey, 40.0f, 0.01f));
+
+	// 同一帧内只移动控制点时需要手动刷新缓存
+	Spline->SetLocationAtSplinePoint(0, FVector(0.0, -300.0, 0.0), ESplineCoordinateSpace::Local, true);
+	USplineFollowLibrary::InvalidateSplineClosestPointCache(Spline);
+	const float MovedInputKey = USplineFollowLibrary::FindSplineInputKeyClosestToLocation(Spline, FVector(0.0, -300.0, 0.0), Distance);
+	TestTrue(TEXT("刷新缓存后应找到移动后的起点"), FMath::IsNearlyEqual(MovedInputKey, 0.0f, 0.01f));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSplineFollowLibrary_HintDoesNotStopAtLocalMinimum,
+	"XTools.BlueprintExtensionsRuntime.Spline.HintDoesNotStopAtLocalMinimum",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSplineFollowLibrary_HintDoesNotStopAtLocalMinimum::RunTest(const FString& Parameters)
+{
+	USplineComponent* Spline = NewObject<USplineComponent>(GetTransientPackage());
+	TestNotNull(TEXT("应创建瞬态样条组件"), Spline);
+	if (!Spline)
+	{
+		return false;
+	}
+
+	// 折返的U形样条：去程沿Y=0，回程沿Y=600
+	Spline->ClearSplinePoints(false);
+	for (int32 PointIndex = 0; PointIndex < 20; ++PointIndex)
+	{
+		Spline->AddSplinePoint(FVector(PointIndex * 200.0, 0.0, 0.0), ESplineCoordinateSpace::Local, false);
+	}
+	for (int32 PointIndex = 19; PointIndex >= 0; --PointIndex)
+	{
+		Spline->AddSplinePoint(FVector(PointIndex * 200.0, 600.0, 0.0), ESplineCoordinateSpace::Local, false);
+	}
+	Spline->UpdateSpline();
+
+	// 上次输入键在去程上，窗口内的最近边位于窗口内部，但真正的最近点在回程上
+	const FVector Location(1000.0, 590.0, 0.0);
+	double Distance = 0.0;
+	const float InputKey = USplineFollowLibrary::FindSplineInputKeyClosestToLocation(Spline, Location, Distance);
+	const float HintedInputKey = USplineFollowLibrary::FindSplineInputKeyClosestToLocation(Spline, Location, Distance, 5.0f);
+
+	const double DistanceToSpline = FVector::Dist(Location, Spline->GetLocationAtSplineInputKey(InputKey, ESplineCoordinateSpace::World));
+	const double HintedDistanceToSpline = FVector::Dist(Location, Spline->GetLocationAtSplineInputKey(HintedInputKey, ESplineCoordinateSpace::World));
+	TestTrue(TEXT("不带上次输入键时找到回程"), DistanceToSpline < 20.0);
+	TestTrue(TEXT("上次输入键附近只有局部最近点时仍找到回程"), FMath::IsNearlyEqual(HintedDistanceToSpline, DistanceToSpline, 0.5));
+
+	return true;
+}
+
+#endif
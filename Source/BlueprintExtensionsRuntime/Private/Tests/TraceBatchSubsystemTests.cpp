@@ -0,0 +1,180 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+
+#include "Libraries/TraceBatchSubsystem.h"
+
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+namespace
+{
+	UWorld* CreateTraceBatchTestWorld(UTraceBatchSubsystem*& OutSubsystem)
+	{
+		UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+		OutSubsystem = World ? World->GetSubsystem<UTraceBatchSubsystem>() : nullptr;
+		return World;
+	}
+
+	/** 推进世界直到批次完成，异步追踪的结果在下一帧开始时回到游戏线程 */
+	bool TickUntilComplete(UWorld* World, const UTraceBatchSubsystem* Subsystem, FXToolsTraceBatchHandle Handle, int32 MaxTicks)
+	{
+		for (int32 TickIndex = 0; TickIndex < MaxTicks && !Subsystem->IsTraceBatchComplete(Handle); ++TickIndex)
+		{
+			World->Tick(LEVELTICK_All, 1.0f / 60.0f);
+		}
+		return Subsystem->IsTraceBatchComplete(Handle);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FTraceBatchSubsystem_SubmitAndTakeResults,
+	"XTools.BlueprintExtensionsRuntime.Trace.BatchSubmitAndTakeResults",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FTraceBatchSubsystem_SubmitAndTakeResults::RunTest(const FString& Parameters)
+{
+	UTraceBatchSubsystem* Subsystem = nullptr;
+	UWorld* World = CreateTraceBatchTestWorld(Subsystem);
+	if (!TestNotNull(TEXT("应能创建追踪批次子系统"), Subsystem))
+	{
+		if (World)
+		{
+			World->DestroyWorld(false);
+		}
+		return false;
+	}
+
+	TArray<FXToolsTraceRequest> Requests;
+	Requests.Add(UTraceExtensionsLibrary::MakeTraceRequestChannel(FVector::ZeroVector, FVector(1000.0, 0.0, 0.0), TEXT("TraceTypeQuery1"), false));
+	Requests.Add(UTraceExtensionsLibrary::MakeTraceRequestChannel(FVector::ZeroVector, FVector(0.0, 1000.0, 0.0), TEXT("TraceTypeQuery1"), true, 20.0f));
+	Requests.Add(UTraceExtensionsLibrary::MakeTraceRequestObject(FVector::ZeroVector, FVector(0.0, 0.0, 1000.0), { TEXT("ObjectTypeQuery1") }, false));
+	Requests.Add(UTraceExtensionsLibrary::MakeTraceRequestObject(FVector::ZeroVector, FVector(0.0, 0.0, -1000.0), { TEXT("ObjectTypeQuery2") }, false, 20.0f));
+
+	const FXToolsTraceBatchHandle Handle = Subsystem->SubmitTraceBatch(Requests, {});
+	TestTrue(TEXT("提交后得到有效句柄"), Handle.IsSet());
+	TestEqual(TEXT("提交后批次数量"), Subsystem->GetNumTraceBatches(), 1);
+	TestFalse(TEXT("提交的同一帧内批次尚未完成"), Subsystem->IsTraceBatchComplete(Handle));
+
+	TArray<FXToolsTraceResult> Results;
+	TestFalse(TEXT("未完成时不能取出结果"), Subsystem->TakeTraceBatchResults(Handle, Results));
+	TestEqual(TEXT("未完成时结果为空"), Results.Num(), 0);
+
+	TestTrue(TEXT("推进世界后批次完成"), TickUntilComplete(World, Subsystem, Handle, 4));
+	TestTrue(TEXT("完成后取出结果"), Subsystem->TakeTraceBatchResults(Handle, Results));
+	TestEqual(TEXT("结果与请求一一对应"), Results.Num(), Requests.Num());
+	for (int32 Index = 0; Index < Results.Num(); ++Index)
+	{
+		TestFalse(FString::Printf(TEXT("空世界中请求%d未命中"), Index), Results[Index].bHit);
+	}
+
+	TestFalse(TEXT("取出结果后句柄失效"), Subsystem->IsTraceBatchComplete(Handle));
+	TestFalse(TEXT("不能重复取出结果"), Subsystem->TakeTraceBatchResults(Handle, Results));
+	TestEqual(TEXT("取出结果后批次数量归零"), Subsystem->GetNumTraceBatches(), 0);
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FTraceBatchSubsystem_RejectsStaleHandles,
+	"XTools.BlueprintExtensionsRuntime.Trace.BatchRejectsStaleHandles",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FTraceBatchSubsystem_RejectsStaleHandles::RunTest(const FString& Parameters)
+{
+	UTraceBatchSubsystem* Subsystem = nullptr;
+	UWorld* World = CreateTraceBatchTestWorld(Subsystem);
+	if (!TestNotNull(TEXT("应能创建追踪批次子系统"), Subsystem))
+	{
+		if (World)
+		{
+			World->DestroyWorld(false);
+		}
+		return false;
+	}
+
+	const TArray<FXToolsTraceRequest> Requests = {
+		UTraceExtensionsLibrary::MakeTraceRequestChannel(FVector::ZeroVector, FVector(1000.0, 0.0, 0.0), TEXT("TraceTypeQuery1"), false)
+	};
+
+	const FXToolsTraceBatchHandle OldHandle = Subsystem->SubmitTraceBatch(Requests, {});
+	TestTrue(TEXT("释放进行中的批次"), Subsystem->ReleaseTraceBatch(OldHandle));
+	TestFalse(TEXT("不能重复释放"), Subsystem->ReleaseTraceBatch(OldHandle));
+
+	const FXToolsTraceBatchHandle NewHandle = Subsystem->SubmitTraceBatch(Requests, {});
+	TestEqual(TEXT("空闲槽位被复用"), NewHandle.Index, OldHandle.Index);
+	TestNotEqual(TEXT("复用槽位时序号递增"), NewHandle.Serial, OldHandle.Serial);
+
+	// 旧批次的追踪返回时被忽略，不会计入复用槽位的新批次
+	TestTrue(TEXT("新批次正常完成"), TickUntilComplete(World, Subsystem, NewHandle, 4));
+
+	TArray<FXToolsTraceResult> Results;
+	TestFalse(TEXT("复用槽位后旧句柄不算完成"), Subsystem->IsTraceBatchComplete(OldHandle));
+	TestFalse(TEXT("复用槽位后旧句柄不能取出结果"), Subsystem->TakeTraceBatchResults(OldHandle, Results));
+	TestFalse(TEXT("复用槽位后旧句柄不能释放新批次"), Subsystem->ReleaseTraceBatch(OldHandle));
+	TestTrue(TEXT("新句柄仍能取出结果"), Subsystem->TakeTraceBatchResults(NewHandle, Results));
+	TestEqual(TEXT("新批次结果数量"), Results.Num(), Requests.Num());
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FTraceBatchSubsystem_CompletesEmptyBatches,
+	"XTools.BlueprintExtensionsRuntime.Trace.BatchCompletesEmptyBatches",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FTraceBatchSubsystem_CompletesEmptyBatches::RunTest(const FString& Parameters)
+{
+	UTraceBatchSubsystem* Subsystem = nullptr;
+	UWorld* World = CreateTraceBatchTestWorld(Subsystem);
+	if (!TestNotNull(TEXT("应能创建追踪批次子系统"), Subsystem))
+	{
+		if (World)
+		{
+			World->DestroyWorld(false);
+		}
+		return false;
+	}
+
+	// 默认请求没有解析出通道或对象类型，不执行追踪
+	const TArray<FXToolsTraceRequest> UnresolvedRequests = { FXToolsTraceRequest(), FXToolsTraceRequest() };
+	const FXToolsTraceBatchHandle EmptyHandle = Subsystem->SubmitTraceBatch({}, {});
+	const FXToolsTraceBatchHandle UnresolvedHandle = Subsystem->SubmitTraceBatch(UnresolvedRequests, {});
+	TestTrue(TEXT("空批次得到有效句柄"), EmptyHandle.IsSet());
+	TestTrue(TEXT("未解析批次得到有效句柄"), UnresolvedHandle.IsSet());
+	TestTrue(TEXT("空批次没有待返回的追踪"), Subsystem->IsTraceBatchComplete(EmptyHandle));
+	TestTrue(TEXT("未解析批次没有待返回的追踪"), Subsystem->IsTraceBatchComplete(UnresolvedHandle));
+
+	// 完成事件在下一帧广播，推进一帧后句柄仍然有效
+	World->Tick(LEVELTICK_All, 1.0f / 60.0f);
+	TestTrue(TEXT("下一帧后空批次仍可取出"), Subsystem->IsTraceBatchComplete(EmptyHandle));
+
+	TArray<FXToolsTraceResult> Results;
+	TestTrue(TEXT("取出空批次结果"), Subsystem->TakeTraceBatchResults(EmptyHandle, Results));
+	TestEqual(TEXT("空批次没有结果"), Results.Num(), 0);
+
+	TestTrue(TEXT("取出未解析批次结果"), Subsystem->TakeTraceBatchResults(UnresolvedHandle, Results));
+	TestEqual(TEXT("未解析的请求仍占一个结果"), Results.Num(), UnresolvedRequests.Num());
+	for (int32 Index = 0; Index < Results.Num(); ++Index)
+	{
+		TestFalse(FString::Printf(TEXT("未解析的请求%d结果为未命中"), Index), Results[Index].bHit);
+	}
+
+	// 下一帧广播前释放的空批次，槽位复用后不会把完成事件发给新批次
+	const FXToolsTraceBatchHandle ReleasedHandle = Subsystem->SubmitTraceBatch({}, {});
+	Subsystem->ReleaseTraceBatch(ReleasedHandle);
+	const FXToolsTraceBatchHandle ReusedHandle = Subsystem->SubmitTraceBatch(UnresolvedRequests, {});
+	World->Tick(LEVELTICK_All, 1.0f / 60.0f);
+	TestFalse(TEXT("释放的空批次句柄失效"), Subsystem->IsTraceBatchComplete(ReleasedHandle));
+	TestTrue(TEXT("复用槽位的批次照常完成"), Subsystem->TakeTraceBatchResults(ReusedHandle, Results));
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
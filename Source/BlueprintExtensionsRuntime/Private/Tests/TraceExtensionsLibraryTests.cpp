@@ -0,0 +1,52 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+
+#include "Libraries/TraceExtensionsLibrary.h"
+
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FTraceExtensionsLibrary_ResolveTraceTypes,
+	"XTools.BlueprintExtensionsRuntime.Trace.ResolveTraceTypes",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FTraceExtensionsLibrary_ResolveTraceTypes::RunTest(const FString& Parameters)
+{
+	bool bSuccess = false;
+	FXToolsTraceQueryType QueryType = UTraceExtensionsLibrary::ResolveTraceChannel(TEXT("TraceTypeQuery1"), bSuccess);
+	TestTrue(TEXT("枚举名应能解析为追踪通道"), bSuccess);
+	TestEqual(TEXT("TraceTypeQuery1对应可见性通道"), QueryType.TraceChannel.GetValue(), ECC_Visibility);
+
+	QueryType = UTraceExtensionsLibrary::ResolveTraceChannel(TEXT("Visibility"), bSuccess);
+	TestTrue(TEXT("碰撞配置中的通道名应能解析"), bSuccess);
+	TestEqual(TEXT("通道名与枚举名解析结果一致"), QueryType.TraceChannel.GetValue(), ECC_Visibility);
+
+	QueryType = UTraceExtensionsLibrary::ResolveTraceChannel(TEXT("XToolsNoSuchChannel"), bSuccess);
+	TestFalse(TEXT("未知通道名解析失败"), bSuccess);
+	TestFalse(TEXT("解析失败的查询类型无效"), QueryType.IsValid());
+
+	QueryType = UTraceExtensionsLibrary::ResolveTraceObjectTypes({ TEXT("ObjectTypeQuery1"), TEXT("ObjectTypeQuery2") }, bSuccess);
+	TestTrue(TEXT("对象类型应能解析"), bSuccess);
+	TestEqual(TEXT("对象类型位掩码包含静态与动态对象"), QueryType.ObjectTypesMask,
+		static_cast<int32>(ECC_TO_BITFIELD(ECC_WorldStatic) | ECC_TO_BITFIELD(ECC_WorldDynamic)));
+
+	UTraceExtensionsLibrary::ResolveTraceObjectTypes({ TEXT("ObjectTypeQuery1"), TEXT("XToolsNoSuchType") }, bSuccess);
+	TestFalse(TEXT("任一对象类型无效时整体解析失败"), bSuccess);
+
+	FString EnumString;
+	UTraceExtensionsLibrary::TraceChannelType(TEXT("Visibility"), EnumString);
+	TestEqual(TEXT("显示名转换为枚举字符串"), EnumString, FString(TEXT("TraceTypeQuery1")));
+
+	const FXToolsTraceRequest Request = UTraceExtensionsLibrary::MakeTraceRequestChannel(
+		FVector::ZeroVector, FVector(100.0, 0.0, 0.0), TEXT("TraceTypeQuery2"), false, 10.0f);
+	TestEqual(TEXT("创建请求时解析通道"), Request.QueryType.TraceChannel.GetValue(), ECC_Camera);
+	TestEqual(TEXT("请求保留半径"), Request.Radius, 10.0f);
+
+	return true;
+}
+
+#endif
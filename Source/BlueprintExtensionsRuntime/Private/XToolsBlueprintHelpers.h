@@ -67,27 +67,6 @@ namespace XToolsBlueprintHelpers
 		return Keys;
 	}
 
-	/**
-	 * 构建枚举名称到字符串的映射
-	 * @param EnumPtr 枚举指针
-	 * @return 名称到字符串的映射
-	 */
-	inline TMap<FName, FString> BuildEnumNameMap(UEnum* EnumPtr)
-	{
-		TMap<FName, FString> NameMap;
-		if (EnumPtr)
-		{
-			for (int32 i = 0; i < EnumPtr->NumEnums(); ++i)
-			{
-				const FString DisplayName = EnumPtr->GetDisplayNameTextByIndex(i).ToString();
-				const FString EnumName = EnumPtr->GetNameStringByIndex(i);
-
-				NameMap.Add(FName(*DisplayName), EnumName);
-			}
-		}
-		return NameMap;
-	}
-
 	/**
 	 * RAII 风格的属性存储管理器
 	 * 自动管理属性的内存分配、初始化和清理
@@ -153,41 +132,4 @@ namespace XToolsBlueprintHelpers
 			SourceSize == XTOOLS_GET_ELEMENT_SIZE(TargetProperty) * TargetProperty->ArrayDim &&
 			(SourceClass->IsChildOf(TargetClass) || TargetClass->IsChildOf(SourceClass));
 	}
-
-	/**
-	 * 模板化的枚举缓存获取器
-	 * @param Cache 缓存映射
-	 * @param Key 键
-	 * @param StaticEnum 静态枚举
-	 * @return 缓存的枚举值
-	 */
-	template<typename TEnum>
-	inline bool TryGetCachedEnum(TMap<FString, TEnum>& Cache, const FString& Key, UEnum* StaticEnum, TEnum& OutResult)
-	{
-		if (!StaticEnum)
-		{
-			return false;
-		}
-
-		if (const TEnum* CachedValue = Cache.Find(Key))
-		{
-			const int64 Value = static_cast<int64>(*CachedValue);
-			if (Value < 0 || Value >= StaticEnum->GetMaxEnumValue())
-			{
-				return false;
-			}
-			OutResult = *CachedValue;
-			return true;
-		}
-
-		const int64 EnumValue = StaticEnum->GetValueByName(FName(*Key));
-		if (EnumValue < 0 || EnumValue >= StaticEnum->GetMaxEnumValue())
-		{
-			return false;
-		}
-
-		OutResult = static_cast<TEnum>(EnumValue);
-		Cache.Add(Key, OutResult);
-		return true;
-	}
 }
@@ -332,7 +332,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "XTools|蓝图扩展|子弹",
 		meta = (DisplayName = "更新追踪弹运动",
 			Keywords = "Bullet Projectile Homing Tracking Missile Velocity Rotation 子弹 追踪 导弹 速度 旋转",
-			ToolTip = "执行一次自定义追踪弹运动更新：支持纯追踪、预测拦截和比例导引，可选写入ProjectileMovement并更新Actor/外观组件旋转。同时传入子弹Actor与ProjectileMovement时，实际运动参考组件必须属于该Actor。适合放在Timer或Tick中替换复杂蓝图追踪数学；每枚弹应使用独立状态，目标瞬移或对象池换弹前应重置状态；不要与ProjectileMovement原生Homing同时控制同一个速度。",
+			ToolTip = "执行一次自定义追踪弹运动更新：支持纯追踪、预测拦截和比例导引，可选写入ProjectileMovement并更新Actor/外观组件旋转。同时传入子弹Actor与ProjectileMovement时，实际运动参考组件必须属于该Actor。适合放在Timer或Tick中替换复杂蓝图追踪数学；每枚弹应使用独立状态，目标瞬移或对象池换弹前应重置状态；不要与ProjectileMovement原生Homing同时控制同一个速度。子弹数量较多时可改用注册追踪弹，由追踪弹子系统每帧批量更新。",
 			AdvancedDisplay = "TargetComponent,VisualComponent"))
 	static bool UpdateHomingProjectileMovement(
 		UPARAM(DisplayName = "子弹Actor") AActor* ProjectileActor,
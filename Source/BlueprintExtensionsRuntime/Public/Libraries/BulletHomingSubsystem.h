@@ -0,0 +1,163 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Libraries/BulletHomingLibrary.h"
+
+#include "BulletHomingSubsystem.generated.h"
+
+class AActor;
+class UProjectileMovementComponent;
+class USceneComponent;
+
+/**
+ * 追踪弹句柄
+ * 由追踪弹子系统分配，注销后槽位被复用，旧句柄随即失效
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTEXTENSIONSRUNTIME_API FXToolsBulletHomingHandle
+{
+	GENERATED_BODY()
+
+	int32 Index = INDEX_NONE;
+	int32 Serial = 0;
+
+	bool IsSet() const { return Index != INDEX_NONE; }
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
+	FXToolsBulletHomingStatusChangedSignature,
+	FXToolsBulletHomingHandle, Handle,
+	EXToolsBulletHomingStatus, Status);
+
+/**
+ * 追踪弹子系统
+ * 每个世界一个，批量驱动所有已注册的追踪弹，取代每枚弹在Tick或Timer中各自调用更新追踪弹运动节点。
+ *
+ * - 弹体注册一次得到句柄，对象引用、选项、制导状态与每帧输入输出按字段分别存放在紧凑数组中
+ * - 每帧分三段：游戏线程采集位置与目标，所有弹体的制导计算在一次并行循环中完成，再在游戏线程统一写回速度与旋转
+ * - 制导数学与更新追踪弹运动节点完全相同，同样的输入得到同样的结果
+ * - 注册时的弹体Actor或ProjectileMovement被销毁后自动注销
+ */
+UCLASS()
+class BLUEPRINTEXTENSIONSRUNTIME_API UBulletHomingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	static UBulletHomingSubsystem* Get(const UObject* WorldContextObject);
+
+	UFUNCTION(BlueprintCallable, Category = "XTools|蓝图扩展|子弹",
+		meta = (DisplayName = "注册追踪弹",
+			Keywords = "Bullet Projectile Homing Register Batch 子弹 追踪 注册 批量",
+			ToolTip = "将子弹交给追踪弹子系统每帧批量更新，参数含义与更新追踪弹运动节点相同。注册后不要再对同一子弹调用更新追踪弹运动节点；子弹销毁时自动注销，对象池回收前应手动注销。",
+			AdvancedDisplay = "TargetComponent,VisualComponent"))
+	FXToolsBulletHomingHandle RegisterHomingProjectile(
+		UPARAM(DisplayName = "子弹Actor") AActor* ProjectileActor,
+		UPARAM(DisplayName = "ProjectileMovement") UProjectileMovementComponent* ProjectileMovement,
+		UPARAM(DisplayName = "目标Actor") AActor* TargetActor,
+		UPARAM(DisplayName = "目标组件") USceneComponent* TargetComponent,
+		UPARAM(DisplayName = "外观组件") USceneComponent* VisualComponent,
+		UPARAM(DisplayName = "选项") const FXToolsBulletHomingOptions& Options);
+
+	UFUNCTION(BlueprintCallable, Category = "XTools|蓝图扩展|子弹",
+		meta = (DisplayName = "注销追踪弹",
+			Keywords = "Bullet Projectile Homing Unregister 子弹 追踪 注销",
+			ToolTip = "停止批量更新该子弹，并恢复由终端状态暂停的ProjectileMovement模拟与停止前速度。句柄失效时返回假。"))
+	bool UnregisterHomingProjectile(UPARAM(DisplayName = "句柄") FXToolsBulletHomingHandle Handle);
+
+	UFUNCTION(BlueprintCallable, Category = "XTools|蓝图扩展|子弹",
+		meta = (DisplayName = "设置追踪弹目标",
+			Keywords = "Bullet Projectile Homing Target 子弹 追踪 目标",
+			ToolTip = "更换已注册子弹的追踪目标。目标改变时按更新追踪弹运动节点的规则重新开始追踪。",
+			AdvancedDisplay = "TargetComponent"))
+	bool SetHomingTarget(
+		UPARAM(DisplayName = "句柄") FXToolsBulletHomingHandle Handle,
+		UPARAM(DisplayName = "目标Actor") AActor* TargetActor,
+		UPARAM(DisplayName = "目标组件") USceneComponent* TargetComponent);
+
+	UFUNCTION(BlueprintCallable, Category = "XTools|蓝图扩展|子弹",
+		meta = (DisplayName = "设置追踪弹选项",
+			Keywords = "Bullet Projectile Homing Options 子弹 追踪 选项",
+			ToolTip = "替换已注册子弹的追踪选项，运行时状态保留。"))
+	bool SetHomingOptions(
+		UPARAM(DisplayName = "句柄") FXToolsBulletHomingHandle Handle,
+		UPARAM(DisplayName = "选项") const FXToolsBulletHomingOptions& Options);
+
+	UFUNCTION(BlueprintPure, Category = "XTools|蓝图扩展|子弹",
+		meta = (DisplayName = "追踪弹是否已注册"))
+	bool IsHomingProjectileRegistered(UPARAM(DisplayName = "句柄") FXToolsBulletHomingHandle Handle) const;
+
+	UFUNCTION(BlueprintPure, Category = "XTools|蓝图扩展|子弹",
+		meta = (DisplayName = "获取追踪弹结果状态",
+			ToolTip = "最近一次批量更新输出的结果状态。句柄失效时返回无效。"))
+	EXToolsBulletHomingStatus GetHomingStatus(UPARAM(DisplayName = "句柄") FXToolsBulletHomingHandle Handle) const;
+
+	UFUNCTION(BlueprintCallable, Category = "XTools|蓝图扩展|子弹",
+		meta = (DisplayName = "获取追踪弹状态",
+			ToolTip = "拷贝已注册子弹的运行时状态。句柄失效时返回假。"))
+	bool GetHomingState(
+		UPARAM(DisplayName = "句柄") FXToolsBulletHomingHandle Handle,
+		UPARAM(DisplayName = "状态") FXToolsBulletHomingState& OutState) const;
+
+	/** 已注册的追踪弹数量 */
+	UFUNCTION(BlueprintPure, Category = "XTools|蓝图扩展|子弹",
+		meta = (DisplayName = "获取追踪弹数量"))
+	int32 GetNumHomingProjectiles() const { return DenseSlots.Num(); }
+
+	/** 按指定DeltaTime推进所有已注册的追踪弹，Tick中以世界DeltaTime调用 */
+	void UpdateHomingProjectiles(float DeltaTime);
+
+	/** 结果状态变化时广播，如进入已捕获或目标无效；回调中可以注销或注册追踪弹 */
+	UPROPERTY(BlueprintAssignable, Category = "XTools|蓝图扩展|子弹",
+		meta = (DisplayName = "追踪弹状态变化"))
+	FXToolsBulletHomingStatusChangedSignature OnHomingStatusChanged;
+
+private:
+	/** 句柄对应的紧凑数组下标，句柄失效时返回INDEX_NONE */
+	int32 FindDenseIndex(FXToolsBulletHomingHandle Handle) const;
+
+	/** 与最后一个元素交换后移除，保持所有数组紧凑 */
+	void RemoveAtDense(int32 DenseIndex);
+
+	void ResizeFrameBuffers(int32 Num);
+
+	/** 槽位 -> 紧凑下标，空闲槽位为INDEX_NONE */
+	TArray<int32> SlotToDense;
+	TArray<int32> SlotSerials;
+	TArray<int32> FreeSlots;
+
+	/** 以下数组按紧凑下标对齐，长度都等于已注册数量 */
+	TArray<int32> DenseSlots;
+	TArray<TWeakObjectPtr<AActor>> ProjectileActors;
+	TArray<TWeakObjectPtr<UProjectileMovementComponent>> ProjectileMovements;
+	TArray<TWeakObjectPtr<AActor>> TargetActors;
+	TArray<TWeakObjectPtr<USceneComponent>> TargetComponents;
+	TArray<TWeakObjectPtr<USceneComponent>> VisualComponents;
+	TArray<FXToolsBulletHomingOptions> HomingOptions;
+	TArray<FXToolsBulletHomingState> HomingStates;
+	TArray<EXToolsBulletHomingStatus> HomingStatuses;
+
+	/** 每帧采集的输入，游戏线程写、并行计算阶段读 */
+	TArray<uint8> FrameInputFlags;
+	TArray<FVector> FrameLocations;
+	TArray<FVector> FrameMovementVelocities;
+	TArray<float> FrameMovementInitialSpeeds;
+	TArray<FVector> FrameInitialDirections;
+	TArray<FVector> FrameTargetLocations;
+	TArray<FVector> FrameTargetVelocities;
+
+	/** 每帧的计算结果，并行计算阶段写、游戏线程写回阶段读 */
+	TArray<uint8> FrameResultFlags;
+	TArray<EXToolsBulletHomingStatus> FrameStatuses;
+	TArray<FVector> FrameVelocities;
+	TArray<FVector> FrameAimLocations;
+	TArray<FVector> FrameRestoreVelocities;
+
+	/** 本帧状态发生变化的句柄，写回结束后统一广播 */
+	TArray<TPair<FXToolsBulletHomingHandle, EXToolsBulletHomingStatus>> PendingStatusChanges;
+};
@@ -54,8 +54,31 @@ namespace XTools::MapExtensions
 		const FProperty* Property = nullptr;
 		void* Value = nullptr;
 	};
+
+#if WITH_DEV_AUTOMATION_TESTS
+	/** 当前线程上Map索引表完整校验（含重建）的累计次数，仅供自动化测试使用 */
+	BLUEPRINTEXTENSIONSRUNTIME_API int32 GetNumMapIndexTableFullChecks();
+#endif
 }
 
+/**
+ * Map索引视图
+ * 记录索引表构建时Map的长度与版本；Map增删元素后索引表重建，旧视图随之失效
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTEXTENSIONSRUNTIME_API FXToolsMapIndexView
+{
+	GENERATED_BODY()
+
+	/** 构建时的元素数量 */
+	UPROPERTY(BlueprintReadOnly, Category = "XTools|Blueprint Extensions|Map", meta = (DisplayName = "长度"))
+	int32 Num = 0;
+
+	/** 索引表版本，为0表示无效视图 */
+	UPROPERTY(BlueprintReadOnly, Category = "XTools|Blueprint Extensions|Map", meta = (DisplayName = "版本"))
+	int32 Revision = 0;
+};
+
 UCLASS()
 class BLUEPRINTEXTENSIONSRUNTIME_API UMapExtensionsLibrary : public UBlueprintFunctionLibrary
 {
@@ -222,6 +245,62 @@ static bool GenericMap_GetKey(const void* TargetMap, const FMapProperty* MapProp
 
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 	
+#pragma region IndexView
+	/**
+	 * Builds the table translating logical indices into the map's internal sparse indices.
+	 * 获取键, 获取值 and 按索引设置值 reuse the table for consecutive indices (forward or reverse for loops),
+	 * so a loop over a map with removed entries costs O(n) instead of O(n^2).
+	 * Index 0 and non-consecutive indices re-verify the table against the map's current layout.
+	 *
+	 * @param	TargetMap		The map to index.
+	 * @return	The view describing the table, compare it with Map_IsIndexViewValid after modifying the map.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta=(DisplayName = "创建Map索引视图", CompactNodeTitle = "INDEX VIEW", MapParam = "TargetMap"), Category = "XTools|Blueprint Extensions|Map")
+	static FXToolsMapIndexView Map_MakeIndexView(const TMap<int32, int32>& TargetMap);
+
+	DECLARE_FUNCTION(execMap_MakeIndexView);
+
+	static FXToolsMapIndexView GenericMap_MakeIndexView(const void* TargetMap, const FMapProperty* MapProperty);
+
+	/**
+	 * Checks whether the index view still describes the map, i.e. no entries were added or removed since it was made.
+	 *
+	 * @param	TargetMap		The map the view was made from.
+	 * @param	IndexView		The view returned by Map_MakeIndexView.
+	 * @return	True if logical indices still map to the same entries.
+	 */
+	UFUNCTION(BlueprintPure, CustomThunk, meta=(DisplayName = "Map索引视图是否有效", MapParam = "TargetMap"), Category = "XTools|Blueprint Extensions|Map")
+	static bool Map_IsIndexViewValid(const TMap<int32, int32>& TargetMap, const FXToolsMapIndexView& IndexView);
+
+	DECLARE_FUNCTION(execMap_IsIndexViewValid);
+
+	static bool GenericMap_IsIndexViewValid(const void* TargetMap, const FMapProperty* MapProperty, const FXToolsMapIndexView& IndexView);
+#pragma endregion
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+	
+#pragma region CacheValueLookups
+	/**
+	 * Hashes every value of the map so that 包含值, 根据值获取键 and 根据值移除条目 only compare entries
+	 * whose value hash matches instead of scanning the whole map.
+	 * The cache lives until the end of the current frame, or until entries are added or removed.
+	 * Lookups fall back to scanning when the cached bucket is empty or holds changed values, but a value
+	 * changed by nodes outside this library into one that is already cached can still be missed,
+	 * so call it again after changing values that way.
+	 *
+	 * @param	TargetMap		The map to cache.
+	 * @return	False if the value type cannot be hashed; lookups keep scanning in that case.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, meta=(DisplayName = "缓存Map值查找", CompactNodeTitle = "CACHE VALUES", MapParam = "TargetMap"), Category = "XTools|Blueprint Extensions|Map")
+	static bool Map_CacheValueLookups(const TMap<int32, int32>& TargetMap);
+
+	DECLARE_FUNCTION(execMap_CacheValueLookups);
+
+	static bool GenericMap_CacheValueLookups(const void* TargetMap, const FMapProperty* MapProperty);
+#pragma endregion
+
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+	
 #pragma region RandomMapItem
 	/**
 	 * Returns a random entry from the target map.
@@ -4,6 +4,50 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "SplineExtensionsLibrary.generated.h"
 
+class USplineComponent;
+
+/**
+ * 样条快照
+ * 捕获时按样条距离等间距采样一次，保存世界空间位置与单位切线方向的紧凑数组。
+ * 之后的查询只读这两组数组，不访问样条组件，可以在任意线程并发调用；
+ * 采样点之间线性插值，精度由采样间距决定。
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTEXTENSIONSRUNTIME_API FXToolsSplineSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "XTools|Blueprint Extensions|Spline", meta = (DisplayName = "样条长度"))
+	double Length = 0.0;
+
+	/** 实际采样间距，捕获时会微调使最后一个采样点正好落在终点 */
+	UPROPERTY(BlueprintReadOnly, Category = "XTools|Blueprint Extensions|Spline", meta = (DisplayName = "采样间距"))
+	double SampleSpacing = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "XTools|Blueprint Extensions|Spline", meta = (DisplayName = "闭环"))
+	bool bClosedLoop = false;
+
+	/** 世界空间采样位置，第i个采样点位于样条距离 i * SampleSpacing */
+	TArray<FVector> Locations;
+
+	/** 世界空间单位切线方向，与Locations一一对应 */
+	TArray<FVector> Directions;
+
+	bool IsValid() const { return Locations.Num() >= 2 && SampleSpacing > 0.0; }
+
+	FVector GetLocationAtDistance(double Distance) const;
+	FVector GetDirectionAtDistance(double Distance) const;
+
+	/** 批量查询，输出数组长度需与Distances一致 */
+	void GetLocationsAtDistances(TConstArrayView<double> Distances, TArrayView<FVector> OutLocations, TArrayView<FVector> OutDirections) const;
+
+	/** 采样折线上距离世界位置最近的点对应的样条距离 */
+	double FindDistanceClosestToLocation(const FVector& WorldLocation) const;
+
+	/** 批量查询，输出数组长度需与WorldLocations一致 */
+	void FindDistancesClosestToLocations(TConstArrayView<FVector> WorldLocations, TArrayView<double> OutDistances) const;
+};
+
 
 UCLASS()
 class BLUEPRINTEXTENSIONSRUNTIME_API USplineExtensionsLibrary : public UBlueprintFunctionLibrary
@@ -27,4 +71,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "XTools|Blueprint Extensions|Spline", meta = (DisplayName = "简化样条", CompactNodeTitle = "SimplifySpline"))
 	static void SimplifySpline(USplineComponent* SplineComponent, const TArray<FVector>& SplinePath);
 
+	UFUNCTION(BlueprintCallable, Category = "XTools|Blueprint Extensions|Spline", meta = (DisplayName = "捕获样条快照", CompactNodeTitle = "CaptureSnapshot", Keywords = "Spline Snapshot Sample Arc Length 样条 快照 采样", ToolTip = "按样条距离等间距采样一次，生成世界空间的位置与方向表。\n之后的批量查询不再访问样条组件，样条修改后需要重新捕获。"))
+	static FXToolsSplineSnapshot CaptureSplineSnapshot(
+		UPARAM(DisplayName = "样条组件") USplineComponent* SplineComponent,
+		UPARAM(DisplayName = "采样间距") double SampleSpacing = 50.0);
+
+	UFUNCTION(BlueprintPure, Category = "XTools|Blueprint Extensions|Spline", meta = (DisplayName = "样条快照批量取点", Keywords = "Spline Snapshot Location Direction Distance Batch 样条 快照 批量 位置 方向", ToolTip = "按样条距离批量查询快照上的位置与方向。闭环样条的距离会回绕，开放样条限制在0到长度之间。"))
+	static void GetSplineSnapshotLocationsAtDistances(
+		UPARAM(DisplayName = "样条快照") const FXToolsSplineSnapshot& Snapshot,
+		UPARAM(DisplayName = "样条距离") const TArray<double>& Distances,
+		UPARAM(DisplayName = "位置") TArray<FVector>& OutLocations,
+		UPARAM(DisplayName = "方向") TArray<FVector>& OutDirections);
+
+	UFUNCTION(BlueprintPure, Category = "XTools|Blueprint Extensions|Spline", meta = (DisplayName = "样条快照批量最近距离", Keywords = "Spline Snapshot Closest Distance Batch 样条 快照 批量 最近点 距离", ToolTip = "批量查询世界位置在快照上最近点的样条距离。"))
+	static void FindSplineSnapshotDistancesClosestToLocations(
+		UPARAM(DisplayName = "样条快照") const FXToolsSplineSnapshot& Snapshot,
+		UPARAM(DisplayName = "世界位置") const TArray<FVector>& WorldLocations,
+		UPARAM(DisplayName = "样条距离") TArray<double>& OutDistances);
+
 };
\ No newline at end of file
@@ -47,6 +47,12 @@ struct BLUEPRINTEXTENSIONSRUNTIME_API FXToolsSplineFollowState
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "XTools|样条线|移动", meta = (DisplayName = "上次是否反向"))
 	bool bLastReverse = false;
 
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "XTools|样条线|移动", meta = (DisplayName = "已有输入键缓存"))
+	bool bHasInputKeyCache = false;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "XTools|样条线|移动", meta = (DisplayName = "上次最近输入键", ToolTip = "下次查找最近点时优先搜索其附近。\n切换样条后请重置状态。"))
+	float LastClosestInputKey = 0.0f;
+
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "XTools|样条线|移动", meta = (DisplayName = "已有运行方向"))
 	bool bHasRuntimeReverse = false;
 
@@ -163,6 +169,39 @@ public:
 		UPARAM(DisplayName = "缩放范围半宽") double SplineScaleRangeHalfWidth = 0.0,
 		UPARAM(DisplayName = "限制到XY平面", meta = (Tooltip = "忽略高度差，适合地面角色。")) bool bConstrainToXY = true);
 
+	/**
+	 * 查找距离世界位置最近的样条输入键。
+	 * 每条样条缓存一份采样包围盒层次，样条修改后自动重建。
+	 * 结果为近似值，最近点与引擎同名查询的结果相差不超过样条与采样折线（每段8个采样）最大偏差的约两倍。
+	 *
+	 * @param SplineComponent 要查询的样条组件。
+	 * @param WorldLocation 查询的世界位置。
+	 * @param OutDistance 输出最近点的样条距离。
+	 * @param LastInputKey 上次查询结果，传入后优先在其附近搜索以加快查询，结果不变；小于0表示没有。
+	 * @return 最近点的样条输入键。
+	 */
+	UFUNCTION(BlueprintCallable, Category = "XTools|样条线|移动",
+		meta = (DisplayName = "查找样条最近输入键", Keywords = "样条 最近点 输入键 距离 加速 缓存 Spline Closest Input Key",
+			ToolTip = "查找距离世界位置最近的样条输入键，结果为近似值：最近点可能比引擎同名查询的结果稍远，差距不超过样条与其采样折线最大偏差的约两倍。\n传入上次结果可先搜索附近区段以加快逐帧跟随，结果与不传入时相同。",
+			AdvancedDisplay = "LastInputKey"))
+	static float FindSplineInputKeyClosestToLocation(
+		UPARAM(DisplayName = "样条组件", meta = (Tooltip = "要查询的样条。")) USplineComponent* SplineComponent,
+		UPARAM(DisplayName = "世界位置", meta = (Tooltip = "查询的世界位置。")) const FVector& WorldLocation,
+		UPARAM(DisplayName = "样条距离", meta = (Tooltip = "输出最近点的样条距离。")) double& OutDistance,
+		UPARAM(DisplayName = "上次输入键", meta = (Tooltip = "上次查询结果；小于0表示没有。")) float LastInputKey = -1.0f);
+
+	/**
+	 * 丢弃样条的最近点缓存。
+	 * 控制点数量、闭环或长度变化时会自动重建，仅在同一帧内修改控制点后需要调用。
+	 *
+	 * @param SplineComponent 要丢弃缓存的样条组件。
+	 */
+	UFUNCTION(BlueprintCallable, Category = "XTools|样条线|移动",
+		meta = (DisplayName = "刷新样条最近点缓存", Keywords = "样条 最近点 缓存 刷新 Spline Closest Cache Invalidate",
+			ToolTip = "丢弃样条的最近点缓存。\n同一帧内修改控制点后需要立即查询时调用。"))
+	static void InvalidateSplineClosestPointCache(
+		UPARAM(DisplayName = "样条组件", meta = (Tooltip = "要刷新缓存的样条。")) USplineComponent* SplineComponent);
+
 	/**
 	 * 计算样条前视目标，不主动移动。
 	 *
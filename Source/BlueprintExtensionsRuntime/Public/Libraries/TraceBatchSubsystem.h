@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Libraries/TraceExtensionsLibrary.h"
+
+#include "TraceBatchSubsystem.generated.h"
+
+class AActor;
+struct FTraceDatum;
+struct FTraceHandle;
+
+/**
+ * 追踪批次句柄
+ * 由追踪批次子系统分配，取出结果或释放后槽位被复用，旧句柄随即失效
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTEXTENSIONSRUNTIME_API FXToolsTraceBatchHandle
+{
+	GENERATED_BODY()
+
+	int32 Index = INDEX_NONE;
+	int32 Serial = 0;
+
+	bool IsSet() const { return Index != INDEX_NONE; }
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(
+	FXToolsTraceBatchCompletedSignature,
+	FXToolsTraceBatchHandle, Handle);
+
+/**
+ * 追踪批次子系统
+ * 每个世界一个，把一组线性/球形追踪请求一次提交给世界的异步追踪，取代逐条调用同步追踪节点。
+ *
+ * - 请求的通道与对象类型在创建请求时已解析，提交时不做字符串查找
+ * - 追踪在物理工作线程上执行，结果在下一帧回到游戏线程，按请求顺序存放为紧凑数组
+ * - 批次全部完成时广播完成事件，取出结果后句柄失效
+ */
+UCLASS()
+class BLUEPRINTEXTENSIONSRUNTIME_API UTraceBatchSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	static UTraceBatchSubsystem* Get(const UObject* WorldContextObject);
+
+	UFUNCTION(BlueprintCallable, Category = "XTools|Blueprint Extensions|Trace",
+		meta = (DisplayName = "提交追踪批次",
+			Keywords = "Trace Batch Async Line Sphere 追踪 批量 异步",
+			ToolTip = "异步执行一组追踪请求，结果在下一帧可用。未解析出通道或对象类型的请求不执行，结果为未命中。",
+			AutoCreateRefTerm = "ActorsToIgnore"))
+	FXToolsTraceBatchHandle SubmitTraceBatch(
+		UPARAM(DisplayName = "追踪请求") const TArray<FXToolsTraceRequest>& Requests,
+		UPARAM(DisplayName = "忽略的Actor") const TArray<AActor*>& ActorsToIgnore);
+
+	UFUNCTION(BlueprintPure, Category = "XTools|Blueprint Extensions|Trace",
+		meta = (DisplayName = "追踪批次是否完成"))
+	bool IsTraceBatchComplete(UPARAM(DisplayName = "句柄") FXToolsTraceBatchHandle Handle) const;
+
+	UFUNCTION(BlueprintCallable, Category = "XTools|Blueprint Extensions|Trace",
+		meta = (DisplayName = "取出追踪批次结果",
+			ToolTip = "批次完成后取出结果并释放句柄，结果与请求一一对应。未完成或句柄无效时返回假。"))
+	bool TakeTraceBatchResults(
+		UPARAM(DisplayName = "句柄") FXToolsTraceBatchHandle Handle,
+		UPARAM(DisplayName = "结果") TArray<FXToolsTraceResult>& OutResults);
+
+	UFUNCTION(BlueprintCallable, Category = "XTools|Blueprint Extensions|Trace",
+		meta = (DisplayName = "释放追踪批次",
+			ToolTip = "丢弃批次及其结果，未完成的追踪返回后被忽略。句柄失效时返回假。"))
+	bool ReleaseTraceBatch(UPARAM(DisplayName = "句柄") FXToolsTraceBatchHandle Handle);
+
+	/** 进行中与已完成未取出的批次数量 */
+	int32 GetNumTraceBatches() const { return Batches.Num() - FreeSlots.Num(); }
+
+	/** 批次中所有追踪都返回后广播；回调中可以取出结果或提交新批次 */
+	UPROPERTY(BlueprintAssignable, Category = "XTools|Blueprint Extensions|Trace",
+		meta = (DisplayName = "追踪批次完成"))
+	FXToolsTraceBatchCompletedSignature OnTraceBatchCompleted;
+
+private:
+	struct FTraceBatch
+	{
+		int32 Serial = 0;
+		bool bInUse = false;
+		int32 NumPending = 0;
+		TArray<FXToolsTraceResult> Results;
+	};
+
+	/** 句柄对应的批次，句柄失效时返回nullptr */
+	FTraceBatch* FindBatch(FXToolsTraceBatchHandle Handle);
+	const FTraceBatch* FindBatch(FXToolsTraceBatchHandle Handle) const;
+
+	void HandleTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceData, int32 SlotIndex, int32 Serial);
+	void BroadcastBatchCompleted(FXToolsTraceBatchHandle Handle);
+
+	TArray<FTraceBatch> Batches;
+	TArray<int32> FreeSlots;
+};
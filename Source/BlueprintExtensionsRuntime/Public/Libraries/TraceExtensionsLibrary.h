@@ -6,6 +6,8 @@
 
 #include "TraceExtensionsLibrary.generated.h"
 
+class AActor;
+class UPrimitiveComponent;
 
 UENUM(BlueprintType)
 enum class EDebugTraceType : uint8
@@ -16,6 +18,80 @@ enum class EDebugTraceType : uint8
 	Persistent UMETA(DisplayName = "永久显示")
 };
 
+/**
+ * 预解析的追踪查询类型
+ * 由解析追踪通道/解析追踪对象类型节点生成，热点蓝图保存后反复使用，追踪时不再按名称查找
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTEXTENSIONSRUNTIME_API FXToolsTraceQueryType
+{
+	GENERATED_BODY()
+
+	/** 通道追踪使用的碰撞通道，ECC_MAX表示未解析 */
+	UPROPERTY()
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_MAX;
+
+	/** 对象追踪的对象类型位掩码，非0时按对象类型追踪 */
+	UPROPERTY()
+	int32 ObjectTypesMask = 0;
+
+	bool IsValid() const { return ObjectTypesMask != 0 || TraceChannel != ECC_MAX; }
+};
+
+/**
+ * 批量追踪请求
+ * 由创建追踪请求节点生成，通道与对象类型在创建时已解析，提交时不再按名称查找
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTEXTENSIONSRUNTIME_API FXToolsTraceRequest
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "起点"))
+	FVector Start = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "终点"))
+	FVector End = FVector::ZeroVector;
+
+	/** 大于0时为球形追踪，否则为线性追踪 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "半径", ClampMin = "0.0"))
+	float Radius = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "复杂碰撞"))
+	bool bTraceComplex = false;
+
+	UPROPERTY()
+	FXToolsTraceQueryType QueryType;
+};
+
+/**
+ * 批量追踪结果
+ * 只保留常用的命中信息，与请求一一对应
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTEXTENSIONSRUNTIME_API FXToolsTraceResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "是否命中"))
+	bool bHit = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "命中点"))
+	FVector ImpactPoint = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "命中法线"))
+	FVector ImpactNormal = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "距离"))
+	float Distance = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "命中Actor"))
+	TWeakObjectPtr<AActor> HitActor;
+
+	UPROPERTY(BlueprintReadOnly, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "命中组件"))
+	TWeakObjectPtr<UPrimitiveComponent> HitComponent;
+};
+
 UCLASS()
 class BLUEPRINTEXTENSIONSRUNTIME_API UTraceExtensionsLibrary : public UBlueprintFunctionLibrary
 {
@@ -165,11 +241,93 @@ public:
 #pragma endregion
 
 //————————————————————————————————————————————————————————————————————————————————————————————————————
-	
+
+#pragma region ResolvedTrace
+
+	UFUNCTION(BlueprintPure, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "解析追踪通道", ToolTip = "把通道名称解析为查询类型。结果可以保存下来反复用于追踪，省去每次追踪的名称查找"))
+	static FXToolsTraceQueryType ResolveTraceChannel(
+		UPARAM(DisplayName = "通道名称", meta = (GetOptions = GetTraceTypeQueryNames)) FName ChannelName,
+		UPARAM(DisplayName = "成功") bool& bSuccess
+	);
+
+	UFUNCTION(BlueprintPure, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "解析追踪对象类型", ToolTip = "把一组对象类型名称解析为查询类型，任一名称无效则解析失败"))
+	static FXToolsTraceQueryType ResolveTraceObjectTypes(
+		UPARAM(DisplayName = "对象类型名称") const TArray<FName>& ObjectTypeNames,
+		UPARAM(DisplayName = "成功") bool& bSuccess
+	);
+
+	UFUNCTION(BlueprintCallable, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "线性追踪(查询类型)", CompactNodeTitle = "TraceLineQuery", ToolTip = "从起点到终点发射一条射线，使用预解析的查询类型检测碰撞", AdvancedDisplay = "TraceColor, TraceHitColor, DrawTime", WorldContext = "WorldContextObject", AutoCreateRefTerm = "ActorsToIgnore"))
+	static void TraceLineByQueryType(
+		UObject* WorldContextObject,
+		UPARAM(DisplayName = "起点") FVector Start,
+		UPARAM(DisplayName = "终点") FVector End,
+		UPARAM(DisplayName = "查询类型") const FXToolsTraceQueryType& QueryType,
+		UPARAM(DisplayName = "复杂碰撞") bool bTraceComplex,
+		UPARAM(DisplayName = "忽略的Actor") const TArray<AActor*>& ActorsToIgnore,
+		UPARAM(DisplayName = "调试绘制") EDebugTraceType DrawDebugType,
+		UPARAM(DisplayName = "是否命中") bool& Block,
+		UPARAM(DisplayName = "命中点") FVector& ImpactPoint,
+		UPARAM(DisplayName = "命中结果") FHitResult& OutHit,
+		UPARAM(DisplayName = "射线颜色") FLinearColor TraceColor = FLinearColor::Green,
+		UPARAM(DisplayName = "命中颜色") FLinearColor TraceHitColor = FLinearColor::Red,
+		UPARAM(DisplayName = "绘制时长") float DrawTime = 0.0f
+	);
+
+	UFUNCTION(BlueprintCallable, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "球形追踪(查询类型)", CompactNodeTitle = "TraceSphereQuery", ToolTip = "从起点到终点扫描球形区域，使用预解析的查询类型检测碰撞", AdvancedDisplay = "TraceColor, TraceHitColor, DrawTime", WorldContext = "WorldContextObject", AutoCreateRefTerm = "ActorsToIgnore"))
+	static void TraceSphereByQueryType(
+		UObject* WorldContextObject,
+		UPARAM(DisplayName = "起点") FVector Start,
+		UPARAM(DisplayName = "终点") FVector End,
+		UPARAM(DisplayName = "半径") float Radius,
+		UPARAM(DisplayName = "查询类型") const FXToolsTraceQueryType& QueryType,
+		UPARAM(DisplayName = "复杂碰撞") bool bTraceComplex,
+		UPARAM(DisplayName = "忽略的Actor") const TArray<AActor*>& ActorsToIgnore,
+		UPARAM(DisplayName = "调试绘制") EDebugTraceType DrawDebugType,
+		UPARAM(DisplayName = "是否命中") bool& Block,
+		UPARAM(DisplayName = "命中点") FVector& ImpactPoint,
+		UPARAM(DisplayName = "命中结果") FHitResult& OutHit,
+		UPARAM(DisplayName = "球体颜色") FLinearColor TraceColor = FLinearColor::Green,
+		UPARAM(DisplayName = "命中颜色") FLinearColor TraceHitColor = FLinearColor::Red,
+		UPARAM(DisplayName = "绘制时长") float DrawTime = 0.0f
+	);
+
+#pragma endregion
+
+//————————————————————————————————————————————————————————————————————————————————————————————————————
+
+#pragma region BatchTrace
+
+	UFUNCTION(BlueprintPure, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "创建追踪请求(通道)", ToolTip = "描述一次按通道类型的线性或球形追踪，交给追踪批次子系统异步执行。通道在此解析，半径大于0时为球形追踪"))
+	static FXToolsTraceRequest MakeTraceRequestChannel(
+		UPARAM(DisplayName = "起点") FVector Start,
+		UPARAM(DisplayName = "终点") FVector End,
+		UPARAM(DisplayName = "通道类型") FString TraceChannelType,
+		UPARAM(DisplayName = "复杂碰撞") bool bTraceComplex,
+		UPARAM(DisplayName = "半径") float Radius = 0.0f
+	);
+
+	UFUNCTION(BlueprintPure, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "创建追踪请求(对象)", ToolTip = "描述一次按对象类型的线性或球形追踪，交给追踪批次子系统异步执行。对象类型在此解析，半径大于0时为球形追踪"))
+	static FXToolsTraceRequest MakeTraceRequestObject(
+		UPARAM(DisplayName = "起点") FVector Start,
+		UPARAM(DisplayName = "终点") FVector End,
+		UPARAM(DisplayName = "对象类型") const TArray<FString>& TraceObjectType,
+		UPARAM(DisplayName = "复杂碰撞") bool bTraceComplex,
+		UPARAM(DisplayName = "半径") float Radius = 0.0f
+	);
+
+	UFUNCTION(BlueprintPure, Category = "XTools|Blueprint Extensions|Trace", meta = (DisplayName = "创建追踪请求(查询类型)", ToolTip = "使用预解析的查询类型描述一次线性或球形追踪，交给追踪批次子系统异步执行。半径大于0时为球形追踪"))
+	static FXToolsTraceRequest MakeTraceRequest(
+		UPARAM(DisplayName = "起点") FVector Start,
+		UPARAM(DisplayName = "终点") FVector End,
+		UPARAM(DisplayName = "查询类型") const FXToolsTraceQueryType& QueryType,
+		UPARAM(DisplayName = "复杂碰撞") bool bTraceComplex,
+		UPARAM(DisplayName = "半径") float Radius = 0.0f
+	);
+
+#pragma endregion
+
 //————————————————————————————————————————————————————————————————————————————————————————————————————
 	
-private:
-	static TMap<FString, ETraceTypeQuery> CachedTraceChannels;
-	static TMap<FString, EObjectTypeQuery> CachedObjectTypes;
+//————————————————————————————————————————————————————————————————————————————————————————————————————
 };
 
@@ -1,141 +1,220 @@
 // FormationAlgorithms.cpp - 基础阵型分配算法
-// 包含基础分配算法、成本矩阵计算、匈牙利算法等核心算法实现
+// 包含基础分配算法、成本矩阵计算与分配求解等核心算法实现
 
 #include "FormationManagerComponent.h"
+#include "FormationAssignmentSolver.h"
 #include "FormationMathUtils.h"
+#include "FormationPathConflicts.h"
+#include "FormationTemplateCache.h"
 #include "FormationLog.h"
 #include "Kismet/KismetMathLibrary.h"
 
-// 性能优化配置常量（本地定义）
-namespace FormationPerformanceConfig
+namespace FormationAlgorithms_Private
 {
-    constexpr int32 HungarianAlgorithmThreshold = 50;
+    /** 模板预排序的极坐标中心与位置都与本次求解一致时才可使用 */
+    bool IsSpatialOrderHintUsable(const FSpatialOrderHint& Hint, const TArray<FVector>& Positions, const FVector& Center, int32 NumPositions, float CenterTolerance)
+    {
+        if (Hint.SortedData.Num() != NumPositions || Positions.Num() != NumPositions || !Hint.Center.Equals(Center, CenterTolerance))
+        {
+            return false;
+        }
+
+        for (const FSpatialSortData& Data : Hint.SortedData)
+        {
+            if (!Positions.IsValidIndex(Data.OriginalIndex) || Positions[Data.OriginalIndex] != Data.Position)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
 }
 
 // ========== 成本矩阵计算 ==========
 
-TArray<TArray<float>> UFormationManagerComponent::CalculateRelativePositionCostMatrix(
+FFormationCostMatrix UFormationManagerComponent::CalculateRelativePositionCostMatrix(
     const TArray<FVector>& FromPositions,
     const TArray<FVector>& ToPositions)
 {
-    int32 NumPositions = FromPositions.Num();
-    TArray<TArray<float>> CostMatrix;
-
-    // 性能优化：预分配内存避免重复分配
-    CostMatrix.Reserve(NumPositions);
-    CostMatrix.SetNum(NumPositions);
-
-    // 性能优化：使用 UE 内置的高效包围盒计算
-    FBox FromAABB = FBox(FromPositions);
-    FBox ToAABB = FBox(ToPositions);
-
-    // 性能优化：缓存中心点和尺寸，避免重复计算
-    const FVector FromCenter = FromAABB.GetCenter();
-    const FVector ToCenter = ToAABB.GetCenter();
-    const FVector FromSize = FromAABB.GetSize();
-    const FVector ToSize = ToAABB.GetSize();
-
-    // 性能优化：预计算归一化因子，避免重复除法运算
-    const FVector FromSizeInv = FVector(
-        FromSize.X > 1.0f ? 1.0f / FromSize.X : 0.0f,
-        FromSize.Y > 1.0f ? 1.0f / FromSize.Y : 0.0f,
-        FromSize.Z > 1.0f ? 1.0f / FromSize.Z : 0.0f
-    );
-    const FVector ToSizeInv = FVector(
-        ToSize.X > 1.0f ? 1.0f / ToSize.X : 0.0f,
-        ToSize.Y > 1.0f ? 1.0f / ToSize.Y : 0.0f,
-        ToSize.Z > 1.0f ? 1.0f / ToSize.Z : 0.0f
-    );
-
-    // 性能优化：预计算归一化位置数组，避免重复计算
-    TArray<FVector> FromNormalized;
-    TArray<FVector> ToNormalized;
-    FromNormalized.Reserve(NumPositions);
-    ToNormalized.Reserve(NumPositions);
+    // 两个阵型各自按包围盒归一化，相对位置成本为主、绝对距离为辅
+    FFormationCostMatrix CostMatrix;
+    FFormationCostMatrix::BuildRelativePosition(FromPositions, ToPositions, CostMatrix);
+    return CostMatrix;
+}
 
-    for (int32 i = 0; i < NumPositions; i++)
-    {
-        FVector FromRelative = FromPositions[i] - FromCenter;
-        FromNormalized.Add(FromRelative * FromSizeInv);
+FFormationCostMatrix UFormationManagerComponent::CalculateAbsoluteDistanceCostMatrix(
+    const TArray<FVector>& FromPositions,
+    const TArray<FVector>& ToPositions)
+{
+    FFormationCostMatrix CostMatrix;
+    FFormationCostMatrix::BuildAbsoluteDistance(FromPositions, ToPositions, CostMatrix);
+    return CostMatrix;
+}
+
+// ========== 分配问题求解器 ==========
 
-        FVector ToRelative = ToPositions[i] - ToCenter;
-        ToNormalized.Add(ToRelative * ToSizeInv);
+TArray<int32> UFormationManagerComponent::SolveAssignmentProblem(const FFormationCostMatrix& CostMatrix)
+{
+    if (CostMatrix.GetNumRows() == 0)
+    {
+        return TArray<int32>();
     }
 
-    // 性能优化：使用常量权重，避免重复乘法
-    constexpr float RelativeWeight = 0.7f;
-    constexpr float AbsoluteWeight = 0.3f;
-    constexpr float RelativeScale = 1000.0f;
+    const int32 NumPositions = CostMatrix.GetNumRows();
+    if (!CostMatrix.IsSquare())
+    {
+        UE_LOG(LogFormationSystem, Warning, TEXT("分配求解要求方阵，当前矩阵不是 %d×%d，退回按索引映射"), NumPositions, NumPositions);
+        TArray<int32> Identity;
+        Identity.SetNumUninitialized(NumPositions);
+        for (int32 Index = 0; Index < NumPositions; Index++)
+        {
+            Identity[Index] = Index;
+        }
+        return Identity;
+    }
 
-    // 计算相对位置成本矩阵
-    for (int32 i = 0; i < NumPositions; i++)
+    if (AssignmentSolver == EFormationAssignmentSolver::Greedy)
     {
-        CostMatrix[i].Reserve(NumPositions);
-        CostMatrix[i].SetNum(NumPositions);
+        UE_LOG(LogFormationSystem, VeryVerbose, TEXT("使用贪心算法求解 %d×%d 分配问题"), NumPositions, NumPositions);
+        return SolveAssignmentGreedy(CostMatrix);
+    }
 
-        for (int32 j = 0; j < NumPositions; j++)
+    TArray<int32> Assignment;
+    if (AssignmentSolver == EFormationAssignmentSolver::Auction)
+    {
+        UE_LOG(LogFormationSystem, VeryVerbose, TEXT("使用拍卖算法求解 %d×%d 分配问题"), NumPositions, NumPositions);
+        if (FFormationAssignmentSolver::SolveAuction(CostMatrix.GetValues(), NumPositions, Assignment, &AssignmentWarmStart, 1.0e-5f, SolveCancelFlag))
         {
-            // 性能优化：使用预计算的归一化位置
-            float RelativePositionCost = FVector::Dist(FromNormalized[i], ToNormalized[j]) * RelativeScale;
-            float AbsoluteDistanceCost = FVector::Dist(FromPositions[i], ToPositions[j]);
-
-            // 组合成本：相对位置权重更高
-            CostMatrix[i][j] = RelativePositionCost * RelativeWeight + AbsoluteDistanceCost * AbsoluteWeight;
+            return Assignment;
         }
     }
 
-    return CostMatrix;
+    UE_LOG(LogFormationSystem, VeryVerbose, TEXT("使用最短增广路算法求解 %d×%d 分配问题"), NumPositions, NumPositions);
+    if (!IsSolveCancelled() && FFormationAssignmentSolver::SolveLAPJV(CostMatrix.GetValues(), NumPositions, Assignment, &AssignmentWarmStart, SolveCancelFlag))
+    {
+        return Assignment;
+    }
+
+    // 已被新命令取消的后台求解不再回退，结果会被丢弃
+    if (IsSolveCancelled())
+    {
+        return TArray<int32>();
+    }
+
+    // 输入含非有限值等异常情况下退回贪心分配，保证总能得到完整分配
+    AssignmentWarmStart.Reset();
+    return SolveAssignmentGreedy(CostMatrix);
 }
 
-TArray<TArray<float>> UFormationManagerComponent::CalculateAbsoluteDistanceCostMatrix(
-    const TArray<FVector>& FromPositions,
-    const TArray<FVector>& ToPositions)
+TArray<int32> UFormationManagerComponent::SolveAssignmentProblem(const TArray<TArray<float>>& CostMatrix)
 {
-    int32 NumPositions = FromPositions.Num();
-    TArray<TArray<float>> CostMatrix;
+    FFormationCostMatrix FlatMatrix;
+    if (!FlatMatrix.SetFromNested(CostMatrix))
+    {
+        UE_LOG(LogFormationSystem, Warning, TEXT("分配求解要求各行长度一致，退回按索引映射"));
+        TArray<int32> Identity;
+        Identity.SetNumUninitialized(CostMatrix.Num());
+        for (int32 Index = 0; Index < CostMatrix.Num(); Index++)
+        {
+            Identity[Index] = Index;
+        }
+        return Identity;
+    }
+    return SolveAssignmentProblem(FlatMatrix);
+}
 
-    // 性能优化：预分配内存
-    CostMatrix.Reserve(NumPositions);
-    CostMatrix.SetNum(NumPositions);
+TArray<int32> UFormationManagerComponent::SolveSparseAssignment(
+    const TArray<FVector>& FromPositions,
+    const TArray<FVector>& ToPositions,
+    bool bUseRelativePosition)
+{
+    UE_LOG(LogFormationSystem, VeryVerbose, TEXT("使用 %d 近邻稀疏矩阵求解 %d 单位分配问题"), SparseNeighborCount, FromPositions.Num());
+    FFormationSparseCostMatrix::BuildNearest(FromPositions, ToPositions, SparseNeighborCount, bUseRelativePosition, SparseCostMatrix);
 
-    // 性能优化：使用更高效的距离计算
-    for (int32 i = 0; i < NumPositions; i++)
+    TArray<int32> Assignment;
+    if (FFormationAssignmentSolver::SolveSparse(SparseCostMatrix, Assignment, &AssignmentWarmStart, SolveCancelFlag))
     {
-        CostMatrix[i].Reserve(NumPositions);
-        CostMatrix[i].SetNum(NumPositions);
+        return Assignment;
+    }
 
-        const FVector& FromPos = FromPositions[i];
-        for (int32 j = 0; j < NumPositions; j++)
-        {
-            // 使用引用避免数组访问开销
-            CostMatrix[i][j] = FVector::Dist(FromPos, ToPositions[j]);
-        }
+    // 已被新命令取消的后台求解不再回退，结果会被丢弃
+    if (IsSolveCancelled())
+    {
+        return TArray<int32>();
     }
 
-    return CostMatrix;
+    // 稀疏矩阵无效时退回稠密求解
+    AssignmentWarmStart.Reset();
+    return SolveAssignmentProblem(CreateCostMatrix(FromPositions, ToPositions, bUseRelativePosition));
 }
 
-// ========== 分配问题求解器 ==========
-
-TArray<int32> UFormationManagerComponent::SolveAssignmentProblem(const TArray<TArray<float>>& CostMatrix)
+TArray<int32> UFormationManagerComponent::CalculateProvisionalAssignment(
+    const TArray<FVector>& FromPositions,
+    const TArray<FVector>& ToPositions)
 {
-    if (CostMatrix.Num() == 0)
+    // 临时分配只求尽快可用，近邻数量取较小值
+    constexpr int32 ProvisionalNeighborCount = 8;
+
+    const int32 NumUnits = FromPositions.Num();
+    if (NumUnits == 0 || NumUnits != ToPositions.Num())
     {
         return TArray<int32>();
     }
 
-    // 性能优化：使用配置常量进行算法选择
-    // 对于小规模问题使用匈牙利算法（精确），大规模问题使用贪心算法（快速）
-    if (CostMatrix.Num() <= FormationPerformanceConfig::HungarianAlgorithmThreshold)
+    FFormationSparseCostMatrix Sparse;
+    FFormationSparseCostMatrix::BuildNearest(FromPositions, ToPositions, ProvisionalNeighborCount, true, Sparse);
+
+    TArray<int32> EdgeRows;
+    TArray<int32> EdgeOrder;
+    EdgeRows.SetNumUninitialized(Sparse.GetNumEdges());
+    EdgeOrder.SetNumUninitialized(Sparse.GetNumEdges());
+    for (int32 Row = 0; Row < NumUnits; ++Row)
     {
-        UE_LOG(LogFormationSystem, VeryVerbose, TEXT("使用匈牙利算法求解 %d×%d 分配问题"), CostMatrix.Num(), CostMatrix.Num());
-        return SolveAssignmentHungarian(CostMatrix);
+        for (int32 Edge = Sparse.RowOffsets[Row]; Edge < Sparse.RowOffsets[Row + 1]; ++Edge)
+        {
+            EdgeRows[Edge] = Row;
+            EdgeOrder[Edge] = Edge;
+        }
     }
-    else
+
+    // 按成本从小到大接受两端都未匹配的边
+    EdgeOrder.Sort([&Sparse](int32 A, int32 B)
     {
-        UE_LOG(LogFormationSystem, VeryVerbose, TEXT("使用贪心算法求解 %d×%d 分配问题"), CostMatrix.Num(), CostMatrix.Num());
-        return SolveAssignmentGreedy(CostMatrix);
+        return Sparse.Costs[A] < Sparse.Costs[B] || (Sparse.Costs[A] == Sparse.Costs[B] && A < B);
+    });
+
+    TArray<int32> Assignment;
+    TArray<bool> ColumnUsed;
+    Assignment.Init(INDEX_NONE, NumUnits);
+    ColumnUsed.Init(false, NumUnits);
+    for (const int32 Edge : EdgeOrder)
+    {
+        const int32 Row = EdgeRows[Edge];
+        const int32 Column = Sparse.Columns[Edge];
+        if (Assignment[Row] == INDEX_NONE && !ColumnUsed[Column])
+        {
+            Assignment[Row] = Column;
+            ColumnUsed[Column] = true;
+        }
     }
+
+    // 近邻都被占用的少量单位依次填入剩余目标
+    int32 NextColumn = 0;
+    for (int32 Row = 0; Row < NumUnits; ++Row)
+    {
+        if (Assignment[Row] != INDEX_NONE)
+        {
+            continue;
+        }
+        while (ColumnUsed[NextColumn])
+        {
+            ++NextColumn;
+        }
+        Assignment[Row] = NextColumn;
+        ColumnUsed[NextColumn] = true;
+    }
+
+    return Assignment;
 }
 
 TArray<int32> UFormationManagerComponent::SolveAssignmentGreedy(const TArray<TArray<float>>& CostMatrix)
@@ -180,102 +259,41 @@ TArray<int32> UFormationManagerComponent::SolveAssignmentGreedy(const TArray<TAr
     return Assignment;
 }
 
-TArray<int32> UFormationManagerComponent::SolveAssignmentHungarian(const TArray<TArray<float>>& CostMatrix)
+TArray<int32> UFormationManagerComponent::SolveAssignmentGreedy(const FFormationCostMatrix& CostMatrix)
 {
-    const int32 n = CostMatrix.Num();
+    const int32 NumPositions = CostMatrix.GetNumRows();
+    const int32 NumTargets = CostMatrix.GetNumColumns();
     TArray<int32> Assignment;
-    Assignment.Init(INDEX_NONE, n);
-
-    if (n == 0)
-    {
-        return Assignment;
-    }
-
-    for (const TArray<float>& Row : CostMatrix)
-    {
-        if (Row.Num() != n)
-        {
-            UE_LOG(LogFormationSystem, Warning, TEXT("匈牙利算法要求方阵，当前矩阵不是 %d×%d"), n, n);
-            return Assignment;
-        }
-    }
+    Assignment.SetNum(NumPositions);
 
-    // 1-based Kuhn-Munkres potentials implementation, O(n^3).
-    TArray<double> RowPotential;
-    TArray<double> ColumnPotential;
-    TArray<int32> MatchedRow;
-    TArray<int32> PreviousColumn;
-    RowPotential.Init(0.0, n + 1);
-    ColumnPotential.Init(0.0, n + 1);
-    MatchedRow.Init(0, n + 1);
-    PreviousColumn.Init(0, n + 1);
+    TArray<bool> UsedTargets;
+    UsedTargets.Init(false, NumTargets);
 
-    for (int32 Row = 1; Row <= n; ++Row)
+    // 贪心分配：每次为当前单位选择最优的未使用目标
+    for (int32 i = 0; i < NumPositions; i++)
     {
-        MatchedRow[0] = Row;
-        int32 CurrentColumn = 0;
-        TArray<double> MinReducedCost;
-        TArray<bool> UsedColumns;
-        MinReducedCost.Init(TNumericLimits<double>::Max(), n + 1);
-        UsedColumns.Init(false, n + 1);
+        const float* RowCosts = CostMatrix.GetRow(i);
+        int32 BestTarget = -1;
+        float BestCost = FLT_MAX;
 
-        do
+        for (int32 j = 0; j < NumTargets; j++)
         {
-            UsedColumns[CurrentColumn] = true;
-            const int32 CurrentRow = MatchedRow[CurrentColumn];
-            double Delta = TNumericLimits<double>::Max();
-            int32 NextColumn = 0;
-
-            for (int32 Column = 1; Column <= n; ++Column)
+            if (!UsedTargets[j] && RowCosts[j] < BestCost)
             {
-                if (UsedColumns[Column])
-                {
-                    continue;
-                }
-
-                const double ReducedCost = static_cast<double>(CostMatrix[CurrentRow - 1][Column - 1])
-                    - RowPotential[CurrentRow] - ColumnPotential[Column];
-                if (ReducedCost < MinReducedCost[Column])
-                {
-                    MinReducedCost[Column] = ReducedCost;
-                    PreviousColumn[Column] = CurrentColumn;
-                }
-                if (MinReducedCost[Column] < Delta)
-                {
-                    Delta = MinReducedCost[Column];
-                    NextColumn = Column;
-                }
-            }
-
-            for (int32 Column = 0; Column <= n; ++Column)
-            {
-                if (UsedColumns[Column])
-                {
-                    RowPotential[MatchedRow[Column]] += Delta;
-                    ColumnPotential[Column] -= Delta;
-                }
-                else
-                {
-                    MinReducedCost[Column] -= Delta;
-                }
+                BestCost = RowCosts[j];
+                BestTarget = j;
             }
-
-            CurrentColumn = NextColumn;
         }
-        while (MatchedRow[CurrentColumn] != 0);
 
-        do
+        if (BestTarget != -1)
         {
-            const int32 Previous = PreviousColumn[CurrentColumn];
-            MatchedRow[CurrentColumn] = MatchedRow[Previous];
-            CurrentColumn = Previous;
+            Assignment[i] = BestTarget;
+            UsedTargets[BestTarget] = true;
+        }
+        else
+        {
+            Assignment[i] = i; // 后备方案
         }
-        while (CurrentColumn != 0);
-    }
-
-    for (int32 Column = 1; Column <= n; ++Column)
-    {
-        Assignment[MatchedRow[Column] - 1] = Column - 1;
     }
 
     return Assignment;
@@ -285,7 +303,8 @@ TArray<int32> UFormationManagerComponent::SolveAssignmentHungarian(const TArray<
 
 TArray<int32> UFormationManagerComponent::CalculateDirectRelativePositionMatching(
     const TArray<FVector>& FromPositions,
-    const TArray<FVector>& ToPositions)
+    const TArray<FVector>& ToPositions,
+    const FSpatialOrderHints* OrderHints)
 {
     int32 NumPositions = FromPositions.Num();
     TArray<int32> Assignment;
@@ -311,7 +330,7 @@ TArray<int32> UFormationManagerComponent::CalculateDirectRelativePositionMatchin
     }
 
     // 使用空间排序进行直接映射
-    Assignment = CalculateSpatialOrderMapping(FromPositions, ToPositions);
+    Assignment = CalculateSpatialOrderMapping(FromPositions, ToPositions, OrderHints);
 
     return Assignment;
 }
@@ -321,17 +340,17 @@ TArray<int32> UFormationManagerComponent::CalculateRTSFlockMovementAssignment(
     const TArray<FVector>& ToPositions)
 {
     // RTS群集移动使用基于距离的简单分配，但考虑群集行为
-    TArray<TArray<float>> CostMatrix = CalculateAbsoluteDistanceCostMatrix(FromPositions, ToPositions);
+    FFormationCostMatrix CostMatrix = CalculateAbsoluteDistanceCostMatrix(FromPositions, ToPositions);
     
     // 添加群集行为修正
     for (int32 i = 0; i < FromPositions.Num(); i++)
     {
+        float* RowCosts = CostMatrix.GetRow(i);
         for (int32 j = 0; j < ToPositions.Num(); j++)
         {
             // 计算群集密度影响
             float FlockingBonus = CalculateFlockingBonus(i, j, FromPositions, ToPositions);
-            CostMatrix[i][j] -= FlockingBonus;
-            CostMatrix[i][j] = FMath::Max(1.0f, CostMatrix[i][j]);
+            RowCosts[j] = FMath::Max(1.0f, RowCosts[j] - FlockingBonus);
         }
     }
 
@@ -340,10 +359,11 @@ TArray<int32> UFormationManagerComponent::CalculateRTSFlockMovementAssignment(
 
 TArray<int32> UFormationManagerComponent::CalculatePathAwareAssignment(
     const TArray<FVector>& FromPositions,
-    const TArray<FVector>& ToPositions)
+    const TArray<FVector>& ToPositions,
+    const FSpatialOrderHints* OrderHints)
 {
     // 首先使用基础算法获得初始分配
-    TArray<int32> InitialAssignment = CalculateDirectRelativePositionMatching(FromPositions, ToPositions);
+    TArray<int32> InitialAssignment = CalculateDirectRelativePositionMatching(FromPositions, ToPositions, OrderHints);
     
     // 检测路径冲突
     FPathConflictInfo ConflictInfo = DetectPathConflicts(InitialAssignment, FromPositions, ToPositions);
@@ -355,7 +375,7 @@ TArray<int32> UFormationManagerComponent::CalculatePathAwareAssignment(
     }
 
     // 有冲突时，使用修正的成本矩阵
-    TArray<TArray<float>> CostMatrix = CalculateRelativePositionCostMatrix(FromPositions, ToPositions);
+    FFormationCostMatrix CostMatrix = CalculateRelativePositionCostMatrix(FromPositions, ToPositions);
     
     // 为可能产生冲突的路径增加惩罚
     for (const FIntPoint& ConflictPair : ConflictInfo.ConflictPairs)
@@ -369,23 +389,28 @@ TArray<int32> UFormationManagerComponent::CalculatePathAwareAssignment(
             int32 Target2 = InitialAssignment[Unit2];
             
             // 惩罚当前发生冲突的两条路径，让重新求解选择非冲突目标。
-            if (CostMatrix.IsValidIndex(Unit1) && CostMatrix[Unit1].IsValidIndex(Target1))
+            if (Unit1 < CostMatrix.GetNumRows() && Target1 >= 0 && Target1 < CostMatrix.GetNumColumns())
             {
-                CostMatrix[Unit1][Target1] += 1000.0f;
+                CostMatrix(Unit1, Target1) += 1000.0f;
             }
-            if (CostMatrix.IsValidIndex(Unit2) && CostMatrix[Unit2].IsValidIndex(Target2))
+            if (Unit2 < CostMatrix.GetNumRows() && Target2 >= 0 && Target2 < CostMatrix.GetNumColumns())
             {
-                CostMatrix[Unit2][Target2] += 1000.0f;
+                CostMatrix(Unit2, Target2) += 1000.0f;
             }
         }
     }
 
-    return SolveAssignmentProblem(CostMatrix);
+    TArray<int32> Assignment = SolveAssignmentProblem(CostMatrix);
+
+    // 惩罚后重新求解仍可能留下少量冲突，再用局部交换消除
+    UntanglePathConflicts(Assignment, FromPositions, ToPositions);
+    return Assignment;
 }
 
 TArray<int32> UFormationManagerComponent::CalculateSpatialOrderMapping(
     const TArray<FVector>& FromPositions, 
-    const TArray<FVector>& ToPositions)
+    const TArray<FVector>& ToPositions,
+    const FSpatialOrderHints* OrderHints)
 {
     int32 NumPositions = FMath::Min(FromPositions.Num(), ToPositions.Num());
     TArray<int32> Assignment;
@@ -448,8 +473,8 @@ TArray<int32> UFormationManagerComponent::CalculateSpatialOrderMapping(
         UE_LOG(LogFormationSystem, VeryVerbose, TEXT("空间排序算法: 相同阵型平移，使用精确相对位置匹配"));
 
         // 计算AABB相对位置成本矩阵
-        TArray<TArray<float>> RelativeCostMatrix;
-        RelativeCostMatrix.SetNum(NumPositions);
+        FFormationCostMatrix RelativeCostMatrix;
+        RelativeCostMatrix.Init(NumPositions, NumPositions);
 
         // 避免除零错误
         FVector FromSizeForRelative = FromAABB.GetSize();
@@ -463,8 +488,6 @@ TArray<int32> UFormationManagerComponent::CalculateSpatialOrderMapping(
 
         for (int32 i = 0; i < NumPositions; i++)
         {
-            RelativeCostMatrix[i].SetNum(NumPositions);
-
             // 计算起始位置的相对坐标（归一化到0-1范围）
             FVector RelativeFrom = (FromPositions[i] - FromAABB.Min) / FromSizeForRelative;
 
@@ -475,7 +498,7 @@ TArray<int32> UFormationManagerComponent::CalculateSpatialOrderMapping(
 
                 // 相对位置距离成本（这是关键！）
                 float RelativeCost = FVector::Dist(RelativeFrom, RelativeTo);
-                RelativeCostMatrix[i][j] = RelativeCost;
+                RelativeCostMatrix(i, j) = RelativeCost;
                 
                 // 调试输出第一个单位的相对位置成本
                 if (i == 0 && j < 5)
@@ -485,7 +508,7 @@ TArray<int32> UFormationManagerComponent::CalculateSpatialOrderMapping(
             }
         }
 
-        // 使用匈牙利算法求解最优相对位置匹配
+        // 使用配置的求解器求解最优相对位置匹配
         Assignment = SolveAssignmentProblem(RelativeCostMatrix);
 
         // 输出前5个单位的分配结果和移动距离
@@ -509,34 +532,55 @@ TArray<int32> UFormationManagerComponent::CalculateSpatialOrderMapping(
         UE_LOG(LogFormationSystem, VeryVerbose, TEXT("空间排序算法: 不同阵型变换，使用空间排序匹配"));
     }
 
+    // 阵型由模板生成时使用模板预排序的结果，中心或位置对不上（如阵型带俯仰、被修改过）时逐点计算
+    const float CenterTolerance = 1.0e-3f * FMath::Max(1.0f, static_cast<float>(FMath::Max(FromSize.Size(), ToSize.Size())));
+    const bool bFromPresorted = OrderHints
+        && FormationAlgorithms_Private::IsSpatialOrderHintUsable(OrderHints->From, FromPositions, FromCenter, NumPositions, CenterTolerance);
+    const bool bToPresorted = OrderHints
+        && FormationAlgorithms_Private::IsSpatialOrderHintUsable(OrderHints->To, ToPositions, ToCenter, NumPositions, CenterTolerance);
+
     // 计算起始位置的空间排序数据
     TArray<FSpatialSortData> FromSortData;
-    FromSortData.SetNum(NumPositions);
-    for (int32 i = 0; i < NumPositions; i++)
+    if (bFromPresorted)
     {
-        FVector RelativePos = FromPositions[i] - FromCenter;
-        float Angle = FMath::Atan2(RelativePos.Y, RelativePos.X);
-        float Distance = RelativePos.Size();
-        
-        FromSortData[i].OriginalIndex = i;
-        FromSortData[i].Angle = Angle;
-        FromSortData[i].DistanceToCenter = Distance;
-        FromSortData[i].Position = FromPositions[i];
+        FromSortData = OrderHints->From.SortedData;
+    }
+    else
+    {
+        FromSortData.SetNum(NumPositions);
+        for (int32 i = 0; i < NumPositions; i++)
+        {
+            FVector RelativePos = FromPositions[i] - FromCenter;
+            float Angle = FMath::Atan2(RelativePos.Y, RelativePos.X);
+            float Distance = RelativePos.Size();
+
+            FromSortData[i].OriginalIndex = i;
+            FromSortData[i].Angle = Angle;
+            FromSortData[i].DistanceToCenter = Distance;
+            FromSortData[i].Position = FromPositions[i];
+        }
     }
     
     // 计算目标位置的空间排序数据
     TArray<FSpatialSortData> ToSortData;
-    ToSortData.SetNum(NumPositions);
-    for (int32 i = 0; i < NumPositions; i++)
+    if (bToPresorted)
     {
-        FVector RelativePos = ToPositions[i] - ToCenter;
-        float Angle = FMath::Atan2(RelativePos.Y, RelativePos.X);
-        float Distance = RelativePos.Size();
-        
-        ToSortData[i].OriginalIndex = i;
-        ToSortData[i].Angle = Angle;
-        ToSortData[i].DistanceToCenter = Distance;
-        ToSortData[i].Position = ToPositions[i];
+        ToSortData = OrderHints->To.SortedData;
+    }
+    else
+    {
+        ToSortData.SetNum(NumPositions);
+        for (int32 i = 0; i < NumPositions; i++)
+        {
+            FVector RelativePos = ToPositions[i] - ToCenter;
+            float Angle = FMath::Atan2(RelativePos.Y, RelativePos.X);
+            float Distance = RelativePos.Size();
+
+            ToSortData[i].OriginalIndex = i;
+            ToSortData[i].Angle = Angle;
+            ToSortData[i].DistanceToCenter = Distance;
+            ToSortData[i].Position = ToPositions[i];
+        }
     }
     
     // 检测是否为螺旋阵型
@@ -571,8 +615,15 @@ TArray<int32> UFormationManagerComponent::CalculateSpatialOrderMapping(
             return A.DistanceToCenter < B.DistanceToCenter;
         };
 
-        FromSortData.Sort(SortPredicate);
-        ToSortData.Sort(SortPredicate);
+        // 模板预排序的数据已是这一顺序
+        if (!bFromPresorted)
+        {
+            FromSortData.Sort(SortPredicate);
+        }
+        if (!bToPresorted)
+        {
+            ToSortData.Sort(SortPredicate);
+        }
     }
     
     // 根据排序结果建立映射
@@ -595,6 +646,87 @@ TArray<int32> UFormationManagerComponent::CalculateDistancePriorityAssignment(
 
 // ========== 辅助函数 ==========
 
+bool UFormationManagerComponent::BuildSpatialOrderHint(const FFormationData& Formation, const TArray<FVector>& WorldPositions, FSpatialOrderHint& OutHint)
+{
+    OutHint.SortedData.Reset();
+
+    const FFormationTemplate* Template = Formation.Template.Get();
+    const int32 NumSlots = Formation.Positions.Num();
+    if (!Template || Template->Offsets.Num() != NumSlots || Template->PolarOrder.Num() != NumSlots
+        || WorldPositions.Num() != NumSlots || Formation.TemplateScale <= 0.0f)
+    {
+        return false;
+    }
+
+    // 俯仰与翻滚会改变水平投影，极角不再只是整体平移
+    if (!FMath::IsNearlyZero(Formation.Rotation.Pitch) || !FMath::IsNearlyZero(Formation.Rotation.Roll))
+    {
+        return false;
+    }
+
+    // Positions 是可编辑的蓝图属性，逐个核对仍是模板的缩放与旋转
+    const float Scale = Formation.TemplateScale;
+    float Sin, Cos;
+    FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(Formation.TemplateYaw));
+    const float PositionTolerance = UE_KINDA_SMALL_NUMBER * FMath::Max(1.0f, Scale);
+    auto TemplateToFormation = [Scale, Sin, Cos](const FVector& Offset)
+    {
+        return FVector((Offset.X * Cos - Offset.Y * Sin) * Scale, (Offset.X * Sin + Offset.Y * Cos) * Scale, Offset.Z * Scale);
+    };
+    for (int32 Index = 0; Index < NumSlots; ++Index)
+    {
+        if (!Formation.Positions[Index].Equals(TemplateToFormation(Template->Offsets[Index]), PositionTolerance))
+        {
+            return false;
+        }
+    }
+
+    const FTransform Transform(Formation.Rotation, Formation.CenterLocation, FVector::OneVector);
+    OutHint.Center = Transform.TransformPosition(TemplateToFormation(Template->PolarCenter));
+
+    const float YawDegrees = Formation.Rotation.Yaw + Formation.TemplateYaw;
+    const float YawRadians = FMath::DegreesToRadians(YawDegrees);
+    TArray<int32> Order;
+    Template->GetRotatedPolarOrder(YawDegrees, Order);
+
+    OutHint.SortedData.SetNumUninitialized(NumSlots);
+    for (int32 Index = 0; Index < NumSlots; ++Index)
+    {
+        const int32 Slot = Order[Index];
+        FSpatialSortData& Data = OutHint.SortedData[Index];
+        Data.OriginalIndex = Slot;
+        Data.Angle = FMath::UnwindRadians(Template->PolarAngles[Slot] + YawRadians);
+        Data.DistanceToCenter = Template->PolarDistances[Slot] * Scale;
+        Data.Position = WorldPositions[Slot];
+    }
+    return true;
+}
+
+void UFormationManagerComponent::PrepareSpatialOrderHints(
+    const FFormationData& FromFormation,
+    const TArray<FVector>& FromWorldPositions,
+    const FFormationData& ToFormation,
+    const TArray<FVector>& ToWorldPositions,
+    EFormationTransitionMode Mode)
+{
+    SpatialOrderHints.From.SortedData.Reset();
+    SpatialOrderHints.To.SortedData.Reset();
+
+    switch (Mode)
+    {
+    case EFormationTransitionMode::DirectRelativePositionMatching:
+    case EFormationTransitionMode::PathAwareAssignment:
+    case EFormationTransitionMode::SpatialOrderMapping:
+    case EFormationTransitionMode::DistancePriorityAssignment:
+        BuildSpatialOrderHint(FromFormation, FromWorldPositions, SpatialOrderHints.From);
+        BuildSpatialOrderHint(ToFormation, ToWorldPositions, SpatialOrderHints.To);
+        break;
+
+    default:
+        break;
+    }
+}
+
 bool UFormationManagerComponent::DetectSpiralFormation(const TArray<FSpatialSortData>& SortedData)
 {
     if (SortedData.Num() < 10)
@@ -683,50 +815,26 @@ FPathConflictInfo UFormationManagerComponent::DetectPathConflicts(
     Result.ConflictSeverity = 0.0f;
     Result.TotalConflicts = 0;
     
-    int32 NumPositions = FMath::Min(Assignment.Num(), FMath::Min(FromPositions.Num(), ToPositions.Num()));
-    
-    // 检查每对路径是否相交
-    for (int32 i = 0; i < NumPositions; i++)
+    // 时间分片 + 扫描排除粗检测，只对可能接近的单位对做最近距离检测
+    FFormationPathConflictDetector Detector(PathConflictThreshold);
+    Detector.Build(FromPositions, ToPositions, Assignment);
+    Detector.FindAllConflicts(Result.ConflictPairs);
+
+    for (const FIntPoint& ConflictPair : Result.ConflictPairs)
     {
-        if (!Assignment.IsValidIndex(i) || !ToPositions.IsValidIndex(Assignment[i]))
-        {
-            continue;
-        }
-        
-        FVector Start1 = FromPositions[i];
-        FVector End1 = ToPositions[Assignment[i]];
-        
-        for (int32 j = i + 1; j < NumPositions; j++)
-        {
-            if (!Assignment.IsValidIndex(j) || !ToPositions.IsValidIndex(Assignment[j]))
-            {
-                continue;
-            }
-            
-            FVector Start2 = FromPositions[j];
-            FVector End2 = ToPositions[Assignment[j]];
-            
-            // 使用工具类检测路径是否相交
-            if (FFormationMathUtils::DoPathsIntersect(Start1, End1, Start2, End2))
-            {
-                Result.bHasConflict = true;
-                Result.ConflictPairs.Add(FIntPoint(i, j));
-                Result.TotalConflicts++;
-                
-                // 计算冲突严重程度（基于路径长度和交叉角度）
-                FVector Dir1 = (End1 - Start1).GetSafeNormal();
-                FVector Dir2 = (End2 - Start2).GetSafeNormal();
-                // 将点积钳位到有效范围，避免浮点精度问题导致 Acos 返回 NaN
-                float DotProduct = FMath::Clamp(FVector::DotProduct(Dir1, Dir2), -1.0f, 1.0f);
-                float CrossAngle = FMath::Acos(DotProduct);
-                
-                // 垂直交叉的冲突最严重
-                float AngleSeverity = FMath::Sin(CrossAngle);
-                Result.ConflictSeverity += AngleSeverity;
-            }
-        }
+        const FVector Dir1 = (Detector.GetEnd(ConflictPair.X) - Detector.GetStart(ConflictPair.X)).GetSafeNormal();
+        const FVector Dir2 = (Detector.GetEnd(ConflictPair.Y) - Detector.GetStart(ConflictPair.Y)).GetSafeNormal();
+
+        // 计算冲突严重程度（基于交叉角度），垂直交叉的冲突最严重
+        // 将点积钳位到有效范围，避免浮点精度问题导致 Acos 返回 NaN
+        float DotProduct = FMath::Clamp(FVector::DotProduct(Dir1, Dir2), -1.0f, 1.0f);
+        float CrossAngle = FMath::Acos(DotProduct);
+        Result.ConflictSeverity += FMath::Sin(CrossAngle);
     }
-    
+
+    Result.TotalConflicts = Result.ConflictPairs.Num();
+    Result.bHasConflict = Result.TotalConflicts > 0;
+
     // 归一化冲突严重程度
     if (Result.TotalConflicts > 0)
     {
@@ -735,3 +843,67 @@ FPathConflictInfo UFormationManagerComponent::DetectPathConflicts(
     
     return Result;
 }
+
+int32 UFormationManagerComponent::UntanglePathConflicts(
+    TArray<int32>& Assignment,
+    const TArray<FVector>& FromPositions,
+    const TArray<FVector>& ToPositions)
+{
+    // 交换后两个单位的总路程最多允许增加的比例
+    constexpr float MaxPathLengthIncrease = 0.2f;
+
+    FFormationPathConflictDetector Detector(PathConflictThreshold);
+    Detector.Build(FromPositions, ToPositions, Assignment);
+
+    TArray<FIntPoint> Conflicts;
+    Detector.FindAllConflicts(Conflicts);
+
+    TArray<int32> ConflictingUnits;
+    auto CountConflicts = [&](int32 Unit)
+    {
+        Detector.FindConflictsForUnit(Unit, ConflictingUnits);
+        return ConflictingUnits.Num();
+    };
+
+    int32 NumSwaps = 0;
+    for (const FIntPoint& ConflictPair : Conflicts)
+    {
+        const int32 UnitA = ConflictPair.X;
+        const int32 UnitB = ConflictPair.Y;
+
+        // 之前的交换可能已经消除了这一对冲突
+        if (!Detector.HasConflict(UnitA, UnitB))
+        {
+            continue;
+        }
+
+        const FVector TargetA = Detector.GetEnd(UnitA);
+        const FVector TargetB = Detector.GetEnd(UnitB);
+        const double LengthBefore = FVector::Dist(Detector.GetStart(UnitA), TargetA) + FVector::Dist(Detector.GetStart(UnitB), TargetB);
+        const double LengthAfter = FVector::Dist(Detector.GetStart(UnitA), TargetB) + FVector::Dist(Detector.GetStart(UnitB), TargetA);
+        if (LengthAfter > LengthBefore * (1.0f + MaxPathLengthIncrease))
+        {
+            continue;
+        }
+
+        // 只复查被交换的两个单位
+        const int32 ConflictsBefore = CountConflicts(UnitA) + CountConflicts(UnitB);
+        Detector.SetUnitTarget(UnitA, TargetB);
+        Detector.SetUnitTarget(UnitB, TargetA);
+        const int32 ConflictsAfter = CountConflicts(UnitA) + CountConflicts(UnitB);
+
+        if (ConflictsAfter < ConflictsBefore)
+        {
+            Swap(Assignment[UnitA], Assignment[UnitB]);
+            ++NumSwaps;
+        }
+        else
+        {
+            Detector.SetUnitTarget(UnitA, TargetA);
+            Detector.SetUnitTarget(UnitB, TargetB);
+        }
+    }
+
+    UE_LOG(LogFormationSystem, VeryVerbose, TEXT("路径冲突消解: %d 对冲突，保留 %d 次交换"), Conflicts.Num(), NumSwaps);
+    return NumSwaps;
+}
@@ -0,0 +1,835 @@
+// FormationAssignmentSolver.cpp - 线性分配问题求解器
+// LAPJV（Jonker-Volgenant 最短增广路）、稀疏最短增广路与 ε-缩放拍卖算法实现
+
+#include "FormationAssignmentSolver.h"
+#include "FormationCostMatrix.h"
+#include "FormationLog.h"
+#include "Async/ParallelFor.h"
+#include "XToolsVersionCompat.h"
+
+namespace FormationAssignmentSolver_Private
+{
+    /** 增广行约简的轮数，JV 原论文建议两轮 */
+    constexpr int32 AugmentingRowReductionPasses = 2;
+
+    /** 单轮增广行约简中每行允许的平均重分配次数，防止浮点近似相等时反复争夺同一列 */
+    constexpr int32 RowReductionStepsPerRow = 8;
+
+    /** ε-缩放拍卖每个阶段 ε 的缩小倍数 */
+    constexpr double AuctionEpsilonScaling = 6.0;
+
+    /** 拍卖算法的出价总数上限（相对于 N），超出后认为价格战无法收敛 */
+    constexpr int64 AuctionMaxBidsPerRow = 2000;
+
+    /** 本轮出价行数达到该值时才并行计算出价 */
+    constexpr int32 AuctionParallelThreshold = 256;
+
+    FORCEINLINE bool IsCancelled(const std::atomic<bool>* CancelFlag)
+    {
+        return CancelFlag && CancelFlag->load(std::memory_order_relaxed);
+    }
+
+    FORCEINLINE double GetCost(const float* Costs, int32 Size, int32 Row, int32 Column)
+    {
+        return static_cast<double>(Costs[static_cast<int64>(Row) * Size + Column]);
+    }
+
+    /** 在一行中查找约简成本 c(i,j) - v(j) 的最小值与次小值 */
+    FORCEINLINE void FindTwoSmallestReduced(
+        const float* Costs, int32 Size, const double* Prices, int32 Row,
+        double& OutMin, int32& OutMinColumn, double& OutSecondMin, int32& OutSecondColumn)
+    {
+        const float* RowCosts = Costs + static_cast<int64>(Row) * Size;
+        OutMin = static_cast<double>(RowCosts[0]) - Prices[0];
+        OutMinColumn = 0;
+        OutSecondMin = TNumericLimits<double>::Max();
+        OutSecondColumn = INDEX_NONE;
+
+        for (int32 Column = 1; Column < Size; ++Column)
+        {
+            const double Reduced = static_cast<double>(RowCosts[Column]) - Prices[Column];
+            if (Reduced < OutSecondMin)
+            {
+                if (Reduced >= OutMin)
+                {
+                    OutSecondMin = Reduced;
+                    OutSecondColumn = Column;
+                }
+                else
+                {
+                    OutSecondMin = OutMin;
+                    OutSecondColumn = OutMinColumn;
+                    OutMin = Reduced;
+                    OutMinColumn = Column;
+                }
+            }
+        }
+    }
+}
+
+bool FFormationAssignmentSolver::ValidateInput(TConstArrayView<float> Costs, int32 Size)
+{
+    if (Size < 0 || static_cast<int64>(Costs.Num()) != static_cast<int64>(Size) * Size)
+    {
+        UE_LOG(LogFormationSystem, Warning, TEXT("分配求解器: 成本矩阵元素数量 %d 与阶数 %d 不匹配"), Costs.Num(), Size);
+        return false;
+    }
+
+    for (const float Cost : Costs)
+    {
+        if (!FMath::IsFinite(Cost))
+        {
+            UE_LOG(LogFormationSystem, Warning, TEXT("分配求解器: 成本矩阵包含非有限值"));
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FFormationAssignmentSolver::ValidateSparseInput(const FFormationSparseCostMatrix& Matrix)
+{
+    const int32 Size = Matrix.GetNumRows();
+    if (Matrix.RowOffsets.Num() == 0 || Matrix.RowOffsets[0] != 0
+        || Matrix.RowOffsets.Last() != Matrix.Columns.Num() || Matrix.Columns.Num() != Matrix.Costs.Num())
+    {
+        UE_LOG(LogFormationSystem, Warning, TEXT("分配求解器: 稀疏成本矩阵的行偏移与边数量不匹配"));
+        return false;
+    }
+
+    for (int32 Row = 0; Row < Size; ++Row)
+    {
+        if (Matrix.RowOffsets[Row] > Matrix.RowOffsets[Row + 1])
+        {
+            UE_LOG(LogFormationSystem, Warning, TEXT("分配求解器: 稀疏成本矩阵第 %d 行的偏移不匹配"), Row);
+            return false;
+        }
+    }
+
+    for (int32 Edge = 0; Edge < Matrix.Columns.Num(); ++Edge)
+    {
+        if (Matrix.Columns[Edge] < 0 || Matrix.Columns[Edge] >= Size || !FMath::IsFinite(Matrix.Costs[Edge]))
+        {
+            UE_LOG(LogFormationSystem, Warning, TEXT("分配求解器: 稀疏成本矩阵包含无效的边 %d"), Edge);
+            return false;
+        }
+    }
+    return true;
+}
+
+double FFormationAssignmentSolver::CalculateTotalCost(TConstArrayView<float> Costs, int32 Size, const TArray<int32>& Assignment)
+{
+    double Total = 0.0;
+    for (int32 Row = 0; Row < FMath::Min(Size, Assignment.Num()); ++Row)
+    {
+        const int32 Column = Assignment[Row];
+        if (Column >= 0 && Column < Size)
+        {
+            Total += Costs[static_cast<int64>(Row) * Size + Column];
+        }
+    }
+    return Total;
+}
+
+bool FFormationAssignmentSolver::SolveLAPJV(
+    TConstArrayView<float> Costs,
+    int32 Size,
+    TArray<int32>& OutAssignment,
+    FFormationAssignmentWarmStart* WarmStart,
+    const std::atomic<bool>* CancelFlag)
+{
+    using namespace FormationAssignmentSolver_Private;
+
+    OutAssignment.Reset();
+    if (!ValidateInput(Costs, Size) || IsCancelled(CancelFlag))
+    {
+        return false;
+    }
+    if (Size <= 1)
+    {
+        OutAssignment.Init(0, Size);
+        return true;
+    }
+
+    const float* C = Costs.GetData();
+    TArray<double> Prices;
+    TArray<int32> RowSolution;
+    TArray<int32> ColumnSolution;
+    TArray<int32> FreeRows;
+    RowSolution.Init(INDEX_NONE, Size);
+    ColumnSolution.Init(INDEX_NONE, Size);
+    FreeRows.Reserve(Size);
+
+    // 不变式：已匹配行所在列总是该行约简成本 c(i,j) - v(j) 的最小列
+    if (WarmStart && WarmStart->IsValidFor(Size))
+    {
+        // 热启动：沿用上一次的价格，优先保留上一次的分配
+        Prices = WarmStart->ColumnPrices;
+        const bool bHasPreviousAssignment = WarmStart->Assignment.Num() == Size;
+        for (int32 Row = 0; Row < Size; ++Row)
+        {
+            double MinReduced = TNumericLimits<double>::Max();
+            int32 MinColumn = 0;
+            for (int32 Column = 0; Column < Size; ++Column)
+            {
+                const double Reduced = GetCost(C, Size, Row, Column) - Prices[Column];
+                if (Reduced < MinReduced)
+                {
+                    MinReduced = Reduced;
+                    MinColumn = Column;
+                }
+            }
+
+            if (bHasPreviousAssignment)
+            {
+                const int32 PreviousColumn = WarmStart->Assignment[Row];
+                if (PreviousColumn >= 0 && PreviousColumn < Size
+                    && GetCost(C, Size, Row, PreviousColumn) - Prices[PreviousColumn] <= MinReduced)
+                {
+                    MinColumn = PreviousColumn;
+                }
+            }
+
+            if (ColumnSolution[MinColumn] == INDEX_NONE)
+            {
+                ColumnSolution[MinColumn] = Row;
+                RowSolution[Row] = MinColumn;
+            }
+            else
+            {
+                FreeRows.Add(Row);
+            }
+        }
+    }
+    else
+    {
+        // 列约简：v(j) = min_i c(i,j)，按行遍历保持连续访问
+        Prices.Init(TNumericLimits<double>::Max(), Size);
+        TArray<int32> MinRows;
+        MinRows.Init(0, Size);
+        for (int32 Row = 0; Row < Size; ++Row)
+        {
+            const float* RowCosts = C + static_cast<int64>(Row) * Size;
+            for (int32 Column = 0; Column < Size; ++Column)
+            {
+                if (RowCosts[Column] < Prices[Column])
+                {
+                    Prices[Column] = RowCosts[Column];
+                    MinRows[Column] = Row;
+                }
+            }
+        }
+
+        for (int32 Column = 0; Column < Size; ++Column)
+        {
+            const int32 Row = MinRows[Column];
+            if (RowSolution[Row] == INDEX_NONE)
+            {
+                RowSolution[Row] = Column;
+                ColumnSolution[Column] = Row;
+            }
+        }
+
+        for (int32 Row = 0; Row < Size; ++Row)
+        {
+            if (RowSolution[Row] == INDEX_NONE)
+            {
+                FreeRows.Add(Row);
+            }
+        }
+    }
+
+    // 增广行约简：空闲行抢占约简成本最小的列，并把该列价格降到与次小列持平
+    for (int32 Pass = 0; Pass < AugmentingRowReductionPasses && FreeRows.Num() > 0; ++Pass)
+    {
+        if (IsCancelled(CancelFlag))
+        {
+            return false;
+        }
+
+        const int32 PreviousNumFree = FreeRows.Num();
+        const int32 MaxSteps = Size * RowReductionStepsPerRow;
+        int32 NumFree = 0;
+        int32 Steps = 0;
+        int32 Cursor = 0;
+
+        while (Cursor < PreviousNumFree)
+        {
+            const int32 Row = FreeRows[Cursor++];
+
+            double MinReduced;
+            double SecondReduced;
+            int32 MinColumn;
+            int32 SecondColumn;
+            FindTwoSmallestReduced(C, Size, Prices.GetData(), Row, MinReduced, MinColumn, SecondReduced, SecondColumn);
+
+            int32 PreviousOwner = ColumnSolution[MinColumn];
+            const bool bStrictMin = MinReduced < SecondReduced;
+            if (bStrictMin)
+            {
+                Prices[MinColumn] -= SecondReduced - MinReduced;
+            }
+            else if (PreviousOwner != INDEX_NONE)
+            {
+                // 最小值并列时改抢次小列，避免无意义的来回争夺
+                MinColumn = SecondColumn;
+                PreviousOwner = ColumnSolution[SecondColumn];
+            }
+
+            if (PreviousOwner != INDEX_NONE)
+            {
+                RowSolution[PreviousOwner] = INDEX_NONE;
+            }
+            RowSolution[Row] = MinColumn;
+            ColumnSolution[MinColumn] = Row;
+
+            if (PreviousOwner != INDEX_NONE)
+            {
+                if (bStrictMin && ++Steps < MaxSteps)
+                {
+                    // 被挤出的行立即继续处理
+                    FreeRows[--Cursor] = PreviousOwner;
+                }
+                else
+                {
+                    FreeRows[NumFree++] = PreviousOwner;
+                }
+            }
+        }
+#if XTOOLS_ENGINE_5_8_OR_LATER
+        FreeRows.SetNum(NumFree, EAllowShrinking::No);
+#else
+        FreeRows.SetNum(NumFree, false);
+#endif
+    }
+
+    // 对剩余空闲行做 Dijkstra 最短增广路
+    TArray<double> Distances;
+    TArray<int32> Predecessors;
+    TArray<int32> Scanned;
+    TArray<int32> Unscanned;
+    Distances.SetNumUninitialized(Size);
+    Predecessors.SetNumUninitialized(Size);
+    Scanned.Reserve(Size);
+    Unscanned.Reserve(Size);
+
+    for (const int32 FreeRow : FreeRows)
+    {
+        if (IsCancelled(CancelFlag))
+        {
+            return false;
+        }
+
+        Scanned.Reset();
+        Unscanned.Reset();
+
+        double MinDistance = TNumericLimits<double>::Max();
+        int32 MinSlot = INDEX_NONE;
+        for (int32 Column = 0; Column < Size; ++Column)
+        {
+            Distances[Column] = GetCost(C, Size, FreeRow, Column) - Prices[Column];
+            Predecessors[Column] = FreeRow;
+            if (Distances[Column] < MinDistance)
+            {
+                MinDistance = Distances[Column];
+                MinSlot = Unscanned.Num();
+            }
+            Unscanned.Add(Column);
+        }
+
+        int32 Sink = INDEX_NONE;
+        while (Sink == INDEX_NONE)
+        {
+            const int32 Column = Unscanned[MinSlot];
+#if XTOOLS_ENGINE_5_8_OR_LATER
+            Unscanned.RemoveAtSwap(MinSlot, 1, EAllowShrinking::No);
+#else
+            Unscanned.RemoveAtSwap(MinSlot, 1, false);
+#endif
+            MinDistance = Distances[Column];
+
+            const int32 Row = ColumnSolution[Column];
+            if (Row == INDEX_NONE)
+            {
+                Sink = Column;
+                break;
+            }
+            Scanned.Add(Column);
+
+            // 经由该列的匹配行松弛其余列，同时找出下一个距离最小的列
+            const double Offset = GetCost(C, Size, Row, Column) - Prices[Column] - MinDistance;
+            const float* RowCosts = C + static_cast<int64>(Row) * Size;
+            double NextMin = TNumericLimits<double>::Max();
+            MinSlot = INDEX_NONE;
+            for (int32 Slot = 0; Slot < Unscanned.Num(); ++Slot)
+            {
+                const int32 Candidate = Unscanned[Slot];
+                const double Reduced = static_cast<double>(RowCosts[Candidate]) - Prices[Candidate] - Offset;
+                if (Reduced < Distances[Candidate])
+                {
+                    Distances[Candidate] = Reduced;
+                    Predecessors[Candidate] = Row;
+                }
+                if (Distances[Candidate] < NextMin)
+                {
+                    NextMin = Distances[Candidate];
+                    MinSlot = Slot;
+                }
+            }
+        }
+
+        // 更新已扫描列的价格，保持约简成本非负
+        for (const int32 Column : Scanned)
+        {
+            Prices[Column] += Distances[Column] - MinDistance;
+        }
+
+        // 沿前驱链翻转匹配
+        int32 Column = Sink;
+        int32 Row;
+        do
+        {
+            Row = Predecessors[Column];
+            ColumnSolution[Column] = Row;
+            Swap(Column, RowSolution[Row]);
+        }
+        while (Row != FreeRow);
+    }
+
+    OutAssignment = MoveTemp(RowSolution);
+    if (WarmStart)
+    {
+        WarmStart->ColumnPrices = MoveTemp(Prices);
+        WarmStart->Assignment = OutAssignment;
+    }
+    return true;
+}
+
+bool FFormationAssignmentSolver::SolveSparse(
+    const FFormationSparseCostMatrix& Matrix,
+    TArray<int32>& OutAssignment,
+    FFormationAssignmentWarmStart* WarmStart,
+    const std::atomic<bool>* CancelFlag)
+{
+    using FormationAssignmentSolver_Private::IsCancelled;
+
+    OutAssignment.Reset();
+    if (!ValidateSparseInput(Matrix) || IsCancelled(CancelFlag))
+    {
+        return false;
+    }
+
+    const int32 Size = Matrix.GetNumRows();
+    const int32* Offsets = Matrix.RowOffsets.GetData();
+    const int32* EdgeColumns = Matrix.Columns.GetData();
+    const float* EdgeCosts = Matrix.Costs.GetData();
+
+    TArray<double> Prices;
+    TArray<int32> RowSolution;
+    TArray<int32> ColumnSolution;
+    TArray<double> RowMatchedCost;
+    TArray<int32> FreeRows;
+    RowSolution.Init(INDEX_NONE, Size);
+    ColumnSolution.Init(INDEX_NONE, Size);
+    RowMatchedCost.SetNumUninitialized(Size);
+    FreeRows.Reserve(Size);
+
+    auto Assign = [&](int32 Row, int32 Column, double Cost)
+    {
+        RowSolution[Row] = Column;
+        ColumnSolution[Column] = Row;
+        RowMatchedCost[Row] = Cost;
+    };
+
+    // 与 LAPJV 相同的不变式：已匹配行所在列是该行所有边中约简成本最小的列
+    if (WarmStart && WarmStart->IsValidFor(Size))
+    {
+        Prices = WarmStart->ColumnPrices;
+        const bool bHasPreviousAssignment = WarmStart->Assignment.Num() == Size;
+        for (int32 Row = 0; Row < Size; ++Row)
+        {
+            double MinReduced = TNumericLimits<double>::Max();
+            int32 MinColumn = INDEX_NONE;
+            double MinCost = 0.0;
+            const int32 PreviousColumn = bHasPreviousAssignment ? WarmStart->Assignment[Row] : INDEX_NONE;
+            for (int32 Edge = Offsets[Row]; Edge < Offsets[Row + 1]; ++Edge)
+            {
+                const int32 Column = EdgeColumns[Edge];
+                const double Reduced = EdgeCosts[Edge] - Prices[Column];
+                if (Reduced < MinReduced || (Reduced == MinReduced && Column == PreviousColumn))
+                {
+                    MinReduced = Reduced;
+                    MinColumn = Column;
+                    MinCost = EdgeCosts[Edge];
+                }
+            }
+
+            if (MinColumn != INDEX_NONE && ColumnSolution[MinColumn] == INDEX_NONE)
+            {
+                Assign(Row, MinColumn, MinCost);
+            }
+            else
+            {
+                FreeRows.Add(Row);
+            }
+        }
+    }
+    else
+    {
+        // 列约简：v(j) 取所有指向该列的边中的最小成本
+        TArray<int32> MinEdges;
+        Prices.Init(TNumericLimits<double>::Max(), Size);
+        MinEdges.Init(INDEX_NONE, Size);
+        for (int32 Edge = 0; Edge < Matrix.Columns.Num(); ++Edge)
+        {
+            const int32 Column = EdgeColumns[Edge];
+            if (EdgeCosts[Edge] < Prices[Column])
+            {
+                Prices[Column] = EdgeCosts[Edge];
+                MinEdges[Column] = Edge;
+            }
+        }
+
+        // 没有任何边的列不可能被匹配
+        if (MinEdges.Contains(INDEX_NONE))
+        {
+            UE_LOG(LogFormationSystem, Warning, TEXT("分配求解器: 稀疏成本矩阵存在没有任何边的列，无法完美匹配"));
+            return false;
+        }
+
+        // 边号 -> 行号：Offsets 单调递增，按边号顺序扫描即可
+        TArray<int32> EdgeRows;
+        EdgeRows.SetNumUninitialized(Matrix.Columns.Num());
+        for (int32 Row = 0; Row < Size; ++Row)
+        {
+            for (int32 Edge = Offsets[Row]; Edge < Offsets[Row + 1]; ++Edge)
+            {
+                EdgeRows[Edge] = Row;
+            }
+        }
+
+        for (int32 Column = 0; Column < Size; ++Column)
+        {
+            const int32 Edge = MinEdges[Column];
+            const int32 Row = EdgeRows[Edge];
+            if (RowSolution[Row] == INDEX_NONE)
+            {
+                Assign(Row, Column, EdgeCosts[Edge]);
+            }
+        }
+
+        for (int32 Row = 0; Row < Size; ++Row)
+        {
+            if (RowSolution[Row] == INDEX_NONE)
+            {
+                FreeRows.Add(Row);
+            }
+        }
+    }
+
+    // 对空闲行做 Dijkstra 最短增广路，距离数组用代数标记代替每次重新初始化
+    typedef TPair<double, int32> FHeapEntry;
+    const auto CloserFirst = [](const FHeapEntry& A, const FHeapEntry& B) { return A.Key < B.Key; };
+
+    TArray<double> Distances;
+    TArray<int32> Predecessors;
+    TArray<float> PredecessorCosts;
+    TArray<uint32> VisitStamps;
+    TArray<uint32> ScanStamps;
+    TArray<int32> Scanned;
+    TArray<FHeapEntry> Heap;
+    Distances.SetNumUninitialized(Size);
+    Predecessors.SetNumUninitialized(Size);
+    PredecessorCosts.SetNumUninitialized(Size);
+    VisitStamps.Init(0, Size);
+    ScanStamps.Init(0, Size);
+    uint32 Stamp = 0;
+
+    for (const int32 FreeRow : FreeRows)
+    {
+        if (IsCancelled(CancelFlag))
+        {
+            return false;
+        }
+
+        ++Stamp;
+        Scanned.Reset();
+        Heap.Reset();
+
+        // 松弛 Row 的所有边，Offset 为 Row 在当前最短路树中的累计约简量
+        auto RelaxRow = [&](int32 Row, double Offset)
+        {
+            for (int32 Edge = Offsets[Row]; Edge < Offsets[Row + 1]; ++Edge)
+            {
+                const int32 Column = EdgeColumns[Edge];
+                if (ScanStamps[Column] == Stamp)
+                {
+                    continue;
+                }
+
+                const double Distance = EdgeCosts[Edge] - Prices[Column] - Offset;
+                if (VisitStamps[Column] != Stamp || Distance < Distances[Column])
+                {
+                    VisitStamps[Column] = Stamp;
+                    Distances[Column] = Distance;
+                    Predecessors[Column] = Row;
+                    PredecessorCosts[Column] = EdgeCosts[Edge];
+                    Heap.HeapPush(FHeapEntry(Distance, Column), CloserFirst);
+                }
+            }
+        };
+
+        RelaxRow(FreeRow, 0.0);
+
+        int32 Sink = INDEX_NONE;
+        double SinkDistance = 0.0;
+        while (Heap.Num() > 0)
+        {
+            FHeapEntry Entry;
+#if XTOOLS_ENGINE_5_8_OR_LATER
+            Heap.HeapPop(Entry, CloserFirst, EAllowShrinking::No);
+#else
+            Heap.HeapPop(Entry, CloserFirst, false);
+#endif
+            const int32 Column = Entry.Value;
+            if (ScanStamps[Column] == Stamp || Entry.Key > Distances[Column])
+            {
+                // 惰性删除：已扫描或已被更短距离取代的过期条目
+                continue;
+            }
+
+            const int32 Row = ColumnSolution[Column];
+            if (Row == INDEX_NONE)
+            {
+                Sink = Column;
+                SinkDistance = Entry.Key;
+                break;
+            }
+
+            ScanStamps[Column] = Stamp;
+            Scanned.Add(Column);
+            RelaxRow(Row, RowMatchedCost[Row] - Prices[Column] - Entry.Key);
+        }
+
+        if (Sink == INDEX_NONE)
+        {
+            UE_LOG(LogFormationSystem, Warning, TEXT("分配求解器: 稀疏成本矩阵不存在完美匹配 (行 %d)"), FreeRow);
+            return false;
+        }
+
+        // 更新已扫描列的价格，保持约简成本非负
+        for (const int32 Column : Scanned)
+        {
+            Prices[Column] += Distances[Column] - SinkDistance;
+        }
+
+        // 沿前驱链翻转匹配
+        int32 Column = Sink;
+        int32 Row;
+        do
+        {
+            Row = Predecessors[Column];
+            ColumnSolution[Column] = Row;
+            RowMatchedCost[Row] = PredecessorCosts[Column];
+            Swap(Column, RowSolution[Row]);
+        }
+        while (Row != FreeRow);
+    }
+
+    OutAssignment = MoveTemp(RowSolution);
+    if (WarmStart)
+    {
+        WarmStart->ColumnPrices = MoveTemp(Prices);
+        WarmStart->Assignment = OutAssignment;
+    }
+    return true;
+}
+
+bool FFormationAssignmentSolver::SolveAuction(
+    TConstArrayView<float> Costs,
+    int32 Size,
+    TArray<int32>& OutAssignment,
+    FFormationAssignmentWarmStart* WarmStart,
+    float RelativeTolerance,
+    const std::atomic<bool>* CancelFlag)
+{
+    using namespace FormationAssignmentSolver_Private;
+
+    OutAssignment.Reset();
+    if (!ValidateInput(Costs, Size) || IsCancelled(CancelFlag))
+    {
+        return false;
+    }
+    if (Size <= 1)
+    {
+        OutAssignment.Init(0, Size);
+        return true;
+    }
+
+    const float* C = Costs.GetData();
+    float MinCost = C[0];
+    float MaxCost = C[0];
+    for (const float Cost : Costs)
+    {
+        MinCost = FMath::Min(MinCost, Cost);
+        MaxCost = FMath::Max(MaxCost, Cost);
+    }
+    const double CostRange = FMath::Max(static_cast<double>(MaxCost) - MinCost, UE_DOUBLE_KINDA_SMALL_NUMBER);
+    const double FinalEpsilon = CostRange * FMath::Max(static_cast<double>(RelativeTolerance), 1.0e-9);
+
+    // 价格与 LAPJV 使用相同约定：行选择 c(i,j) - v(j) 最小的列，出价降低 v(j)
+    TArray<double> Prices;
+    const bool bWarm = WarmStart && WarmStart->IsValidFor(Size);
+    if (bWarm)
+    {
+        Prices = WarmStart->ColumnPrices;
+    }
+    else
+    {
+        Prices.Init(0.0, Size);
+    }
+    double Epsilon = bWarm ? FinalEpsilon : FMath::Max(CostRange * 0.25, FinalEpsilon);
+
+    TArray<int32> RowSolution;
+    TArray<int32> ColumnSolution;
+    TArray<int32> FreeRows;
+    TArray<int32> NextFreeRows;
+    TArray<int32> BidColumns;
+    TArray<double> BidAmounts;
+    TArray<double> BestBids;
+    TArray<int32> BestBidders;
+    TArray<int32> BidTargets;
+    BestBids.Init(-1.0, Size);
+    BestBidders.Init(INDEX_NONE, Size);
+    FreeRows.Reserve(Size);
+    NextFreeRows.Reserve(Size);
+    BidTargets.Reserve(Size);
+
+    const int64 MaxBids = static_cast<int64>(Size) * AuctionMaxBidsPerRow;
+    int64 TotalBids = 0;
+    bool bFirstPhase = true;
+
+    for (;;)
+    {
+        RowSolution.Init(INDEX_NONE, Size);
+        ColumnSolution.Init(INDEX_NONE, Size);
+        FreeRows.Reset();
+
+        for (int32 Row = 0; Row < Size; ++Row)
+        {
+            // 热启动的第一阶段保留满足 ε-互补松弛的旧分配
+            if (bFirstPhase && bWarm && WarmStart->Assignment.Num() == Size)
+            {
+                const int32 PreviousColumn = WarmStart->Assignment[Row];
+                if (PreviousColumn >= 0 && PreviousColumn < Size && ColumnSolution[PreviousColumn] == INDEX_NONE)
+                {
+                    double MinReduced;
+                    double SecondReduced;
+                    int32 MinColumn;
+                    int32 SecondColumn;
+                    FindTwoSmallestReduced(C, Size, Prices.GetData(), Row, MinReduced, MinColumn, SecondReduced, SecondColumn);
+                    if (GetCost(C, Size, Row, PreviousColumn) - Prices[PreviousColumn] <= MinReduced + Epsilon)
+                    {
+                        RowSolution[Row] = PreviousColumn;
+                        ColumnSolution[PreviousColumn] = Row;
+                        continue;
+                    }
+                }
+            }
+            FreeRows.Add(Row);
+        }
+        bFirstPhase = false;
+
+        while (FreeRows.Num() > 0)
+        {
+            if (IsCancelled(CancelFlag))
+            {
+                return false;
+            }
+
+            TotalBids += FreeRows.Num();
+            if (TotalBids > MaxBids)
+            {
+                UE_LOG(LogFormationSystem, Verbose, TEXT("分配求解器: 拍卖算法在 %lld 次出价后仍未收敛"), TotalBids);
+                return false;
+            }
+
+            // 各出价者只读取价格，互不依赖，可并行计算
+            const int32 NumBidders = FreeRows.Num();
+#if XTOOLS_ENGINE_5_8_OR_LATER
+            BidColumns.SetNumUninitialized(NumBidders, EAllowShrinking::No);
+            BidAmounts.SetNumUninitialized(NumBidders, EAllowShrinking::No);
+#else
+            BidColumns.SetNumUninitialized(NumBidders, false);
+            BidAmounts.SetNumUninitialized(NumBidders, false);
+#endif
+            ParallelFor(NumBidders, [&](int32 BidderIndex)
+            {
+                double MinReduced;
+                double SecondReduced;
+                int32 MinColumn;
+                int32 SecondColumn;
+                FindTwoSmallestReduced(C, Size, Prices.GetData(), FreeRows[BidderIndex], MinReduced, MinColumn, SecondReduced, SecondColumn);
+                BidColumns[BidderIndex] = MinColumn;
+                BidAmounts[BidderIndex] = SecondReduced - MinReduced + Epsilon;
+            }, NumBidders < AuctionParallelThreshold);
+
+            // 每列只接受降价幅度最大的出价
+            BidTargets.Reset();
+            for (int32 BidderIndex = 0; BidderIndex < NumBidders; ++BidderIndex)
+            {
+                const int32 Column = BidColumns[BidderIndex];
+                if (BestBidders[Column] == INDEX_NONE)
+                {
+                    BidTargets.Add(Column);
+                }
+                if (BidAmounts[BidderIndex] > BestBids[Column])
+                {
+                    BestBids[Column] = BidAmounts[BidderIndex];
+                    BestBidders[Column] = FreeRows[BidderIndex];
+                }
+            }
+
+            NextFreeRows.Reset();
+            for (int32 BidderIndex = 0; BidderIndex < NumBidders; ++BidderIndex)
+            {
+                if (BestBidders[BidColumns[BidderIndex]] != FreeRows[BidderIndex])
+                {
+                    NextFreeRows.Add(FreeRows[BidderIndex]);
+                }
+            }
+
+            for (const int32 Column : BidTargets)
+            {
+                const int32 Winner = BestBidders[Column];
+                const int32 PreviousOwner = ColumnSolution[Column];
+                if (PreviousOwner != INDEX_NONE)
+                {
+                    RowSolution[PreviousOwner] = INDEX_NONE;
+                    NextFreeRows.Add(PreviousOwner);
+                }
+                Prices[Column] -= BestBids[Column];
+                ColumnSolution[Column] = Winner;
+                RowSolution[Winner] = Column;
+
+                BestBids[Column] = -1.0;
+                BestBidders[Column] = INDEX_NONE;
+            }
+
+            Swap(FreeRows, NextFreeRows);
+        }
+
+        if (Epsilon <= FinalEpsilon)
+        {
+            break;
+        }
+        Epsilon = FMath::Max(Epsilon / AuctionEpsilonScaling, FinalEpsilon);
+    }
+
+    OutAssignment = MoveTemp(RowSolution);
+    if (WarmStart)
+    {
+        WarmStart->ColumnPrices = MoveTemp(Prices);
+        WarmStart->Assignment = OutAssignment;
+    }
+    return true;
+}
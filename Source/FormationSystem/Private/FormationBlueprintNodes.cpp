@@ -1,6 +1,7 @@
 #include "FormationBlueprintNodes.h"
 #include "FormationLibrary.h"
 #include "FormationManagerComponent.h"
+#include "FormationSubsystem.h"
 #include "FormationMovementComponent.h"
 #include "FormationLog.h"
 
@@ -41,24 +42,14 @@ bool UFormationBlueprintNodes::QuickFormationTransition(
         return false;
     }
 
-    // 创建临时Actor来承载阵型管理器
-    AActor* FormationActor = World->SpawnActor<AActor>();
-    if (!FormationActor)
+    // 管理器来自阵型子系统的对象池，不再为每次变换生成临时 Actor
+    UFormationSubsystem* FormationSubsystem = World->GetSubsystem<UFormationSubsystem>();
+    if (!FormationSubsystem)
     {
         OutFormationManager = nullptr;
         return false;
     }
 
-    FormationActor->SetActorLocation(FormationTransform.GetLocation());
-#if WITH_EDITOR
-    FormationActor->SetActorLabel(TEXT("QuickFormationManager"));
-#endif
-
-    // 创建阵型管理器组件
-    OutFormationManager = NewObject<UFormationManagerComponent>(FormationActor);
-    FormationActor->AddInstanceComponent(OutFormationManager);
-    OutFormationManager->RegisterComponent();
-
     // 获取当前阵型
     FVector CurrentCenter;
     FFormationData CurrentFormation = UFormationLibrary::GetCurrentFormationFromActors(Units, CurrentCenter);
@@ -68,7 +59,7 @@ bool UFormationBlueprintNodes::QuickFormationTransition(
         TargetFormationType, FVector::ZeroVector, FormationSize, Units.Num());
 
     // 应用阵型变换（位置、旋转和缩放）
-    TargetFormation = ApplyFormationTransform(TargetFormation, FormationTransform);
+    ApplyFormationTransformInPlace(TargetFormation, FormationTransform);
 
     // 配置变换参数
     FFormationTransitionConfig Config;
@@ -79,25 +70,14 @@ bool UFormationBlueprintNodes::QuickFormationTransition(
     Config.bShowDebug = bShowDebug;
     Config.DebugDuration = TransitionDuration + 2.0f;
 
-    // 开始变换
-    bool bSuccess = OutFormationManager->StartFormationTransition(Units, CurrentFormation, TargetFormation, Config);
+    // 开始变换，完成后管理器自动回收到池中
+    const bool bSuccess = FormationSubsystem->StartTransition(
+        Units, CurrentFormation, TargetFormation, Config, nullptr, &OutFormationManager).IsSet();
 
-    if (bSuccess)
-    {
-        // 过渡完成后自动销毁临时管理 Actor
-        OutFormationManager->OnFormationTransitionCompleted.AddDynamic(
-            OutFormationManager, &UFormationManagerComponent::DestroyOwnerActor);
-
-        if (bShowDebug)
-        {
-            UFormationLibrary::DrawFormationDebug(WorldContext, CurrentFormation, Config.DebugDuration, FLinearColor::Green, 2.0f);
-            UFormationLibrary::DrawFormationDebug(WorldContext, TargetFormation, Config.DebugDuration, FLinearColor::Red, 2.0f);
-        }
-    }
-    else
+    if (bSuccess && bShowDebug)
     {
-        FormationActor->Destroy();
-        OutFormationManager = nullptr;
+        UFormationLibrary::DrawFormationDebug(WorldContext, CurrentFormation, Config.DebugDuration, FLinearColor::Green, 2.0f);
+        UFormationLibrary::DrawFormationDebug(WorldContext, TargetFormation, Config.DebugDuration, FLinearColor::Red, 2.0f);
     }
 
     return bSuccess;
@@ -145,24 +125,15 @@ UFormationManagerComponent* UFormationBlueprintNodes::FormationTransitionSequenc
         return nullptr;
     }
 
-    // 创建序列管理器Actor
-    AActor* SequenceActor = World->SpawnActor<AActor>();
-    if (!SequenceActor)
+    UFormationSubsystem* FormationSubsystem = World->GetSubsystem<UFormationSubsystem>();
+    if (!FormationSubsystem)
     {
         return nullptr;
     }
 
-    SequenceActor->SetActorLocation(CenterLocation);
-    #if WITH_EDITOR
-    SequenceActor->SetActorLabel(TEXT("FormationSequenceManager"));
-#endif
-
-    UFormationManagerComponent* FormationManager = NewObject<UFormationManagerComponent>(SequenceActor);
-    SequenceActor->AddInstanceComponent(FormationManager);
-    FormationManager->RegisterComponent();
-
     // 序列逻辑未实现：仅执行第一个阵型的变换，SequenceInterval 和 bLoop 参数不生效
     UE_LOG(LogFormationSystem, Warning, TEXT("FormationTransitionSequence: 序列逻辑未完成，仅执行 FormationSequence[0]。请改用 QuickFormationTransition。"));
+    UFormationManagerComponent* FormationManager = nullptr;
     if (FormationSequence.Num() > 0)
     {
         FVector CurrentCenter;
@@ -173,11 +144,7 @@ UFormationManagerComponent* UFormationBlueprintNodes::FormationTransitionSequenc
         Config.Duration = TransitionDuration;
         Config.bShowDebug = bShowDebug;
 
-        FormationManager->StartFormationTransition(Units, CurrentFormation, FirstTargetFormation, Config);
-
-        // 过渡完成后自动销毁临时管理 Actor
-        FormationManager->OnFormationTransitionCompleted.AddDynamic(
-            FormationManager, &UFormationManagerComponent::DestroyOwnerActor);
+        FormationSubsystem->StartTransition(Units, CurrentFormation, FirstTargetFormation, Config, nullptr, &FormationManager);
     }
 
     return FormationManager;
@@ -378,7 +345,7 @@ bool UFormationBlueprintNodes::CharacterFormationMovement(
     );
 
     // 应用阵型变换（位置、旋转和缩放）
-    TargetFormation = ApplyFormationTransform(TargetFormation, FormationTransform);
+    ApplyFormationTransformInPlace(TargetFormation, FormationTransform);
 
     // 获取世界坐标位置
     TArray<FVector> FromPositions = CurrentFormation.GetWorldPositions();
@@ -563,28 +530,14 @@ bool UFormationBlueprintNodes::RTSFlockFormationTransition(
         return false;
     }
 
-    // 创建阵型管理器
-    AActor* ManagerActor = World->SpawnActor<AActor>();
-    if (!ManagerActor)
+    // 管理器来自阵型子系统的对象池，不再为每次变换生成临时 Actor
+    UFormationSubsystem* FormationSubsystem = World->GetSubsystem<UFormationSubsystem>();
+    if (!FormationSubsystem)
     {
         OutFormationManager = nullptr;
         return false;
     }
 
-    // 创建阵型管理器组件
-    OutFormationManager = NewObject<UFormationManagerComponent>(ManagerActor);
-    if (!OutFormationManager)
-    {
-        ManagerActor->Destroy();
-        return false;
-    }
-
-    ManagerActor->AddInstanceComponent(OutFormationManager);
-    OutFormationManager->RegisterComponent();
-
-    // 设置Boids参数
-    OutFormationManager->SetBoidsMovementParams(BoidsParams);
-
     // 获取当前阵型
     FVector CurrentCenter;
     FFormationData CurrentFormation = UFormationLibrary::GetCurrentFormationFromActors(Units, CurrentCenter);
@@ -601,25 +554,14 @@ bool UFormationBlueprintNodes::RTSFlockFormationTransition(
     Config.bShowDebug = bShowDebug;
     Config.DebugDuration = TransitionDuration + 2.0f;
 
-    // 开始变换
-    bool bSuccess = OutFormationManager->StartFormationTransition(Units, CurrentFormation, TargetFormation, Config);
-
-    if (bSuccess)
-    {
-        // 过渡完成后自动销毁临时管理 Actor
-        OutFormationManager->OnFormationTransitionCompleted.AddDynamic(
-            OutFormationManager, &UFormationManagerComponent::DestroyOwnerActor);
+    // 开始变换（同时设置Boids参数），完成后管理器自动回收到池中
+    const bool bSuccess = FormationSubsystem->StartTransition(
+        Units, CurrentFormation, TargetFormation, Config, &BoidsParams, &OutFormationManager).IsSet();
 
-        if (bShowDebug)
-        {
-            UFormationLibrary::DrawFormationDebug(WorldContext, CurrentFormation, Config.DebugDuration, FLinearColor::Green, 2.0f);
-            UFormationLibrary::DrawFormationDebug(WorldContext, TargetFormation, Config.DebugDuration, FLinearColor::Blue, 2.0f);
-        }
-    }
-    else
+    if (bSuccess && bShowDebug)
     {
-        ManagerActor->Destroy();
-        OutFormationManager = nullptr;
+        UFormationLibrary::DrawFormationDebug(WorldContext, CurrentFormation, Config.DebugDuration, FLinearColor::Green, 2.0f);
+        UFormationLibrary::DrawFormationDebug(WorldContext, TargetFormation, Config.DebugDuration, FLinearColor::Blue, 2.0f);
     }
 
     return bSuccess;
@@ -650,25 +592,14 @@ bool UFormationBlueprintNodes::PathAwareFormationTransition(
         return false;
     }
 
-    // 创建阵型管理器
-    AActor* ManagerActor = World->SpawnActor<AActor>();
-    if (!ManagerActor)
+    // 管理器来自阵型子系统的对象池，不再为每次变换生成临时 Actor
+    UFormationSubsystem* FormationSubsystem = World->GetSubsystem<UFormationSubsystem>();
+    if (!FormationSubsystem)
     {
         OutFormationManager = nullptr;
         return false;
     }
 
-    // 创建阵型管理器组件
-    OutFormationManager = NewObject<UFormationManagerComponent>(ManagerActor);
-    if (!OutFormationManager)
-    {
-        ManagerActor->Destroy();
-        return false;
-    }
-
-    ManagerActor->AddInstanceComponent(OutFormationManager);
-    OutFormationManager->RegisterComponent();
-
     // 获取当前阵型
     FVector CurrentCenter;
     FFormationData CurrentFormation = UFormationLibrary::GetCurrentFormationFromActors(Units, CurrentCenter);
@@ -676,14 +607,6 @@ bool UFormationBlueprintNodes::PathAwareFormationTransition(
     // 创建目标阵型
     FFormationData TargetFormation = CreateFormationByType(TargetFormationType, CenterLocation, FormationSize, Units.Num());
 
-    // 预先检测路径冲突
-    OutConflictInfo = OutFormationManager->CheckFormationPathConflicts(
-        CurrentFormation.GetWorldPositions(),
-        TargetFormation.GetWorldPositions()
-    );
-
-
-
     // 配置变换参数（使用路径感知模式）
     FFormationTransitionConfig Config;
     Config.TransitionMode = EFormationTransitionMode::PathAwareAssignment;
@@ -693,14 +616,18 @@ bool UFormationBlueprintNodes::PathAwareFormationTransition(
     Config.bShowDebug = bShowDebug;
     Config.DebugDuration = TransitionDuration + 2.0f;
 
-    // 开始变换
-    bool bSuccess = OutFormationManager->StartFormationTransition(Units, CurrentFormation, TargetFormation, Config);
+    // 开始变换，完成后管理器自动回收到池中
+    const bool bSuccess = FormationSubsystem->StartTransition(
+        Units, CurrentFormation, TargetFormation, Config, nullptr, &OutFormationManager).IsSet();
 
+    OutConflictInfo = FPathConflictInfo();
     if (bSuccess)
     {
-        // 过渡完成后自动销毁临时管理 Actor
-        OutFormationManager->OnFormationTransitionCompleted.AddDynamic(
-            OutFormationManager, &UFormationManagerComponent::DestroyOwnerActor);
+        // 检测路径冲突（按空间顺序映射预估）
+        OutConflictInfo = OutFormationManager->CheckFormationPathConflicts(
+            CurrentFormation.GetWorldPositions(),
+            TargetFormation.GetWorldPositions()
+        );
 
         if (bShowDebug)
         {
@@ -730,11 +657,6 @@ bool UFormationBlueprintNodes::PathAwareFormationTransition(
             }
         }
     }
-    else
-    {
-        ManagerActor->Destroy();
-        OutFormationManager = nullptr;
-    }
 
     return bSuccess;
 }
@@ -744,35 +666,28 @@ FFormationData UFormationBlueprintNodes::ApplyFormationTransform(
     const FTransform& Transform)
 {
     FFormationData TransformedFormation = FormationData;
+    ApplyFormationTransformInPlace(TransformedFormation, Transform);
+    return TransformedFormation;
+}
 
+void UFormationBlueprintNodes::ApplyFormationTransformInPlace(
+    FFormationData& FormationData,
+    const FTransform& Transform)
+{
     // 获取变换信息
-    FVector FormationCenter = Transform.GetLocation();
-    FRotator AdditionalRotation = Transform.GetRotation().Rotator();
-    FVector Scale = Transform.GetScale3D();
+    const FRotator AdditionalRotation = Transform.GetRotation().Rotator();
 
-    // 对每个位置应用变换
-    for (int32 i = 0; i < TransformedFormation.Positions.Num(); i++)
+    // 缩放（相对于原点）与额外旋转合成为一个矩阵，位置仍然相对于中心
+    const FMatrix ScaleRotation = FScaleRotationTranslationMatrix(Transform.GetScale3D(), AdditionalRotation, FVector::ZeroVector);
+    for (FVector& Position : FormationData.Positions)
     {
-        FVector& Position = TransformedFormation.Positions[i];
-
-        // 1. 应用缩放（相对于原点）
-        FVector ScaledPosition = Position * Scale;
-
-        // 2. 应用额外的旋转（在原有旋转基础上）
-        FVector RotatedPosition = AdditionalRotation.RotateVector(ScaledPosition);
-
-        // 3. 存储变换后的相对位置（仍然相对于中心）
-        Position = RotatedPosition;
+        Position = ScaleRotation.TransformVector(Position);
     }
 
     // 更新阵型的中心位置
-    TransformedFormation.CenterLocation = FormationCenter;
+    FormationData.CenterLocation = Transform.GetLocation();
 
     // 组合旋转：原有旋转 + 额外旋转
-    FQuat OriginalQuat = FormationData.Rotation.Quaternion();
-    FQuat AdditionalQuat = AdditionalRotation.Quaternion();
-    FQuat CombinedQuat = AdditionalQuat * OriginalQuat;
-    TransformedFormation.Rotation = CombinedQuat.Rotator();
-
-    return TransformedFormation;
+    const FQuat CombinedQuat = AdditionalRotation.Quaternion() * FormationData.Rotation.Quaternion();
+    FormationData.Rotation = CombinedQuat.Rotator();
 }
\ No newline at end of file
@@ -0,0 +1,460 @@
+// FormationCostMatrix.cpp - 连续/稀疏成本矩阵构建
+// 稠密矩阵使用 SoA + 4路 SIMD 计算距离，稀疏矩阵使用目标位置网格查找 K 近邻
+
+#include "FormationCostMatrix.h"
+#include "FormationLog.h"
+#include "Async/ParallelFor.h"
+#include "XToolsVersionCompat.h"
+
+namespace FormationCostMatrix_Private
+{
+    /** 行数达到该值时按行并行构建 */
+    constexpr int32 ParallelRowThreshold = 128;
+
+    /** 网格单边最大格子数 */
+    constexpr int32 MaxGridCellsPerAxis = 1024;
+
+    /** 结构数组形式的目标位置，便于 SIMD 连续加载 */
+    struct FSoAPositions
+    {
+        TArray<float, TAlignedHeapAllocator<16>> X;
+        TArray<float, TAlignedHeapAllocator<16>> Y;
+        TArray<float, TAlignedHeapAllocator<16>> Z;
+
+        void Init(int32 Num)
+        {
+            X.SetNumUninitialized(Num);
+            Y.SetNumUninitialized(Num);
+            Z.SetNumUninitialized(Num);
+        }
+
+        void Set(int32 Index, const FVector3f& Position)
+        {
+            X[Index] = Position.X;
+            Y[Index] = Position.Y;
+            Z[Index] = Position.Z;
+        }
+    };
+
+    /** 包围盒归一化参数，与原相对位置成本矩阵的计算方式一致 */
+    struct FNormalization
+    {
+        FVector Center = FVector::ZeroVector;
+        FVector SizeInv = FVector::ZeroVector;
+
+        explicit FNormalization(const TArray<FVector>& Positions)
+        {
+            const FBox Bounds(Positions);
+            Center = Bounds.GetCenter();
+            const FVector Size = Bounds.GetSize();
+            SizeInv = FVector(
+                Size.X > 1.0f ? 1.0f / Size.X : 0.0f,
+                Size.Y > 1.0f ? 1.0f / Size.Y : 0.0f,
+                Size.Z > 1.0f ? 1.0f / Size.Z : 0.0f);
+        }
+
+        FVector3f Apply(const FVector& Position) const
+        {
+            return FVector3f((Position - Center) * SizeInv);
+        }
+    };
+
+    /** 以目标阵型中心为原点转为单精度，避免大世界坐标下的精度损失 */
+    FVector GetLocalOrigin(const TArray<FVector>& ToPositions)
+    {
+        return ToPositions.Num() > 0 ? FBox(ToPositions).GetCenter() : FVector::ZeroVector;
+    }
+
+    FORCEINLINE VectorRegister4Float VectorDistance(
+        const VectorRegister4Float& DX, const VectorRegister4Float& DY, const VectorRegister4Float& DZ)
+    {
+        return VectorSqrt(VectorMultiplyAdd(DX, DX, VectorMultiplyAdd(DY, DY, VectorMultiply(DZ, DZ))));
+    }
+
+    /** 目标位置上的均匀网格，仅按 XY 分格，距离仍按三维计算 */
+    struct FTargetGrid
+    {
+        FVector2f Min = FVector2f::ZeroVector;
+        float CellSize = 1.0f;
+        int32 SizeX = 1;
+        int32 SizeY = 1;
+        TArray<int32> CellStarts;
+        TArray<int32> Entries;
+
+        void Build(const TArray<FVector3f>& Points, int32 NeighborCount)
+        {
+            FVector2f Max(-MAX_flt, -MAX_flt);
+            Min = FVector2f(MAX_flt, MAX_flt);
+            for (const FVector3f& Point : Points)
+            {
+                Min.X = FMath::Min(Min.X, Point.X);
+                Min.Y = FMath::Min(Min.Y, Point.Y);
+                Max.X = FMath::Max(Max.X, Point.X);
+                Max.Y = FMath::Max(Max.Y, Point.Y);
+            }
+
+            // 平均每个格子约 K/4 个点，3×3 邻域即可覆盖约 2K 个候选
+            const float ExtentX = FMath::Max(Max.X - Min.X, 1.0f);
+            const float ExtentY = FMath::Max(Max.Y - Min.Y, 1.0f);
+            const float Density = Points.Num() / (ExtentX * ExtentY);
+            CellSize = FMath::Sqrt(NeighborCount / FMath::Max(Density, UE_SMALL_NUMBER)) * 0.5f;
+            CellSize = FMath::Max3(CellSize, FMath::Max(ExtentX, ExtentY) / MaxGridCellsPerAxis, 1.0f);
+            SizeX = FMath::Clamp(FMath::CeilToInt32(ExtentX / CellSize), 1, MaxGridCellsPerAxis);
+            SizeY = FMath::Clamp(FMath::CeilToInt32(ExtentY / CellSize), 1, MaxGridCellsPerAxis);
+
+            // 计数排序：CellStarts[c] 为格子 c 在 Entries 中的起始位置
+            CellStarts.Init(0, SizeX * SizeY + 1);
+            for (const FVector3f& Point : Points)
+            {
+                ++CellStarts[GetCellIndex(GetCell(Point)) + 1];
+            }
+            for (int32 Cell = 0; Cell < SizeX * SizeY; ++Cell)
+            {
+                CellStarts[Cell + 1] += CellStarts[Cell];
+            }
+
+            TArray<int32> Cursor(CellStarts.GetData(), SizeX * SizeY);
+            Entries.SetNumUninitialized(Points.Num());
+            for (int32 Index = 0; Index < Points.Num(); ++Index)
+            {
+                Entries[Cursor[GetCellIndex(GetCell(Points[Index]))]++] = Index;
+            }
+        }
+
+        FIntPoint GetCell(const FVector3f& Point) const
+        {
+            return FIntPoint(
+                FMath::Clamp(FMath::FloorToInt32((Point.X - Min.X) / CellSize), 0, SizeX - 1),
+                FMath::Clamp(FMath::FloorToInt32((Point.Y - Min.Y) / CellSize), 0, SizeY - 1));
+        }
+
+        int32 GetCellIndex(const FIntPoint& Cell) const
+        {
+            return Cell.Y * SizeX + Cell.X;
+        }
+
+        /**
+         * 查找最近的 K 个点，按环形逐层扩展格子
+         * 第 r+1 环的格子到查询点的距离不小于 r * CellSize，第 K 近的距离不超过该值时即可停止
+         */
+        void FindNearest(const TArray<FVector3f>& Points, const FVector3f& Query, int32 NeighborCount,
+            TArray<TPair<float, int32>>& OutHeap) const
+        {
+            OutHeap.Reset();
+            const auto FartherFirst = [](const TPair<float, int32>& A, const TPair<float, int32>& B)
+            {
+                return A.Key > B.Key || (A.Key == B.Key && A.Value > B.Value);
+            };
+
+            auto VisitCell = [&](int32 CellX, int32 CellY)
+            {
+                if (CellX < 0 || CellX >= SizeX || CellY < 0 || CellY >= SizeY)
+                {
+                    return;
+                }
+
+                const int32 Cell = GetCellIndex(FIntPoint(CellX, CellY));
+                for (int32 Entry = CellStarts[Cell]; Entry < CellStarts[Cell + 1]; ++Entry)
+                {
+                    const int32 Index = Entries[Entry];
+                    const float DistSquared = FVector3f::DistSquared(Query, Points[Index]);
+                    if (OutHeap.Num() < NeighborCount)
+                    {
+                        OutHeap.HeapPush(TPair<float, int32>(DistSquared, Index), FartherFirst);
+                    }
+                    else if (DistSquared < OutHeap.HeapTop().Key)
+                    {
+#if XTOOLS_ENGINE_5_8_OR_LATER
+                        OutHeap.HeapPopDiscard(FartherFirst, EAllowShrinking::No);
+#else
+                        OutHeap.HeapPopDiscard(FartherFirst, false);
+#endif
+                        OutHeap.HeapPush(TPair<float, int32>(DistSquared, Index), FartherFirst);
+                    }
+                }
+            };
+
+            const FIntPoint Center = GetCell(Query);
+            const int32 MaxRing = FMath::Max(SizeX, SizeY);
+            for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+            {
+                // 只访问第 Ring 环上的格子，内部格子已在之前的环中处理
+                if (Ring == 0)
+                {
+                    VisitCell(Center.X, Center.Y);
+                }
+                else
+                {
+                    for (int32 Offset = -Ring; Offset <= Ring; ++Offset)
+                    {
+                        VisitCell(Center.X + Offset, Center.Y - Ring);
+                        VisitCell(Center.X + Offset, Center.Y + Ring);
+                    }
+                    for (int32 Offset = -Ring + 1; Offset < Ring; ++Offset)
+                    {
+                        VisitCell(Center.X - Ring, Center.Y + Offset);
+                        VisitCell(Center.X + Ring, Center.Y + Offset);
+                    }
+                }
+
+                const float RingDistance = Ring * CellSize;
+                if (OutHeap.Num() >= NeighborCount && OutHeap.HeapTop().Key <= RingDistance * RingDistance)
+                {
+                    break;
+                }
+            }
+        }
+    };
+}
+
+void FFormationCostMatrix::Init(int32 InNumRows, int32 InNumColumns)
+{
+    NumRows = FMath::Max(InNumRows, 0);
+    NumColumns = FMath::Max(InNumColumns, 0);
+#if XTOOLS_ENGINE_5_8_OR_LATER
+    Values.SetNumUninitialized(NumRows * NumColumns, EAllowShrinking::No);
+#else
+    Values.SetNumUninitialized(NumRows * NumColumns, false);
+#endif
+}
+
+bool FFormationCostMatrix::SetFromNested(const TArray<TArray<float>>& Nested)
+{
+    const int32 Rows = Nested.Num();
+    const int32 Columns = Rows > 0 ? Nested[0].Num() : 0;
+    for (const TArray<float>& Row : Nested)
+    {
+        if (Row.Num() != Columns)
+        {
+            Reset();
+            return false;
+        }
+    }
+
+    Init(Rows, Columns);
+    for (int32 Row = 0; Row < Rows; ++Row)
+    {
+        FMemory::Memcpy(GetRow(Row), Nested[Row].GetData(), Columns * sizeof(float));
+    }
+    return true;
+}
+
+void FFormationCostMatrix::BuildAbsoluteDistance(
+    const TArray<FVector>& FromPositions,
+    const TArray<FVector>& ToPositions,
+    FFormationCostMatrix& OutMatrix)
+{
+    using namespace FormationCostMatrix_Private;
+
+    const int32 NumFrom = FromPositions.Num();
+    const int32 NumTo = ToPositions.Num();
+    OutMatrix.Init(NumFrom, NumTo);
+
+    const FVector Origin = GetLocalOrigin(ToPositions);
+    FSoAPositions Targets;
+    Targets.Init(NumTo);
+    for (int32 Column = 0; Column < NumTo; ++Column)
+    {
+        Targets.Set(Column, FVector3f(ToPositions[Column] - Origin));
+    }
+
+    ParallelFor(NumFrom, [&](int32 Row)
+    {
+        const FVector3f From(FromPositions[Row] - Origin);
+        const VectorRegister4Float FromX = VectorSetFloat1(From.X);
+        const VectorRegister4Float FromY = VectorSetFloat1(From.Y);
+        const VectorRegister4Float FromZ = VectorSetFloat1(From.Z);
+        float* RowCosts = OutMatrix.GetRow(Row);
+
+        int32 Column = 0;
+        for (; Column + 4 <= NumTo; Column += 4)
+        {
+            const VectorRegister4Float DX = VectorSubtract(VectorLoadAligned(&Targets.X[Column]), FromX);
+            const VectorRegister4Float DY = VectorSubtract(VectorLoadAligned(&Targets.Y[Column]), FromY);
+            const VectorRegister4Float DZ = VectorSubtract(VectorLoadAligned(&Targets.Z[Column]), FromZ);
+            VectorStore(VectorDistance(DX, DY, DZ), RowCosts + Column);
+        }
+        for (; Column < NumTo; ++Column)
+        {
+            RowCosts[Column] = FVector3f::Dist(From, FVector3f(Targets.X[Column], Targets.Y[Column], Targets.Z[Column]));
+        }
+    }, NumFrom < ParallelRowThreshold);
+}
+
+void FFormationCostMatrix::BuildRelativePosition(
+    const TArray<FVector>& FromPositions,
+    const TArray<FVector>& ToPositions,
+    FFormationCostMatrix& OutMatrix)
+{
+    using namespace FormationCostMatrix_Private;
+
+    const int32 NumFrom = FromPositions.Num();
+    const int32 NumTo = ToPositions.Num();
+    OutMatrix.Init(NumFrom, NumTo);
+    if (NumFrom == 0 || NumTo == 0)
+    {
+        return;
+    }
+
+    const FNormalization FromNormalization(FromPositions);
+    const FNormalization ToNormalization(ToPositions);
+    const FVector Origin = GetLocalOrigin(ToPositions);
+
+    FSoAPositions NormalizedTargets;
+    FSoAPositions Targets;
+    NormalizedTargets.Init(NumTo);
+    Targets.Init(NumTo);
+    for (int32 Column = 0; Column < NumTo; ++Column)
+    {
+        NormalizedTargets.Set(Column, ToNormalization.Apply(ToPositions[Column]));
+        Targets.Set(Column, FVector3f(ToPositions[Column] - Origin));
+    }
+
+    const float RelativeFactor = RelativeScale * RelativeWeight;
+    ParallelFor(NumFrom, [&](int32 Row)
+    {
+        const FVector3f NormalizedFrom = FromNormalization.Apply(FromPositions[Row]);
+        const FVector3f From(FromPositions[Row] - Origin);
+        const VectorRegister4Float NX = VectorSetFloat1(NormalizedFrom.X);
+        const VectorRegister4Float NY = VectorSetFloat1(NormalizedFrom.Y);
+        const VectorRegister4Float NZ = VectorSetFloat1(NormalizedFrom.Z);
+        const VectorRegister4Float AX = VectorSetFloat1(From.X);
+        const VectorRegister4Float AY = VectorSetFloat1(From.Y);
+        const VectorRegister4Float AZ = VectorSetFloat1(From.Z);
+        const VectorRegister4Float RelativeFactorVector = VectorSetFloat1(RelativeFactor);
+        const VectorRegister4Float AbsoluteWeightVector = VectorSetFloat1(AbsoluteWeight);
+        float* RowCosts = OutMatrix.GetRow(Row);
+
+        int32 Column = 0;
+        for (; Column + 4 <= NumTo; Column += 4)
+        {
+            const VectorRegister4Float RelativeDistance = VectorDistance(
+                VectorSubtract(VectorLoadAligned(&NormalizedTargets.X[Column]), NX),
+                VectorSubtract(VectorLoadAligned(&NormalizedTargets.Y[Column]), NY),
+                VectorSubtract(VectorLoadAligned(&NormalizedTargets.Z[Column]), NZ));
+            const VectorRegister4Float AbsoluteDistance = VectorDistance(
+                VectorSubtract(VectorLoadAligned(&Targets.X[Column]), AX),
+                VectorSubtract(VectorLoadAligned(&Targets.Y[Column]), AY),
+                VectorSubtract(VectorLoadAligned(&Targets.Z[Column]), AZ));
+            VectorStore(
+                VectorMultiplyAdd(RelativeDistance, RelativeFactorVector, VectorMultiply(AbsoluteDistance, AbsoluteWeightVector)),
+                RowCosts + Column);
+        }
+        for (; Column < NumTo; ++Column)
+        {
+            const float RelativeDistance = FVector3f::Dist(NormalizedFrom,
+                FVector3f(NormalizedTargets.X[Column], NormalizedTargets.Y[Column], NormalizedTargets.Z[Column]));
+            const float AbsoluteDistance = FVector3f::Dist(From,
+                FVector3f(Targets.X[Column], Targets.Y[Column], Targets.Z[Column]));
+            RowCosts[Column] = RelativeDistance * RelativeFactor + AbsoluteDistance * AbsoluteWeight;
+        }
+    }, NumFrom < ParallelRowThreshold);
+}
+
+void FFormationSparseCostMatrix::BuildNearest(
+    const TArray<FVector>& FromPositions,
+    const TArray<FVector>& ToPositions,
+    int32 NeighborCount,
+    bool bUseRelativePosition,
+    FFormationSparseCostMatrix& OutMatrix)
+{
+    using namespace FormationCostMatrix_Private;
+
+    OutMatrix.Reset();
+    const int32 Num = FromPositions.Num();
+    if (Num == 0 || ToPositions.Num() != Num)
+    {
+        if (ToPositions.Num() != Num)
+        {
+            UE_LOG(LogFormationSystem, Warning, TEXT("稀疏成本矩阵要求起始与目标位置数量一致 (%d/%d)"), Num, ToPositions.Num());
+        }
+        return;
+    }
+
+    const int32 K = FMath::Clamp(NeighborCount, 1, Num);
+    const FNormalization FromNormalization(FromPositions);
+    const FNormalization ToNormalization(ToPositions);
+    const float RelativeFactor = FFormationCostMatrix::RelativeScale * FFormationCostMatrix::RelativeWeight;
+
+    // 近邻查找空间：相对位置模式下使用占主导的归一化位置项；
+    // 绝对距离模式下两个阵型各自以包围盒中心为原点，整体平移较远时近邻仍然覆盖阵型内对应的区域
+    auto ToSearchSpace = [&](const FVector& Position, const FNormalization& Normalization)
+    {
+        return bUseRelativePosition
+            ? Normalization.Apply(Position) * RelativeFactor
+            : FVector3f(Position - Normalization.Center);
+    };
+
+    auto ComputeCost = [&](int32 Row, int32 Column)
+    {
+        const float AbsoluteDistance = FVector::Dist(FromPositions[Row], ToPositions[Column]);
+        if (!bUseRelativePosition)
+        {
+            return AbsoluteDistance;
+        }
+        const float RelativeDistance = FVector3f::Dist(
+            FromNormalization.Apply(FromPositions[Row]), ToNormalization.Apply(ToPositions[Column]));
+        return RelativeDistance * RelativeFactor + AbsoluteDistance * FFormationCostMatrix::AbsoluteWeight;
+    };
+
+    TArray<FVector3f> SearchTargets;
+    SearchTargets.SetNumUninitialized(Num);
+    for (int32 Column = 0; Column < Num; ++Column)
+    {
+        SearchTargets[Column] = ToSearchSpace(ToPositions[Column], ToNormalization);
+    }
+
+    FTargetGrid Grid;
+    Grid.Build(SearchTargets, K);
+
+    // 每行固定预留 K+1 个槽位并行填充，之后再压缩为 CSR
+    const int32 SlotsPerRow = K + 1;
+    TArray<int32> SlotColumns;
+    TArray<int32> RowCounts;
+    SlotColumns.SetNumUninitialized(Num * SlotsPerRow);
+    RowCounts.SetNumUninitialized(Num);
+
+    ParallelFor(Num, [&](int32 Row)
+    {
+        TArray<TPair<float, int32>> Nearest;
+        Nearest.Reserve(K);
+        Grid.FindNearest(SearchTargets, ToSearchSpace(FromPositions[Row], FromNormalization), K, Nearest);
+
+        int32* RowSlots = SlotColumns.GetData() + Row * SlotsPerRow;
+        int32 Count = 0;
+        bool bHasDiagonal = false;
+        for (const TPair<float, int32>& Entry : Nearest)
+        {
+            RowSlots[Count++] = Entry.Value;
+            bHasDiagonal |= Entry.Value == Row;
+        }
+
+        // 对角边保证完美匹配一定存在
+        if (!bHasDiagonal)
+        {
+            RowSlots[Count++] = Row;
+        }
+        RowCounts[Row] = Count;
+    }, Num < ParallelRowThreshold);
+
+    OutMatrix.RowOffsets.SetNumUninitialized(Num + 1);
+    OutMatrix.RowOffsets[0] = 0;
+    for (int32 Row = 0; Row < Num; ++Row)
+    {
+        OutMatrix.RowOffsets[Row + 1] = OutMatrix.RowOffsets[Row] + RowCounts[Row];
+    }
+
+    const int32 NumEdges = OutMatrix.RowOffsets[Num];
+    OutMatrix.Columns.SetNumUninitialized(NumEdges);
+    OutMatrix.Costs.SetNumUninitialized(NumEdges);
+    ParallelFor(Num, [&](int32 Row)
+    {
+        const int32* RowSlots = SlotColumns.GetData() + Row * SlotsPerRow;
+        const int32 Offset = OutMatrix.RowOffsets[Row];
+        for (int32 Slot = 0; Slot < RowCounts[Row]; ++Slot)
+        {
+            OutMatrix.Columns[Offset + Slot] = RowSlots[Slot];
+            OutMatrix.Costs[Offset + Slot] = ComputeCost(Row, RowSlots[Slot]);
+        }
+    }, Num < ParallelRowThreshold);
+}
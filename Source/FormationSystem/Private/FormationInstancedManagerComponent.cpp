@@ -0,0 +1,213 @@
+// FormationInstancedManagerComponent.cpp - 实例化网格阵型管理组件实现
+
+#include "FormationInstancedManagerComponent.h"
+#include "FormationLog.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/World.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+bool UFormationInstancedManagerComponent::StartInstancedFormationTransition(
+    UInstancedStaticMeshComponent* Instances,
+    const FFormationData& FromFormation,
+    const FFormationData& ToFormation,
+    const FFormationTransitionConfig& Config)
+{
+    if (!IsValid(Instances))
+    {
+        UE_LOG(LogFormationSystem, Warning, TEXT("StartInstancedFormationTransition: 实例化网格组件无效"));
+        return false;
+    }
+
+    const int32 NumInstances = Instances->GetInstanceCount();
+    if (NumInstances == 0)
+    {
+        UE_LOG(LogFormationSystem, Warning, TEXT("StartInstancedFormationTransition: 实例数量为空"));
+        return false;
+    }
+
+    if (FromFormation.Positions.Num() != ToFormation.Positions.Num())
+    {
+        UE_LOG(LogFormationSystem, Warning, TEXT("StartInstancedFormationTransition: 阵型位置数量不匹配 (起始: %d, 目标: %d)"),
+            FromFormation.Positions.Num(), ToFormation.Positions.Num());
+        return false;
+    }
+
+    if (NumInstances != FromFormation.Positions.Num())
+    {
+        UE_LOG(LogFormationSystem, Warning, TEXT("StartInstancedFormationTransition: 实例数量与阵型位置数量不匹配 (实例: %d, 位置: %d)"),
+            NumInstances, FromFormation.Positions.Num());
+        return false;
+    }
+
+    // 同一组件上只保留一个进行中的变换，新命令取代尚未返回的后台求解
+    StopFormationTransition(false);
+    CancelPendingAssignment();
+
+    const TArray<FVector> FromWorldPositions = FromFormation.GetWorldPositions();
+    const TArray<FVector> ToWorldPositions = ToFormation.GetWorldPositions();
+    PrepareSpatialOrderHints(FromFormation, FromWorldPositions, ToFormation, ToWorldPositions, Config.TransitionMode);
+
+    // 大规模实例先用临时分配开始移动，最优分配在后台求解；否则同步计算最优分配
+    const bool bSolveAsync = ShouldSolveAssignmentAsync(NumInstances, Config.TransitionMode);
+    const TArray<int32> Assignment = bSolveAsync
+        ? CalculateProvisionalAssignment(FromWorldPositions, ToWorldPositions)
+        : CalculateOptimalAssignment(FromWorldPositions, ToWorldPositions, Config.TransitionMode);
+    if (Assignment.Num() != NumInstances)
+    {
+        UE_LOG(LogFormationSystem, Warning, TEXT("StartInstancedFormationTransition: 分配结果数量异常 (%d)"), Assignment.Num());
+        return false;
+    }
+
+    // 在组件空间中插值，提交时不需要逐实例做世界空间换算
+    InstanceComponentTransform = Instances->GetComponentTransform();
+    InstanceStartTransforms.SetNumUninitialized(NumInstances);
+    TArray<FTransform> TargetTransforms;
+    TargetTransforms.SetNumUninitialized(NumInstances);
+
+    for (int32 Index = 0; Index < NumInstances; ++Index)
+    {
+        Instances->GetInstanceTransform(Index, InstanceStartTransforms[Index], false);
+        TargetTransforms[Index] = MakeInstanceTarget(InstanceStartTransforms[Index], ToWorldPositions[Assignment[Index]]);
+    }
+
+    InstanceRunner.InitTransforms(InstanceStartTransforms, TargetTransforms);
+    TargetInstances = Instances;
+
+    TransitionState.bIsTransitioning = true;
+    TransitionState.StartTime = GetWorld()->GetTimeSeconds();
+    TransitionState.OverallProgress = 0.0f;
+    TransitionState.Config = Config;
+    TransitionState.UnitTransitions.Reset();
+    SetComponentTickEnabled(true);
+
+    if (bSolveAsync)
+    {
+        // 路径冲突在最优分配返回后再检测
+        TransitionState.ConflictInfo = FPathConflictInfo();
+        LaunchAsyncAssignment(FromWorldPositions, ToWorldPositions, Config.TransitionMode);
+    }
+    else
+    {
+        TransitionState.ConflictInfo = DetectPathConflicts(Assignment, FromWorldPositions, ToWorldPositions);
+    }
+
+    return true;
+}
+
+FTransform UFormationInstancedManagerComponent::MakeInstanceTarget(const FTransform& Start, const FVector& TargetWorldPosition) const
+{
+    FTransform Target = Start;
+    Target.SetLocation(InstanceComponentTransform.InverseTransformPosition(TargetWorldPosition));
+
+    // 计算目标朝向（朝向移动方向）
+    const FVector MovementDirection = Target.GetLocation() - Start.GetLocation();
+    if (bFaceMovementDirection && !MovementDirection.IsNearlyZero())
+    {
+        Target.SetRotation(MovementDirection.Rotation().Quaternion());
+    }
+    return Target;
+}
+
+void UFormationInstancedManagerComponent::StopFormationTransition(bool bSnapToTarget)
+{
+    if (TransitionState.bIsTransitioning && bSnapToTarget && InstanceRunner.Num() > 0)
+    {
+        UInstancedStaticMeshComponent* Instances = TargetInstances.Get();
+        if (Instances && Instances->GetInstanceCount() == InstanceRunner.Num())
+        {
+            PushInstanceTransforms(1.0f);
+        }
+    }
+
+    InstanceRunner.Reset();
+    InstanceStartTransforms.Reset();
+    Super::StopFormationTransition(bSnapToTarget);
+}
+
+void UFormationInstancedManagerComponent::UpdateUnitPositions(float DeltaTime)
+{
+    // 没有实例变换时按 Actor 版本处理
+    if (InstanceRunner.Num() == 0)
+    {
+        Super::UpdateUnitPositions(DeltaTime);
+        return;
+    }
+
+    if (!TransitionState.bIsTransitioning)
+    {
+        return;
+    }
+
+    UInstancedStaticMeshComponent* Instances = TargetInstances.Get();
+    if (!Instances || Instances->GetInstanceCount() != InstanceRunner.Num())
+    {
+        UE_LOG(LogFormationSystem, Warning, TEXT("UpdateUnitPositions: 实例化网格组件已失效或实例数量已改变，停止变换"));
+        StopFormationTransition(false);
+        return;
+    }
+
+    const float Progress = CalculateTransitionProgress();
+    TransitionState.OverallProgress = Progress;
+
+    // 后台求解已返回时先切换目标，本帧即按新目标插值
+    if (PendingAssignment.IsValid() && PendingAssignment->bCompleted.load(std::memory_order_acquire))
+    {
+        ApplyAsyncAssignment();
+    }
+
+    PushInstanceTransforms(Progress);
+
+    if (Progress >= 1.0f)
+    {
+        TransitionState.bIsTransitioning = false;
+        InstanceRunner.Reset();
+        InstanceStartTransforms.Reset();
+
+        // 变换结束前未返回的求解不再需要
+        CancelPendingAssignment();
+        SetComponentTickEnabled(false);
+
+        OnFormationTransitionCompleted.Broadcast();
+    }
+}
+
+void UFormationInstancedManagerComponent::ApplyAsyncAssignment()
+{
+    // 没有实例变换时按 Actor 版本处理
+    if (InstanceRunner.Num() == 0)
+    {
+        Super::ApplyAsyncAssignment();
+        return;
+    }
+
+    const TSharedPtr<FAsyncAssignmentRequest, ESPMode::ThreadSafe> Request = MoveTemp(PendingAssignment);
+    PendingAssignment.Reset();
+
+    const TArray<int32>& Assignment = Request->Result;
+    if (Assignment.Num() != InstanceRunner.Num() || InstanceStartTransforms.Num() != InstanceRunner.Num())
+    {
+        UE_LOG(LogFormationSystem, Warning, TEXT("ApplyAsyncAssignment: 后台求解结果无效，保留临时分配"));
+        return;
+    }
+
+    // 实例从本帧进度处的位置出发，在剩余进度内到达新目标
+    InstanceRunner.Evaluate(TransitionState.OverallProgress);
+    for (int32 Index = 0; Index < InstanceRunner.Num(); ++Index)
+    {
+        const FTransform Target = MakeInstanceTarget(InstanceStartTransforms[Index], Request->ToPositions[Assignment[Index]]);
+        InstanceRunner.Retarget(Index, Target.GetLocation(), Target.Rotator());
+    }
+
+    TransitionState.ConflictInfo = DetectPathConflicts(Assignment, Request->FromPositions, Request->ToPositions);
+}
+
+void UFormationInstancedManagerComponent::PushInstanceTransforms(float Progress)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE("Formation - Push Instance Transforms");
+
+    InstanceRunner.EvaluateTransforms(Progress, InstanceTransforms);
+
+    // 一次提交全部实例，渲染状态只标记一次
+    TargetInstances->BatchUpdateInstancesTransforms(
+        0, InstanceTransforms, false, true, TransitionState.Config.bTeleportUnits);
+}
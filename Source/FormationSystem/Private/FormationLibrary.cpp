@@ -1,12 +1,25 @@
 #include "FormationLibrary.h"
 #include "FormationMathUtils.h"
 #include "FormationLog.h"
+#include "FormationTemplateCache.h"
 #include "XToolsErrorReporter.h"
 #include "Engine/World.h"
 #include "DrawDebugHelpers.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Engine/Engine.h"
 
+namespace FormationLibrary_Private
+{
+    /** 按比例拷贝模板槽位并记录来源模板，空间排序映射据此复用模板的预排序 */
+    void CopyFromTemplate(FFormationData& Formation, const FFormationTemplateRef& Template, float Scale, float YawDegrees = 0.0f)
+    {
+        Template->CopyScaled(Scale, Formation.Positions, YawDegrees);
+        Formation.Template = Template;
+        Formation.TemplateScale = Scale;
+        Formation.TemplateYaw = YawDegrees;
+    }
+}
+
 FFormationData UFormationLibrary::CreateSquareFormation(
     FVector CenterLocation,
     FRotator Rotation,
@@ -25,39 +38,47 @@ FFormationData UFormationLibrary::CreateSquareFormation(
         return Formation;
     }
 
-    int32 Rows, Cols;
-    if (RowCount > 0)
-    {
-        Rows = RowCount;
-        Cols = FMath::CeilToInt(static_cast<float>(UnitCount) / Rows);
-    }
-    else
-    {
-        CalculateOptimalRowsCols(UnitCount, Rows, Cols);
-    }
+    FFormationTemplateKey Key;
+    Key.FormationType = EFormationType::Square;
+    Key.UnitCount = UnitCount;
+    Key.IntParam = FMath::Max(RowCount, 0);
 
-    Formation.Positions.Reserve(UnitCount);
+    // 模板以间距 1 生成
+    const FFormationTemplateRef Template = FFormationTemplateCache::Get().FindOrBuild(Key,
+        [UnitCount, RowCount](TArray<FVector>& OutOffsets, FVector2D& OutSize)
+        {
+            int32 Rows, Cols;
+            if (RowCount > 0)
+            {
+                Rows = RowCount;
+                Cols = FMath::CeilToInt(static_cast<float>(UnitCount) / Rows);
+            }
+            else
+            {
+                CalculateOptimalRowsCols(UnitCount, Rows, Cols);
+            }
 
-    // 计算起始偏移，使阵型居中
-    float StartX = -(Cols - 1) * Spacing * 0.5f;
-    float StartY = -(Rows - 1) * Spacing * 0.5f;
+            OutOffsets.Reserve(UnitCount);
 
-    int32 CurrentUnit = 0;
-    for (int32 Row = 0; Row < Rows && CurrentUnit < UnitCount; Row++)
-    {
-        for (int32 Col = 0; Col < Cols && CurrentUnit < UnitCount; Col++)
-        {
-            FVector Position(
-                StartX + Col * Spacing,
-                StartY + Row * Spacing,
-                0.0f
-            );
-            Formation.Positions.Add(Position);
-            CurrentUnit++;
-        }
-    }
+            // 计算起始偏移，使阵型居中
+            const float StartX = -(Cols - 1) * 0.5f;
+            const float StartY = -(Rows - 1) * 0.5f;
+
+            int32 CurrentUnit = 0;
+            for (int32 Row = 0; Row < Rows && CurrentUnit < UnitCount; Row++)
+            {
+                for (int32 Col = 0; Col < Cols && CurrentUnit < UnitCount; Col++)
+                {
+                    OutOffsets.Add(FVector(StartX + Col, StartY + Row, 0.0f));
+                    CurrentUnit++;
+                }
+            }
 
-    Formation.Size = FVector2D(Cols * Spacing, Rows * Spacing);
+            OutSize = FVector2D(Cols, Rows);
+        });
+
+    FormationLibrary_Private::CopyFromTemplate(Formation, Template, Spacing);
+    Formation.Size = Template->Size * Spacing;
     return Formation;
 }
 
@@ -80,35 +101,40 @@ FFormationData UFormationLibrary::CreateCircleFormation(
         return Formation;
     }
 
-    Formation.Positions.Reserve(UnitCount);
+    FFormationTemplateKey Key;
+    Key.FormationType = EFormationType::Circle;
+    Key.UnitCount = UnitCount;
+    Key.IntParam = bClockwise ? 1 : 0;
 
-    if (UnitCount == 1)
-    {
-        // 单个单位放在中心
-        Formation.Positions.Add(FVector::ZeroVector);
-    }
-    else
-    {
-        float AngleStep = 360.0f / UnitCount;
-        if (!bClockwise)
+    // 模板以半径 1、起始角 0 生成，起始角在拷贝时作为整体旋转
+    const FFormationTemplateRef Template = FFormationTemplateCache::Get().FindOrBuild(Key,
+        [UnitCount, bClockwise](TArray<FVector>& OutOffsets, FVector2D& OutSize)
         {
-            AngleStep = -AngleStep;
-        }
+            OutSize = FVector2D(2.0f, 2.0f);
+            OutOffsets.Reserve(UnitCount);
 
-        for (int32 i = 0; i < UnitCount; i++)
-        {
-            float Angle = StartAngle + i * AngleStep;
-            float RadianAngle = FMath::DegreesToRadians(Angle);
-            
-            FVector Position(
-                Radius * FMath::Cos(RadianAngle),
-                Radius * FMath::Sin(RadianAngle),
-                0.0f
-            );
-            Formation.Positions.Add(Position);
-        }
-    }
+            if (UnitCount == 1)
+            {
+                // 单个单位放在中心
+                OutOffsets.Add(FVector::ZeroVector);
+                return;
+            }
+
+            float AngleStep = 360.0f / UnitCount;
+            if (!bClockwise)
+            {
+                AngleStep = -AngleStep;
+            }
+
+            for (int32 i = 0; i < UnitCount; i++)
+            {
+                float Sin, Cos;
+                FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(i * AngleStep));
+                OutOffsets.Add(FVector(Cos, Sin, 0.0f));
+            }
+        });
 
+    FormationLibrary_Private::CopyFromTemplate(Formation, Template, Radius, StartAngle);
     return Formation;
 }
 
@@ -172,43 +198,50 @@ FFormationData UFormationLibrary::CreateTriangleFormation(
         return Formation;
     }
 
-    Formation.Positions.Reserve(UnitCount);
+    FFormationTemplateKey Key;
+    Key.FormationType = EFormationType::Triangle;
+    Key.UnitCount = UnitCount;
+    Key.IntParam = bInverted ? 1 : 0;
 
-    // 生成三角形的行分布
-    TArray<int32> RowDistribution = GenerateTriangleRowDistribution(UnitCount, bInverted);
-    
-    int32 MaxUnitsInRow = 0;
-    for (int32 UnitsInRow : RowDistribution)
-    {
-        MaxUnitsInRow = FMath::Max(MaxUnitsInRow, UnitsInRow);
-    }
+    // 模板以间距 1 生成
+    const FFormationTemplateRef Template = FFormationTemplateCache::Get().FindOrBuild(Key,
+        [UnitCount, bInverted](TArray<FVector>& OutOffsets, FVector2D& OutSize)
+        {
+            OutOffsets.Reserve(UnitCount);
 
-    // 计算阵型尺寸
-    float Width = (MaxUnitsInRow - 1) * Spacing;
-    float Height = (RowDistribution.Num() - 1) * Spacing;
-    Formation.Size = FVector2D(Width, Height);
+            // 生成三角形的行分布
+            const TArray<int32> RowDistribution = GenerateTriangleRowDistribution(UnitCount, bInverted);
 
-    // 计算起始Y偏移
-    float StartY = -Height * 0.5f;
+            int32 MaxUnitsInRow = 0;
+            for (int32 UnitsInRow : RowDistribution)
+            {
+                MaxUnitsInRow = FMath::Max(MaxUnitsInRow, UnitsInRow);
+            }
 
-    int32 CurrentUnit = 0;
-    for (int32 Row = 0; Row < RowDistribution.Num() && CurrentUnit < UnitCount; Row++)
-    {
-        int32 UnitsInThisRow = RowDistribution[Row];
-        float RowStartX = -(UnitsInThisRow - 1) * Spacing * 0.5f;
-        
-        for (int32 Col = 0; Col < UnitsInThisRow && CurrentUnit < UnitCount; Col++)
-        {
-            FVector Position(
-                RowStartX + Col * Spacing,
-                StartY + Row * Spacing,
-                0.0f
-            );
-            Formation.Positions.Add(Position);
-            CurrentUnit++;
-        }
-    }
+            // 计算阵型尺寸
+            const float Width = MaxUnitsInRow - 1;
+            const float Height = RowDistribution.Num() - 1;
+            OutSize = FVector2D(Width, Height);
+
+            // 计算起始Y偏移
+            const float StartY = -Height * 0.5f;
+
+            int32 CurrentUnit = 0;
+            for (int32 Row = 0; Row < RowDistribution.Num() && CurrentUnit < UnitCount; Row++)
+            {
+                const int32 UnitsInThisRow = RowDistribution[Row];
+                const float RowStartX = -(UnitsInThisRow - 1) * 0.5f;
 
+                for (int32 Col = 0; Col < UnitsInThisRow && CurrentUnit < UnitCount; Col++)
+                {
+                    OutOffsets.Add(FVector(RowStartX + Col, StartY + Row, 0.0f));
+                    CurrentUnit++;
+                }
+            }
+        });
+
+    FormationLibrary_Private::CopyFromTemplate(Formation, Template, Spacing);
+    Formation.Size = Template->Size * Spacing;
     return Formation;
 }
 
@@ -293,33 +326,37 @@ FFormationData UFormationLibrary::CreateSpiralFormation(
         return Formation;
     }
 
-    Formation.Positions.Reserve(UnitCount);
-
-    if (UnitCount == 1)
-    {
-        Formation.Positions.Add(FVector::ZeroVector);
-    }
-    else
-    {
-        float TotalAngle = Turns * 360.0f;
-        float AngleStep = TotalAngle / (UnitCount - 1);
+    FFormationTemplateKey Key;
+    Key.FormationType = EFormationType::Spiral;
+    Key.UnitCount = UnitCount;
+    Key.FloatParam = Turns;
 
-        for (int32 i = 0; i < UnitCount; i++)
+    // 模板以半径 1 生成
+    const FFormationTemplateRef Template = FFormationTemplateCache::Get().FindOrBuild(Key,
+        [UnitCount, Turns](TArray<FVector>& OutOffsets, FVector2D& OutSize)
         {
-            float Progress = static_cast<float>(i) / (UnitCount - 1);
-            float CurrentRadius = Radius * Progress; // 半径逐渐增大
-            float Angle = i * AngleStep;
-            float RadianAngle = FMath::DegreesToRadians(Angle);
+            OutSize = FVector2D(2.0f, 2.0f);
+            OutOffsets.Reserve(UnitCount);
 
-            FVector Position(
-                CurrentRadius * FMath::Cos(RadianAngle),
-                CurrentRadius * FMath::Sin(RadianAngle),
-                0.0f
-            );
-            Formation.Positions.Add(Position);
-        }
-    }
+            if (UnitCount == 1)
+            {
+                OutOffsets.Add(FVector::ZeroVector);
+                return;
+            }
 
+            const float TotalAngle = Turns * 360.0f;
+            const float AngleStep = TotalAngle / (UnitCount - 1);
+
+            for (int32 i = 0; i < UnitCount; i++)
+            {
+                const float Progress = static_cast<float>(i) / (UnitCount - 1); // 半径逐渐增大
+                float Sin, Cos;
+                FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(i * AngleStep));
+                OutOffsets.Add(FVector(Progress * Cos, Progress * Sin, 0.0f));
+            }
+        });
+
+    FormationLibrary_Private::CopyFromTemplate(Formation, Template, Radius);
     return Formation;
 }
 
@@ -340,54 +377,47 @@ FFormationData UFormationLibrary::CreateSolidCircleFormation(
         return Formation;
     }
 
-    Formation.Positions.Reserve(UnitCount);
+    FFormationTemplateKey Key;
+    Key.FormationType = EFormationType::SolidCircle;
+    Key.UnitCount = UnitCount;
 
-    if (UnitCount == 1)
-    {
-        Formation.Positions.Add(FVector::ZeroVector);
-    }
-    else
-    {
-        // 计算需要多少层圆环
-        int32 RemainingUnits = UnitCount;
-        float CurrentRadius = 0.0f;
-        float RadiusStep = Radius / FMath::Max(1.0f, FMath::Sqrt(static_cast<float>(UnitCount)) * 0.5f);
-
-        // 中心点
-        if (RemainingUnits > 0)
-        {
-            Formation.Positions.Add(FVector::ZeroVector);
-            RemainingUnits--;
-        }
-
-        // 生成同心圆环
-        while (RemainingUnits > 0 && CurrentRadius < Radius)
+    // 模板以半径 1 生成
+    const FFormationTemplateRef Template = FFormationTemplateCache::Get().FindOrBuild(Key,
+        [UnitCount](TArray<FVector>& OutOffsets, FVector2D& OutSize)
         {
-            CurrentRadius += RadiusStep;
+            OutSize = FVector2D(2.0f, 2.0f);
+            OutOffsets.Reserve(UnitCount);
 
-            // 计算这一层可以放多少个单位
-            float Circumference = 2.0f * PI * CurrentRadius;
-            int32 UnitsInThisRing = FMath::Max(1, FMath::FloorToInt(Circumference / (RadiusStep * 0.8f)));
-            UnitsInThisRing = FMath::Min(UnitsInThisRing, RemainingUnits);
+            // 中心点
+            OutOffsets.Add(FVector::ZeroVector);
+            int32 RemainingUnits = UnitCount - 1;
 
-            float AngleStep = 360.0f / UnitsInThisRing;
+            // 计算需要多少层圆环
+            const float RadiusStep = 1.0f / FMath::Max(1.0f, FMath::Sqrt(static_cast<float>(UnitCount)) * 0.5f);
 
-            for (int32 i = 0; i < UnitsInThisRing; i++)
+            // 生成同心圆环，按层序号计算半径，避免累加误差改变层数
+            for (int32 Ring = 1; RemainingUnits > 0 && (Ring - 1) * RadiusStep < 1.0f; Ring++)
             {
-                float Angle = i * AngleStep;
-                float RadianAngle = FMath::DegreesToRadians(Angle);
-
-                FVector Position(
-                    CurrentRadius * FMath::Cos(RadianAngle),
-                    CurrentRadius * FMath::Sin(RadianAngle),
-                    0.0f
-                );
-                Formation.Positions.Add(Position);
-                RemainingUnits--;
+                const float CurrentRadius = Ring * RadiusStep;
+
+                // 计算这一层可以放多少个单位
+                const float Circumference = 2.0f * PI * CurrentRadius;
+                int32 UnitsInThisRing = FMath::Max(1, FMath::FloorToInt(Circumference / (RadiusStep * 0.8f)));
+                UnitsInThisRing = FMath::Min(UnitsInThisRing, RemainingUnits);
+
+                const float AngleStep = 360.0f / UnitsInThisRing;
+
+                for (int32 i = 0; i < UnitsInThisRing; i++)
+                {
+                    float Sin, Cos;
+                    FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(i * AngleStep));
+                    OutOffsets.Add(FVector(CurrentRadius * Cos, CurrentRadius * Sin, 0.0f));
+                    RemainingUnits--;
+                }
             }
-        }
-    }
+        });
 
+    FormationLibrary_Private::CopyFromTemplate(Formation, Template, Radius);
     return Formation;
 }
 
@@ -11,6 +11,7 @@
 #include "Components/SceneComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 DECLARE_STATS_GROUP(TEXT("FormationSystem"), STATGROUP_FormationSystem, STATCAT_Advanced)
 DECLARE_CYCLE_STAT(TEXT("UpdateUnitPositions"), STAT_UpdateUnitPositions, STATGROUP_FormationSystem)
@@ -54,6 +55,18 @@ void UFormationManagerComponent::BeginPlay()
     Super::BeginPlay();
 }
 
+void UFormationManagerComponent::BeginDestroy()
+{
+    // 后台任务持有 this，销毁前必须等待其结束
+    CancelPendingAssignment();
+    if (AssignmentTask.IsValid())
+    {
+        AssignmentTask.Wait();
+    }
+
+    Super::BeginDestroy();
+}
+
 void UFormationManagerComponent::DestroyOwnerActor()
 {
     AActor* Owner = GetOwner();
@@ -67,6 +80,11 @@ void UFormationManagerComponent::TickComponent(float DeltaTime, ELevelTick TickT
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+    AdvanceTransition(DeltaTime);
+}
+
+void UFormationManagerComponent::AdvanceTransition(float DeltaTime)
+{
     if (TransitionState.bIsTransitioning)
     {
         UpdateUnitPositions(DeltaTime);
@@ -158,16 +176,20 @@ bool UFormationManagerComponent::StartFormationTransition(
         return false;
     }
 
+    // 新命令取代尚未返回的后台求解
+    CancelPendingAssignment();
+    bInterfaceNotified = false;
+
     // 获取世界坐标位置
     TArray<FVector> FromWorldPositions = FromFormation.GetWorldPositions();
     TArray<FVector> ToWorldPositions = ToFormation.GetWorldPositions();
+    PrepareSpatialOrderHints(FromFormation, FromWorldPositions, ToFormation, ToWorldPositions, Config.TransitionMode);
 
-    // 计算最优分配
-    TArray<int32> Assignment = CalculateOptimalAssignment(
-        FromWorldPositions,
-        ToWorldPositions,
-        Config.TransitionMode
-    );
+    // 大规模阵型先用临时分配开始移动，最优分配在后台求解；否则同步计算最优分配
+    const bool bSolveAsync = ShouldSolveAssignmentAsync(Units.Num(), Config.TransitionMode);
+    TArray<int32> Assignment = bSolveAsync
+        ? CalculateProvisionalAssignment(FromWorldPositions, ToWorldPositions)
+        : CalculateOptimalAssignment(FromWorldPositions, ToWorldPositions, Config.TransitionMode);
 
     // 初始化变换状态并启用 Tick 驱动位置更新
     TransitionState.bIsTransitioning = true;
@@ -179,6 +201,7 @@ bool UFormationManagerComponent::StartFormationTransition(
     // 清空并预分配单位变换数据数组
     TransitionState.UnitTransitions.Empty(Units.Num());
     TransitionState.UnitTransitions.Reserve(Units.Num());
+    UnitTransitionSourceIndices.Reset(Units.Num());
 
     // 为每个单位设置变换数据
     for (int32 i = 0; i < Units.Num(); i++)
@@ -214,10 +237,21 @@ bool UFormationManagerComponent::StartFormationTransition(
 
         // 添加到变换数据数组
         TransitionState.UnitTransitions.Add(UnitData);
+        UnitTransitionSourceIndices.Add(i);
     }
+    TransitionRunner.Init(TransitionState.UnitTransitions);
 
-    // 检测路径冲突
-    TransitionState.ConflictInfo = DetectPathConflicts(Assignment, FromWorldPositions, ToWorldPositions);
+    if (bSolveAsync)
+    {
+        // 路径冲突在最优分配返回后再检测
+        TransitionState.ConflictInfo = FPathConflictInfo();
+        LaunchAsyncAssignment(FromWorldPositions, ToWorldPositions, Config.TransitionMode);
+    }
+    else
+    {
+        // 检测路径冲突
+        TransitionState.ConflictInfo = DetectPathConflicts(Assignment, FromWorldPositions, ToWorldPositions);
+    }
 
     return true;
 }
@@ -239,6 +273,8 @@ bool UFormationManagerComponent::StartFormationTransitionWithInterface(
 
 void UFormationManagerComponent::NotifyFormationInterfaceActors()
 {
+    bInterfaceNotified = true;
+
     // 基于已计算好的变换数据，通知实现了 IFormationInterface 的单位
     for (const FUnitTransitionData& UnitData : TransitionState.UnitTransitions)
     {
@@ -267,24 +303,126 @@ void UFormationManagerComponent::StopFormationTransition(bool bSnapToTarget)
 
     if (bSnapToTarget)
     {
-        for (FUnitTransitionData& UnitData : TransitionState.UnitTransitions)
-        {
-            if (UnitData.TargetActor.IsValid())
-            {
-                AActor* Actor = UnitData.TargetActor.Get();
-                Actor->SetActorLocation(UnitData.TargetLocation);
-                Actor->SetActorRotation(UnitData.TargetRotation);
-                Actor->SetActorScale3D(UnitData.TargetScale);
-            }
-        }
+        TransitionRunner.Evaluate(1.0f);
+        TransitionRunner.Apply(TransitionState.Config.bTeleportUnits);
     }
 
     TransitionState.bIsTransitioning = false;
     TransitionState.OverallProgress = 0.0f;
     TransitionState.UnitTransitions.Empty();
+    TransitionRunner.Reset();
+    UnitTransitionSourceIndices.Reset();
+    CancelPendingAssignment();
     SetComponentTickEnabled(false);
 }
 
+// ========== 异步分配求解 ==========
+
+bool UFormationManagerComponent::ShouldSolveAssignmentAsync(int32 NumUnits, EFormationTransitionMode Mode) const
+{
+    return AsyncAssignmentThreshold > 0
+        && NumUnits >= AsyncAssignmentThreshold
+        && Mode != EFormationTransitionMode::DirectMapping;
+}
+
+void UFormationManagerComponent::LaunchAsyncAssignment(
+    const TArray<FVector>& FromPositions,
+    const TArray<FVector>& ToPositions,
+    EFormationTransitionMode Mode)
+{
+    TSharedRef<FAsyncAssignmentRequest, ESPMode::ThreadSafe> Request = MakeShared<FAsyncAssignmentRequest, ESPMode::ThreadSafe>();
+    Request->FromPositions = FromPositions;
+    Request->ToPositions = ToPositions;
+    Request->Mode = Mode;
+    Request->SpatialOrderHints = SpatialOrderHints;
+    PendingAssignment = Request;
+
+    auto Solve = [this, Request]()
+    {
+        // 排队期间已被新命令取代的求解直接跳过
+        if (Request->bCancelled.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        TRACE_CPUPROFILER_EVENT_SCOPE("Formation - Async Assignment");
+        TGuardValue<const std::atomic<bool>*> CancelFlagGuard(SolveCancelFlag, &Request->bCancelled);
+        Request->Result = CalculateAssignmentByMode(Request->FromPositions, Request->ToPositions, Request->Mode, &Request->SpatialOrderHints);
+        Request->bCompleted.store(true, std::memory_order_release);
+    };
+
+    // 与上一个求解任务串行执行，二者共用缓存状态
+    if (AssignmentTask.IsValid())
+    {
+        AssignmentTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(Solve), UE::Tasks::Prerequisites(AssignmentTask));
+    }
+    else
+    {
+        AssignmentTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(Solve));
+    }
+}
+
+void UFormationManagerComponent::CancelPendingAssignment()
+{
+    if (PendingAssignment.IsValid())
+    {
+        PendingAssignment->bCancelled.store(true, std::memory_order_relaxed);
+        PendingAssignment.Reset();
+    }
+}
+
+void UFormationManagerComponent::WaitForAssignmentTask()
+{
+    if (IsInGameThread() && AssignmentTask.IsValid() && !AssignmentTask.IsCompleted())
+    {
+        AssignmentTask.Wait();
+    }
+}
+
+void UFormationManagerComponent::ApplyAsyncAssignment()
+{
+    const TSharedPtr<FAsyncAssignmentRequest, ESPMode::ThreadSafe> Request = MoveTemp(PendingAssignment);
+    PendingAssignment.Reset();
+
+    const TArray<int32>& Assignment = Request->Result;
+    if (Assignment.Num() != Request->FromPositions.Num())
+    {
+        UE_LOG(LogFormationSystem, Warning, TEXT("ApplyAsyncAssignment: 后台求解结果无效，保留临时分配"));
+        return;
+    }
+
+    TArray<FUnitTransitionData>& UnitTransitions = TransitionState.UnitTransitions;
+    for (int32 Index = 0; Index < UnitTransitions.Num(); ++Index)
+    {
+        FUnitTransitionData& UnitData = UnitTransitions[Index];
+        const FVector NewTarget = Request->ToPositions[Assignment[UnitTransitionSourceIndices[Index]]];
+        if (NewTarget.Equals(UnitData.TargetLocation))
+        {
+            continue;
+        }
+
+        UnitData.TargetLocation = NewTarget;
+        const FVector MovementDirection = UnitData.TargetLocation - UnitData.StartLocation;
+        UnitData.TargetRotation = MovementDirection.IsNearlyZero() ? UnitData.StartRotation : MovementDirection.Rotation();
+
+        // 已通过接口收到临时目标的单位需要得知最终目标
+        AActor* Unit = UnitData.TargetActor.Get();
+        if (bInterfaceNotified && IsValid(Unit) && Unit->Implements<UFormationInterface>())
+        {
+            IFormationInterface::Execute_OnFormationPositionAssigned(Unit, UnitData.TargetLocation, TransitionState.Config);
+        }
+    }
+
+    // 单位从当前位置出发，在剩余进度内到达新目标
+    for (int32 Index = 0; Index < TransitionRunner.Num(); ++Index)
+    {
+        const FUnitTransitionData& UnitData = UnitTransitions[TransitionRunner.GetUnitIndex(Index)];
+        TransitionRunner.Retarget(Index, UnitData.TargetLocation, UnitData.TargetRotation);
+    }
+
+    TransitionState.ConflictInfo = DetectPathConflicts(Assignment, Request->FromPositions, Request->ToPositions);
+}
+
 // ========== 算法实现 ==========
 
 TArray<int32> UFormationManagerComponent::CalculateOptimalAssignment(
@@ -293,6 +431,7 @@ TArray<int32> UFormationManagerComponent::CalculateOptimalAssignment(
     EFormationTransitionMode TransitionMode)
 {
     SCOPE_CYCLE_COUNTER(STAT_CalculateOptimalAssignment);
+
     // 性能优化：条件日志记录，避免不必要的字符串构造
     UE_LOG(LogFormationSystem, VeryVerbose, TEXT("FormationManager: 开始计算最优分配，单位数量: %d"), FromPositions.Num());
 
@@ -307,11 +446,18 @@ TArray<int32> UFormationManagerComponent::CalculateOptimalAssignment(
         return TArray<int32>();
     }
 
+    // 除按索引映射外的模式都会读写成本矩阵缓存与热启动数据，不能与后台求解同时进行；
+    // 新命令已先取消等待中的求解，正在运行的求解会在下一轮迭代返回
+    if (TransitionMode != EFormationTransitionMode::DirectMapping)
+    {
+        WaitForAssignmentTask();
+    }
+
     // 性能监控：计算耗时统计
     double StartTime = FPlatformTime::Seconds();
 
     // 简化的算法选择 - 使用统一的成本矩阵方法
-    TArray<int32> Result = CalculateAssignmentByMode(FromPositions, ToPositions, TransitionMode);
+    TArray<int32> Result = CalculateAssignmentByMode(FromPositions, ToPositions, TransitionMode, IsInGameThread() ? &SpatialOrderHints : nullptr);
 
     double ElapsedTime = FPlatformTime::Seconds() - StartTime;
     UE_LOG(LogFormationSystem, VeryVerbose, TEXT("FormationManager: 分配计算完成，耗时: %.3fms"), ElapsedTime * 1000.0);
@@ -322,7 +468,8 @@ TArray<int32> UFormationManagerComponent::CalculateOptimalAssignment(
 TArray<int32> UFormationManagerComponent::CalculateAssignmentByMode(
     const TArray<FVector>& FromPositions,
     const TArray<FVector>& ToPositions,
-    EFormationTransitionMode Mode)
+    EFormationTransitionMode Mode,
+    const FSpatialOrderHints* OrderHints)
 {
     // 专用算法直接分发，不走成本矩阵路径
     switch (Mode)
@@ -340,17 +487,17 @@ TArray<int32> UFormationManagerComponent::CalculateAssignmentByMode(
         }
 
     case EFormationTransitionMode::DirectRelativePositionMatching:
-        return CalculateDirectRelativePositionMatching(FromPositions, ToPositions);
+        return CalculateDirectRelativePositionMatching(FromPositions, ToPositions, OrderHints);
 
     case EFormationTransitionMode::SpatialOrderMapping:
     case EFormationTransitionMode::DistancePriorityAssignment:
-        return CalculateSpatialOrderMapping(FromPositions, ToPositions);
+        return CalculateSpatialOrderMapping(FromPositions, ToPositions, OrderHints);
 
     case EFormationTransitionMode::RTSFlockMovement:
         return CalculateRTSFlockMovementAssignment(FromPositions, ToPositions);
 
     case EFormationTransitionMode::PathAwareAssignment:
-        return CalculatePathAwareAssignment(FromPositions, ToPositions);
+        return CalculatePathAwareAssignment(FromPositions, ToPositions, OrderHints);
 
     case EFormationTransitionMode::OptimizedAssignment:
     case EFormationTransitionMode::SimpleAssignment:
@@ -360,14 +507,26 @@ TArray<int32> UFormationManagerComponent::CalculateAssignmentByMode(
 
     // OptimizedAssignment / SimpleAssignment 走成本矩阵路径
     bool bUseRelativePosition = (Mode == EFormationTransitionMode::OptimizedAssignment);
-    TArray<TArray<float>> CostMatrix = CreateCostMatrix(FromPositions, ToPositions, bUseRelativePosition);
+    if (AssignmentSolver != EFormationAssignmentSolver::Greedy && FromPositions.Num() >= SparseAssignmentThreshold)
+    {
+        return SolveSparseAssignment(FromPositions, ToPositions, bUseRelativePosition);
+    }
+
+    const FFormationCostMatrix& CachedMatrix = CreateCostMatrix(FromPositions, ToPositions, bUseRelativePosition);
+    if (Mode != EFormationTransitionMode::RTSFlockMovement)
+    {
+        // 这些模式没有成本修正，直接使用缓存矩阵，避免复制
+        return SolveAssignmentProblem(CachedMatrix);
+    }
+
+    FFormationCostMatrix CostMatrix = CachedMatrix;
     ApplyCostModifications(CostMatrix, FromPositions, ToPositions, Mode);
     return SolveAssignmentProblem(CostMatrix);
 }
 
 // 简化的工具函数实现
 
-TArray<TArray<float>> UFormationManagerComponent::CreateCostMatrix(
+const FFormationCostMatrix& UFormationManagerComponent::CreateCostMatrix(
     const TArray<FVector>& FromPositions,
     const TArray<FVector>& ToPositions,
     bool bUseRelativePosition)
@@ -386,26 +545,25 @@ TArray<TArray<float>> UFormationManagerComponent::CreateCostMatrix(
         return CostMatrixCache.CostMatrix;
     }
 
-    // 计算新的成本矩阵
-    TArray<TArray<float>> NewCostMatrix;
+    // 直接在缓存中构建新的成本矩阵，尺寸不变时复用已有内存
     if (bUseRelativePosition)
     {
-        NewCostMatrix = CalculateRelativePositionCostMatrix(FromPositions, ToPositions);
+        FFormationCostMatrix::BuildRelativePosition(FromPositions, ToPositions, CostMatrixCache.CostMatrix);
     }
     else
     {
-        NewCostMatrix = CalculateAbsoluteDistanceCostMatrix(FromPositions, ToPositions);
+        FFormationCostMatrix::BuildAbsoluteDistance(FromPositions, ToPositions, CostMatrixCache.CostMatrix);
     }
 
     // 更新缓存
-    CostMatrixCache.UpdateCache(PositionsHash, CacheMode, NewCostMatrix, CurrentTime);
+    CostMatrixCache.UpdateCache(PositionsHash, CacheMode, CurrentTime);
 
-    return NewCostMatrix;
+    return CostMatrixCache.CostMatrix;
 }
 
 uint32 UFormationManagerComponent::CalculatePositionsHash(
     const TArray<FVector>& FromPositions,
-    const TArray<FVector>& ToPositions) const
+    const TArray<FVector>& ToPositions)
 {
     // 性能优化：高效的位置哈希计算
     uint32 Hash = 0;
@@ -439,17 +597,15 @@ bool UFormationManagerComponent::FCostMatrixCache::IsValid(
 void UFormationManagerComponent::FCostMatrixCache::UpdateCache(
     uint32 NewHash,
     EFormationTransitionMode NewMode,
-    const TArray<TArray<float>>& NewMatrix,
     double CurrentTime)
 {
     PositionsHash = NewHash;
     Mode = NewMode;
-    CostMatrix = NewMatrix;
     CacheTime = CurrentTime;
 }
 
 void UFormationManagerComponent::ApplyCostModifications(
-    TArray<TArray<float>>& CostMatrix,
+    FFormationCostMatrix& CostMatrix,
     const TArray<FVector>& FromPositions,
     const TArray<FVector>& ToPositions,
     EFormationTransitionMode Mode)
@@ -465,8 +621,7 @@ void UFormationManagerComponent::ApplyCostModifications(
                 for (int32 j = 0; j < ToPositions.Num(); j++)
                 {
                     float FlockingBonus = CalculateFlockingBonus(i, j, FromPositions, ToPositions);
-                    CostMatrix[i][j] -= FlockingBonus;
-                    CostMatrix[i][j] = FMath::Max(1.0f, CostMatrix[i][j]);
+                    CostMatrix(i, j) = FMath::Max(1.0f, CostMatrix(i, j) - FlockingBonus);
                 }
             }
             break;
@@ -497,19 +652,19 @@ void UFormationManagerComponent::UpdateUnitPositions(float DeltaTime)
         return;
     }
 
-    float CurrentTime = GetWorld()->GetTimeSeconds();
-    float ElapsedTime = CurrentTime - TransitionState.StartTime;
-    float Duration = FMath::Max(TransitionState.Config.Duration, 0.1f);
-    float RawProgress = FMath::Clamp(ElapsedTime / Duration, 0.0f, 1.0f);
-    
-    float Progress = RawProgress;
-    if (TransitionState.Config.bUseEasing)
+    const float Progress = CalculateTransitionProgress();
+    TransitionState.OverallProgress = Progress;
+
+    // 后台求解已返回时先切换目标，本帧即按新目标插值
+    if (PendingAssignment.IsValid() && PendingAssignment->bCompleted.load(std::memory_order_acquire))
     {
-        Progress = ApplyEasing(RawProgress, TransitionState.Config.EasingStrength);
+        ApplyAsyncAssignment();
     }
-    
-    TransitionState.OverallProgress = Progress;
-    
+
+    // 进度对所有单位相同：先批量插值，再一次性写回组件变换
+    TransitionRunner.Evaluate(Progress);
+    TransitionRunner.Apply(TransitionState.Config.bTeleportUnits);
+
     bool bAllCompleted = true;
     
     for (FUnitTransitionData& UnitData : TransitionState.UnitTransitions)
@@ -519,22 +674,14 @@ void UFormationManagerComponent::UpdateUnitPositions(float DeltaTime)
             continue;
         }
         
-        AActor* Actor = UnitData.TargetActor.Get();
         UnitData.Progress = Progress;
         
-        FVector CurrentLocation = FMath::Lerp(UnitData.StartLocation, UnitData.TargetLocation, Progress);
-        FRotator CurrentRotation = FMath::Lerp(UnitData.StartRotation, UnitData.TargetRotation, Progress);
-        FVector CurrentScale = FMath::Lerp(UnitData.StartScale, UnitData.TargetScale, Progress);
-        
-        Actor->SetActorLocation(CurrentLocation);
-        Actor->SetActorRotation(CurrentRotation);
-        Actor->SetActorScale3D(CurrentScale);
-        
         if (Progress >= 1.0f)
         {
             UnitData.bCompleted = true;
 
             // 首次完成时通知接口（仅调用一次）
+            AActor* Actor = UnitData.TargetActor.Get();
             if (IsValid(Actor) && Actor->Implements<UFormationInterface>())
             {
                 IFormationInterface::Execute_OnFormationTransitionCompleted(Actor, UnitData.TargetLocation);
@@ -549,6 +696,10 @@ void UFormationManagerComponent::UpdateUnitPositions(float DeltaTime)
     if (bAllCompleted)
     {
         TransitionState.bIsTransitioning = false;
+        TransitionRunner.Reset();
+
+        // 变换结束前未返回的求解不再需要
+        CancelPendingAssignment();
         SetComponentTickEnabled(false);
 
         // 通知 Owner Actor 过渡已完成，由外部决定是否销毁
@@ -556,6 +707,20 @@ void UFormationManagerComponent::UpdateUnitPositions(float DeltaTime)
     }
 }
 
+float UFormationManagerComponent::CalculateTransitionProgress() const
+{
+    float CurrentTime = GetWorld()->GetTimeSeconds();
+    float ElapsedTime = CurrentTime - TransitionState.StartTime;
+    float Duration = FMath::Max(TransitionState.Config.Duration, 0.1f);
+    float RawProgress = FMath::Clamp(ElapsedTime / Duration, 0.0f, 1.0f);
+
+    if (TransitionState.Config.bUseEasing)
+    {
+        return ApplyEasing(RawProgress, TransitionState.Config.EasingStrength);
+    }
+    return RawProgress;
+}
+
 float UFormationManagerComponent::ApplyEasing(float Progress, float Strength) const
 {
     return FFormationMathUtils::ApplyEasing(Progress, Strength);
@@ -1,5 +1,15 @@
 #include "FormationMathUtils.h"
 #include "FormationLog.h"
+#include "Async/ParallelFor.h"
+
+namespace FormationMathUtils_Private
+{
+    /** 单位数达到该值时按单位并行计算群集力 */
+    constexpr int32 BoidsParallelThreshold = 256;
+
+    /** 网格格子总数上限（相对单位数量的倍数），单位分布很稀疏时放大格子，避免内存随分布范围增长 */
+    constexpr int32 MaxBoidsCellsPerUnit = 4;
+}
 
 bool FFormationMathUtils::DoPathsIntersect(
     const FVector& Start1, const FVector& End1,
@@ -89,7 +99,23 @@ bool FFormationMathUtils::DoPathsIntersect(
     return false;
 }
 
-// TODO: 使用空间分区将 O(N^2) 邻域查询优化为 O(N)
+float FFormationMathUtils::CalculateClosestApproach(
+    const FVector& Start1, const FVector& End1,
+    const FVector& Start2, const FVector& End2,
+    float& OutTime)
+{
+    // 相对运动：D(t) = D0 + DV * t，求 |D(t)| 在 [0,1] 上的最小值
+    const FVector2D D0(Start2.X - Start1.X, Start2.Y - Start1.Y);
+    const FVector2D DV((End2.X - Start2.X) - (End1.X - Start1.X), (End2.Y - Start2.Y) - (End1.Y - Start1.Y));
+
+    const double DVLengthSquared = DV.SizeSquared();
+    OutTime = DVLengthSquared > UE_DOUBLE_SMALL_NUMBER
+        ? static_cast<float>(FMath::Clamp(-FVector2D::DotProduct(D0, DV) / DVLengthSquared, 0.0, 1.0))
+        : 0.0f;
+    return static_cast<float>((D0 + DV * OutTime).Size());
+}
+
+// 单个单位的查询遍历全部单位；需要计算所有单位时使用 CalculateBoidsForces
 FVector FFormationMathUtils::CalculateSeparationForce(
     int32 UnitIndex,
     const TArray<FVector>& Positions,
@@ -226,6 +252,194 @@ FVector FFormationMathUtils::CalculateCohesionForce(
     return FVector::ZeroVector;
 }
 
+void FBoidsNeighborGrid::Build(const TArray<FVector>& Positions, const TArray<FVector>& Velocities, float QueryRadius)
+{
+    using namespace FormationMathUtils_Private;
+
+    const int32 NumUnits = Positions.Num();
+    const bool bHasVelocities = Velocities.Num() == NumUnits;
+    const FBox Bounds = NumUnits > 0 ? FBox(Positions) : FBox(FVector::ZeroVector, FVector::ZeroVector);
+    const FVector Extent = Bounds.GetSize();
+    Origin = Bounds.Min;
+
+    // 格子边长不小于查询半径即可保证正确，放大格子只会增加候选数量
+    CellSize = FMath::Max(QueryRadius, 1.0f);
+    const int64 MaxCells = FMath::Max<int64>(static_cast<int64>(NumUnits) * MaxBoidsCellsPerUnit, 1);
+    while ((static_cast<int64>(Extent.X / CellSize) + 1) * (static_cast<int64>(Extent.Y / CellSize) + 1) > MaxCells)
+    {
+        CellSize *= 2.0f;
+    }
+    SizeX = static_cast<int32>(Extent.X / CellSize) + 1;
+    SizeY = static_cast<int32>(Extent.Y / CellSize) + 1;
+    const int32 NumCells = SizeX * SizeY;
+
+    // 计数排序：先统计每个格子的单位数，UnitSlots 暂存每个单位所在的格子
+    CellStarts.Init(0, NumCells + 1);
+    UnitSlots.SetNumUninitialized(NumUnits);
+    for (int32 Unit = 0; Unit < NumUnits; ++Unit)
+    {
+        const FVector Local = Positions[Unit] - Origin;
+        const int32 CellX = FMath::Clamp(FMath::FloorToInt32(Local.X / CellSize), 0, SizeX - 1);
+        const int32 CellY = FMath::Clamp(FMath::FloorToInt32(Local.Y / CellSize), 0, SizeY - 1);
+        UnitSlots[Unit] = CellY * SizeX + CellX;
+        ++CellStarts[UnitSlots[Unit] + 1];
+    }
+    for (int32 Cell = 0; Cell < NumCells; ++Cell)
+    {
+        CellStarts[Cell + 1] += CellStarts[Cell];
+    }
+
+    // 按单位索引顺序放入槽位，同一格子内保持索引升序；放置时 CellStarts[c] 被推进到下一个格子的起点
+    UnitIndices.SetNumUninitialized(NumUnits);
+    for (int32 Unit = 0; Unit < NumUnits; ++Unit)
+    {
+        const int32 Slot = CellStarts[UnitSlots[Unit]]++;
+        UnitSlots[Unit] = Slot;
+        UnitIndices[Slot] = Unit;
+    }
+    for (int32 Cell = NumCells; Cell > 0; --Cell)
+    {
+        CellStarts[Cell] = CellStarts[Cell - 1];
+    }
+    CellStarts[0] = 0;
+
+    PositionX.SetNumUninitialized(NumUnits);
+    PositionY.SetNumUninitialized(NumUnits);
+    PositionZ.SetNumUninitialized(NumUnits);
+    VelocityX.SetNumUninitialized(NumUnits);
+    VelocityY.SetNumUninitialized(NumUnits);
+    VelocityZ.SetNumUninitialized(NumUnits);
+    for (int32 Slot = 0; Slot < NumUnits; ++Slot)
+    {
+        const int32 Unit = UnitIndices[Slot];
+        const FVector3f Local(Positions[Unit] - Origin);
+        const FVector3f Velocity = bHasVelocities ? FVector3f(Velocities[Unit]) : FVector3f::ZeroVector;
+        PositionX[Slot] = Local.X;
+        PositionY[Slot] = Local.Y;
+        PositionZ[Slot] = Local.Z;
+        VelocityX[Slot] = Velocity.X;
+        VelocityY[Slot] = Velocity.Y;
+        VelocityZ[Slot] = Velocity.Z;
+    }
+}
+
+bool FFormationMathUtils::CalculateBoidsForces(
+    const TArray<FVector>& Positions,
+    const TArray<FVector>& Velocities,
+    const FBoidsMovementParams& Params,
+    TArray<FFormationBoidsForces>& OutForces,
+    FBoidsNeighborGrid* ReusableGrid)
+{
+    using namespace FormationMathUtils_Private;
+
+    OutForces.Reset();
+    if (Velocities.Num() != 0 && Velocities.Num() != Positions.Num())
+    {
+        UE_LOG(LogFormationSystem, Warning, TEXT("CalculateBoidsForces: 速度数组大小 %d 与位置数组大小 %d 不匹配"),
+            Velocities.Num(), Positions.Num());
+        return false;
+    }
+
+    const bool bApplySeparation = Params.SeparationWeight >= 0.0f;
+    if (!bApplySeparation)
+    {
+        UE_LOG(LogFormationSystem, Warning,
+            TEXT("CalculateBoidsForces: SeparationWeight 不能为负数: %.3f"),
+            Params.SeparationWeight);
+    }
+
+    const int32 NumUnits = Positions.Num();
+    OutForces.SetNum(NumUnits);
+    if (NumUnits == 0)
+    {
+        return true;
+    }
+
+    const float QueryRadius = FMath::Max3(Params.SeparationRadius, Params.AlignmentRadius, Params.CohesionRadius);
+    FBoidsNeighborGrid LocalGrid;
+    FBoidsNeighborGrid& Grid = ReusableGrid ? *ReusableGrid : LocalGrid;
+    Grid.Build(Positions, Velocities, QueryRadius);
+
+    const float SeparationRadiusSquared = FMath::Square(Params.SeparationRadius);
+    const float AlignmentRadiusSquared = FMath::Square(Params.AlignmentRadius);
+    const float CohesionRadiusSquared = FMath::Square(Params.CohesionRadius);
+
+    ParallelFor(NumUnits, [&](int32 UnitIndex)
+    {
+        const int32 Slot = Grid.UnitSlots[UnitIndex];
+        const float X = Grid.PositionX[Slot];
+        const float Y = Grid.PositionY[Slot];
+        const float Z = Grid.PositionZ[Slot];
+
+        const int32 MinCellX = FMath::Clamp(FMath::FloorToInt32((X - QueryRadius) / Grid.CellSize), 0, Grid.SizeX - 1);
+        const int32 MaxCellX = FMath::Clamp(FMath::FloorToInt32((X + QueryRadius) / Grid.CellSize), 0, Grid.SizeX - 1);
+        const int32 MinCellY = FMath::Clamp(FMath::FloorToInt32((Y - QueryRadius) / Grid.CellSize), 0, Grid.SizeY - 1);
+        const int32 MaxCellY = FMath::Clamp(FMath::FloorToInt32((Y + QueryRadius) / Grid.CellSize), 0, Grid.SizeY - 1);
+
+        FVector3f SeparationSum = FVector3f::ZeroVector;
+        FVector3f VelocitySum = FVector3f::ZeroVector;
+        FVector3f OffsetSum = FVector3f::ZeroVector;
+        int32 SeparationCount = 0;
+        int32 AlignmentCount = 0;
+        int32 CohesionCount = 0;
+
+        for (int32 CellY = MinCellY; CellY <= MaxCellY; ++CellY)
+        {
+            // 同一行中相邻格子的槽位是连续的，整行一次遍历
+            const int32 RowCell = CellY * Grid.SizeX;
+            const int32 Begin = Grid.CellStarts[RowCell + MinCellX];
+            const int32 End = Grid.CellStarts[RowCell + MaxCellX + 1];
+            for (int32 Other = Begin; Other < End; ++Other)
+            {
+                if (Other == Slot)
+                {
+                    continue;
+                }
+
+                const float DX = Grid.PositionX[Other] - X;
+                const float DY = Grid.PositionY[Other] - Y;
+                const float DZ = Grid.PositionZ[Other] - Z;
+                const float DistSquared = DX * DX + DY * DY + DZ * DZ;
+
+                if (DistSquared < CohesionRadiusSquared)
+                {
+                    OffsetSum += FVector3f(DX, DY, DZ);
+                    ++CohesionCount;
+                }
+                if (DistSquared < AlignmentRadiusSquared)
+                {
+                    VelocitySum += FVector3f(Grid.VelocityX[Other], Grid.VelocityY[Other], Grid.VelocityZ[Other]);
+                    ++AlignmentCount;
+                }
+                if (DistSquared > 0.0f && DistSquared < SeparationRadiusSquared)
+                {
+                    // 分离力与距离成反比：-方向 / 距离 = -偏移 / 距离²
+                    SeparationSum -= FVector3f(DX, DY, DZ) / DistSquared;
+                    ++SeparationCount;
+                }
+            }
+        }
+
+        FFormationBoidsForces& Forces = OutForces[UnitIndex];
+        if (bApplySeparation && SeparationCount > 0)
+        {
+            Forces.Separation = FVector(SeparationSum / SeparationCount).GetSafeNormal() * Params.MaxSpeed * Params.SeparationWeight;
+        }
+        if (AlignmentCount > 0)
+        {
+            const FVector OwnVelocity = Velocities.Num() > 0 ? Velocities[UnitIndex] : FVector::ZeroVector;
+            const FVector AverageVelocity = FVector(VelocitySum / AlignmentCount).GetSafeNormal() * Params.MaxSpeed;
+            Forces.Alignment = (AverageVelocity - OwnVelocity) * Params.AlignmentWeight;
+        }
+        if (CohesionCount > 0)
+        {
+            Forces.Cohesion = FVector(OffsetSum / CohesionCount).GetSafeNormal() * Params.MaxSpeed * Params.CohesionWeight;
+        }
+    }, NumUnits < BoidsParallelThreshold);
+
+    return true;
+}
+
 FVector FFormationMathUtils::CalculateSeekForce(
     const FVector& CurrentPos,
     const FVector& TargetPos,
@@ -0,0 +1,302 @@
+// FormationPathConflicts.cpp - 阵型路径冲突检测
+// 时间分片 + 扫描排除粗检测，最近距离精确检测
+
+#include "FormationPathConflicts.h"
+#include "FormationMathUtils.h"
+#include "Algo/BinarySearch.h"
+#include "XToolsVersionCompat.h"
+
+namespace FormationPathConflicts_Private
+{
+    /** 时间片数量上限 */
+    constexpr int32 MaxTimeSlices = 32;
+
+    /** 过期单位超过该数量（且超过单位总数的 1/8）时重建各时间片的包围盒 */
+    constexpr int32 MinStaleUnitsBeforeRebuild = 16;
+
+    FORCEINLINE uint64 MakePairKey(int32 UnitA, int32 UnitB)
+    {
+        return (static_cast<uint64>(FMath::Min(UnitA, UnitB)) << 32) | static_cast<uint32>(FMath::Max(UnitA, UnitB));
+    }
+}
+
+FFormationPathConflictDetector::FFormationPathConflictDetector(float InThreshold)
+    : Threshold(FMath::Max(InThreshold, 0.0f))
+{
+}
+
+void FFormationPathConflictDetector::Build(
+    const TArray<FVector>& FromPositions,
+    const TArray<FVector>& ToPositions,
+    const TArray<int32>& Assignment)
+{
+    const int32 NumUnits = FMath::Min(Assignment.Num(), FromPositions.Num());
+    Starts.SetNumUninitialized(NumUnits);
+    Ends.SetNumUninitialized(NumUnits);
+    bHasPath.SetNumUninitialized(NumUnits);
+
+    for (int32 Unit = 0; Unit < NumUnits; ++Unit)
+    {
+        Starts[Unit] = FromPositions[Unit];
+        bHasPath[Unit] = ToPositions.IsValidIndex(Assignment[Unit]);
+        Ends[Unit] = bHasPath[Unit] ? ToPositions[Assignment[Unit]] : FromPositions[Unit];
+    }
+
+    bSliceIntervalsValid = false;
+}
+
+int32 FFormationPathConflictDetector::CalculateNumTimeSlices() const
+{
+    double TotalLength = 0.0;
+    int32 NumPaths = 0;
+    for (int32 Unit = 0; Unit < Num(); ++Unit)
+    {
+        if (bHasPath[Unit])
+        {
+            TotalLength += FVector::Dist2D(Starts[Unit], Ends[Unit]);
+            ++NumPaths;
+        }
+    }
+
+    if (NumPaths == 0 || Threshold <= 0.0f)
+    {
+        return 1;
+    }
+    const double AverageLength = TotalLength / NumPaths;
+    return FMath::Clamp(FMath::CeilToInt32(AverageLength / (2.0 * Threshold)), 1, FormationPathConflicts_Private::MaxTimeSlices);
+}
+
+FFormationPathConflictDetector::FSliceBox FFormationPathConflictDetector::MakeSliceBox(int32 Unit, double T0, double T1, bool bSweepAlongY) const
+{
+    const double HalfThreshold = Threshold * 0.5;
+    const FVector P0 = FMath::Lerp(Starts[Unit], Ends[Unit], T0);
+    const FVector P1 = FMath::Lerp(Starts[Unit], Ends[Unit], T1);
+
+    FSliceBox Box;
+    Box.MinA = FMath::Min(P0.X, P1.X) - HalfThreshold;
+    Box.MaxA = FMath::Max(P0.X, P1.X) + HalfThreshold;
+    Box.MinB = FMath::Min(P0.Y, P1.Y) - HalfThreshold;
+    Box.MaxB = FMath::Max(P0.Y, P1.Y) + HalfThreshold;
+    Box.Unit = Unit;
+    if (bSweepAlongY)
+    {
+        Swap(Box.MinA, Box.MinB);
+        Swap(Box.MaxA, Box.MaxB);
+    }
+    return Box;
+}
+
+void FFormationPathConflictDetector::RebuildSliceIntervals() const
+{
+    const int32 NumUnits = Num();
+    const int32 NumSlices = CalculateNumTimeSlices();
+    SliceIntervals.SetNum(NumSlices);
+
+    for (int32 Slice = 0; Slice < NumSlices; ++Slice)
+    {
+        const double T0 = static_cast<double>(Slice) / NumSlices;
+        const double T1 = static_cast<double>(Slice + 1) / NumSlices;
+        const double TMid = (T0 + T1) * 0.5;
+
+        // 沿分布较广的轴扫描，重叠的候选更少
+        FBox2D CenterBounds(ForceInit);
+        for (int32 Unit = 0; Unit < NumUnits; ++Unit)
+        {
+            if (bHasPath[Unit])
+            {
+                CenterBounds += FVector2D(FMath::Lerp(Starts[Unit], Ends[Unit], TMid));
+            }
+        }
+
+        FSliceIntervals& Intervals = SliceIntervals[Slice];
+        Intervals.bSweepAlongY = CenterBounds.bIsValid && CenterBounds.GetSize().Y > CenterBounds.GetSize().X;
+        Intervals.MaxLengthA = 0.0;
+        Intervals.Boxes.Reset();
+        for (int32 Unit = 0; Unit < NumUnits; ++Unit)
+        {
+            if (bHasPath[Unit])
+            {
+                const FSliceBox& Box = Intervals.Boxes.Add_GetRef(MakeSliceBox(Unit, T0, T1, Intervals.bSweepAlongY));
+                Intervals.MaxLengthA = FMath::Max(Intervals.MaxLengthA, Box.MaxA - Box.MinA);
+            }
+        }
+
+        Intervals.Boxes.Sort([](const FSliceBox& A, const FSliceBox& B)
+        {
+            return A.MinA < B.MinA || (A.MinA == B.MinA && A.Unit < B.Unit);
+        });
+    }
+
+    StaleUnits.Reset();
+    bIsStale.Init(false, NumUnits);
+    bSliceIntervalsValid = true;
+}
+
+void FFormationPathConflictDetector::FindAllConflicts(TArray<FIntPoint>& OutPairs) const
+{
+    using namespace FormationPathConflicts_Private;
+
+    OutPairs.Reset();
+    if (!bSliceIntervalsValid || StaleUnits.Num() > 0)
+    {
+        RebuildSliceIntervals();
+    }
+
+    TArray<int32> Active;
+    TArray<uint64> Candidates;
+    for (const FSliceIntervals& Intervals : SliceIntervals)
+    {
+        const TArray<FSliceBox>& Boxes = Intervals.Boxes;
+        Active.Reset();
+        for (int32 Index = 0; Index < Boxes.Num(); ++Index)
+        {
+            const FSliceBox& Box = Boxes[Index];
+
+            // 移出扫描轴上已经结束的包围盒，同时检查剩余包围盒在另一轴上是否重叠
+            int32 NumActive = 0;
+            for (const int32 ActiveIndex : Active)
+            {
+                const FSliceBox& Other = Boxes[ActiveIndex];
+                if (Other.MaxA < Box.MinA)
+                {
+                    continue;
+                }
+
+                Active[NumActive++] = ActiveIndex;
+                if (Other.MinB <= Box.MaxB && Other.MaxB >= Box.MinB)
+                {
+                    Candidates.Add(MakePairKey(Other.Unit, Box.Unit));
+                }
+            }
+#if XTOOLS_ENGINE_5_8_OR_LATER
+            Active.SetNum(NumActive, EAllowShrinking::No);
+#else
+            Active.SetNum(NumActive, false);
+#endif
+            Active.Add(Index);
+        }
+    }
+
+    // 同一单位对可能在多个时间片中成为候选，排序去重后再做精确检测
+    Candidates.Sort();
+    uint64 PreviousKey = MAX_uint64;
+    for (const uint64 Key : Candidates)
+    {
+        if (Key == PreviousKey)
+        {
+            continue;
+        }
+        PreviousKey = Key;
+
+        const int32 UnitA = static_cast<int32>(Key >> 32);
+        const int32 UnitB = static_cast<int32>(Key & MAX_uint32);
+        if (HasConflict(UnitA, UnitB))
+        {
+            OutPairs.Add(FIntPoint(UnitA, UnitB));
+        }
+    }
+}
+
+void FFormationPathConflictDetector::FindConflictsForUnit(int32 Unit, TArray<int32>& OutUnits) const
+{
+    OutUnits.Reset();
+    if (!bHasPath.IsValidIndex(Unit) || !bHasPath[Unit])
+    {
+        return;
+    }
+
+    if (!bSliceIntervalsValid)
+    {
+        RebuildSliceIntervals();
+    }
+
+    // 在各时间片的排序包围盒中二分查找与该单位重叠的候选，跳过已过期的包围盒
+    const int32 NumSlices = SliceIntervals.Num();
+    for (int32 Slice = 0; Slice < NumSlices; ++Slice)
+    {
+        const FSliceIntervals& Intervals = SliceIntervals[Slice];
+        const FSliceBox Box = MakeSliceBox(Unit,
+            static_cast<double>(Slice) / NumSlices, static_cast<double>(Slice + 1) / NumSlices, Intervals.bSweepAlongY);
+
+        // 起点早于 Box.MinA - MaxLengthA 的包围盒在扫描轴上必然已经结束
+        const TArray<FSliceBox>& Boxes = Intervals.Boxes;
+        const double FirstMinA = Box.MinA - Intervals.MaxLengthA;
+        for (int32 Index = Algo::LowerBoundBy(Boxes, FirstMinA, [](const FSliceBox& Other) { return Other.MinA; });
+            Index < Boxes.Num() && Boxes[Index].MinA <= Box.MaxA; ++Index)
+        {
+            const FSliceBox& Other = Boxes[Index];
+            if (Other.Unit != Unit && !bIsStale[Other.Unit]
+                && Other.MaxA >= Box.MinA && Other.MinB <= Box.MaxB && Other.MaxB >= Box.MinB)
+            {
+                OutUnits.Add(Other.Unit);
+            }
+        }
+    }
+
+    for (const int32 StaleUnit : StaleUnits)
+    {
+        if (StaleUnit != Unit && bHasPath[StaleUnit])
+        {
+            OutUnits.Add(StaleUnit);
+        }
+    }
+
+    // 同一单位可能在多个时间片中成为候选，排序去重后原地保留精确检测通过的单位
+    OutUnits.Sort();
+    int32 NumConflicts = 0;
+    int32 PreviousUnit = INDEX_NONE;
+    for (int32 Index = 0; Index < OutUnits.Num(); ++Index)
+    {
+        const int32 Other = OutUnits[Index];
+        if (Other == PreviousUnit)
+        {
+            continue;
+        }
+        PreviousUnit = Other;
+
+        if (HasConflict(Unit, Other))
+        {
+            OutUnits[NumConflicts++] = Other;
+        }
+    }
+#if XTOOLS_ENGINE_5_8_OR_LATER
+    OutUnits.SetNum(NumConflicts, EAllowShrinking::No);
+#else
+    OutUnits.SetNum(NumConflicts, false);
+#endif
+}
+
+bool FFormationPathConflictDetector::HasConflict(int32 UnitA, int32 UnitB) const
+{
+    if (UnitA == UnitB || !bHasPath.IsValidIndex(UnitA) || !bHasPath.IsValidIndex(UnitB) || !bHasPath[UnitA] || !bHasPath[UnitB])
+    {
+        return false;
+    }
+
+    float ClosestTime;
+    return FFormationMathUtils::CalculateClosestApproach(Starts[UnitA], Ends[UnitA], Starts[UnitB], Ends[UnitB], ClosestTime) < Threshold;
+}
+
+void FFormationPathConflictDetector::SetUnitTarget(int32 Unit, const FVector& NewTarget)
+{
+    using namespace FormationPathConflicts_Private;
+
+    if (!Ends.IsValidIndex(Unit))
+    {
+        return;
+    }
+
+    Ends[Unit] = NewTarget;
+    bHasPath[Unit] = true;
+
+    // 已建立的包围盒保留，该单位在复查时单独处理；过期单位太多时下次查询整体重建
+    if (bSliceIntervalsValid && !bIsStale[Unit])
+    {
+        bIsStale[Unit] = true;
+        StaleUnits.Add(Unit);
+        if (StaleUnits.Num() > FMath::Max(MinStaleUnitsBeforeRebuild, Num() / 8))
+        {
+            bSliceIntervalsValid = false;
+        }
+    }
+}
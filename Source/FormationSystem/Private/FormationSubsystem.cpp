@@ -0,0 +1,322 @@
+// FormationSubsystem.cpp - 阵型调度子系统实现
+
+#include "FormationSubsystem.h"
+#include "FormationManagerComponent.h"
+#include "FormationLog.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "XToolsVersionCompat.h"
+
+namespace FormationSubsystem_Private
+{
+    /** 池中最多保留的空闲管理器数量，超出的管理器直接释放（管理器会缓存成本矩阵，不宜无限保留） */
+    constexpr int32 MaxPooledManagers = 16;
+
+    /**
+     * 把管理器的变换状态与全部配置恢复为类默认值
+     * 调用方可能通过 OutManager 修改过求解器、阈值等配置，复用时不能带到下一次变换；成本矩阵缓存与热启动状态保留
+     */
+    void ResetManagerSettings(UFormationManagerComponent& Manager)
+    {
+        const UFormationManagerComponent* Defaults = GetDefault<UFormationManagerComponent>();
+        Manager.TransitionState = FFormationTransitionState();
+        Manager.SetBoidsMovementParams(FBoidsMovementParams());
+        Manager.AssignmentSolver = Defaults->AssignmentSolver;
+        Manager.SparseAssignmentThreshold = Defaults->SparseAssignmentThreshold;
+        Manager.SparseNeighborCount = Defaults->SparseNeighborCount;
+        Manager.PathConflictThreshold = Defaults->PathConflictThreshold;
+        Manager.AsyncAssignmentThreshold = Defaults->AsyncAssignmentThreshold;
+    }
+}
+
+UFormationSubsystem* UFormationSubsystem::Get(const UObject* WorldContext)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UFormationSubsystem>() : nullptr;
+}
+
+void UFormationSubsystem::Deinitialize()
+{
+    for (const FTransitionSlot& Slot : Slots)
+    {
+        if (Slot.Manager)
+        {
+            Slot.Manager->StopFormationTransition(false);
+        }
+    }
+
+    Slots.Empty();
+    FreeSlots.Empty();
+    SlotByUnit.Empty();
+    FreeManagers.Empty();
+    AllManagers.Empty();
+    HostActor = nullptr;
+    NumActive = 0;
+
+    Super::Deinitialize();
+}
+
+TStatId UFormationSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UFormationSubsystem, STATGROUP_Tickables);
+}
+
+void UFormationSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (NumActive == 0)
+    {
+        return;
+    }
+
+    // 完成回调中可能下达新命令，新槽位从下一帧开始推进
+    const int32 NumSlots = Slots.Num();
+    for (int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex)
+    {
+        UFormationManagerComponent* Manager = Slots[SlotIndex].Manager;
+        if (!Manager)
+        {
+            continue;
+        }
+
+        Manager->AdvanceTransition(DeltaTime);
+
+        // 完成或被外部直接停止的变换都在这里回收
+        if (Slots[SlotIndex].Manager == Manager && !Manager->IsTransitioning())
+        {
+            ReleaseSlot(SlotIndex);
+        }
+    }
+}
+
+FFormationTransitionHandle UFormationSubsystem::StartTransition(
+    const TArray<AActor*>& Units,
+    const FFormationData& FromFormation,
+    const FFormationData& ToFormation,
+    const FFormationTransitionConfig& Config,
+    const FBoidsMovementParams* BoidsParams,
+    UFormationManagerComponent** OutManager)
+{
+    if (OutManager)
+    {
+        *OutManager = nullptr;
+    }
+
+    StopTransitionsUsingUnits(Units);
+
+    UFormationManagerComponent* Manager = AcquireManager();
+    if (!Manager)
+    {
+        return FFormationTransitionHandle();
+    }
+
+    if (BoidsParams)
+    {
+        Manager->SetBoidsMovementParams(*BoidsParams);
+    }
+
+    if (!Manager->StartFormationTransition(Units, FromFormation, ToFormation, Config))
+    {
+        FreeManagers.Add(Manager);
+        return FFormationTransitionHandle();
+    }
+
+#if XTOOLS_ENGINE_5_8_OR_LATER
+    const int32 SlotIndex = FreeSlots.Num() > 0 ? FreeSlots.Pop(EAllowShrinking::No) : Slots.AddDefaulted();
+#else
+    const int32 SlotIndex = FreeSlots.Num() > 0 ? FreeSlots.Pop(false) : Slots.AddDefaulted();
+#endif
+    FTransitionSlot& Slot = Slots[SlotIndex];
+    Slot.Manager = Manager;
+    Slot.Units.Reset(Units.Num());
+    for (AActor* Unit : Units)
+    {
+        if (Unit)
+        {
+            Slot.Units.Add(Unit);
+            SlotByUnit.Add(Unit, SlotIndex);
+        }
+    }
+    ++NumActive;
+
+    if (OutManager)
+    {
+        *OutManager = Manager;
+    }
+
+    FFormationTransitionHandle Handle;
+    Handle.Index = SlotIndex;
+    Handle.Serial = Slot.Serial;
+    return Handle;
+}
+
+bool UFormationSubsystem::StopTransition(FFormationTransitionHandle Handle, bool bSnapToTarget)
+{
+    const FTransitionSlot* Slot = FindSlot(Handle);
+    if (!Slot)
+    {
+        return false;
+    }
+
+    Slot->Manager->StopFormationTransition(bSnapToTarget);
+    ReleaseSlot(Handle.Index);
+    return true;
+}
+
+bool UFormationSubsystem::IsTransitionActive(FFormationTransitionHandle Handle) const
+{
+    return FindSlot(Handle) != nullptr;
+}
+
+float UFormationSubsystem::GetTransitionProgress(FFormationTransitionHandle Handle) const
+{
+    const FTransitionSlot* Slot = FindSlot(Handle);
+    return Slot ? Slot->Manager->GetTransitionProgress() : 1.0f;
+}
+
+UFormationManagerComponent* UFormationSubsystem::GetManager(FFormationTransitionHandle Handle) const
+{
+    const FTransitionSlot* Slot = FindSlot(Handle);
+    return Slot ? Slot->Manager : nullptr;
+}
+
+FFormationTransitionHandle UFormationSubsystem::GetTransitionHandle(UFormationManagerComponent* Manager) const
+{
+    FFormationTransitionHandle Handle;
+    if (!Manager)
+    {
+        return Handle;
+    }
+
+    for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+    {
+        if (Slots[SlotIndex].Manager == Manager)
+        {
+            Handle.Index = SlotIndex;
+            Handle.Serial = Slots[SlotIndex].Serial;
+            break;
+        }
+    }
+    return Handle;
+}
+
+UFormationManagerComponent* UFormationSubsystem::AcquireManager()
+{
+    if (FreeManagers.Num() > 0)
+    {
+#if XTOOLS_ENGINE_5_8_OR_LATER
+        UFormationManagerComponent* Manager = FreeManagers.Pop(EAllowShrinking::No);
+#else
+        UFormationManagerComponent* Manager = FreeManagers.Pop(false);
+#endif
+        FormationSubsystem_Private::ResetManagerSettings(*Manager);
+        return Manager;
+    }
+
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    if (!IsValid(HostActor))
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.ObjectFlags |= RF_Transient;
+#if WITH_EDITOR
+        SpawnParams.bHideFromSceneOutliner = true;
+#endif
+        HostActor = World->SpawnActor<AActor>(SpawnParams);
+        if (!HostActor)
+        {
+            UE_LOG(LogFormationSystem, Warning, TEXT("UFormationSubsystem: 无法生成阵型管理器宿主 Actor"));
+            return nullptr;
+        }
+#if WITH_EDITOR
+        HostActor->SetActorLabel(TEXT("FormationSubsystemHost"));
+#endif
+    }
+
+    // 不注册组件：管理器不参与引擎的组件 Tick，由子系统统一推进
+    UFormationManagerComponent* Manager = NewObject<UFormationManagerComponent>(HostActor, NAME_None, RF_Transient);
+    AllManagers.Add(Manager);
+    return Manager;
+}
+
+void UFormationSubsystem::ReleaseSlot(int32 SlotIndex)
+{
+    FTransitionSlot& Slot = Slots[SlotIndex];
+    UFormationManagerComponent* Manager = Slot.Manager;
+
+    for (const TObjectKey<AActor>& Unit : Slot.Units)
+    {
+        const int32* OwnerSlot = SlotByUnit.Find(Unit);
+        if (OwnerSlot && *OwnerSlot == SlotIndex)
+        {
+            SlotByUnit.Remove(Unit);
+        }
+    }
+
+    Slot.Units.Reset();
+    Slot.Manager = nullptr;
+    ++Slot.Serial;
+    FreeSlots.Add(SlotIndex);
+    --NumActive;
+
+    // 清空调用方绑定的回调，避免复用时触发到旧的监听者
+    Manager->OnFormationTransitionCompleted.Clear();
+    if (Manager->IsTransitioning())
+    {
+        Manager->StopFormationTransition(false);
+    }
+    FormationSubsystem_Private::ResetManagerSettings(*Manager);
+
+    if (FreeManagers.Num() < FormationSubsystem_Private::MaxPooledManagers)
+    {
+        FreeManagers.Add(Manager);
+    }
+    else
+    {
+#if XTOOLS_ENGINE_5_8_OR_LATER
+        AllManagers.RemoveSingleSwap(Manager, EAllowShrinking::No);
+#else
+        AllManagers.RemoveSingleSwap(Manager, false);
+#endif
+        Manager->MarkAsGarbage();
+    }
+}
+
+void UFormationSubsystem::StopTransitionsUsingUnits(const TArray<AActor*>& Units)
+{
+    for (AActor* Unit : Units)
+    {
+        if (!Unit)
+        {
+            continue;
+        }
+
+        const int32* SlotIndex = SlotByUnit.Find(Unit);
+        if (!SlotIndex)
+        {
+            continue;
+        }
+
+        FFormationTransitionHandle Handle;
+        Handle.Index = *SlotIndex;
+        Handle.Serial = Slots[*SlotIndex].Serial;
+        StopTransition(Handle, false);
+    }
+}
+
+const UFormationSubsystem::FTransitionSlot* UFormationSubsystem::FindSlot(FFormationTransitionHandle Handle) const
+{
+    if (!Slots.IsValidIndex(Handle.Index))
+    {
+        return nullptr;
+    }
+
+    const FTransitionSlot& Slot = Slots[Handle.Index];
+    return Slot.Manager && Slot.Serial == Handle.Serial ? &Slot : nullptr;
+}
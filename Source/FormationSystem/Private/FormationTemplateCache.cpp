@@ -0,0 +1,265 @@
+// FormationTemplateCache.cpp - 阵型模板缓存实现
+
+#include "FormationTemplateCache.h"
+#include "Algo/StableSort.h"
+
+namespace FormationTemplateCache_Private
+{
+    /** 缓存的模板数量上限，超出时整体清空（圆形/螺旋的浮点参数可能产生大量一次性键） */
+    constexpr int32 MaxCachedTemplates = 512;
+
+    /** Hilbert 曲线的网格阶数，每轴 2^16 个格子 */
+    constexpr uint32 HilbertOrderBits = 16;
+
+    uint64 HilbertIndex(uint32 X, uint32 Y)
+    {
+        constexpr uint32 GridSize = 1u << HilbertOrderBits;
+        uint64 Index = 0;
+        for (uint32 S = GridSize >> 1; S > 0; S >>= 1)
+        {
+            const uint32 RX = (X & S) ? 1u : 0u;
+            const uint32 RY = (Y & S) ? 1u : 0u;
+            Index += static_cast<uint64>(S) * S * ((3u * RX) ^ RY);
+
+            // 旋转象限，使子曲线首尾相接
+            if (RY == 0)
+            {
+                if (RX == 1)
+                {
+                    X = GridSize - 1 - X;
+                    Y = GridSize - 1 - Y;
+                }
+                const uint32 Temp = X;
+                X = Y;
+                Y = Temp;
+            }
+        }
+        return Index;
+    }
+
+    /** 极角相差在该值（弧度）以内时按半径排序，与空间排序映射一致 */
+    constexpr float PolarAngleTolerance = 0.01f;
+
+    /** 计算位置包围盒的中心以及每个位置相对中心的极角与距离 */
+    void CalculatePolarKeys(TConstArrayView<FVector> Positions, FVector& OutCenter, TArray<float>& OutAngles, TArray<float>& OutDistances)
+    {
+        FBox Bounds(ForceInit);
+        for (const FVector& Position : Positions)
+        {
+            Bounds += Position;
+        }
+        OutCenter = Positions.Num() > 0 ? Bounds.GetCenter() : FVector::ZeroVector;
+
+        OutAngles.SetNumUninitialized(Positions.Num());
+        OutDistances.SetNumUninitialized(Positions.Num());
+        for (int32 Index = 0; Index < Positions.Num(); ++Index)
+        {
+            const FVector RelativePosition = Positions[Index] - OutCenter;
+            OutAngles[Index] = static_cast<float>(FMath::Atan2(RelativePosition.Y, RelativePosition.X));
+            OutDistances[Index] = static_cast<float>(RelativePosition.Size());
+        }
+    }
+
+    void SortByPolarKeys(const TArray<float>& Angles, const TArray<float>& Distances, TArray<int32>& InOutOrder)
+    {
+        Algo::StableSort(InOutOrder, [&Angles, &Distances](int32 A, int32 B)
+        {
+            if (!FMath::IsNearlyEqual(Angles[A], Angles[B], PolarAngleTolerance))
+            {
+                return Angles[A] < Angles[B];
+            }
+            return Distances[A] < Distances[B];
+        });
+    }
+}
+
+const TArray<int32>& FFormationTemplate::GetSlotOrder(EFormationSlotOrder Order) const
+{
+    switch (Order)
+    {
+        case EFormationSlotOrder::RowMajor:
+            return RowMajorOrder;
+        case EFormationSlotOrder::Hilbert:
+            return HilbertOrder;
+        case EFormationSlotOrder::Polar:
+        default:
+            return PolarOrder;
+    }
+}
+
+void FFormationTemplate::GetRotatedPolarOrder(float YawDegrees, TArray<int32>& OutOrder) const
+{
+    const int32 NumSlots = PolarOrder.Num();
+    OutOrder.SetNumUninitialized(NumSlots);
+
+    // 旋转后越过 ±π 回绕的槽位在 PolarOrder 中是首或尾的连续一段，找到分界即可
+    const float Yaw = FMath::UnwindRadians(FMath::DegreesToRadians(YawDegrees));
+    const float WrapAngle = Yaw >= 0.0f ? PI - Yaw : -PI - Yaw;
+    int32 Split = 0;
+    while (Split < NumSlots && PolarAngles[PolarOrder[Split]] <= WrapAngle)
+    {
+        ++Split;
+    }
+
+    for (int32 Index = 0; Index < NumSlots; ++Index)
+    {
+        OutOrder[Index] = PolarOrder[(Split + Index) % NumSlots];
+    }
+}
+
+void FFormationTemplate::CopyScaled(float Scale, TArray<FVector>& OutPositions, float YawDegrees) const
+{
+    OutPositions.SetNumUninitialized(Offsets.Num());
+
+    if (FMath::IsNearlyZero(YawDegrees))
+    {
+        for (int32 Index = 0; Index < Offsets.Num(); ++Index)
+        {
+            OutPositions[Index] = Offsets[Index] * Scale;
+        }
+        return;
+    }
+
+    float Sin, Cos;
+    FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(YawDegrees));
+    for (int32 Index = 0; Index < Offsets.Num(); ++Index)
+    {
+        const FVector& Offset = Offsets[Index];
+        OutPositions[Index] = FVector(
+            (Offset.X * Cos - Offset.Y * Sin) * Scale,
+            (Offset.X * Sin + Offset.Y * Cos) * Scale,
+            Offset.Z * Scale);
+    }
+}
+
+FFormationTemplateCache& FFormationTemplateCache::Get()
+{
+    static FFormationTemplateCache Instance;
+    return Instance;
+}
+
+FFormationTemplateRef FFormationTemplateCache::FindOrBuild(
+    const FFormationTemplateKey& Key,
+    TFunctionRef<void(TArray<FVector>& OutOffsets, FVector2D& OutSize)> BuildOffsets)
+{
+    {
+        FReadScopeLock ReadLock(Lock);
+        if (const FFormationTemplateRef* Found = Templates.Find(Key))
+        {
+            return *Found;
+        }
+    }
+
+    TSharedRef<FFormationTemplate, ESPMode::ThreadSafe> NewTemplate = MakeShared<FFormationTemplate, ESPMode::ThreadSafe>();
+    BuildOffsets(NewTemplate->Offsets, NewTemplate->Size);
+    FormationTemplateCache_Private::CalculatePolarKeys(NewTemplate->Offsets, NewTemplate->PolarCenter, NewTemplate->PolarAngles, NewTemplate->PolarDistances);
+    NewTemplate->PolarOrder.SetNumUninitialized(NewTemplate->Offsets.Num());
+    for (int32 Index = 0; Index < NewTemplate->PolarOrder.Num(); ++Index)
+    {
+        NewTemplate->PolarOrder[Index] = Index;
+    }
+    FormationTemplateCache_Private::SortByPolarKeys(NewTemplate->PolarAngles, NewTemplate->PolarDistances, NewTemplate->PolarOrder);
+    CalculateSlotOrder(NewTemplate->Offsets, EFormationSlotOrder::RowMajor, NewTemplate->RowMajorOrder);
+    CalculateSlotOrder(NewTemplate->Offsets, EFormationSlotOrder::Hilbert, NewTemplate->HilbertOrder);
+
+    FWriteScopeLock WriteLock(Lock);
+    if (const FFormationTemplateRef* Found = Templates.Find(Key))
+    {
+        return *Found;
+    }
+
+    if (Templates.Num() >= FormationTemplateCache_Private::MaxCachedTemplates)
+    {
+        Templates.Reset();
+    }
+
+    FFormationTemplateRef Result = NewTemplate;
+    Templates.Add(Key, Result);
+    return Result;
+}
+
+TSharedPtr<const FFormationTemplate, ESPMode::ThreadSafe> FFormationTemplateCache::Find(const FFormationTemplateKey& Key) const
+{
+    FReadScopeLock ReadLock(Lock);
+    const FFormationTemplateRef* Found = Templates.Find(Key);
+    return Found ? TSharedPtr<const FFormationTemplate, ESPMode::ThreadSafe>(*Found) : nullptr;
+}
+
+void FFormationTemplateCache::Empty()
+{
+    FWriteScopeLock WriteLock(Lock);
+    Templates.Empty();
+}
+
+int32 FFormationTemplateCache::Num() const
+{
+    FReadScopeLock ReadLock(Lock);
+    return Templates.Num();
+}
+
+void FFormationTemplateCache::CalculateSlotOrder(TConstArrayView<FVector> Positions, EFormationSlotOrder Order, TArray<int32>& OutOrder)
+{
+    const int32 NumPositions = Positions.Num();
+    OutOrder.SetNumUninitialized(NumPositions);
+    for (int32 Index = 0; Index < NumPositions; ++Index)
+    {
+        OutOrder[Index] = Index;
+    }
+
+    if (NumPositions <= 1)
+    {
+        return;
+    }
+
+    switch (Order)
+    {
+        case EFormationSlotOrder::Polar:
+        {
+            // 先算好排序键，避免比较时重复调用 Atan2
+            FVector Center;
+            TArray<float> Angles;
+            TArray<float> Distances;
+            FormationTemplateCache_Private::CalculatePolarKeys(Positions, Center, Angles, Distances);
+            FormationTemplateCache_Private::SortByPolarKeys(Angles, Distances, OutOrder);
+            break;
+        }
+
+        case EFormationSlotOrder::RowMajor:
+        {
+            Algo::StableSort(OutOrder, [Positions](int32 A, int32 B)
+            {
+                return Positions[A].Y != Positions[B].Y ? Positions[A].Y < Positions[B].Y : Positions[A].X < Positions[B].X;
+            });
+            break;
+        }
+
+        case EFormationSlotOrder::Hilbert:
+        {
+            FBox2D Bounds(ForceInit);
+            for (const FVector& Position : Positions)
+            {
+                Bounds += FVector2D(Position.X, Position.Y);
+            }
+
+            // 按较长边等比量化，保持曲线在两个轴上的分辨率一致
+            const FVector2D Extent = Bounds.GetSize();
+            const double MaxExtent = FMath::Max3<double>(Extent.X, Extent.Y, UE_SMALL_NUMBER);
+            const double GridScale = static_cast<double>((1u << FormationTemplateCache_Private::HilbertOrderBits) - 1) / MaxExtent;
+
+            TArray<uint64> Keys;
+            Keys.SetNumUninitialized(NumPositions);
+            for (int32 Index = 0; Index < NumPositions; ++Index)
+            {
+                const uint32 X = static_cast<uint32>(FMath::RoundToInt64((Positions[Index].X - Bounds.Min.X) * GridScale));
+                const uint32 Y = static_cast<uint32>(FMath::RoundToInt64((Positions[Index].Y - Bounds.Min.Y) * GridScale));
+                Keys[Index] = FormationTemplateCache_Private::HilbertIndex(X, Y);
+            }
+
+            Algo::StableSort(OutOrder, [&Keys](int32 A, int32 B)
+            {
+                return Keys[A] < Keys[B];
+            });
+            break;
+        }
+    }
+}
@@ -0,0 +1,185 @@
+// FormationTransitionRunner.cpp - 阵型变换批量执行器实现
+
+#include "FormationTransitionRunner.h"
+#include "Async/ParallelFor.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+#include "XToolsVersionCompat.h"
+
+namespace FormationTransitionRunner_Private
+{
+    /** 单位数量低于此值时单线程插值，避免任务调度开销 */
+    constexpr int32 ParallelEvaluateThreshold = 256;
+}
+
+void FFormationTransitionRunner::Init(const TArray<FUnitTransitionData>& UnitTransitions)
+{
+    Reset();
+
+    const int32 NumUnits = UnitTransitions.Num();
+    Components.Reserve(NumUnits);
+    UnitIndices.Reserve(NumUnits);
+    StartLocations.Reserve(NumUnits);
+    LocationDeltas.Reserve(NumUnits);
+    StartRotations.Reserve(NumUnits);
+    RotationDeltas.Reserve(NumUnits);
+    StartScales.Reserve(NumUnits);
+    ScaleDeltas.Reserve(NumUnits);
+    bScaleChanges.Reserve(NumUnits);
+
+    for (int32 UnitIndex = 0; UnitIndex < NumUnits; ++UnitIndex)
+    {
+        const FUnitTransitionData& UnitData = UnitTransitions[UnitIndex];
+        const AActor* Actor = UnitData.TargetActor.Get();
+        USceneComponent* Root = Actor ? Actor->GetRootComponent() : nullptr;
+        if (!Root)
+        {
+            continue;
+        }
+
+        Components.Add(Root);
+        UnitIndices.Add(UnitIndex);
+        StartLocations.Add(UnitData.StartLocation);
+        LocationDeltas.Add(UnitData.TargetLocation - UnitData.StartLocation);
+        StartRotations.Add(UnitData.StartRotation);
+        RotationDeltas.Add((UnitData.TargetRotation - UnitData.StartRotation).GetNormalized());
+        StartScales.Add(UnitData.StartScale);
+        ScaleDeltas.Add(UnitData.TargetScale - UnitData.StartScale);
+        bScaleChanges.Add(!UnitData.StartScale.Equals(UnitData.TargetScale));
+    }
+
+    CurrentLocations = StartLocations;
+    CurrentRotations = StartRotations;
+    CurrentScales = StartScales;
+    EvaluatedProgress = 0.0f;
+}
+
+void FFormationTransitionRunner::InitTransforms(const TArray<FTransform>& StartTransforms, const TArray<FTransform>& TargetTransforms)
+{
+    Reset();
+    check(StartTransforms.Num() == TargetTransforms.Num());
+
+    const int32 NumUnits = StartTransforms.Num();
+    StartLocations.SetNumUninitialized(NumUnits);
+    LocationDeltas.SetNumUninitialized(NumUnits);
+    StartRotations.SetNumUninitialized(NumUnits);
+    RotationDeltas.SetNumUninitialized(NumUnits);
+    StartScales.SetNumUninitialized(NumUnits);
+    ScaleDeltas.SetNumUninitialized(NumUnits);
+    bScaleChanges.SetNumUninitialized(NumUnits);
+
+    for (int32 Index = 0; Index < NumUnits; ++Index)
+    {
+        const FTransform& Start = StartTransforms[Index];
+        const FTransform& Target = TargetTransforms[Index];
+        StartLocations[Index] = Start.GetLocation();
+        LocationDeltas[Index] = Target.GetLocation() - Start.GetLocation();
+        StartRotations[Index] = Start.Rotator();
+        RotationDeltas[Index] = (Target.Rotator() - StartRotations[Index]).GetNormalized();
+        StartScales[Index] = Start.GetScale3D();
+        ScaleDeltas[Index] = Target.GetScale3D() - Start.GetScale3D();
+        bScaleChanges[Index] = !Start.GetScale3D().Equals(Target.GetScale3D());
+    }
+
+    CurrentLocations = StartLocations;
+    CurrentRotations = StartRotations;
+    CurrentScales = StartScales;
+    EvaluatedProgress = 0.0f;
+}
+
+void FFormationTransitionRunner::Reset()
+{
+    Components.Reset();
+    UnitIndices.Reset();
+    StartLocations.Reset();
+    LocationDeltas.Reset();
+    StartRotations.Reset();
+    RotationDeltas.Reset();
+    StartScales.Reset();
+    ScaleDeltas.Reset();
+    bScaleChanges.Reset();
+    CurrentLocations.Reset();
+    CurrentRotations.Reset();
+    CurrentScales.Reset();
+    EvaluatedProgress = 0.0f;
+}
+
+void FFormationTransitionRunner::Evaluate(float Progress)
+{
+    EvaluatedProgress = Progress;
+    const int32 NumUnits = Num();
+    ParallelFor(NumUnits, [this, Progress](int32 Index)
+    {
+        CurrentLocations[Index] = StartLocations[Index] + LocationDeltas[Index] * Progress;
+        CurrentRotations[Index] = StartRotations[Index] + RotationDeltas[Index] * Progress;
+        CurrentScales[Index] = StartScales[Index] + ScaleDeltas[Index] * Progress;
+    }, NumUnits < FormationTransitionRunner_Private::ParallelEvaluateThreshold);
+}
+
+void FFormationTransitionRunner::Retarget(int32 Index, const FVector& NewTargetLocation, const FRotator& NewTargetRotation)
+{
+    const FVector& CurrentLocation = CurrentLocations[Index];
+    const FRotator& CurrentRotation = CurrentRotations[Index];
+    const float RemainingProgress = 1.0f - EvaluatedProgress;
+
+    if (RemainingProgress <= KINDA_SMALL_NUMBER)
+    {
+        StartLocations[Index] = NewTargetLocation;
+        LocationDeltas[Index] = FVector::ZeroVector;
+        StartRotations[Index] = NewTargetRotation;
+        RotationDeltas[Index] = FRotator::ZeroRotator;
+        return;
+    }
+
+    // 新的线性插值在当前进度处经过当前位置，在进度 1 处到达新目标
+    const float InvRemaining = 1.0f / RemainingProgress;
+    LocationDeltas[Index] = (NewTargetLocation - CurrentLocation) * InvRemaining;
+    StartLocations[Index] = CurrentLocation - LocationDeltas[Index] * EvaluatedProgress;
+    RotationDeltas[Index] = (NewTargetRotation - CurrentRotation).GetNormalized() * InvRemaining;
+    StartRotations[Index] = CurrentRotation - RotationDeltas[Index] * EvaluatedProgress;
+}
+
+void FFormationTransitionRunner::EvaluateTransforms(float Progress, TArray<FTransform>& OutTransforms) const
+{
+    const int32 NumUnits = Num();
+#if XTOOLS_ENGINE_5_8_OR_LATER
+    OutTransforms.SetNumUninitialized(NumUnits, EAllowShrinking::No);
+#else
+    OutTransforms.SetNumUninitialized(NumUnits, false);
+#endif
+    ParallelFor(NumUnits, [this, Progress, &OutTransforms](int32 Index)
+    {
+        OutTransforms[Index] = FTransform(
+            StartRotations[Index] + RotationDeltas[Index] * Progress,
+            StartLocations[Index] + LocationDeltas[Index] * Progress,
+            StartScales[Index] + ScaleDeltas[Index] * Progress);
+    }, NumUnits < FormationTransitionRunner_Private::ParallelEvaluateThreshold);
+}
+
+void FFormationTransitionRunner::Apply(bool bTeleport) const
+{
+    // 组件变换只能在游戏线程上修改
+    check(IsInGameThread());
+
+    for (int32 Index = 0; Index < Components.Num(); ++Index)
+    {
+        USceneComponent* Root = Components[Index].Get();
+        if (!Root)
+        {
+            continue;
+        }
+
+        if (bTeleport)
+        {
+            Root->SetWorldLocationAndRotationNoPhysics(CurrentLocations[Index], CurrentRotations[Index]);
+            if (bScaleChanges[Index])
+            {
+                Root->SetWorldScale3D(CurrentScales[Index]);
+            }
+        }
+        else
+        {
+            Root->SetWorldTransform(FTransform(CurrentRotations[Index], CurrentLocations[Index], CurrentScales[Index]));
+        }
+    }
+}
@@ -0,0 +1,204 @@
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+
+#include "FormationAssignmentSolver.h"
+#include "FormationCostMatrix.h"
+
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include <algorithm>
+
+namespace FormationAssignmentSolverTests
+{
+    bool IsPermutation(const TArray<int32>& Assignment, int32 Size)
+    {
+        if (Assignment.Num() != Size)
+        {
+            return false;
+        }
+
+        TArray<bool> Used;
+        Used.Init(false, Size);
+        for (const int32 Column : Assignment)
+        {
+            if (Column < 0 || Column >= Size || Used[Column])
+            {
+                return false;
+            }
+            Used[Column] = true;
+        }
+        return true;
+    }
+
+    double SolveByBruteForce(const TArray<float>& Costs, int32 Size)
+    {
+        TArray<int32> Permutation;
+        for (int32 Index = 0; Index < Size; ++Index)
+        {
+            Permutation.Add(Index);
+        }
+
+        double Best = TNumericLimits<double>::Max();
+        do
+        {
+            Best = FMath::Min(Best, FFormationAssignmentSolver::CalculateTotalCost(Costs, Size, Permutation));
+        }
+        while (std::next_permutation(Permutation.GetData(), Permutation.GetData() + Size));
+        return Best;
+    }
+
+    TArray<float> MakeDistanceCosts(const TArray<FVector>& From, const TArray<FVector>& To)
+    {
+        TArray<float> Costs;
+        Costs.Reserve(From.Num() * To.Num());
+        for (const FVector& Start : From)
+        {
+            for (const FVector& End : To)
+            {
+                Costs.Add(FVector::Dist(Start, End));
+            }
+        }
+        return Costs;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FFormationAssignmentSolver_MatchesBruteForce,
+    "XTools.Formation.AssignmentSolver.MatchesBruteForce",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFormationAssignmentSolver_MatchesBruteForce::RunTest(const FString& Parameters)
+{
+    using namespace FormationAssignmentSolverTests;
+
+    constexpr int32 Size = 7;
+    FRandomStream Stream(4242);
+    for (int32 Trial = 0; Trial < 8; ++Trial)
+    {
+        TArray<float> Costs;
+        for (int32 Index = 0; Index < Size * Size; ++Index)
+        {
+            // 少量取值制造大量并列成本
+            Costs.Add(static_cast<float>(Stream.RandRange(0, Trial < 4 ? 5 : 1000)));
+        }
+
+        const double Optimal = SolveByBruteForce(Costs, Size);
+
+        TArray<int32> Assignment;
+        TestTrue(TEXT("LAPJV 应求解成功"), FFormationAssignmentSolver::SolveLAPJV(Costs, Size, Assignment));
+        TestTrue(TEXT("LAPJV 结果应为排列"), IsPermutation(Assignment, Size));
+        TestEqual(TEXT("LAPJV 总成本应等于穷举最优值"), FFormationAssignmentSolver::CalculateTotalCost(Costs, Size, Assignment), Optimal);
+
+        TestTrue(TEXT("拍卖算法应求解成功"), FFormationAssignmentSolver::SolveAuction(Costs, Size, Assignment, nullptr, 1.0e-4f));
+        TestTrue(TEXT("拍卖算法结果应为排列"), IsPermutation(Assignment, Size));
+        TestTrue(TEXT("整数成本下拍卖算法应得到最优值"),
+            FMath::IsNearlyEqual(FFormationAssignmentSolver::CalculateTotalCost(Costs, Size, Assignment), Optimal, 0.5));
+    }
+
+    TArray<int32> Assignment;
+    AddExpectedError(TEXT("不匹配"), EAutomationExpectedErrorFlags::Contains);
+    TestFalse(TEXT("元素数量不匹配时应失败"), FFormationAssignmentSolver::SolveLAPJV(TArray<float>({ 1.0f, 2.0f, 3.0f }), 2, Assignment));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FFormationAssignmentSolver_WarmStartKeepsOptimum,
+    "XTools.Formation.AssignmentSolver.WarmStartKeepsOptimum",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFormationAssignmentSolver_WarmStartKeepsOptimum::RunTest(const FString& Parameters)
+{
+    using namespace FormationAssignmentSolverTests;
+
+    constexpr int32 Size = 300;
+    FRandomStream Stream(777);
+    TArray<FVector> From;
+    TArray<FVector> To;
+    for (int32 Index = 0; Index < Size; ++Index)
+    {
+        From.Add(FVector(Stream.FRandRange(-5000.0f, 5000.0f), Stream.FRandRange(-5000.0f, 5000.0f), 0.0f));
+        To.Add(FVector((Index % 20) * 100.0f, (Index / 20) * 100.0f, 0.0f));
+    }
+
+    const TArray<float> Costs = MakeDistanceCosts(From, To);
+    FFormationAssignmentWarmStart WarmStart;
+    TArray<int32> ColdAssignment;
+    TestTrue(TEXT("冷启动 LAPJV 应求解成功"), FFormationAssignmentSolver::SolveLAPJV(Costs, Size, ColdAssignment, &WarmStart));
+    TestTrue(TEXT("冷启动结果应为排列"), IsPermutation(ColdAssignment, Size));
+    const double ColdCost = FFormationAssignmentSolver::CalculateTotalCost(Costs, Size, ColdAssignment);
+
+    TArray<int32> AuctionAssignment;
+    const float Tolerance = 1.0e-5f;
+    TestTrue(TEXT("拍卖算法应求解成功"), FFormationAssignmentSolver::SolveAuction(Costs, Size, AuctionAssignment, nullptr, Tolerance));
+    TestTrue(TEXT("拍卖算法结果应为排列"), IsPermutation(AuctionAssignment, Size));
+    const double AuctionCost = FFormationAssignmentSolver::CalculateTotalCost(Costs, Size, AuctionAssignment);
+    float MaxCost = 0.0f;
+    for (const float Cost : Costs)
+    {
+        MaxCost = FMath::Max(MaxCost, Cost);
+    }
+    TestTrue(TEXT("拍卖算法总成本与最优值的差距应不超过 N·ε"),
+        AuctionCost >= ColdCost - 1.0 && AuctionCost <= ColdCost + Size * MaxCost * Tolerance + 1.0);
+
+    // 阵型小幅移动后用上一次的价格热启动，结果应与冷启动一致
+    for (FVector& Position : From)
+    {
+        Position += FVector(Stream.FRandRange(-50.0f, 50.0f), Stream.FRandRange(-50.0f, 50.0f), 0.0f);
+    }
+    const TArray<float> MovedCosts = MakeDistanceCosts(From, To);
+
+    TArray<int32> WarmAssignment;
+    TArray<int32> ReferenceAssignment;
+    TestTrue(TEXT("热启动 LAPJV 应求解成功"), FFormationAssignmentSolver::SolveLAPJV(MovedCosts, Size, WarmAssignment, &WarmStart));
+    TestTrue(TEXT("参考 LAPJV 应求解成功"), FFormationAssignmentSolver::SolveLAPJV(MovedCosts, Size, ReferenceAssignment));
+    TestTrue(TEXT("热启动结果应为排列"), IsPermutation(WarmAssignment, Size));
+    TestTrue(TEXT("热启动总成本应与冷启动一致"),
+        FMath::IsNearlyEqual(
+            FFormationAssignmentSolver::CalculateTotalCost(MovedCosts, Size, WarmAssignment),
+            FFormationAssignmentSolver::CalculateTotalCost(MovedCosts, Size, ReferenceAssignment), 1.0e-2));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FFormationAssignmentSolver_StopsWhenCancelled,
+    "XTools.Formation.AssignmentSolver.StopsWhenCancelled",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFormationAssignmentSolver_StopsWhenCancelled::RunTest(const FString& Parameters)
+{
+    using namespace FormationAssignmentSolverTests;
+
+    constexpr int32 Size = 64;
+    FRandomStream Stream(4242);
+    TArray<FVector> From;
+    TArray<FVector> To;
+    for (int32 Index = 0; Index < Size; ++Index)
+    {
+        From.Add(FVector(Stream.FRandRange(-2000.0f, 2000.0f), Stream.FRandRange(-2000.0f, 2000.0f), 0.0f));
+        To.Add(FVector((Index % 8) * 100.0f, (Index / 8) * 100.0f, 0.0f));
+    }
+    const TArray<float> Costs = MakeDistanceCosts(From, To);
+    FFormationSparseCostMatrix Sparse;
+    FFormationSparseCostMatrix::BuildNearest(From, To, 8, false, Sparse);
+
+    // 已取消的求解立即返回失败，输出为空且不改动热启动数据
+    const std::atomic<bool> Cancelled{ true };
+    FFormationAssignmentWarmStart WarmStart;
+    TArray<int32> Assignment;
+    TestFalse(TEXT("取消后 LAPJV 应返回失败"), FFormationAssignmentSolver::SolveLAPJV(Costs, Size, Assignment, &WarmStart, &Cancelled));
+    TestEqual(TEXT("取消后 LAPJV 输出应为空"), Assignment.Num(), 0);
+    TestFalse(TEXT("取消后拍卖算法应返回失败"), FFormationAssignmentSolver::SolveAuction(Costs, Size, Assignment, &WarmStart, 1.0e-5f, &Cancelled));
+    TestFalse(TEXT("取消后稀疏求解应返回失败"), FFormationAssignmentSolver::SolveSparse(Sparse, Assignment, &WarmStart, &Cancelled));
+    TestFalse(TEXT("取消的求解不应写入热启动数据"), WarmStart.IsValidFor(Size));
+
+    // 未置位的标记不影响求解
+    const std::atomic<bool> NotCancelled{ false };
+    TestTrue(TEXT("未取消时 LAPJV 应求解成功"), FFormationAssignmentSolver::SolveLAPJV(Costs, Size, Assignment, &WarmStart, &NotCancelled));
+    TestTrue(TEXT("未取消时结果应为排列"), IsPermutation(Assignment, Size));
+    TestTrue(TEXT("未取消时稀疏求解应成功"), FFormationAssignmentSolver::SolveSparse(Sparse, Assignment, &WarmStart, &NotCancelled));
+    TestTrue(TEXT("未取消时稀疏结果应为排列"), IsPermutation(Assignment, Size));
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,301 @@
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+
+#include "FormationAssignmentSolver.h"
+#include "FormationCostMatrix.h"
+#include "FormationLibrary.h"
+#include "FormationManagerComponent.h"
+#include "FormationMathUtils.h"
+#include "FormationPathConflicts.h"
+#include "FormationTestActor.h"
+#include "FormationTransitionRunner.h"
+#include "XToolsBenchmark.h"
+
+#include "Engine/World.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+namespace FormationBenchmark_Private
+{
+    /** 阵型规模：覆盖 SparseAssignmentThreshold、AsyncAssignmentThreshold 与 ParallelFor 阈值两侧 */
+    constexpr int32 UnitCounts[] = { 16, 64, 256, 1024, 4096 };
+
+    constexpr float UnitSpacing = 100.0f;
+
+    /**
+     * 典型的移动命令：单位散布在原点附近的圆盘内，目标是远处的方阵
+     * 散布半径与方阵尺寸相当，分配结果对路径长度与交叉都有实际影响
+     */
+    void MakeScenario(int32 NumUnits, FRandomStream& Stream, TArray<FVector>& OutFrom, TArray<FVector>& OutTo)
+    {
+        const float ScatterRadius = FMath::Sqrt(static_cast<float>(NumUnits)) * UnitSpacing * 0.6f;
+        OutFrom.Reset(NumUnits);
+        for (int32 Index = 0; Index < NumUnits; ++Index)
+        {
+            const float Angle = Stream.FRandRange(0.0f, UE_TWO_PI);
+            const float Radius = ScatterRadius * FMath::Sqrt(Stream.FRand());
+            OutFrom.Add(FVector(Radius * FMath::Cos(Angle), Radius * FMath::Sin(Angle), 0.0f));
+        }
+
+        OutTo = UFormationLibrary::CreateSquareFormation(
+            FVector(3000.0f, 1000.0f, 0.0f), FRotator(0.0f, 30.0f, 0.0f), NumUnits, UnitSpacing).GetWorldPositions();
+    }
+
+    void AddCostMetrics(FXToolsBenchmarkReport& Report, const TCHAR* Solver, int32 NumUnits, double TotalCost, double OptimalCost)
+    {
+        Report.AddMetric(FString::Printf(TEXT("%s.TotalCost.%d"), Solver, NumUnits), TotalCost);
+        Report.AddMetric(FString::Printf(TEXT("%s.CostRatio.%d"), Solver, NumUnits), OptimalCost > 0.0 ? TotalCost / OptimalCost : 1.0);
+    }
+
+    bool IsPermutation(const TArray<int32>& Assignment, int32 Size)
+    {
+        if (Assignment.Num() != Size)
+        {
+            return false;
+        }
+
+        TBitArray<> Used(false, Size);
+        for (const int32 Column : Assignment)
+        {
+            if (Column < 0 || Column >= Size || Used[Column])
+            {
+                return false;
+            }
+            Used[Column] = true;
+        }
+        return true;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FFormationBenchmark_Algorithms,
+    "XTools.Formation.Benchmark.Algorithms",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FFormationBenchmark_Algorithms::RunTest(const FString& Parameters)
+{
+    using namespace FormationBenchmark_Private;
+
+    FXToolsBenchmarkReport Report(TEXT("Formation.Algorithms"));
+    FRandomStream Stream(20240611);
+
+    // 贪心求解器只能经由管理器调用；管理器会缓存成本矩阵，预热后计时的只是求解本身
+    UFormationManagerComponent* GreedyManager = NewObject<UFormationManagerComponent>(GetTransientPackage());
+    GreedyManager->AssignmentSolver = EFormationAssignmentSolver::Greedy;
+    GreedyManager->AsyncAssignmentThreshold = 0;
+
+    for (const int32 NumUnits : UnitCounts)
+    {
+        TArray<FVector> From;
+        TArray<FVector> To;
+        MakeScenario(NumUnits, Stream, From, To);
+
+        // ---- 成本矩阵 ----
+        FFormationCostMatrix AbsoluteMatrix;
+        FFormationCostMatrix RelativeMatrix;
+        FFormationSparseCostMatrix SparseMatrix;
+        Report.Measure(TEXT("CostMatrix.AbsoluteDistance"), NumUnits, [&]() { FFormationCostMatrix::BuildAbsoluteDistance(From, To, AbsoluteMatrix); });
+        Report.Measure(TEXT("CostMatrix.RelativePosition"), NumUnits, [&]() { FFormationCostMatrix::BuildRelativePosition(From, To, RelativeMatrix); });
+        Report.Measure(TEXT("CostMatrix.SparseNearest16"), NumUnits, [&]() { FFormationSparseCostMatrix::BuildNearest(From, To, 16, false, SparseMatrix); });
+
+        // ---- 分配求解：以绝对距离总成本衡量质量，LAPJV 为精确最优 ----
+        const TConstArrayView<float> Costs = AbsoluteMatrix.GetValues();
+        TArray<int32> Optimal;
+        Report.Measure(TEXT("Solver.LAPJV"), NumUnits, [&]() { FFormationAssignmentSolver::SolveLAPJV(Costs, NumUnits, Optimal); });
+        if (!TestTrue(FString::Printf(TEXT("LAPJV 应输出完整分配 (N=%d)"), NumUnits), IsPermutation(Optimal, NumUnits)))
+        {
+            continue;
+        }
+        const double OptimalCost = FFormationAssignmentSolver::CalculateTotalCost(Costs, NumUnits, Optimal);
+        AddCostMetrics(Report, TEXT("Solver.LAPJV"), NumUnits, OptimalCost, OptimalCost);
+
+        // 热启动价格来自目标整体偏移后的上一次求解，对应连续下达相近的移动命令
+        TArray<FVector> ShiftedTo = To;
+        for (FVector& Position : ShiftedTo)
+        {
+            Position += FVector(UnitSpacing * 0.5f, 0.0f, 0.0f);
+        }
+        FFormationCostMatrix ShiftedMatrix;
+        FFormationCostMatrix::BuildAbsoluteDistance(From, ShiftedTo, ShiftedMatrix);
+        FFormationAssignmentWarmStart PreviousSolve;
+        TArray<int32> Assignment;
+        FFormationAssignmentSolver::SolveLAPJV(ShiftedMatrix.GetValues(), NumUnits, Assignment, &PreviousSolve);
+
+        FFormationAssignmentWarmStart WarmStart;
+        Report.Measure(TEXT("Solver.LAPJVWarmStart"), NumUnits, [&]()
+        {
+            WarmStart = PreviousSolve;
+            FFormationAssignmentSolver::SolveLAPJV(Costs, NumUnits, Assignment, &WarmStart);
+        });
+        AddCostMetrics(Report, TEXT("Solver.LAPJVWarmStart"), NumUnits, FFormationAssignmentSolver::CalculateTotalCost(Costs, NumUnits, Assignment), OptimalCost);
+
+        Report.Measure(TEXT("Solver.Auction"), NumUnits, [&]() { FFormationAssignmentSolver::SolveAuction(Costs, NumUnits, Assignment); });
+        if (IsPermutation(Assignment, NumUnits))
+        {
+            AddCostMetrics(Report, TEXT("Solver.Auction"), NumUnits, FFormationAssignmentSolver::CalculateTotalCost(Costs, NumUnits, Assignment), OptimalCost);
+        }
+
+        Report.Measure(TEXT("Solver.Sparse16"), NumUnits, [&]() { FFormationAssignmentSolver::SolveSparse(SparseMatrix, Assignment); });
+        TestTrue(FString::Printf(TEXT("稀疏求解应输出完整分配 (N=%d)"), NumUnits), IsPermutation(Assignment, NumUnits));
+        AddCostMetrics(Report, TEXT("Solver.Sparse16"), NumUnits, FFormationAssignmentSolver::CalculateTotalCost(Costs, NumUnits, Assignment), OptimalCost);
+
+        Report.Measure(TEXT("Solver.Greedy"), NumUnits, [&]()
+        {
+            Assignment = GreedyManager->CalculateOptimalAssignment(From, To, EFormationTransitionMode::SimpleAssignment);
+        });
+        TestTrue(FString::Printf(TEXT("贪心求解应输出完整分配 (N=%d)"), NumUnits), IsPermutation(Assignment, NumUnits));
+        AddCostMetrics(Report, TEXT("Solver.Greedy"), NumUnits, FFormationAssignmentSolver::CalculateTotalCost(Costs, NumUnits, Assignment), OptimalCost);
+
+        // ---- 路径冲突检测（使用最优分配） ----
+        FFormationPathConflictDetector Detector;
+        TArray<FIntPoint> ConflictPairs;
+        Report.Measure(TEXT("PathConflicts.BuildAndFindAll"), NumUnits, [&]()
+        {
+            Detector.Build(From, To, Optimal);
+            Detector.FindAllConflicts(ConflictPairs);
+        });
+        Report.AddMetric(FString::Printf(TEXT("PathConflicts.NumPairs.%d"), NumUnits), ConflictPairs.Num());
+
+        // ---- 群集力：每帧一次全量计算 ----
+        TArray<FVector> Velocities;
+        Velocities.SetNumUninitialized(NumUnits);
+        for (FVector& Velocity : Velocities)
+        {
+            Velocity = Stream.GetUnitVector() * Stream.FRandRange(0.0f, 300.0f);
+            Velocity.Z = 0.0f;
+        }
+
+        const FBoidsMovementParams BoidsParams;
+        FBoidsNeighborGrid Grid;
+        TArray<FFormationBoidsForces> Forces;
+        Report.Measure(TEXT("Boids.ForcesPerTick"), NumUnits, [&]()
+        {
+            FFormationMathUtils::CalculateBoidsForces(From, Velocities, BoidsParams, Forces, &Grid);
+        });
+        TestEqual(FString::Printf(TEXT("群集力数量应与单位一致 (N=%d)"), NumUnits), Forces.Num(), NumUnits);
+    }
+
+    GreedyManager->MarkAsGarbage();
+
+    TestTrue(TEXT("基准测试结果应写入JSON"), Report.Save());
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FFormationBenchmark_TransitionUpdate,
+    "XTools.Formation.Benchmark.TransitionUpdate",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FFormationBenchmark_TransitionUpdate::RunTest(const FString& Parameters)
+{
+    using namespace FormationBenchmark_Private;
+
+    FXToolsBenchmarkReport Report(TEXT("Formation.TransitionUpdate"));
+
+    // 单位需要真实注册的根组件，使用临时世界生成
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+    AFormationTestActor* TestActor = World ? World->SpawnActor<AFormationTestActor>() : nullptr;
+    if (!TestNotNull(TEXT("临时世界应生成阵型测试Actor"), TestActor))
+    {
+        if (World)
+        {
+            World->DestroyWorld(false);
+        }
+        return false;
+    }
+
+    UFormationManagerComponent* Manager = TestActor->FormationManager;
+    Manager->AsyncAssignmentThreshold = 0;
+
+    // 模拟 60 帧每秒的帧间隔
+    constexpr float DeltaTime = 1.0f / 60.0f;
+
+    for (const int32 NumUnits : UnitCounts)
+    {
+        TestActor->CreateTestUnits(NumUnits);
+        TArray<AActor*> Units = TestActor->TestUnits;
+        if (!TestEqual(FString::Printf(TEXT("应生成全部测试单位 (N=%d)"), NumUnits), Units.Num(), NumUnits))
+        {
+            continue;
+        }
+
+        FVector CurrentCenter;
+        const FFormationData FromFormation = UFormationLibrary::GetCurrentFormationFromActors(Units, CurrentCenter);
+        const FFormationData ToFormation = UFormationLibrary::CreateSquareFormation(
+            CurrentCenter + FVector(3000.0f, 0.0f, 0.0f), FRotator::ZeroRotator, NumUnits, UnitSpacing);
+
+        // ---- 批量执行器：插值 + 写回组件，进度逐次推进，避免组件因变换未改变而提前返回 ----
+        const TArray<FVector> FromPositions = FromFormation.GetWorldPositions();
+        const TArray<FVector> ToPositions = ToFormation.GetWorldPositions();
+        TArray<FUnitTransitionData> UnitTransitions;
+        UnitTransitions.SetNum(NumUnits);
+        for (int32 Index = 0; Index < NumUnits; ++Index)
+        {
+            FUnitTransitionData& Transition = UnitTransitions[Index];
+            Transition.TargetActor = Units[Index];
+            Transition.StartLocation = FromPositions[Index];
+            Transition.TargetLocation = ToPositions[Index];
+            Transition.StartRotation = FRotator::ZeroRotator;
+            Transition.TargetRotation = (ToPositions[Index] - FromPositions[Index]).Rotation();
+        }
+
+        FFormationTransitionRunner Runner;
+        Runner.Init(UnitTransitions);
+        TestEqual(FString::Printf(TEXT("执行器应接管全部单位 (N=%d)"), NumUnits), Runner.Num(), NumUnits);
+
+        float Progress = 0.0f;
+        const auto AdvanceProgress = [&Progress]()
+        {
+            Progress = FMath::Fmod(Progress + 0.001f, 1.0f);
+            return Progress;
+        };
+
+        Report.Measure(TEXT("Runner.Evaluate"), NumUnits, [&]() { Runner.Evaluate(AdvanceProgress()); });
+        Report.Measure(TEXT("Runner.EvaluateAndApply"), NumUnits, [&]()
+        {
+            Runner.Evaluate(AdvanceProgress());
+            Runner.Apply(false);
+        });
+        Report.Measure(TEXT("Runner.EvaluateAndApplyTeleport"), NumUnits, [&]()
+        {
+            Runner.Evaluate(AdvanceProgress());
+            Runner.Apply(true);
+        });
+
+        TArray<FTransform> StartTransforms;
+        TArray<FTransform> TargetTransforms;
+        for (int32 Index = 0; Index < NumUnits; ++Index)
+        {
+            StartTransforms.Add(FTransform(FromPositions[Index]));
+            TargetTransforms.Add(FTransform(UnitTransitions[Index].TargetRotation, ToPositions[Index]));
+        }
+        FFormationTransitionRunner InstanceRunner;
+        InstanceRunner.InitTransforms(StartTransforms, TargetTransforms);
+        TArray<FTransform> InstanceTransforms;
+        Report.Measure(TEXT("Runner.EvaluateTransforms"), NumUnits, [&]() { InstanceRunner.EvaluateTransforms(AdvanceProgress(), InstanceTransforms); });
+
+        // ---- 管理器完整的每帧更新：按索引映射，分配成本不计入 ----
+        FFormationTransitionConfig Config;
+        Config.TransitionMode = EFormationTransitionMode::DirectMapping;
+        Config.Duration = 3600.0f;
+        if (TestTrue(FString::Printf(TEXT("管理器应开始变换 (N=%d)"), NumUnits),
+            Manager->StartFormationTransition(Units, FromFormation, ToFormation, Config)))
+        {
+            // 世界不 Tick，回拨起始时间模拟时间流逝
+            Report.Measure(TEXT("Manager.AdvanceTransition"), NumUnits, [&]()
+            {
+                Manager->TransitionState.StartTime -= DeltaTime;
+                Manager->AdvanceTransition(DeltaTime);
+            });
+            TestTrue(FString::Printf(TEXT("计时期间变换不应结束 (N=%d)"), NumUnits), Manager->IsTransitioning());
+            Manager->StopFormationTransition(false);
+        }
+    }
+
+    TestActor->ClearTestUnits();
+    World->DestroyWorld(false);
+
+    TestTrue(TEXT("基准测试结果应写入JSON"), Report.Save());
+    return true;
+}
+
+#endif
@@ -0,0 +1,181 @@
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+
+#include "FormationCostMatrix.h"
+#include "FormationAssignmentSolver.h"
+
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+namespace FormationCostMatrixTests
+{
+    void MakeShiftedGrid(int32 Num, int32 Columns, const FVector& Offset, FRandomStream& Stream, TArray<FVector>& OutFrom, TArray<FVector>& OutTo)
+    {
+        OutFrom.Reset();
+        OutTo.Reset();
+        for (int32 Index = 0; Index < Num; ++Index)
+        {
+            const FVector Target((Index % Columns) * 100.0f, (Index / Columns) * 100.0f, 0.0f);
+            OutTo.Add(Target);
+            OutFrom.Add(Target + Offset + FVector(Stream.FRandRange(-150.0f, 150.0f), Stream.FRandRange(-150.0f, 150.0f), 0.0f));
+        }
+
+        // 打乱起始顺序，使按索引映射不是最优解
+        for (int32 Index = OutFrom.Num() - 1; Index > 0; --Index)
+        {
+            OutFrom.Swap(Index, Stream.RandRange(0, Index));
+        }
+    }
+
+    bool IsPermutation(const TArray<int32>& Assignment, int32 Size)
+    {
+        TArray<bool> Used;
+        Used.Init(false, Size);
+        for (const int32 Column : Assignment)
+        {
+            if (Column < 0 || Column >= Size || Used[Column])
+            {
+                return false;
+            }
+            Used[Column] = true;
+        }
+        return Assignment.Num() == Size;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FFormationCostMatrix_DenseBuildersMatchScalar,
+    "XTools.Formation.CostMatrix.DenseBuildersMatchScalar",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFormationCostMatrix_DenseBuildersMatchScalar::RunTest(const FString& Parameters)
+{
+    FRandomStream Stream(1234);
+    TArray<FVector> From;
+    TArray<FVector> To;
+
+    // 列数不是 4 的倍数，覆盖 SIMD 尾部；位置远离原点，覆盖局部原点换算
+    for (int32 Index = 0; Index < 37; ++Index)
+    {
+        From.Add(FVector(100000.0f, -50000.0f, 0.0f) + Stream.GetUnitVector() * Stream.FRandRange(0.0f, 3000.0f));
+        To.Add(FVector(103000.0f, -50000.0f, 200.0f) + Stream.GetUnitVector() * Stream.FRandRange(0.0f, 3000.0f));
+    }
+
+    FFormationCostMatrix Absolute;
+    FFormationCostMatrix::BuildAbsoluteDistance(From, To, Absolute);
+    TestEqual(TEXT("行数"), Absolute.GetNumRows(), From.Num());
+    TestEqual(TEXT("列数"), Absolute.GetNumColumns(), To.Num());
+
+    FFormationCostMatrix Relative;
+    FFormationCostMatrix::BuildRelativePosition(From, To, Relative);
+
+    const FBox FromBounds(From);
+    const FBox ToBounds(To);
+    const FVector FromSizeInv = FVector::OneVector / FromBounds.GetSize();
+    const FVector ToSizeInv = FVector::OneVector / ToBounds.GetSize();
+
+    bool bAbsoluteMatches = true;
+    bool bRelativeMatches = true;
+    for (int32 Row = 0; Row < From.Num(); ++Row)
+    {
+        for (int32 Column = 0; Column < To.Num(); ++Column)
+        {
+            const float Expected = FVector::Dist(From[Row], To[Column]);
+            bAbsoluteMatches &= FMath::IsNearlyEqual(Absolute(Row, Column), Expected, 1.0e-2f);
+
+            const float RelativeDistance = FVector::Dist(
+                (From[Row] - FromBounds.GetCenter()) * FromSizeInv,
+                (To[Column] - ToBounds.GetCenter()) * ToSizeInv);
+            const float ExpectedRelative = RelativeDistance * FFormationCostMatrix::RelativeScale * FFormationCostMatrix::RelativeWeight
+                + Expected * FFormationCostMatrix::AbsoluteWeight;
+            bRelativeMatches &= FMath::IsNearlyEqual(Relative(Row, Column), ExpectedRelative, 1.0e-2f);
+        }
+    }
+    TestTrue(TEXT("绝对距离成本应与逐元素计算一致"), bAbsoluteMatches);
+    TestTrue(TEXT("相对位置成本应与逐元素计算一致"), bRelativeMatches);
+
+    TArray<TArray<float>> Nested;
+    Nested.Add({ 1.0f, 2.0f });
+    Nested.Add({ 3.0f, 4.0f });
+    FFormationCostMatrix FromNested;
+    TestTrue(TEXT("嵌套数组转换应成功"), FromNested.SetFromNested(Nested));
+    TestEqual(TEXT("嵌套数组转换后元素位置"), FromNested(1, 0), 3.0f);
+
+    Nested[1].Add(5.0f);
+    TestFalse(TEXT("行长度不一致时转换应失败"), FromNested.SetFromNested(Nested));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FFormationCostMatrix_SparseNearestMatchesDense,
+    "XTools.Formation.CostMatrix.SparseNearestMatchesDense",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFormationCostMatrix_SparseNearestMatchesDense::RunTest(const FString& Parameters)
+{
+    using namespace FormationCostMatrixTests;
+
+    constexpr int32 Num = 400;
+    constexpr int32 NeighborCount = 16;
+    FRandomStream Stream(99);
+    TArray<FVector> From;
+    TArray<FVector> To;
+    MakeShiftedGrid(Num, 20, FVector(3000.0f, 0.0f, 0.0f), Stream, From, To);
+
+    for (const bool bUseRelativePosition : { false, true })
+    {
+        FFormationSparseCostMatrix Sparse;
+        FFormationSparseCostMatrix::BuildNearest(From, To, NeighborCount, bUseRelativePosition, Sparse);
+        TestEqual(TEXT("稀疏矩阵行数"), Sparse.GetNumRows(), Num);
+
+        bool bRowsValid = true;
+        for (int32 Row = 0; Row < Num; ++Row)
+        {
+            const int32 NumEdges = Sparse.RowOffsets[Row + 1] - Sparse.RowOffsets[Row];
+            bool bHasDiagonal = false;
+            for (int32 Edge = Sparse.RowOffsets[Row]; Edge < Sparse.RowOffsets[Row + 1]; ++Edge)
+            {
+                bHasDiagonal |= Sparse.Columns[Edge] == Row;
+            }
+            bRowsValid &= NumEdges >= NeighborCount && NumEdges <= NeighborCount + 1 && bHasDiagonal;
+        }
+        TestTrue(TEXT("每行应有 K 或 K+1 条边且包含对角边"), bRowsValid);
+
+        FFormationCostMatrix Dense;
+        if (bUseRelativePosition)
+        {
+            FFormationCostMatrix::BuildRelativePosition(From, To, Dense);
+        }
+        else
+        {
+            FFormationCostMatrix::BuildAbsoluteDistance(From, To, Dense);
+        }
+
+        TArray<int32> DenseAssignment;
+        TArray<int32> SparseAssignment;
+        TestTrue(TEXT("稠密求解应成功"), FFormationAssignmentSolver::SolveLAPJV(Dense.GetValues(), Num, DenseAssignment));
+        TestTrue(TEXT("稀疏求解应成功"), FFormationAssignmentSolver::SolveSparse(Sparse, SparseAssignment));
+        TestTrue(TEXT("稀疏求解结果应为排列"), IsPermutation(SparseAssignment, Num));
+
+        const double DenseCost = FFormationAssignmentSolver::CalculateTotalCost(Dense.GetValues(), Num, DenseAssignment);
+        const double SparseCost = FFormationAssignmentSolver::CalculateTotalCost(Dense.GetValues(), Num, SparseAssignment);
+        TestTrue(TEXT("稀疏求解总成本应与稠密最优值相差不超过 1%"),
+            SparseCost >= DenseCost - 1.0 && SparseCost <= DenseCost * 1.01);
+    }
+
+    // 所有边都保留时稀疏求解应与稠密求解完全一致
+    FFormationSparseCostMatrix Full;
+    FFormationSparseCostMatrix::BuildNearest(From, To, Num, false, Full);
+    FFormationCostMatrix Dense;
+    FFormationCostMatrix::BuildAbsoluteDistance(From, To, Dense);
+    TArray<int32> DenseAssignment;
+    TArray<int32> FullAssignment;
+    FFormationAssignmentSolver::SolveLAPJV(Dense.GetValues(), Num, DenseAssignment);
+    TestTrue(TEXT("完整稀疏矩阵求解应成功"), FFormationAssignmentSolver::SolveSparse(Full, FullAssignment));
+    TestTrue(TEXT("完整稀疏矩阵应得到相同的最优总成本"), FMath::IsNearlyEqual(
+        FFormationAssignmentSolver::CalculateTotalCost(Dense.GetValues(), Num, FullAssignment),
+        FFormationAssignmentSolver::CalculateTotalCost(Dense.GetValues(), Num, DenseAssignment), 1.0));
+
+    return true;
+}
+
+#endif
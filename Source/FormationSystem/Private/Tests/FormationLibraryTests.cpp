@@ -7,7 +7,9 @@
 
 #include "Algo/AllOf.h"
 #include "FormationLibrary.h"
+#include "FormationBlueprintNodes.h"
 #include "FormationMathUtils.h"
+#include "FormationTemplateCache.h"
 #include "Misc/AutomationTest.h"
 
 namespace
@@ -126,6 +128,113 @@ bool FFormationLibrary_TransformsAndValidatesData::RunTest(const FString& Parame
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FFormationLibrary_TemplateCacheScalesAndOrdersSlots,
+	"XTools.Formation.Library.TemplateCacheScalesAndOrdersSlots",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFormationLibrary_TemplateCacheScalesAndOrdersSlots::RunTest(const FString& Parameters)
+{
+	// 不同间距共用同一模板，结果只差一个缩放
+	const FFormationData Small = UFormationLibrary::CreateSquareFormation(FVector::ZeroVector, FRotator::ZeroRotator, 10, 100.0f);
+	const FFormationData Large = UFormationLibrary::CreateSquareFormation(FVector::ZeroVector, FRotator::ZeroRotator, 10, 250.0f);
+	TestFormation(*this, TEXT("缓存方形阵"), Large, 10);
+	bool bScaled = Small.Positions.Num() == Large.Positions.Num();
+	for (int32 Index = 0; bScaled && Index < Small.Positions.Num(); ++Index)
+	{
+		bScaled = Large.Positions[Index].Equals(Small.Positions[Index] * 2.5f, UE_KINDA_SMALL_NUMBER);
+	}
+	TestTrue(TEXT("不同间距的方形阵应为同一模板的缩放"), bScaled);
+	TestTrue(TEXT("方形阵尺寸应随间距缩放"), Large.Size.Equals(FVector2D(4.0f * 250.0f, 3.0f * 250.0f)));
+
+	// 起始角在拷贝时作为整体旋转
+	const FFormationData Circle = UFormationLibrary::CreateCircleFormation(FVector::ZeroVector, FRotator::ZeroRotator, 8, 100.0f, 90.0f, true);
+	TestTrue(TEXT("圆形阵首个点应位于起始角"), Circle.Positions[0].Equals(FVector(0.0f, 100.0f, 0.0f), 0.01f));
+
+	FFormationTemplateKey Key;
+	Key.FormationType = EFormationType::Square;
+	Key.UnitCount = 10;
+	const TSharedPtr<const FFormationTemplate, ESPMode::ThreadSafe> Template = FFormationTemplateCache::Get().Find(Key);
+	if (TestTrue(TEXT("方形阵模板应已缓存"), Template.IsValid()))
+	{
+		for (const EFormationSlotOrder Order : { EFormationSlotOrder::Polar, EFormationSlotOrder::RowMajor, EFormationSlotOrder::Hilbert })
+		{
+			TArray<int32> Sorted = Template->GetSlotOrder(Order);
+			Sorted.Sort();
+			bool bPermutation = Sorted.Num() == 10;
+			for (int32 Index = 0; bPermutation && Index < Sorted.Num(); ++Index)
+			{
+				bPermutation = Sorted[Index] == Index;
+			}
+			TestTrue(TEXT("槽位顺序应为全部槽位的一个排列"), bPermutation);
+		}
+
+		// 方形阵按行生成，行优先顺序与生成顺序一致
+		const TArray<int32>& RowMajor = Template->GetSlotOrder(EFormationSlotOrder::RowMajor);
+		bool bRowMajorMatches = true;
+		for (int32 Index = 0; Index < RowMajor.Num(); ++Index)
+		{
+			bRowMajorMatches &= RowMajor[Index] == Index;
+		}
+		TestTrue(TEXT("方形阵的行优先顺序应与生成顺序一致"), bRowMajorMatches);
+	}
+
+	// Hilbert 顺序中相邻的两个网格槽位在空间上也相邻
+	TArray<FVector> Grid;
+	for (int32 Y = 0; Y < 8; ++Y)
+	{
+		for (int32 X = 0; X < 8; ++X)
+		{
+			Grid.Add(FVector(static_cast<float>(X), static_cast<float>(Y), 0.0f));
+		}
+	}
+	TArray<int32> HilbertOrder;
+	FFormationTemplateCache::CalculateSlotOrder(Grid, EFormationSlotOrder::Hilbert, HilbertOrder);
+	bool bContiguous = HilbertOrder.Num() == Grid.Num();
+	for (int32 Index = 1; bContiguous && Index < HilbertOrder.Num(); ++Index)
+	{
+		bContiguous = FMath::IsNearlyEqual(FVector::Dist(Grid[HilbertOrder[Index - 1]], Grid[HilbertOrder[Index]]), 1.0f);
+	}
+	TestTrue(TEXT("Hilbert 顺序在规则网格上应逐格相邻"), bContiguous);
+
+	// 旋转后的极坐标顺序只是预排序的循环移位，应与对旋转后的位置重新排序一致
+	for (const int32 RowCount : { 2, 4 })
+	{
+		const FFormationData Grid2D = UFormationLibrary::CreateSquareFormation(FVector::ZeroVector, FRotator::ZeroRotator, RowCount == 2 ? 12 : 16, 100.0f, RowCount);
+		if (!TestTrue(TEXT("方形阵应记录来源模板"), Grid2D.Template.IsValid()))
+		{
+			continue;
+		}
+
+		for (const float Yaw : { 0.0f, 30.0f, 100.0f, -70.0f })
+		{
+			TArray<FVector> Rotated;
+			Grid2D.Template->CopyScaled(Grid2D.TemplateScale, Rotated, Yaw);
+			TArray<int32> Expected;
+			FFormationTemplateCache::CalculateSlotOrder(Rotated, EFormationSlotOrder::Polar, Expected);
+			TArray<int32> Shifted;
+			Grid2D.Template->GetRotatedPolarOrder(Yaw, Shifted);
+			TestEqual(FString::Printf(TEXT("%d 行方形阵旋转 %.0f 度后的极坐标顺序应与重新排序一致"), RowCount, Yaw), Shifted, Expected);
+		}
+	}
+
+	// 原地变换与拷贝版本结果一致
+	const FTransform Transform(FRotator(0.0f, 30.0f, 0.0f), FVector(500.0f, 0.0f, 0.0f), FVector(2.0f));
+	const FFormationData Copied = UFormationBlueprintNodes::ApplyFormationTransform(Small, Transform);
+	FFormationData InPlace = Small;
+	UFormationBlueprintNodes::ApplyFormationTransformInPlace(InPlace, Transform);
+	bool bSameTransform = InPlace.CenterLocation.Equals(Copied.CenterLocation) && InPlace.Rotation.Equals(Copied.Rotation);
+	for (int32 Index = 0; bSameTransform && Index < InPlace.Positions.Num(); ++Index)
+	{
+		bSameTransform = InPlace.Positions[Index].Equals(Copied.Positions[Index], UE_KINDA_SMALL_NUMBER);
+	}
+	TestTrue(TEXT("原地变换应与拷贝变换一致"), bSameTransform);
+	TestTrue(TEXT("变换应先缩放后旋转"),
+		InPlace.Positions[0].Equals(FRotator(0.0f, 30.0f, 0.0f).RotateVector(Small.Positions[0] * 2.0f), 0.01f));
+
+	return true;
+}
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
 	FFormationMathUtils_ProducesBoundedForces,
 	"XTools.Formation.MathUtils.ProducesBoundedForces",
@@ -2,6 +2,7 @@
 
 #include "FormationMathUtils.h"
 
+#include "Math/RandomStream.h"
 #include "Misc/AutomationTest.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
@@ -25,4 +26,55 @@ bool FFormationMathUtils_RejectsNegativeSeparationWeight::RunTest(const FString&
     return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FFormationMathUtils_BatchBoidsForcesMatchPerUnit,
+    "XTools.Formation.MathUtils.BatchBoidsForcesMatchPerUnit",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFormationMathUtils_BatchBoidsForcesMatchPerUnit::RunTest(const FString& Parameters)
+{
+    FBoidsMovementParams BoidsParams;
+    FRandomStream Stream(2024);
+
+    // 两个相距很远的密集群体，覆盖稀疏分布时放大格子的情况；远离原点覆盖局部坐标换算
+    TArray<FVector> Positions;
+    TArray<FVector> Velocities;
+    for (int32 Index = 0; Index < 600; ++Index)
+    {
+        const FVector GroupCenter = Index % 2 == 0 ? FVector(200000.0f, 0.0f, 0.0f) : FVector(-300000.0f, 80000.0f, 500.0f);
+        Positions.Add(GroupCenter + FVector(Stream.FRandRange(-1500.0f, 1500.0f), Stream.FRandRange(-1500.0f, 1500.0f), Stream.FRandRange(-50.0f, 50.0f)));
+        Velocities.Add(FVector(Stream.FRandRange(-300.0f, 300.0f), Stream.FRandRange(-300.0f, 300.0f), 0.0f));
+    }
+    Positions.Add(Positions[0]);
+    Velocities.Add(Velocities[0]);
+
+    TArray<FFormationBoidsForces> Forces;
+    FBoidsNeighborGrid Grid;
+    TestTrue(TEXT("Batch boids forces succeed"), FFormationMathUtils::CalculateBoidsForces(Positions, Velocities, BoidsParams, Forces, &Grid));
+    TestEqual(TEXT("One force entry per unit"), Forces.Num(), Positions.Num());
+
+    bool bAllMatch = true;
+    for (int32 Index = 0; Index < Positions.Num(); ++Index)
+    {
+        bAllMatch &= Forces[Index].Separation.Equals(FFormationMathUtils::CalculateSeparationForce(Index, Positions, BoidsParams), 0.5f);
+        bAllMatch &= Forces[Index].Alignment.Equals(FFormationMathUtils::CalculateAlignmentForce(Index, Positions, Velocities, BoidsParams), 0.5f);
+        bAllMatch &= Forces[Index].Cohesion.Equals(FFormationMathUtils::CalculateCohesionForce(Index, Positions, BoidsParams), 0.5f);
+    }
+    TestTrue(TEXT("Batch forces match per-unit forces"), bAllMatch);
+
+    TArray<FFormationBoidsForces> Repeated;
+    FFormationMathUtils::CalculateBoidsForces(Positions, Velocities, BoidsParams, Repeated, &Grid);
+    bool bDeterministic = true;
+    for (int32 Index = 0; Index < Positions.Num(); ++Index)
+    {
+        bDeterministic &= Forces[Index].GetTotal() == Repeated[Index].GetTotal();
+    }
+    TestTrue(TEXT("Batch forces are deterministic across runs"), bDeterministic);
+
+    AddExpectedError(TEXT("CalculateBoidsForces"), EAutomationExpectedErrorFlags::Contains);
+    Velocities.Pop();
+    TestFalse(TEXT("Mismatched velocity count fails"), FFormationMathUtils::CalculateBoidsForces(Positions, Velocities, BoidsParams, Forces));
+    return true;
+}
+
 #endif
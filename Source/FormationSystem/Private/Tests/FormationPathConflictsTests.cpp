@@ -0,0 +1,162 @@
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+
+#include "FormationPathConflicts.h"
+#include "FormationMathUtils.h"
+
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FFormationPathConflicts_TimeParameterized,
+    "XTools.Formation.PathConflicts.TimeParameterized",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFormationPathConflicts_TimeParameterized::RunTest(const FString& Parameters)
+{
+    float ClosestTime = 0.0f;
+
+    // 两条路径在 (500,0) 交叉，且同时到达交点
+    const float SameTime = FFormationMathUtils::CalculateClosestApproach(
+        FVector(0.0f, 0.0f, 0.0f), FVector(1000.0f, 0.0f, 0.0f),
+        FVector(500.0f, -500.0f, 0.0f), FVector(500.0f, 500.0f, 0.0f), ClosestTime);
+    TestTrue(TEXT("同时经过交点应视为接近"), SameTime < 1.0f);
+    TestEqual(TEXT("最近距离出现在中点"), ClosestTime, 0.5f, 1.0e-3f);
+
+    // 空间上同样交叉，但第二个单位在第一个单位离开后很久才经过交点
+    const float DifferentTime = FFormationMathUtils::CalculateClosestApproach(
+        FVector(0.0f, 0.0f, 0.0f), FVector(1000.0f, 0.0f, 0.0f),
+        FVector(900.0f, -100.0f, 0.0f), FVector(900.0f, 5000.0f, 0.0f), ClosestTime);
+    TestTrue(TEXT("先后经过交点不算冲突"), DifferentTime > 50.0f);
+    TestTrue(TEXT("空间上路径仍然相交"), FFormationMathUtils::DoPathsIntersect(
+        FVector(0.0f, 0.0f, 0.0f), FVector(1000.0f, 0.0f, 0.0f),
+        FVector(900.0f, -100.0f, 0.0f), FVector(900.0f, 5000.0f, 0.0f)));
+
+    // 阵型整体平移：路径互相重叠，但任意时刻都保持间距
+    TArray<FVector> From;
+    TArray<FVector> To;
+    TArray<int32> Assignment;
+    for (int32 Index = 0; Index < 100; ++Index)
+    {
+        From.Add(FVector((Index % 10) * 100.0f, (Index / 10) * 100.0f, 0.0f));
+        To.Add(From.Last() + FVector(3000.0f, 0.0f, 0.0f));
+        Assignment.Add(Index);
+    }
+
+    FFormationPathConflictDetector Detector(50.0f);
+    Detector.Build(From, To, Assignment);
+    TArray<FIntPoint> Conflicts;
+    Detector.FindAllConflicts(Conflicts);
+    TestEqual(TEXT("整体平移没有冲突"), Conflicts.Num(), 0);
+
+    // 交换两个相邻单位的目标后，它们会在途中相遇
+    Detector.SetUnitTarget(0, To[1]);
+    Detector.SetUnitTarget(1, To[0]);
+    TArray<int32> UnitConflicts;
+    Detector.FindConflictsForUnit(0, UnitConflicts);
+    TestTrue(TEXT("交换目标后只需复查被交换的单位"), UnitConflicts.Contains(1));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FFormationPathConflicts_MatchesAllPairs,
+    "XTools.Formation.PathConflicts.MatchesAllPairs",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFormationPathConflicts_MatchesAllPairs::RunTest(const FString& Parameters)
+{
+    FRandomStream Stream(31337);
+    for (int32 Trial = 0; Trial < 6; ++Trial)
+    {
+        const int32 NumUnits = 40 + Trial * 30;
+        const float Threshold = Trial % 2 == 0 ? 50.0f : 120.0f;
+
+        TArray<FVector> From;
+        TArray<FVector> To;
+        TArray<int32> Assignment;
+        for (int32 Index = 0; Index < NumUnits; ++Index)
+        {
+            From.Add(FVector(Stream.FRandRange(0.0f, 2000.0f), Stream.FRandRange(0.0f, 1500.0f), 0.0f));
+            To.Add(FVector(Stream.FRandRange(-3000.0f, 5000.0f), Stream.FRandRange(0.0f, 4000.0f), 0.0f));
+            Assignment.Add(NumUnits - 1 - Index);
+        }
+
+        TArray<FIntPoint> Expected;
+        for (int32 UnitA = 0; UnitA < NumUnits; ++UnitA)
+        {
+            for (int32 UnitB = UnitA + 1; UnitB < NumUnits; ++UnitB)
+            {
+                float ClosestTime;
+                if (FFormationMathUtils::CalculateClosestApproach(
+                    From[UnitA], To[Assignment[UnitA]], From[UnitB], To[Assignment[UnitB]], ClosestTime) < Threshold)
+                {
+                    Expected.Add(FIntPoint(UnitA, UnitB));
+                }
+            }
+        }
+
+        FFormationPathConflictDetector Detector(Threshold);
+        Detector.Build(From, To, Assignment);
+        TArray<FIntPoint> Conflicts;
+        Detector.FindAllConflicts(Conflicts);
+        TestTrue(TEXT("扫描排除结果应与逐对检测完全一致"), Conflicts == Expected);
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FFormationPathConflicts_UnitQueryMatchesAllPairs,
+    "XTools.Formation.PathConflicts.UnitQueryMatchesAllPairs",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFormationPathConflicts_UnitQueryMatchesAllPairs::RunTest(const FString& Parameters)
+{
+    FRandomStream Stream(4242);
+    constexpr int32 NumUnits = 160;
+    constexpr float Threshold = 80.0f;
+
+    TArray<FVector> From;
+    TArray<FVector> To;
+    TArray<int32> Assignment;
+    for (int32 Index = 0; Index < NumUnits; ++Index)
+    {
+        From.Add(FVector(Stream.FRandRange(0.0f, 2000.0f), Stream.FRandRange(0.0f, 1500.0f), 0.0f));
+        To.Add(FVector(Stream.FRandRange(-3000.0f, 5000.0f), Stream.FRandRange(0.0f, 4000.0f), 0.0f));
+        Assignment.Add(Index);
+    }
+
+    FFormationPathConflictDetector Detector(Threshold);
+    Detector.Build(From, To, Assignment);
+    TArray<FIntPoint> Conflicts;
+    Detector.FindAllConflicts(Conflicts);
+
+    // 交换次数超过过期单位的重建阈值，覆盖缓存中复查、过期单位单独检测与整体重建三种情况
+    bool bAllMatch = true;
+    TArray<int32> UnitConflicts;
+    for (int32 SwapIndex = 0; SwapIndex < 60; ++SwapIndex)
+    {
+        const int32 UnitA = Stream.RandHelper(NumUnits);
+        const int32 UnitB = Stream.RandHelper(NumUnits);
+        const FVector TargetA = Detector.GetEnd(UnitA);
+        Detector.SetUnitTarget(UnitA, Detector.GetEnd(UnitB));
+        Detector.SetUnitTarget(UnitB, TargetA);
+
+        for (const int32 Unit : { UnitA, UnitB, Stream.RandHelper(NumUnits) })
+        {
+            TArray<int32> Expected;
+            for (int32 Other = 0; Other < NumUnits; ++Other)
+            {
+                if (Detector.HasConflict(Unit, Other))
+                {
+                    Expected.Add(Other);
+                }
+            }
+
+            Detector.FindConflictsForUnit(Unit, UnitConflicts);
+            bAllMatch &= UnitConflicts == Expected;
+        }
+    }
+    TestTrue(TEXT("单个单位的复查结果应与逐个检测完全一致"), bAllMatch);
+    return true;
+}
+
+#endif
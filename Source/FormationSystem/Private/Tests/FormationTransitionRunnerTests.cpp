@@ -0,0 +1,92 @@
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+
+#include "FormationTransitionRunner.h"
+
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FFormationTransitionRunner_EvaluateTransformsMatchesLerp,
+    "XTools.Formation.TransitionRunner.EvaluateTransformsMatchesLerp",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFormationTransitionRunner_EvaluateTransformsMatchesLerp::RunTest(const FString& Parameters)
+{
+    FRandomStream Stream(7);
+    TArray<FTransform> Starts;
+    TArray<FTransform> Targets;
+
+    // 数量超过并行阈值，覆盖多线程插值
+    for (int32 Index = 0; Index < 1000; ++Index)
+    {
+        Starts.Add(FTransform(
+            FRotator(0.0f, Stream.FRandRange(-180.0f, 180.0f), 0.0f),
+            Stream.GetUnitVector() * Stream.FRandRange(0.0f, 5000.0f),
+            FVector(Stream.FRandRange(0.5f, 2.0f))));
+        Targets.Add(FTransform(
+            FRotator(0.0f, Stream.FRandRange(-180.0f, 180.0f), 0.0f),
+            Stream.GetUnitVector() * Stream.FRandRange(0.0f, 5000.0f),
+            Starts.Last().GetScale3D()));
+    }
+
+    FFormationTransitionRunner Runner;
+    Runner.InitTransforms(Starts, Targets);
+    TestEqual(TEXT("单位数量"), Runner.Num(), Starts.Num());
+
+    TArray<FTransform> Current;
+    for (const float Progress : { 0.0f, 0.3f, 1.0f })
+    {
+        Runner.EvaluateTransforms(Progress, Current);
+        TestEqual(TEXT("输出数量"), Current.Num(), Starts.Num());
+
+        bool bAllMatch = true;
+        for (int32 Index = 0; Index < Starts.Num(); ++Index)
+        {
+            const FVector ExpectedLocation = FMath::Lerp(Starts[Index].GetLocation(), Targets[Index].GetLocation(), Progress);
+            const FRotator ExpectedRotation = FMath::Lerp(Starts[Index].Rotator(), Targets[Index].Rotator(), Progress);
+            bAllMatch &= Current[Index].GetLocation().Equals(ExpectedLocation, 0.01f);
+            bAllMatch &= Current[Index].GetRotation().Equals(ExpectedRotation.Quaternion(), 1.0e-3f);
+            bAllMatch &= Current[Index].GetScale3D().Equals(Starts[Index].GetScale3D(), 1.0e-4f);
+        }
+        TestTrue(TEXT("批量插值结果应与逐单位插值一致（旋转走最短路径）"), bAllMatch);
+    }
+
+    Runner.Reset();
+    TestEqual(TEXT("重置后为空"), Runner.Num(), 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FFormationTransitionRunner_RetargetKeepsPositionContinuous,
+    "XTools.Formation.TransitionRunner.RetargetKeepsPositionContinuous",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFormationTransitionRunner_RetargetKeepsPositionContinuous::RunTest(const FString& Parameters)
+{
+    TArray<FTransform> Starts;
+    TArray<FTransform> Targets;
+    Starts.Add(FTransform(FRotator(0.0f, 170.0f, 0.0f), FVector(0.0f, 0.0f, 0.0f)));
+    Targets.Add(FTransform(FRotator(0.0f, -170.0f, 0.0f), FVector(1000.0f, 0.0f, 0.0f)));
+
+    FFormationTransitionRunner Runner;
+    Runner.InitTransforms(Starts, Targets);
+    Runner.Evaluate(0.4f);
+    const FVector LocationBefore = Runner.GetCurrentLocation(0);
+    const FRotator RotationBefore = Runner.GetCurrentRotation(0);
+
+    // 模拟后台求解返回：目标改变后，同一进度处位置不跳变，进度 1 时到达新目标
+    const FVector NewTarget(0.0f, 2000.0f, 0.0f);
+    const FRotator NewRotation(0.0f, 90.0f, 0.0f);
+    Runner.Retarget(0, NewTarget, NewRotation);
+
+    Runner.Evaluate(0.4f);
+    TestTrue(TEXT("切换目标时位置连续"), Runner.GetCurrentLocation(0).Equals(LocationBefore, 0.01f));
+    TestTrue(TEXT("切换目标时朝向连续"), Runner.GetCurrentRotation(0).Quaternion().Equals(RotationBefore.Quaternion(), 1.0e-3f));
+
+    Runner.Evaluate(1.0f);
+    TestTrue(TEXT("进度 1 时到达新目标"), Runner.GetCurrentLocation(0).Equals(NewTarget, 0.01f));
+    TestTrue(TEXT("进度 1 时到达新朝向"), Runner.GetCurrentRotation(0).Quaternion().Equals(NewRotation.Quaternion(), 1.0e-3f));
+    return true;
+}
+
+#endif
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+struct FFormationSparseCostMatrix;
+
+/**
+ * 分配求解的热启动数据
+ * 保存上一次求解的对偶价格与分配结果。阵型通常是增量变化的，
+ * 用上一次的价格作为初值时绝大多数行在初始化阶段就能直接匹配，只需少量增广。
+ * 任意价格都是合法的初值，因此即使成本矩阵已改变，热启动也只影响速度，不影响结果最优性。
+ */
+struct FORMATIONSYSTEM_API FFormationAssignmentWarmStart
+{
+    /** 列价格（对偶变量） */
+    TArray<double> ColumnPrices;
+
+    /** 上一次的分配结果：行 -> 列 */
+    TArray<int32> Assignment;
+
+    /** 是否可用于指定规模的问题 */
+    bool IsValidFor(int32 Size) const { return ColumnPrices.Num() == Size; }
+
+    void Reset()
+    {
+        ColumnPrices.Reset();
+        Assignment.Reset();
+    }
+};
+
+/**
+ * 线性分配问题求解器
+ * 输入为行主序的连续 N×N 成本矩阵（Costs[Row * N + Column]），求最小总成本的一一分配。
+ * - LAPJV：Jonker-Volgenant 最短增广路算法，列约简 + 增广行约简 + Dijkstra 增广，结果精确最优
+ * - 拍卖算法：ε-缩放拍卖，同一轮内各出价者互相独立，可并行计算出价，结果与最优解的差距不超过 N·ε
+ */
+class FORMATIONSYSTEM_API FFormationAssignmentSolver
+{
+public:
+    /**
+     * 使用 LAPJV 求解
+     * @param Costs 行主序成本矩阵，元素数量必须为 Size*Size 且全部有限
+     * @param Size 矩阵阶数
+     * @param OutAssignment 输出分配结果：行 -> 列
+     * @param WarmStart 可选的热启动数据，求解后会被更新为本次的价格与分配
+     * @param CancelFlag 可选的取消标记，每条增广路前检查，置位后立即返回 false 且不更新热启动数据
+     * @return 是否求解成功
+     */
+    static bool SolveLAPJV(
+        TConstArrayView<float> Costs,
+        int32 Size,
+        TArray<int32>& OutAssignment,
+        FFormationAssignmentWarmStart* WarmStart = nullptr,
+        const std::atomic<bool>* CancelFlag = nullptr);
+
+    /**
+     * 使用 ε-缩放拍卖算法求解
+     * @param Costs 行主序成本矩阵，元素数量必须为 Size*Size 且全部有限
+     * @param Size 矩阵阶数
+     * @param OutAssignment 输出分配结果：行 -> 列
+     * @param WarmStart 可选的热启动数据，有价格时直接从最终 ε 开始拍卖
+     * @param RelativeTolerance 最终 ε 相对于成本范围的比例，总成本误差不超过 N·ε
+     * @param CancelFlag 可选的取消标记，每轮出价前检查，置位后立即返回 false 且不更新热启动数据
+     * @return 是否在轮数上限内完成；失败时输出为空，调用者应回退到 LAPJV
+     */
+    static bool SolveAuction(
+        TConstArrayView<float> Costs,
+        int32 Size,
+        TArray<int32>& OutAssignment,
+        FFormationAssignmentWarmStart* WarmStart = nullptr,
+        float RelativeTolerance = 1.0e-5f,
+        const std::atomic<bool>* CancelFlag = nullptr);
+
+    /**
+     * 在稀疏成本矩阵上求解（Dijkstra 最短增广路，二叉堆 + 惰性删除）
+     * 只在矩阵给出的边上搜索，复杂度约 O(N·E·logE / N)，不存在的边视为不可分配。
+     * FFormationSparseCostMatrix::BuildNearest 总是包含对角边，因此一定存在完美匹配。
+     * @param Matrix 方阵形式的 CSR 成本矩阵
+     * @param OutAssignment 输出分配结果：行 -> 列
+     * @param WarmStart 可选的热启动数据，与稠密求解共用同一份价格
+     * @param CancelFlag 可选的取消标记，每条增广路前检查，置位后立即返回 false 且不更新热启动数据
+     * @return 是否求解成功；矩阵无效、不存在完美匹配或被取消时返回 false
+     */
+    static bool SolveSparse(
+        const FFormationSparseCostMatrix& Matrix,
+        TArray<int32>& OutAssignment,
+        FFormationAssignmentWarmStart* WarmStart = nullptr,
+        const std::atomic<bool>* CancelFlag = nullptr);
+
+    /** 计算分配结果的总成本 */
+    static double CalculateTotalCost(TConstArrayView<float> Costs, int32 Size, const TArray<int32>& Assignment);
+
+private:
+    static bool ValidateInput(TConstArrayView<float> Costs, int32 Size);
+    static bool ValidateSparseInput(const FFormationSparseCostMatrix& Matrix);
+};
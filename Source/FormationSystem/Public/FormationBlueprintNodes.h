@@ -29,7 +29,7 @@ public:
      * @param Units 参与变换的单位数组
      * @param TargetFormationType 目标阵型类型
      * @param FormationTransform 阵型变换（位置、旋转、缩放），可分割结构体引脚
-     * @param OutFormationManager 输出的阵型管理器（可用于后续控制）
+     * @param OutFormationManager 输出的阵型管理器（来自 UFormationSubsystem 对象池，变换结束后回收复用，不应长期持有）
      * @param FormationSize 阵型尺寸参数
      * @param TransitionDuration 变换持续时间
      * @param TransitionMode 变换模式（推荐使用直接相对位置匹配）
@@ -172,7 +172,7 @@ public:
      * @param Units 参与变换的单位数组
      * @param TargetFormationType 目标阵型类型
      * @param CenterLocation 阵型中心位置
-     * @param OutFormationManager 输出的阵型管理器
+     * @param OutFormationManager 输出的阵型管理器（来自 UFormationSubsystem 对象池，变换结束后回收复用，不应长期持有）
      * @param FormationSize 阵型尺寸参数
      * @param TransitionDuration 变换持续时间
      * @param BoidsParams Boids群集移动参数
@@ -201,7 +201,7 @@ public:
      * @param Units 参与变换的单位数组
      * @param TargetFormationType 目标阵型类型
      * @param CenterLocation 阵型中心位置
-     * @param OutFormationManager 输出的阵型管理器
+     * @param OutFormationManager 输出的阵型管理器（来自 UFormationSubsystem 对象池，变换结束后回收复用，不应长期持有）
      * @param OutConflictInfo 输出的路径冲突信息
      * @param FormationSize 阵型尺寸参数
      * @param TransitionDuration 变换持续时间
@@ -247,5 +247,11 @@ public:
         const FTransform& Transform
     );
 
+    /** 原地应用变换，避免拷贝整个位置数组；结果与 ApplyFormationTransform 相同 */
+    static void ApplyFormationTransformInPlace(
+        FFormationData& FormationData,
+        const FTransform& Transform
+    );
+
 private:
 };
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 连续存储的成本矩阵
+ * 行主序单块内存（Values[Row * NumColumns + Column]），起始地址按 SIMD 宽度对齐。
+ * 相比每行单独分配的 TArray<TArray<float>>，构建与求解时都是顺序访问，复制也只需一次 memcpy。
+ */
+struct FORMATIONSYSTEM_API FFormationCostMatrix
+{
+    using FValueArray = TArray<float, TAlignedHeapAllocator<16>>;
+
+    FFormationCostMatrix() = default;
+
+    /** 调整尺寸，内容未初始化；容量足够时不重新分配 */
+    void Init(int32 InNumRows, int32 InNumColumns);
+
+    void Reset()
+    {
+        NumRows = 0;
+        NumColumns = 0;
+        Values.Reset();
+    }
+
+    int32 GetNumRows() const { return NumRows; }
+    int32 GetNumColumns() const { return NumColumns; }
+    bool IsSquare() const { return NumRows == NumColumns; }
+    bool IsEmpty() const { return NumRows == 0 || NumColumns == 0; }
+
+    float& operator()(int32 Row, int32 Column)
+    {
+        checkSlow(Row >= 0 && Row < NumRows && Column >= 0 && Column < NumColumns);
+        return Values[static_cast<int64>(Row) * NumColumns + Column];
+    }
+
+    float operator()(int32 Row, int32 Column) const
+    {
+        checkSlow(Row >= 0 && Row < NumRows && Column >= 0 && Column < NumColumns);
+        return Values[static_cast<int64>(Row) * NumColumns + Column];
+    }
+
+    float* GetRow(int32 Row) { return Values.GetData() + static_cast<int64>(Row) * NumColumns; }
+    const float* GetRow(int32 Row) const { return Values.GetData() + static_cast<int64>(Row) * NumColumns; }
+
+    /** 全部元素的只读视图，可直接传给 FFormationAssignmentSolver */
+    TConstArrayView<float> GetValues() const { return TConstArrayView<float>(Values.GetData(), Values.Num()); }
+
+    /** 由嵌套数组构建，行长度不一致时返回 false */
+    bool SetFromNested(const TArray<TArray<float>>& Nested);
+
+    /**
+     * 绝对距离成本：Cost(i,j) = |From[i] - To[j]|
+     * 目标位置转为 SoA 浮点数组后按4路 SIMD 计算，规模较大时按行并行
+     */
+    static void BuildAbsoluteDistance(const TArray<FVector>& FromPositions, const TArray<FVector>& ToPositions, FFormationCostMatrix& OutMatrix);
+
+    /**
+     * 相对位置成本：各自包围盒归一化后的距离为主、绝对距离为辅
+     * Cost(i,j) = |N(From[i]) - N(To[j])| * RelativeScale * RelativeWeight + |From[i] - To[j]| * AbsoluteWeight
+     */
+    static void BuildRelativePosition(const TArray<FVector>& FromPositions, const TArray<FVector>& ToPositions, FFormationCostMatrix& OutMatrix);
+
+    static constexpr float RelativeWeight = 0.7f;
+    static constexpr float AbsoluteWeight = 0.3f;
+    static constexpr float RelativeScale = 1000.0f;
+
+private:
+    int32 NumRows = 0;
+    int32 NumColumns = 0;
+    FValueArray Values;
+};
+
+/**
+ * 稀疏成本矩阵（CSR 格式）
+ * 每行只保留距离最近的 K 个目标位置，另外总是保留 (i,i) 这条边以保证存在完美匹配。
+ * 内存为 O(N·K)，适合数千单位的大规模阵型。
+ */
+struct FORMATIONSYSTEM_API FFormationSparseCostMatrix
+{
+    /** 第 i 行的边为 [RowOffsets[i], RowOffsets[i+1]) */
+    TArray<int32> RowOffsets;
+
+    /** 每条边的列索引 */
+    TArray<int32> Columns;
+
+    /** 每条边的成本 */
+    TArray<float> Costs;
+
+    int32 GetNumRows() const { return FMath::Max(RowOffsets.Num() - 1, 0); }
+    int32 GetNumEdges() const { return Columns.Num(); }
+
+    void Reset()
+    {
+        RowOffsets.Reset();
+        Columns.Reset();
+        Costs.Reset();
+    }
+
+    /**
+     * 使用目标位置上的均匀网格查找每个起始位置最近的 K 个目标，并计算对应成本
+     * 查找时两个阵型先各自对齐到包围盒中心，边的成本仍按原始位置精确计算
+     * @param NeighborCount 每行保留的近邻数量 K
+     * @param bUseRelativePosition true 时使用与 BuildRelativePosition 相同的成本，近邻按归一化位置查找
+     */
+    static void BuildNearest(
+        const TArray<FVector>& FromPositions,
+        const TArray<FVector>& ToPositions,
+        int32 NeighborCount,
+        bool bUseRelativePosition,
+        FFormationSparseCostMatrix& OutMatrix);
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FormationManagerComponent.h"
+#include "FormationInstancedManagerComponent.generated.h"
+
+class UInstancedStaticMeshComponent;
+
+/**
+ * 实例化网格阵型管理器组件
+ * 驱动 UInstancedStaticMeshComponent（含 HISM）的实例而不是 Actor，适合大规模装饰性军队、人群与无人机群。
+ *
+ * 与 Actor 版本共用 FFormationData、变换模式与分配求解器；实例变换以结构数组保存，
+ * 每帧在工作线程上插值，再通过 BatchUpdateInstancesTransforms 一次性提交并只标记一次渲染状态。
+ * 第 i 个实例对应起始阵型的第 i 个位置。
+ * 实例数量达到 AsyncAssignmentThreshold 时与 Actor 版本相同：先按临时分配开始移动，最优分配在后台求解后平滑切换。
+ */
+UCLASS(BlueprintType, Blueprintable, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent, DisplayName = "实例化阵型管理器"))
+class FORMATIONSYSTEM_API UFormationInstancedManagerComponent : public UFormationManagerComponent
+{
+    GENERATED_BODY()
+
+public:
+    /** 实例是否在移动时朝向移动方向，与 Actor 版本行为一致 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Formation",
+              meta = (DisplayName = "朝向移动方向", ToolTip = "开启时实例的目标朝向为移动方向；关闭时保持原有朝向"))
+    bool bFaceMovementDirection = true;
+
+    /**
+     * 开始实例化网格的阵型变换
+     * @param Instances 目标实例化网格组件，实例数量必须与阵型位置数量一致
+     * @param FromFormation 起始阵型
+     * @param ToFormation 目标阵型
+     * @param Config 变换配置，bTeleportUnits 对应批量提交时的 bTeleport
+     * @return 是否成功开始变换
+     */
+    UFUNCTION(BlueprintCallable, Category = "Formation", meta = (DisplayName = "开始实例阵型变换"))
+    bool StartInstancedFormationTransition(
+        UInstancedStaticMeshComponent* Instances,
+        const FFormationData& FromFormation,
+        const FFormationData& ToFormation,
+        const FFormationTransitionConfig& Config = FFormationTransitionConfig()
+    );
+
+    virtual void StopFormationTransition(bool bSnapToTarget = false) override;
+
+    /** 获取当前驱动的实例化网格组件 */
+    UFUNCTION(BlueprintPure, Category = "Formation", meta = (DisplayName = "获取目标实例组件"))
+    UInstancedStaticMeshComponent* GetTargetInstances() const { return TargetInstances.Get(); }
+
+protected:
+    virtual void UpdateUnitPositions(float DeltaTime) override;
+    virtual void ApplyAsyncAssignment() override;
+
+private:
+    /** 实例在组件空间中的目标变换：位置为目标点，朝向按 bFaceMovementDirection 决定 */
+    FTransform MakeInstanceTarget(const FTransform& Start, const FVector& TargetWorldPosition) const;
+
+    /** 把插值结果批量写入实例 */
+    void PushInstanceTransforms(float Progress);
+
+    TWeakObjectPtr<UInstancedStaticMeshComponent> TargetInstances;
+
+    /** 实例起止变换的批量数据 */
+    FFormationTransitionRunner InstanceRunner;
+
+    /** 变换开始时的实例变换与组件变换，后台求解返回后据此计算新目标 */
+    TArray<FTransform> InstanceStartTransforms;
+    FTransform InstanceComponentTransform;
+
+    /** 每帧提交的实例变换，复用内存 */
+    TArray<FTransform> InstanceTransforms;
+};
@@ -3,6 +3,11 @@
 #include "CoreMinimal.h"
 #include "Components/SceneComponent.h"
 #include "FormationTypes.h"
+#include "FormationAssignmentSolver.h"
+#include "FormationCostMatrix.h"
+#include "FormationTransitionRunner.h"
+#include "Tasks/Task.h"
+#include <atomic>
 #include "FormationManagerComponent.generated.h"
 
 // 前向声明
@@ -26,12 +31,40 @@ public:
 protected:
     virtual void BeginPlay() override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+    virtual void BeginDestroy() override;
 
 public:
     /** 当前阵型变换状态 */
     UPROPERTY(BlueprintReadOnly, Category = "Formation", meta = (DisplayName = "变换状态"))
     FFormationTransitionState TransitionState;
 
+    /** 成本矩阵分配使用的求解器 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Formation", meta = (DisplayName = "分配求解器"))
+    EFormationAssignmentSolver AssignmentSolver = EFormationAssignmentSolver::ShortestAugmentingPath;
+
+    /** 单位数量达到该值时，优化/简单分配模式改用 K 近邻稀疏成本矩阵求解 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Formation",
+              meta = (DisplayName = "稀疏求解阈值", ClampMin = "2",
+                     ToolTip = "单位数量达到该值时只为每个单位保留最近的若干目标，内存与耗时从 O(N²) 降到约 O(N·K)；结果限定在近邻范围内，通常与全局最优一致或非常接近"))
+    int32 SparseAssignmentThreshold = 2000;
+
+    /** 稀疏求解时每个单位保留的近邻目标数量 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Formation",
+              meta = (DisplayName = "稀疏近邻数量", ClampMin = "4", ClampMax = "128",
+                     ToolTip = "稀疏求解时每个单位保留的候选目标数量，越大越接近全局最优但耗时越高"))
+    int32 SparseNeighborCount = 16;
+
+    /** 路径冲突判定距离：所有单位同时移动时两个单位的最近距离小于该值视为冲突 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Formation",
+              meta = (DisplayName = "路径冲突距离", ClampMin = "0.0", ForceUnits = "cm"))
+    float PathConflictThreshold = 50.0f;
+
+    /** 单位数量达到该值时在后台任务中求解分配 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Formation",
+              meta = (DisplayName = "异步求解阈值", ClampMin = "0",
+                     ToolTip = "单位数量达到该值时分配在后台任务中求解，单位先按近邻贪心的临时分配开始移动，求解完成后平滑切换到最优目标；新命令会取消尚未完成的求解。0 表示始终同步求解"))
+    int32 AsyncAssignmentThreshold = 1000;
+
     /** 阵型过渡完成时广播（可用于清理临时管理 Actor） */
     UPROPERTY(BlueprintAssignable, Category = "Formation", meta = (DisplayName = "过渡完成事件"))
     FOnFormationTransitionCompleted OnFormationTransitionCompleted;
@@ -83,7 +116,13 @@ public:
      * @param bSnapToTarget 是否立即移动到目标位置
      */
     UFUNCTION(BlueprintCallable, Category = "Formation", meta = (DisplayName = "停止阵型变换"))
-    void StopFormationTransition(bool bSnapToTarget = false);
+    virtual void StopFormationTransition(bool bSnapToTarget = false);
+
+    /**
+     * 推进一帧变换（更新单位位置与调试绘制）
+     * 组件自身 Tick 时调用；由 UFormationSubsystem 统一驱动的池化管理器不注册 Tick，由子系统调用
+     */
+    void AdvanceTransition(float DeltaTime);
 
     /** 销毁拥有此组件的 Actor（用于自动清理临时管理 Actor） */
     UFUNCTION()
@@ -101,6 +140,10 @@ public:
     UFUNCTION(BlueprintPure, Category = "Formation", meta = (DisplayName = "获取变换进度"))
     float GetTransitionProgress() const { return TransitionState.OverallProgress; }
 
+    /** 是否有尚未返回的后台分配求解 */
+    UFUNCTION(BlueprintPure, Category = "Formation", meta = (DisplayName = "是否正在异步求解"))
+    bool IsAssignmentPending() const { return PendingAssignment.IsValid(); }
+
     /** 获取变换状态 */
     UFUNCTION(BlueprintPure, Category = "Formation", meta = (DisplayName = "获取变换状态"))
     FFormationTransitionState GetTransitionState() const { return TransitionState; }
@@ -124,49 +167,69 @@ public:
 protected:
     /** 核心算法委托 - 简化架构，提高可维护性 */
 
-    /** 计算分配方案的核心接口 */
+    /**
+     * 计算分配方案的核心接口
+     * @param OrderHints 由阵型模板得到的空间排序，空间排序类模式核对与位置一致后使用，可为空
+     */
     TArray<int32> CalculateAssignmentByMode(
         const TArray<FVector>& FromPositions,
         const TArray<FVector>& ToPositions,
-        EFormationTransitionMode Mode);
+        EFormationTransitionMode Mode,
+        const FSpatialOrderHints* OrderHints = nullptr);
 
     /** 算法工具函数 */
 
-    /** 创建成本矩阵 */
-    TArray<TArray<float>> CreateCostMatrix(
+    /** 创建成本矩阵，直接在缓存中构建并返回缓存的引用 */
+    const FFormationCostMatrix& CreateCostMatrix(
         const TArray<FVector>& FromPositions,
         const TArray<FVector>& ToPositions,
         bool bUseRelativePosition = true);
 
     /** 成本矩阵计算函数 */
-    TArray<TArray<float>> CalculateRelativePositionCostMatrix(
+    FFormationCostMatrix CalculateRelativePositionCostMatrix(
         const TArray<FVector>& FromPositions,
         const TArray<FVector>& ToPositions);
 
-    TArray<TArray<float>> CalculateAbsoluteDistanceCostMatrix(
+    FFormationCostMatrix CalculateAbsoluteDistanceCostMatrix(
         const TArray<FVector>& FromPositions,
         const TArray<FVector>& ToPositions);
 
     /** 应用算法特定的成本修正 */
     void ApplyCostModifications(
-        TArray<TArray<float>>& CostMatrix,
+        FFormationCostMatrix& CostMatrix,
         const TArray<FVector>& FromPositions,
         const TArray<FVector>& ToPositions,
         EFormationTransitionMode Mode);
 
-    /** 匈牙利算法求解分配问题 */
-    TArray<int32> SolveAssignmentHungarian(const TArray<TArray<float>>& CostMatrix);
-
     /** 贪心算法求解分配问题 */
     TArray<int32> SolveAssignmentGreedy(const TArray<TArray<float>>& CostMatrix);
+    TArray<int32> SolveAssignmentGreedy(const FFormationCostMatrix& CostMatrix);
 
     /** 通用分配问题求解器 */
+    TArray<int32> SolveAssignmentProblem(const FFormationCostMatrix& CostMatrix);
+
+    /** 通用分配问题求解器（嵌套数组版本，转换为连续矩阵后求解） */
     TArray<int32> SolveAssignmentProblem(const TArray<TArray<float>>& CostMatrix);
 
+    /** 大规模阵型的稀疏求解：K 近邻成本矩阵 + 稀疏最短增广路 */
+    TArray<int32> SolveSparseAssignment(
+        const TArray<FVector>& FromPositions,
+        const TArray<FVector>& ToPositions,
+        bool bUseRelativePosition);
+
+    /**
+     * 临时分配：K 近邻稀疏矩阵上的贪心匹配，不使用任何成员状态，可在任意线程调用
+     * 用于后台求解期间让单位立即开始移动
+     */
+    static TArray<int32> CalculateProvisionalAssignment(
+        const TArray<FVector>& FromPositions,
+        const TArray<FVector>& ToPositions);
+
     /** 特殊分配算法 */
     TArray<int32> CalculateDirectRelativePositionMatching(
         const TArray<FVector>& FromPositions,
-        const TArray<FVector>& ToPositions);
+        const TArray<FVector>& ToPositions,
+        const FSpatialOrderHints* OrderHints = nullptr);
 
     TArray<int32> CalculateRTSFlockMovementAssignment(
         const TArray<FVector>& FromPositions,
@@ -174,19 +237,42 @@ protected:
 
     TArray<int32> CalculatePathAwareAssignment(
         const TArray<FVector>& FromPositions,
-        const TArray<FVector>& ToPositions);
+        const TArray<FVector>& ToPositions,
+        const FSpatialOrderHints* OrderHints = nullptr);
 
     TArray<int32> CalculateSpatialOrderMapping(
         const TArray<FVector>& FromPositions,
-        const TArray<FVector>& ToPositions);
+        const TArray<FVector>& ToPositions,
+        const FSpatialOrderHints* OrderHints = nullptr);
 
     TArray<int32> CalculateDistancePriorityAssignment(
         const TArray<FVector>& FromPositions,
         const TArray<FVector>& ToPositions);
 
-    /** 检测路径冲突 */
+    /** 检测路径冲突：所有单位同时移动时最近距离小于阈值的单位对，返回全部冲突对 */
     FPathConflictInfo DetectPathConflicts(const TArray<int32>& Assignment, const TArray<FVector>& FromPositions, const TArray<FVector>& ToPositions);
 
+    /**
+     * 交换冲突单位的目标以消除冲突
+     * 每次交换后只复查被交换的两个单位，交换使这两个单位的冲突数减少且总路程增加不超过上限时才保留
+     * @return 保留的交换次数
+     */
+    int32 UntanglePathConflicts(TArray<int32>& Assignment, const TArray<FVector>& FromPositions, const TArray<FVector>& ToPositions);
+
+    /**
+     * 由阵型模板的预排序生成世界空间的空间排序数据，不需要逐点三角函数与排序
+     * 阵型没有模板、Positions 已被修改或阵型带俯仰/翻滚时返回 false
+     */
+    static bool BuildSpatialOrderHint(const FFormationData& Formation, const TArray<FVector>& WorldPositions, FSpatialOrderHint& OutHint);
+
+    /** 为即将求解的变换准备 SpatialOrderHints，只有使用空间排序的模式才会生成 */
+    void PrepareSpatialOrderHints(
+        const FFormationData& FromFormation,
+        const TArray<FVector>& FromWorldPositions,
+        const FFormationData& ToFormation,
+        const TArray<FVector>& ToWorldPositions,
+        EFormationTransitionMode Mode);
+
     /** 辅助函数 */
     bool DetectSpiralFormation(const TArray<FSpatialSortData>& SortedData);
 
@@ -199,7 +285,10 @@ protected:
         const TArray<FVector>& ToPositions);
 
     /** 更新单位位置 */
-    void UpdateUnitPositions(float DeltaTime);
+    virtual void UpdateUnitPositions(float DeltaTime);
+
+    /** 根据开始时间与配置计算当前进度（已应用缓动），所有单位共享 */
+    float CalculateTransitionProgress() const;
 
     /** 绘制调试信息 */
     void DrawDebugInfo() const;
@@ -210,6 +299,42 @@ protected:
     /** 通知实现了IFormationInterface接口的单位（基于当前变换状态 TransitionState.UnitTransitions） */
     void NotifyFormationInterfaceActors();
 
+    /** 后台分配求解请求，取消标记与完成标记跨线程访问 */
+    struct FAsyncAssignmentRequest
+    {
+        TArray<FVector> FromPositions;
+        TArray<FVector> ToPositions;
+        EFormationTransitionMode Mode = EFormationTransitionMode::OptimizedAssignment;
+        FSpatialOrderHints SpatialOrderHints;
+        TArray<int32> Result;
+        std::atomic<bool> bCancelled{ false };
+        std::atomic<bool> bCompleted{ false };
+    };
+
+    /** 最近一次变换命令的空间排序数据，只在游戏线程读写 */
+    FSpatialOrderHints SpatialOrderHints;
+
+    /** 后台求解期间指向该请求的取消标记，求解器每轮迭代检查；同步求解时为空 */
+    const std::atomic<bool>* SolveCancelFlag = nullptr;
+
+    /** 当前求解是否已被新命令取消 */
+    bool IsSolveCancelled() const { return SolveCancelFlag && SolveCancelFlag->load(std::memory_order_relaxed); }
+
+    /** 当前变换等待中的后台求解 */
+    TSharedPtr<FAsyncAssignmentRequest, ESPMode::ThreadSafe> PendingAssignment;
+
+    /** 单位数量达到 AsyncAssignmentThreshold 且模式需要求解时，先用临时分配开始移动，最优分配在后台求解 */
+    bool ShouldSolveAssignmentAsync(int32 NumUnits, EFormationTransitionMode Mode) const;
+
+    /** 启动后台求解 */
+    void LaunchAsyncAssignment(const TArray<FVector>& FromPositions, const TArray<FVector>& ToPositions, EFormationTransitionMode Mode);
+
+    /** 取消等待中的求解：尚未开始的任务直接跳过，已在运行的任务结果被丢弃 */
+    void CancelPendingAssignment();
+
+    /** 把已完成的后台求解结果应用到进行中的变换，单位从当前位置平滑转向新目标 */
+    virtual void ApplyAsyncAssignment();
+
 private:
     /** 性能优化：智能缓存系统 */
 
@@ -218,16 +343,43 @@ private:
     {
         uint32 PositionsHash = 0;
         EFormationTransitionMode Mode = EFormationTransitionMode::OptimizedAssignment;
-        TArray<TArray<float>> CostMatrix;
+        FFormationCostMatrix CostMatrix;
         double CacheTime = 0.0;
 
         bool IsValid(uint32 NewHash, EFormationTransitionMode NewMode, double CurrentTime) const;
-        void UpdateCache(uint32 NewHash, EFormationTransitionMode NewMode, const TArray<TArray<float>>& NewMatrix, double CurrentTime);
+
+        /** 更新缓存键；矩阵本身由调用者直接构建到 CostMatrix 中 */
+        void UpdateCache(uint32 NewHash, EFormationTransitionMode NewMode, double CurrentTime);
     };
 
     /** 成本矩阵缓存 */
     mutable FCostMatrixCache CostMatrixCache;
 
-    /** 计算位置数组的哈希值 */
-    uint32 CalculatePositionsHash(const TArray<FVector>& FromPositions, const TArray<FVector>& ToPositions) const;
+    /** 上一次分配求解的价格与结果，阵型增量变化时用于热启动 */
+    FFormationAssignmentWarmStart AssignmentWarmStart;
+
+    /** 稀疏求解复用的成本矩阵存储 */
+    FFormationSparseCostMatrix SparseCostMatrix;
+
+    /** 当前变换的批量执行器，与 TransitionState.UnitTransitions 同步建立 */
+    FFormationTransitionRunner TransitionRunner;
+
+    /**
+     * 最近一次启动的求解任务
+     * 求解会读写成本矩阵缓存、稀疏矩阵与热启动状态，新任务以上一个任务为前置依次执行，
+     * 游戏线程同步求解前也会先等待该任务结束
+     */
+    UE::Tasks::FTask AssignmentTask;
+
+    /** UnitTransitions 中每一项对应的输入单位索引（跳过了空单位） */
+    TArray<int32> UnitTransitionSourceIndices;
+
+    /** 当前变换是否已通过接口通知单位，最优分配返回后需要重新通知目标位置 */
+    bool bInterfaceNotified = false;
+
+    /** 在游戏线程上等待正在运行的求解任务结束 */
+    void WaitForAssignmentTask();
+
+    /** 计算位置数组的哈希值，不访问成员状态，可在任意线程调用 */
+    static uint32 CalculatePositionsHash(const TArray<FVector>& FromPositions, const TArray<FVector>& ToPositions);
 };
\ No newline at end of file
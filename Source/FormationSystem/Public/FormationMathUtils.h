@@ -3,6 +3,60 @@
 #include "CoreMinimal.h"
 #include "FormationTypes.h"
 
+/**
+ * 单个单位的 Boids 群集力
+ * 三个分量与 FFormationMathUtils 中对应的单体计算函数含义一致
+ */
+struct FORMATIONSYSTEM_API FFormationBoidsForces
+{
+    FVector Separation = FVector::ZeroVector;
+    FVector Alignment = FVector::ZeroVector;
+    FVector Cohesion = FVector::ZeroVector;
+
+    FVector GetTotal() const { return Separation + Alignment + Cohesion; }
+};
+
+/**
+ * Boids 邻域查询网格
+ * 每帧对所有单位位置构建一次（XY 均匀网格 + 计数排序），位置与速度按格子顺序存为 SoA 浮点数组，
+ * 邻域查询只访问半径覆盖的格子，且同一格子内的邻居在内存中连续。
+ * 可作为成员保存以便跨帧复用内存。
+ */
+struct FORMATIONSYSTEM_API FBoidsNeighborGrid
+{
+    /**
+     * 构建网格
+     * @param Positions 所有单位的位置
+     * @param Velocities 所有单位的速度，为空时视为全零
+     * @param QueryRadius 之后查询使用的最大半径，决定格子边长
+     */
+    void Build(const TArray<FVector>& Positions, const TArray<FVector>& Velocities, float QueryRadius);
+
+    int32 Num() const { return UnitIndices.Num(); }
+
+    /** 网格原点（所有单位的包围盒最小点），SoA 中的位置都是相对该点的单精度坐标 */
+    FVector Origin = FVector::ZeroVector;
+    float CellSize = 1.0f;
+    int32 SizeX = 1;
+    int32 SizeY = 1;
+
+    /** 格子 c 中的单位位于 [CellStarts[c], CellStarts[c+1]) */
+    TArray<int32> CellStarts;
+
+    /** 排序后槽位 -> 原单位索引 */
+    TArray<int32> UnitIndices;
+
+    /** 原单位索引 -> 排序后槽位 */
+    TArray<int32> UnitSlots;
+
+    TArray<float> PositionX;
+    TArray<float> PositionY;
+    TArray<float> PositionZ;
+    TArray<float> VelocityX;
+    TArray<float> VelocityY;
+    TArray<float> VelocityZ;
+};
+
 /**
  * 阵型系统数学工具
  * 提供阵型计算和路径检测相关的数学函数
@@ -24,6 +78,18 @@ public:
         const FVector& Start2, const FVector& End2,
         float Threshold = 50.0f);
 
+    /**
+     * 计算两个单位同时沿直线移动时的最近距离（忽略Z轴）
+     * 两个单位以相同进度 t∈[0,1] 从起点移动到终点，P(t) = Start + (End - Start) * t。
+     * 与 DoPathsIntersect 不同，两条路径在空间上交叉但先后经过交点时不算接近。
+     * @param OutTime 输出最近距离出现时的进度
+     * @return 移动过程中的最小距离
+     */
+    static float CalculateClosestApproach(
+        const FVector& Start1, const FVector& End1,
+        const FVector& Start2, const FVector& End2,
+        float& OutTime);
+
     /**
      * 计算分离力（Boids算法）
      * @param UnitIndex 单位索引
@@ -62,6 +128,24 @@ public:
         const TArray<FVector>& Positions,
         const FBoidsMovementParams& Params);
 
+    /**
+     * 批量计算所有单位的分离、对齐、聚合力
+     * 先构建一次邻域网格，每个单位只遍历半径内格子中的邻居，三种力在同一次遍历中累加，
+     * 按单位并行计算。每个单位的累加顺序只取决于网格顺序，结果与线程调度无关。
+     * @param Positions 所有单位的位置数组
+     * @param Velocities 所有单位的速度数组，数量必须与位置一致
+     * @param Params Boids参数
+     * @param OutForces 输出每个单位的群集力，与 Positions 一一对应
+     * @param ReusableGrid 可选的网格存储，跨帧传入同一对象可复用内存
+     * @return 输入是否有效
+     */
+    static bool CalculateBoidsForces(
+        const TArray<FVector>& Positions,
+        const TArray<FVector>& Velocities,
+        const FBoidsMovementParams& Params,
+        TArray<FFormationBoidsForces>& OutForces,
+        FBoidsNeighborGrid* ReusableGrid = nullptr);
+
     /**
      * 计算寻找力（Boids算法）
      * @param CurrentPos 当前位置
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 阵型路径冲突检测器
+ * 所有单位以相同进度同时沿直线从起点移动到终点，两条路径的冲突定义为移动过程中的最近距离小于阈值。
+ *
+ * 粗检测把进度 [0,1] 分成若干时间片，每个时间片内单位只占据路径上的一小段，
+ * 对各时间片的包围盒沿分布较广的轴做扫描排除（sweep-and-prune），只对包围盒重叠的单位对做精确的最近距离检测。
+ * 阵型整体平移时路径虽然大量重叠，但同一时刻的位置互不接近，粗检测即可排除绝大多数单位对。
+ *
+ * 交换目标后调用 SetUnitTarget 更新对应单位，再用 FindConflictsForUnit 只复查受影响的单位。
+ * 各时间片排序后的包围盒会保留下来，单个单位的复查在其中二分查找；
+ * 修改过终点的单位在缓存中已过期，复查时直接做精确检测，过期单位较多时整体重建。
+ */
+class FORMATIONSYSTEM_API FFormationPathConflictDetector
+{
+public:
+    explicit FFormationPathConflictDetector(float InThreshold = 50.0f);
+
+    /**
+     * 根据分配结果建立路径
+     * 分配索引无效的单位没有路径，不参与检测
+     */
+    void Build(const TArray<FVector>& FromPositions, const TArray<FVector>& ToPositions, const TArray<int32>& Assignment);
+
+    /** 查找全部冲突单位对，结果满足 X < Y 且按 (X, Y) 升序排列 */
+    void FindAllConflicts(TArray<FIntPoint>& OutPairs) const;
+
+    /** 查找与指定单位冲突的其他单位，结果按索引升序排列 */
+    void FindConflictsForUnit(int32 Unit, TArray<int32>& OutUnits) const;
+
+    /** 精确检测两个单位是否冲突 */
+    bool HasConflict(int32 UnitA, int32 UnitB) const;
+
+    /** 修改单位的终点（例如交换目标后），不需要重新 Build */
+    void SetUnitTarget(int32 Unit, const FVector& NewTarget);
+
+    int32 Num() const { return Starts.Num(); }
+    float GetThreshold() const { return Threshold; }
+    const FVector& GetStart(int32 Unit) const { return Starts[Unit]; }
+    const FVector& GetEnd(int32 Unit) const { return Ends[Unit]; }
+    bool HasPath(int32 Unit) const { return bHasPath[Unit]; }
+
+private:
+    /** 单个时间片内单位所占区域的包围盒，A 为扫描轴，B 为另一轴 */
+    struct FSliceBox
+    {
+        double MinA;
+        double MaxA;
+        double MinB;
+        double MaxB;
+        int32 Unit;
+    };
+
+    /** 单个时间片的包围盒，按扫描轴上的起点排序 */
+    struct FSliceIntervals
+    {
+        TArray<FSliceBox> Boxes;
+
+        /** 包围盒在扫描轴上的最大长度，用于二分查找可能重叠的第一个包围盒 */
+        double MaxLengthA = 0.0;
+
+        /** 沿 Y 轴扫描时 A 为 Y */
+        bool bSweepAlongY = false;
+    };
+
+    /** 根据平均路径长度选择时间片数量，使每片内的移动距离与阈值相当 */
+    int32 CalculateNumTimeSlices() const;
+
+    /** 单位在进度 [T0, T1] 内经过的线段的包围盒，各向外扩展半个阈值 */
+    FSliceBox MakeSliceBox(int32 Unit, double T0, double T1, bool bSweepAlongY) const;
+
+    /** 按当前路径重建各时间片的排序包围盒，并清空过期单位 */
+    void RebuildSliceIntervals() const;
+
+    float Threshold = 50.0f;
+    TArray<FVector> Starts;
+    TArray<FVector> Ends;
+    TArray<bool> bHasPath;
+
+    mutable TArray<FSliceIntervals> SliceIntervals;
+    mutable bool bSliceIntervalsValid = false;
+
+    /** 重建后修改过终点的单位，它们在 SliceIntervals 中的包围盒已过期 */
+    mutable TArray<int32> StaleUnits;
+    mutable TBitArray<> bIsStale;
+};
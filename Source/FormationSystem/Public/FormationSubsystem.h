@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "FormationTypes.h"
+#include "FormationSubsystem.generated.h"
+
+class AActor;
+class UFormationManagerComponent;
+
+/**
+ * 阵型变换句柄
+ * 由 UFormationSubsystem 分配，蓝图中可用阵型变换节点输出的管理器通过 GetTransitionHandle 取得；
+ * 变换结束后槽位被复用，旧句柄随即失效
+ */
+USTRUCT(BlueprintType)
+struct FORMATIONSYSTEM_API FFormationTransitionHandle
+{
+    GENERATED_BODY()
+
+    int32 Index = INDEX_NONE;
+    int32 Serial = 0;
+
+    bool IsSet() const { return Index != INDEX_NONE; }
+};
+
+/**
+ * 阵型调度子系统
+ * 每个世界一个，统一驱动所有进行中的阵型变换，取代"每次变换生成一个临时 Actor + 管理器组件"的做法。
+ *
+ * - 管理器组件来自对象池，挂在一个常驻的隐藏宿主 Actor 上但不注册组件 Tick，由子系统在一次 Tick 中批量推进
+ * - 变换结束（完成或被停止）后管理器清空回调并回收到池中，反复下达移动命令不再生成任何 Actor
+ * - 新命令包含正在其他变换中移动的单位时，旧变换会先被停止，避免两个管理器同时驱动同一单位
+ */
+UCLASS()
+class FORMATIONSYSTEM_API UFormationSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    static UFormationSubsystem* Get(const UObject* WorldContext);
+
+    /**
+     * 开始阵型变换
+     * @param BoidsParams 群集移动参数，为空时使用默认参数
+     * @param OutManager 本次变换使用的池化管理器；变换结束后会被回收复用，不应长期持有
+     * @return 变换句柄，失败时 IsSet() 为 false
+     */
+    FFormationTransitionHandle StartTransition(
+        const TArray<AActor*>& Units,
+        const FFormationData& FromFormation,
+        const FFormationData& ToFormation,
+        const FFormationTransitionConfig& Config,
+        const FBoidsMovementParams* BoidsParams = nullptr,
+        UFormationManagerComponent** OutManager = nullptr);
+
+    /** 停止变换，句柄失效时返回 false */
+    UFUNCTION(BlueprintCallable, Category = "XTools|Formation", meta = (DisplayName = "停止阵型变换（句柄）"))
+    bool StopTransition(FFormationTransitionHandle Handle, bool bSnapToTarget = false);
+
+    /** 句柄对应的变换是否仍在进行 */
+    UFUNCTION(BlueprintPure, Category = "XTools|Formation", meta = (DisplayName = "阵型变换是否进行中"))
+    bool IsTransitionActive(FFormationTransitionHandle Handle) const;
+
+    /** 获取变换进度，句柄失效时返回 1 */
+    UFUNCTION(BlueprintPure, Category = "XTools|Formation", meta = (DisplayName = "获取阵型变换进度（句柄）"))
+    float GetTransitionProgress(FFormationTransitionHandle Handle) const;
+
+    /** 获取句柄对应的管理器，句柄失效时返回空 */
+    UFormationManagerComponent* GetManager(FFormationTransitionHandle Handle) const;
+
+    /** 获取管理器当前进行中变换的句柄，管理器未在变换中时返回未设置的句柄 */
+    UFUNCTION(BlueprintPure, Category = "XTools|Formation", meta = (DisplayName = "获取阵型变换句柄"))
+    FFormationTransitionHandle GetTransitionHandle(UFormationManagerComponent* Manager) const;
+
+    /** 进行中的变换数量 */
+    int32 GetNumActiveTransitions() const { return NumActive; }
+
+    /** 池中空闲的管理器数量 */
+    int32 GetNumPooledManagers() const { return FreeManagers.Num(); }
+
+private:
+    struct FTransitionSlot
+    {
+        UFormationManagerComponent* Manager = nullptr;
+        int32 Serial = 0;
+        TArray<TObjectKey<AActor>> Units;
+    };
+
+    /** 从池中取出管理器并恢复默认配置，池为空时在宿主 Actor 上新建 */
+    UFormationManagerComponent* AcquireManager();
+
+    /** 结束槽位上的变换并回收管理器，回收时恢复默认配置 */
+    void ReleaseSlot(int32 SlotIndex);
+
+    /** 停止所有包含这些单位的进行中变换 */
+    void StopTransitionsUsingUnits(const TArray<AActor*>& Units);
+
+    const FTransitionSlot* FindSlot(FFormationTransitionHandle Handle) const;
+
+    /** 承载池化管理器的隐藏 Actor，首次需要时生成一次 */
+    UPROPERTY(Transient)
+    TObjectPtr<AActor> HostActor;
+
+    /** 所有已创建的管理器，保证不被垃圾回收 */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UFormationManagerComponent>> AllManagers;
+
+    TArray<UFormationManagerComponent*> FreeManagers;
+    TArray<FTransitionSlot> Slots;
+    TArray<int32> FreeSlots;
+    TMap<TObjectKey<AActor>, int32> SlotByUnit;
+    int32 NumActive = 0;
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FormationTypes.h"
+#include "Misc/ScopeRWLock.h"
+#include "Templates/Function.h"
+
+/** 阵型槽位的预排序方式 */
+enum class EFormationSlotOrder : uint8
+{
+    /** 绕包围盒中心按角度（相差 0.01 弧度以内视为相同），再按半径，与空间排序映射的规则一致 */
+    Polar,
+    /** 按 Y 行，再按 X 列 */
+    RowMajor,
+    /** 沿 Hilbert 曲线，空间上相邻的槽位在顺序中也相邻 */
+    Hilbert
+};
+
+/**
+ * 阵型模板缓存键
+ * 不包含间距/半径：模板以单位尺度保存，生成阵型时按间距或半径缩放，
+ * 同一形状的不同尺寸共用一份模板。
+ */
+struct FORMATIONSYSTEM_API FFormationTemplateKey
+{
+    EFormationType FormationType = EFormationType::Square;
+    int32 UnitCount = 0;
+
+    /** 形状的整数参数，如方形的行数、三角形是否倒置 */
+    int32 IntParam = 0;
+
+    /** 形状的浮点参数，如螺旋圈数 */
+    float FloatParam = 0.0f;
+
+    bool operator==(const FFormationTemplateKey& Other) const
+    {
+        return FormationType == Other.FormationType
+            && UnitCount == Other.UnitCount
+            && IntParam == Other.IntParam
+            && FloatParam == Other.FloatParam;
+    }
+
+    friend uint32 GetTypeHash(const FFormationTemplateKey& Key)
+    {
+        uint32 Hash = HashCombineFast(::GetTypeHash(static_cast<uint8>(Key.FormationType)), ::GetTypeHash(Key.UnitCount));
+        Hash = HashCombineFast(Hash, ::GetTypeHash(Key.IntParam));
+        return HashCombineFast(Hash, ::GetTypeHash(Key.FloatParam));
+    }
+};
+
+/**
+ * 阵型模板
+ * 单位尺度下的槽位偏移（方形类间距为 1，圆形类半径为 1）及其预计算的空间排序，创建后只读。
+ */
+struct FORMATIONSYSTEM_API FFormationTemplate
+{
+    /** 单位尺度下相对阵型中心的槽位偏移 */
+    TArray<FVector> Offsets;
+
+    /** 单位尺度下的阵型尺寸 */
+    FVector2D Size = FVector2D::ZeroVector;
+
+    TArray<int32> PolarOrder;
+    TArray<int32> RowMajorOrder;
+    TArray<int32> HilbertOrder;
+
+    /** 单位尺度下槽位包围盒的中心，极坐标顺序以此为中心 */
+    FVector PolarCenter = FVector::ZeroVector;
+
+    /** 每个槽位相对 PolarCenter 的极角（弧度）与距离，按槽位索引存放 */
+    TArray<float> PolarAngles;
+    TArray<float> PolarDistances;
+
+    /** 获取指定方式的槽位顺序，Order[i] 为排在第 i 位的槽位索引 */
+    const TArray<int32>& GetSlotOrder(EFormationSlotOrder Order) const;
+
+    /**
+     * 获取绕 Z 轴旋转后的极坐标顺序
+     * 旋转只让极角整体平移，越过 ±π 的槽位移到开头，结果是 PolarOrder 的一次循环移位，不需要重新排序
+     */
+    void GetRotatedPolarOrder(float YawDegrees, TArray<int32>& OutOrder) const;
+
+    /** 按比例拷贝槽位偏移，可附加绕 Z 轴的旋转（度） */
+    void CopyScaled(float Scale, TArray<FVector>& OutPositions, float YawDegrees = 0.0f) const;
+};
+
+typedef TSharedRef<const FFormationTemplate, ESPMode::ThreadSafe> FFormationTemplateRef;
+
+/**
+ * 阵型模板缓存
+ * 进程内共享，读多写少，可从任意线程访问。
+ * 反复以相同单位数下达阵型命令时，三角函数、行列拆分与空间排序只计算一次，之后每次生成只是一次缩放拷贝。
+ */
+class FORMATIONSYSTEM_API FFormationTemplateCache
+{
+public:
+    static FFormationTemplateCache& Get();
+
+    /**
+     * 查找模板，不存在时用 BuildOffsets 生成单位尺度的偏移与尺寸并计算排序
+     * BuildOffsets 在锁外执行，并发首次请求同一键时可能重复构建，结果以先写入者为准
+     */
+    FFormationTemplateRef FindOrBuild(
+        const FFormationTemplateKey& Key,
+        TFunctionRef<void(TArray<FVector>& OutOffsets, FVector2D& OutSize)> BuildOffsets);
+
+    /** 仅查找已缓存的模板 */
+    TSharedPtr<const FFormationTemplate, ESPMode::ThreadSafe> Find(const FFormationTemplateKey& Key) const;
+
+    /** 清空缓存，已取出的模板引用仍然有效 */
+    void Empty();
+
+    int32 Num() const;
+
+    /** 计算任意位置集合的槽位顺序，Polar 以位置包围盒的中心为中心 */
+    static void CalculateSlotOrder(TConstArrayView<FVector> Positions, EFormationSlotOrder Order, TArray<int32>& OutOrder);
+
+private:
+    mutable FRWLock Lock;
+    TMap<FFormationTemplateKey, FFormationTemplateRef> Templates;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FormationTypes.h"
+
+class USceneComponent;
+
+/**
+ * 阵型变换批量执行器
+ * 以结构数组（SoA）保存全部单位的起止变换，每帧先并行插值，再在游戏线程上一次性写回根组件。
+ *
+ * 所有单位共享同一个进度，缓动只需每帧计算一次。
+ * 普通模式每个单位只调用一次 SetWorldTransform，而不是位置、旋转、缩放分别更新三次组件变换；
+ * 瞬移模式直接写入位置和旋转，跳过扫掠、重叠检测与物理同步，缩放只在发生变化的单位上更新。
+ * 渲染变换由引擎在帧末统一提交，这里不单独标记渲染状态。
+ */
+struct FORMATIONSYSTEM_API FFormationTransitionRunner
+{
+    /** 根据单位变换数据建立批量数据，没有根组件的单位会被跳过 */
+    void Init(const TArray<FUnitTransitionData>& UnitTransitions);
+
+    /**
+     * 根据起止变换建立批量数据，不绑定组件（例如实例化网格的实例变换）
+     * 两个数组长度必须一致
+     */
+    void InitTransforms(const TArray<FTransform>& StartTransforms, const TArray<FTransform>& TargetTransforms);
+
+    /** 清空所有数据 */
+    void Reset();
+
+    /** 按统一进度计算所有单位的当前变换 */
+    void Evaluate(float Progress);
+
+    /**
+     * 把 Evaluate 的结果写回单位根组件
+     * @param bTeleport 是否跳过扫掠、重叠检测与物理同步
+     */
+    void Apply(bool bTeleport) const;
+
+    /**
+     * 修改单位的目标，单位从最近一次 Evaluate 的位置出发，在剩余进度内到达新目标，位置保持连续
+     * @param Index 批量数据中的索引（对应 GetUnitIndex）
+     */
+    void Retarget(int32 Index, const FVector& NewTargetLocation, const FRotator& NewTargetRotation);
+
+    /** 按统一进度直接输出所有单位的变换，供实例化网格批量提交 */
+    void EvaluateTransforms(float Progress, TArray<FTransform>& OutTransforms) const;
+
+    int32 Num() const { return StartLocations.Num(); }
+
+    /** 单位在 UnitTransitions 中的索引（仅 Init 建立的数据有效） */
+    int32 GetUnitIndex(int32 Index) const { return UnitIndices[Index]; }
+
+    const FVector& GetCurrentLocation(int32 Index) const { return CurrentLocations[Index]; }
+    const FRotator& GetCurrentRotation(int32 Index) const { return CurrentRotations[Index]; }
+    const FVector& GetCurrentScale(int32 Index) const { return CurrentScales[Index]; }
+
+private:
+    TArray<TWeakObjectPtr<USceneComponent>> Components;
+    TArray<int32> UnitIndices;
+
+    TArray<FVector> StartLocations;
+    TArray<FVector> LocationDeltas;
+    TArray<FRotator> StartRotations;
+    /** 已规范化到最短路径的旋转差值，与 FMath::Lerp(FRotator) 的插值结果一致 */
+    TArray<FRotator> RotationDeltas;
+    TArray<FVector> StartScales;
+    TArray<FVector> ScaleDeltas;
+    TArray<bool> bScaleChanges;
+
+    TArray<FVector> CurrentLocations;
+    TArray<FRotator> CurrentRotations;
+    TArray<FVector> CurrentScales;
+
+    /** 最近一次 Evaluate 使用的进度 */
+    float EvaluatedProgress = 0.0f;
+};
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "FormationTypes.generated.h"
 
+struct FFormationTemplate;
+
 /**
  * 阵型系统类型定义
  * 包含阵型相关的枚举和数据结构
@@ -39,6 +41,22 @@ enum class EFormationTransitionMode : uint8
     DistancePriorityAssignment UMETA(DisplayName = "距离优先分配（已弃用）", Hidden)
 };
 
+/**
+ * 分配问题求解器枚举
+ */
+UENUM(BlueprintType)
+enum class EFormationAssignmentSolver : uint8
+{
+    /** Jonker-Volgenant 最短增广路算法，结果精确最优（推荐） */
+    ShortestAugmentingPath  UMETA(DisplayName = "最短增广路（精确）"),
+
+    /** ε-缩放拍卖算法，出价可并行计算，结果接近最优；未收敛时自动回退到最短增广路 */
+    Auction                 UMETA(DisplayName = "拍卖算法（并行近似）"),
+
+    /** 贪心分配，速度最快但路径交叉较多 */
+    Greedy                  UMETA(DisplayName = "贪心分配")
+};
+
 /**
  * 阵型类型枚举
  */
@@ -113,6 +131,13 @@ struct FORMATIONSYSTEM_API FFormationData
                      UIMin = "50.0", UIMax = "300.0"))
     float Spacing = 100.0f;
 
+    /** 生成 Positions 的阵型模板，手动构造的阵型为空；不参与序列化，使用前需与 Positions 核对 */
+    TSharedPtr<const FFormationTemplate, ESPMode::ThreadSafe> Template;
+
+    /** 模板拷贝到 Positions 时的缩放与绕 Z 轴旋转（度） */
+    float TemplateScale = 1.0f;
+    float TemplateYaw = 0.0f;
+
     FFormationData()
     {
         FormationType = EFormationType::Square;
@@ -159,6 +184,11 @@ struct FORMATIONSYSTEM_API FFormationTransitionConfig
                      EditCondition = "bUseEasing"))
     float EasingStrength = 2.0f;
 
+    /** 瞬移更新单位位置 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Transition",
+              meta = (DisplayName = "瞬移更新", ToolTip = "直接写入根组件变换，跳过扫掠、重叠检测与物理同步。适合大规模阵型中不依赖重叠事件的单位"))
+    bool bTeleportUnits = false;
+
     /** 是否显示调试信息 */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug", 
               meta = (DisplayName = "显示调试", ToolTip = "在运行时显示阵型变换的调试可视化信息"))
@@ -176,6 +206,7 @@ struct FORMATIONSYSTEM_API FFormationTransitionConfig
         Duration = 2.0f;
         bUseEasing = true;
         EasingStrength = 2.0f;
+        bTeleportUnits = false;
         bShowDebug = false;
         DebugDuration = 5.0f;
     }
@@ -405,4 +436,22 @@ struct FSpatialSortData
     float Angle;
     float DistanceToCenter;
     FVector Position;
+};
+
+/**
+ * 由阵型模板得到的空间排序数据
+ * 已按极角排序，空间排序映射核对中心与位置一致后直接使用，跳过逐点三角函数与排序
+ */
+struct FSpatialOrderHint
+{
+    /** 极坐标中心（世界坐标） */
+    FVector Center = FVector::ZeroVector;
+    TArray<FSpatialSortData> SortedData;
+};
+
+/** 一次阵型变换起始与目标阵型的空间排序数据 */
+struct FSpatialOrderHints
+{
+    FSpatialOrderHint From;
+    FSpatialOrderHint To;
 }; 
\ No newline at end of file
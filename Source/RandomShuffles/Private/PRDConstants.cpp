@@ -0,0 +1,123 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#include "PRDConstants.h"
+
+namespace RandomShuffles
+{
+    namespace
+    {
+        /** 剩余未触发概率低于该值时停止累加期望 */
+        constexpr double PRDTailEpsilon = 1e-13;
+
+        /** 二分迭代次数，double 精度下足够收敛 */
+        constexpr int32 PRDSolveIterations = 52;
+
+        struct FPRDConstantTable
+        {
+            FPRDConstantTable()
+            {
+                Constants.SetNumUninitialized(PRDConstantTableResolution + 1);
+                Constants[0] = 0.0f;
+                for (int32 i = 1; i < PRDConstantTableResolution; ++i)
+                {
+                    Constants[i] = static_cast<float>(SolvePRDConstant(static_cast<double>(i) / PRDConstantTableResolution));
+                }
+                Constants[PRDConstantTableResolution] = 1.0f;
+            }
+
+            TArray<float> Constants;
+        };
+
+        const FPRDConstantTable& GetPRDConstantTable()
+        {
+            // 函数内静态变量的初始化是线程安全的
+            static const FPRDConstantTable Table;
+            return Table;
+        }
+    }
+
+    double CalculatePRDProbabilityFromConstant(double C)
+    {
+        if (C <= 0.0)
+        {
+            return 0.0;
+        }
+        if (C >= 1.0)
+        {
+            return 1.0;
+        }
+
+        // 第 n 次判定的触发概率为 min(1, n*C)，累加 n * P(第 n 次首次触发) 得到期望间隔
+        double NotTriggeredYet = 1.0;
+        double ExpectedTrials = 0.0;
+        for (int32 N = 1; NotTriggeredYet > PRDTailEpsilon; ++N)
+        {
+            const double TriggerChance = FMath::Min(1.0, N * C);
+            const double FirstTriggerAtN = NotTriggeredYet * TriggerChance;
+            ExpectedTrials += N * FirstTriggerAtN;
+            NotTriggeredYet -= FirstTriggerAtN;
+            if (TriggerChance >= 1.0)
+            {
+                break;
+            }
+        }
+
+        return 1.0 / ExpectedTrials;
+    }
+
+    double SolvePRDConstant(double P)
+    {
+        if (P <= 0.0)
+        {
+            return 0.0;
+        }
+        if (P >= 1.0)
+        {
+            return 1.0;
+        }
+
+        // 长期触发概率随 C 单调递增，且 C <= P
+        double Low = 0.0;
+        double High = P;
+        for (int32 Iteration = 0; Iteration < PRDSolveIterations; ++Iteration)
+        {
+            const double Mid = 0.5 * (Low + High);
+            if (CalculatePRDProbabilityFromConstant(Mid) < P)
+            {
+                Low = Mid;
+            }
+            else
+            {
+                High = Mid;
+            }
+        }
+        return 0.5 * (Low + High);
+    }
+
+    void InitializePRDConstantTable()
+    {
+        GetPRDConstantTable();
+    }
+
+    float GetPRDConstant(float P)
+    {
+        if (P <= 0.f) return 0.f;
+        if (P >= 1.f) return 1.f;
+
+        const TArray<float>& Constants = GetPRDConstantTable().Constants;
+        const float Scaled = P * PRDConstantTableResolution;
+        const int32 Lower = FMath::Min(FMath::FloorToInt32(Scaled), PRDConstantTableResolution - 1);
+        const float Alpha = Scaled - Lower;
+
+        // 首个区间内 C 近似与 P^2 成正比，按二次关系缩放比线性插值更准确
+        if (Lower == 0)
+        {
+            return Constants[1] * Alpha * Alpha;
+        }
+
+        return FMath::Lerp(Constants[Lower], Constants[Lower + 1], Alpha);
+    }
+}
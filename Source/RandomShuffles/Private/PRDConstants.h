@@ -0,0 +1,26 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace RandomShuffles
+{
+    /** PRD 常数表的概率分辨率，表项数为 PRDConstantTableResolution + 1 */
+    constexpr int32 PRDConstantTableResolution = 2048;
+
+    /** 求解 PRD 常数表，模块启动时调用；未调用时在首次查询时构建 */
+    void InitializePRDConstantTable();
+
+    /** 获取概率 P 对应的 PRD 常数 C（查表 + 线性插值） */
+    float GetPRDConstant(float P);
+
+    /** 给定常数 C 时 PRD 的长期触发概率，即 1 / 期望触发间隔 */
+    double CalculatePRDProbabilityFromConstant(double C);
+
+    /** 二分求解满足 CalculatePRDProbabilityFromConstant(C) == P 的常数 C */
+    double SolvePRDConstant(double P);
+}
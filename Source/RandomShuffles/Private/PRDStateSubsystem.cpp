@@ -0,0 +1,361 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#include "PRDStateSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "PRDConstants.h"
+#include "RandomShuffleLog.h"
+#include "XToolsVersionCompat.h"
+
+namespace PRDStateSubsystem_Private
+{
+	/** 为每个线程分配固定的统计分片，轮流分配使分片均匀 */
+	int32 GetThreadStatsShard(int32 NumShards)
+	{
+		static std::atomic<int32> NextShard{ 0 };
+		static thread_local int32 ThreadShard = NextShard.fetch_add(1, std::memory_order_relaxed);
+		return ThreadShard % NumShards;
+	}
+}
+
+// ========== FPRDStateStore ==========
+
+FPRDStateStore::FPRDStateStore()
+{
+	for (std::atomic<FSlotChunk*>& Chunk : Chunks)
+	{
+		Chunk.store(nullptr, std::memory_order_relaxed);
+	}
+}
+
+FPRDStateStore::~FPRDStateStore()
+{
+	for (std::atomic<FSlotChunk*>& Chunk : Chunks)
+	{
+		delete Chunk.exchange(nullptr, std::memory_order_acq_rel);
+	}
+}
+
+bool FPRDStateStore::AllocateSlot(int32& OutIndex, int32& OutGeneration)
+{
+	FScopeLock Lock(&AllocationLock);
+
+	int32 Index = INDEX_NONE;
+	if (FreeSlots.Num() > 0)
+	{
+#if XTOOLS_ENGINE_5_8_OR_LATER
+		Index = FreeSlots.Pop(EAllowShrinking::No);
+#else
+		Index = FreeSlots.Pop(false);
+#endif
+	}
+	else
+	{
+		if (NextSlot >= MaxSlots)
+		{
+			UE_LOG(LogRandomShuffle, Error, TEXT("PRD状态槽位已达到最大数量 (%d)，无法分配新句柄"), MaxSlots);
+			return false;
+		}
+
+		Index = NextSlot++;
+		const int32 ChunkIndex = Index / SlotsPerChunk;
+		if (!Chunks[ChunkIndex].load(std::memory_order_relaxed))
+		{
+			FSlotChunk* NewChunk = new FSlotChunk;
+			for (std::atomic<uint64>& State : NewChunk->States)
+			{
+				// 代数从1开始，0保留给未初始化的句柄
+				State.store(PackState(1, 0), std::memory_order_relaxed);
+			}
+			// 发布分块，判定路径通过 acquire 读取
+			Chunks[ChunkIndex].store(NewChunk, std::memory_order_release);
+		}
+	}
+
+	OutIndex = Index;
+	OutGeneration = static_cast<int32>(UnpackGeneration(FindSlot(Index)->load(std::memory_order_acquire)));
+	LiveSlots.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+void FPRDStateStore::ReleaseSlot(int32 Index, int32 Generation)
+{
+	FScopeLock Lock(&AllocationLock);
+
+	std::atomic<uint64>* Slot = FindSlot(Index);
+	if (!Slot)
+	{
+		return;
+	}
+
+	uint64 Current = Slot->load(std::memory_order_acquire);
+	if (UnpackGeneration(Current) != static_cast<uint32>(Generation))
+	{
+		return;
+	}
+
+	// 递增代数使所有旧句柄失效，跳过0
+	uint32 NextGeneration = UnpackGeneration(Current) + 1;
+	NextGeneration = NextGeneration == 0 ? 1 : NextGeneration;
+	while (!Slot->compare_exchange_weak(Current, PackState(NextGeneration, 0), std::memory_order_acq_rel))
+	{
+		if (UnpackGeneration(Current) != static_cast<uint32>(Generation))
+		{
+			return;
+		}
+	}
+
+	FreeSlots.Add(Index);
+	LiveSlots.fetch_sub(1, std::memory_order_relaxed);
+}
+
+std::atomic<uint64>* FPRDStateStore::FindSlot(int32 Index) const
+{
+	if (Index < 0 || Index >= MaxSlots)
+	{
+		return nullptr;
+	}
+
+	FSlotChunk* Chunk = Chunks[Index / SlotsPerChunk].load(std::memory_order_acquire);
+	return Chunk ? &Chunk->States[Index % SlotsPerChunk] : nullptr;
+}
+
+bool FPRDStateStore::IsSlotValid(int32 Index, int32 Generation) const
+{
+	const std::atomic<uint64>* Slot = FindSlot(Index);
+	return Slot && UnpackGeneration(Slot->load(std::memory_order_relaxed)) == static_cast<uint32>(Generation);
+}
+
+bool FPRDStateStore::Roll(int32 Index, int32 Generation, float BaseChance, float Uniform, int32& OutFailureCount, float& OutActualChance)
+{
+	const float P = FMath::Clamp(BaseChance, 0.0f, RandomShuffles::Config::MaxValidChance);
+	return RollWithConstant(Index, Generation, P, RandomShuffles::GetPRDConstant(P), Uniform, OutFailureCount, OutActualChance);
+}
+
+bool FPRDStateStore::RollWithConstant(int32 Index, int32 Generation, float P, float C, float Uniform, int32& OutFailureCount, float& OutActualChance)
+{
+	OutFailureCount = 0;
+	OutActualChance = 0.0f;
+
+	std::atomic<uint64>* Slot = FindSlot(Index);
+	if (!Slot)
+	{
+		return false;
+	}
+
+	uint64 Current = Slot->load(std::memory_order_relaxed);
+	bool bSuccess = false;
+	uint32 NewFailureCount = 0;
+	do
+	{
+		if (UnpackGeneration(Current) != static_cast<uint32>(Generation))
+		{
+			return false;
+		}
+
+		const int32 FailureCount = static_cast<int32>(UnpackFailureCount(Current));
+		if (P <= 0.0f)
+		{
+			OutActualChance = 0.0f;
+			bSuccess = false;
+			NewFailureCount = 0;
+		}
+		else if (P >= 1.0f)
+		{
+			OutActualChance = 1.0f;
+			bSuccess = true;
+			NewFailureCount = 0;
+		}
+		else
+		{
+			OutActualChance = FMath::Min(static_cast<float>(FailureCount + 1) * C, 1.0f);
+			bSuccess = Uniform < OutActualChance;
+			NewFailureCount = bSuccess ? 0 : static_cast<uint32>(FMath::Min(FailureCount + 1, RandomShuffles::Config::MaxFailureCount));
+		}
+	}
+	// 其他线程在此期间修改了状态时，用同一个随机数按新状态重新判定
+	while (!Slot->compare_exchange_weak(Current, PackState(static_cast<uint32>(Generation), NewFailureCount), std::memory_order_relaxed));
+
+	OutFailureCount = static_cast<int32>(NewFailureCount);
+	RecordCall(OutFailureCount);
+	return bSuccess;
+}
+
+bool FPRDStateStore::ResetSlot(int32 Index, int32 Generation)
+{
+	std::atomic<uint64>* Slot = FindSlot(Index);
+	if (!Slot)
+	{
+		return false;
+	}
+
+	uint64 Expected = Slot->load(std::memory_order_relaxed);
+	do
+	{
+		if (UnpackGeneration(Expected) != static_cast<uint32>(Generation))
+		{
+			return false;
+		}
+	}
+	while (!Slot->compare_exchange_weak(Expected, PackState(static_cast<uint32>(Generation), 0), std::memory_order_relaxed));
+
+	return true;
+}
+
+int32 FPRDStateStore::GetFailureCount(int32 Index, int32 Generation) const
+{
+	const std::atomic<uint64>* Slot = FindSlot(Index);
+	if (!Slot)
+	{
+		return 0;
+	}
+
+	const uint64 State = Slot->load(std::memory_order_relaxed);
+	return UnpackGeneration(State) == static_cast<uint32>(Generation) ? static_cast<int32>(UnpackFailureCount(State)) : 0;
+}
+
+void FPRDStateStore::RecordCall(int32 FailureCount)
+{
+	// 每个分片基本只被一个线程写入，relaxed 原子操作不会产生缓存行争用
+	FStatsShard& Shard = StatsShards[PRDStateSubsystem_Private::GetThreadStatsShard(NumStatsShards)];
+	Shard.Calls.fetch_add(1, std::memory_order_relaxed);
+	Shard.FailureSum.fetch_add(FailureCount, std::memory_order_relaxed);
+
+	int32 CurrentMax = Shard.MaxFailure.load(std::memory_order_relaxed);
+	while (FailureCount > CurrentMax
+		&& !Shard.MaxFailure.compare_exchange_weak(CurrentMax, FailureCount, std::memory_order_relaxed))
+	{
+	}
+}
+
+FPRDPerformanceStats FPRDStateStore::GetStats() const
+{
+	int64 Calls = 0;
+	int64 FailureSum = 0;
+	int32 MaxFailure = 0;
+	for (const FStatsShard& Shard : StatsShards)
+	{
+		Calls += Shard.Calls.load(std::memory_order_relaxed);
+		FailureSum += Shard.FailureSum.load(std::memory_order_relaxed);
+		MaxFailure = FMath::Max(MaxFailure, Shard.MaxFailure.load(std::memory_order_relaxed));
+	}
+
+	FPRDPerformanceStats Stats;
+	Stats.TotalCalls = static_cast<int32>(FMath::Min<int64>(Calls, MAX_int32));
+	Stats.StateMapSize = NumLiveSlots();
+	Stats.MaxFailureCount = MaxFailure;
+	Stats.AverageFailureCount = Calls > 0 ? static_cast<float>(static_cast<double>(FailureSum) / Calls) : 0.0f;
+	return Stats;
+}
+
+void FPRDStateStore::ResetStats()
+{
+	for (FStatsShard& Shard : StatsShards)
+	{
+		Shard.Calls.store(0, std::memory_order_relaxed);
+		Shard.FailureSum.store(0, std::memory_order_relaxed);
+		Shard.MaxFailure.store(0, std::memory_order_relaxed);
+	}
+}
+
+// ========== UPRDStateSubsystem ==========
+
+void UPRDStateSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Store = MakeUnique<FPRDStateStore>();
+}
+
+void UPRDStateSubsystem::Deinitialize()
+{
+	{
+		FScopeLock Lock(&HandleMapLock);
+		HandleByOwner.Empty();
+		OwnerKeyBySlot.Empty();
+	}
+	Store.Reset();
+
+	Super::Deinitialize();
+}
+
+UPRDStateSubsystem* UPRDStateSubsystem::Get(const UObject* WorldContext)
+{
+	if (UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull) : nullptr)
+	{
+		return World->GetSubsystem<UPRDStateSubsystem>();
+	}
+	return nullptr;
+}
+
+FPRDHandle UPRDStateSubsystem::AcquireHandle(const UObject* Owner, FName StatName)
+{
+	FPRDHandle Handle;
+	if (!Store)
+	{
+		return Handle;
+	}
+
+	FScopeLock Lock(&HandleMapLock);
+
+	const FOwnerStatKey Key(Owner, StatName);
+	if (const FPRDHandle* Existing = HandleByOwner.Find(Key))
+	{
+		if (Store->IsSlotValid(Existing->Index, Existing->Generation))
+		{
+			return *Existing;
+		}
+	}
+
+	if (Store->AllocateSlot(Handle.Index, Handle.Generation))
+	{
+		Handle.Store = this;
+		HandleByOwner.Add(Key, Handle);
+		if (Handle.Index >= OwnerKeyBySlot.Num())
+		{
+			OwnerKeyBySlot.SetNum(Handle.Index + 1);
+		}
+		OwnerKeyBySlot[Handle.Index] = Key;
+	}
+	return Handle;
+}
+
+void UPRDStateSubsystem::ReleaseHandle(const FPRDHandle& Handle)
+{
+	if (!Store || Handle.Store.Get() != this)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&HandleMapLock);
+	if (!Store->IsSlotValid(Handle.Index, Handle.Generation))
+	{
+		return;
+	}
+
+	Store->ReleaseSlot(Handle.Index, Handle.Generation);
+
+	const FOwnerStatKey& Key = OwnerKeyBySlot[Handle.Index];
+	const FPRDHandle* Mapped = HandleByOwner.Find(Key);
+	if (Mapped && Mapped->Index == Handle.Index && Mapped->Generation == Handle.Generation)
+	{
+		HandleByOwner.Remove(Key);
+	}
+	OwnerKeyBySlot[Handle.Index] = FOwnerStatKey();
+}
+
+bool UPRDStateSubsystem::Roll(const FPRDHandle& Handle, float BaseChance, FRandomStream* Stream, int32& OutFailureCount, float& OutActualChance)
+{
+	// 只接受本子系统分配的句柄，其他世界的句柄可能恰好落在本存储的有效槽位上
+	if (!Store || Handle.Store.Get() != this)
+	{
+		OutFailureCount = 0;
+		OutActualChance = 0.0f;
+		return false;
+	}
+
+	const float Uniform = Stream ? Stream->FRand() : FMath::FRand();
+	return Store->Roll(Handle.Index, Handle.Generation, BaseChance, Uniform, OutFailureCount, OutActualChance);
+}
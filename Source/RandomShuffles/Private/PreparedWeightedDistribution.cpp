@@ -0,0 +1,255 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#include "PreparedWeightedDistribution.h"
+#include "RandomShuffleLog.h"
+#include "Algo/BinarySearch.h"
+#include "XToolsVersionCompat.h"
+
+namespace PreparedWeightedDistribution_Private
+{
+	float GetUniform(FRandomStream* Stream)
+	{
+		return Stream ? Stream->FRand() : FMath::FRand();
+	}
+
+	/** Efraimidis-Spirakis 随机键，比较 ln(u)/w 等价于比较 u^(1/w)，数值上更稳定 */
+	struct FSampleKey
+	{
+		double Key;
+		int32 Index;
+	};
+
+	/** 键更小者优先级更高，用于维护保留最大K个键的最小堆 */
+	struct FSampleKeyLess
+	{
+		bool operator()(const FSampleKey& A, const FSampleKey& B) const
+		{
+			return A.Key < B.Key || (A.Key == B.Key && A.Index > B.Index);
+		}
+	};
+}
+
+bool FPreparedWeightedDistribution::Build(TArrayView<const float> InWeights)
+{
+	Reset();
+
+	const int32 Count = InWeights.Num();
+	double Total = 0.0;
+	int32 Positive = 0;
+	for (const float Weight : InWeights)
+	{
+		if (!FMath::IsFinite(Weight) || Weight < 0.0f)
+		{
+			UE_LOG(LogRandomShuffle, Warning, TEXT("预处理加权分布失败：权重必须为有限的非负数"));
+			return false;
+		}
+		Total += Weight;
+		Positive += Weight > 0.0f ? 1 : 0;
+	}
+
+	if (Positive == 0 || Total <= 0.0)
+	{
+		UE_LOG(LogRandomShuffle, Warning, TEXT("预处理加权分布失败：至少需要一个正权重"));
+		return false;
+	}
+
+	Weights.Append(InWeights.GetData(), Count);
+	AliasProbabilities.SetNumUninitialized(Count);
+	Aliases.SetNumUninitialized(Count);
+	Cumulative.SetNumUninitialized(Count);
+
+	int32 LastPositive = Count - 1;
+	while (Weights[LastPositive] <= 0.0f)
+	{
+		--LastPositive;
+	}
+
+	// 累积概率表，从最后一个正权重元素起固定为1，避免舍入误差落到尾部的零权重元素上
+	double Running = 0.0;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Running += Weights[i];
+		Cumulative[i] = i >= LastPositive ? 1.0f : static_cast<float>(Running / Total);
+	}
+
+	// Vose 别名表：缩放后小于1的列由大于1的列补齐
+	TArray<double> Scaled;
+	Scaled.SetNumUninitialized(Count);
+	TArray<int32> Small;
+	TArray<int32> Large;
+	Small.Reserve(Count);
+	Large.Reserve(Count);
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Scaled[i] = Weights[i] * Count / Total;
+		if (Scaled[i] < 1.0)
+		{
+			Small.Add(i);
+		}
+		else
+		{
+			Large.Add(i);
+		}
+	}
+
+	while (Small.Num() > 0 && Large.Num() > 0)
+	{
+#if XTOOLS_ENGINE_5_8_OR_LATER
+		const int32 Less = Small.Pop(EAllowShrinking::No);
+		const int32 More = Large.Pop(EAllowShrinking::No);
+#else
+		const int32 Less = Small.Pop(false);
+		const int32 More = Large.Pop(false);
+#endif
+
+		AliasProbabilities[Less] = static_cast<float>(Scaled[Less]);
+		Aliases[Less] = More;
+
+		Scaled[More] = (Scaled[More] + Scaled[Less]) - 1.0;
+		if (Scaled[More] < 1.0)
+		{
+			Small.Add(More);
+		}
+		else
+		{
+			Large.Add(More);
+		}
+	}
+
+	// 剩余列的缩放值理论上都为1，误差导致的残留直接视为满列
+	for (const int32 Index : Large)
+	{
+		AliasProbabilities[Index] = 1.0f;
+		Aliases[Index] = Index;
+	}
+	for (const int32 Index : Small)
+	{
+		// 零权重元素即使因舍入误差残留也不能被选中
+		const bool bZeroWeight = Weights[Index] <= 0.0f;
+		AliasProbabilities[Index] = bZeroWeight ? 0.0f : 1.0f;
+		Aliases[Index] = bZeroWeight ? LastPositive : Index;
+	}
+
+	TotalWeight = Total;
+	PositiveCount = Positive;
+	return true;
+}
+
+void FPreparedWeightedDistribution::Reset()
+{
+	Weights.Reset();
+	AliasProbabilities.Reset();
+	Aliases.Reset();
+	Cumulative.Reset();
+	TotalWeight = 0.0;
+	PositiveCount = 0;
+}
+
+float FPreparedWeightedDistribution::GetProbability(int32 Index) const
+{
+	if (!IsValid() || !Weights.IsValidIndex(Index))
+	{
+		return 0.0f;
+	}
+	return static_cast<float>(Weights[Index] / TotalWeight);
+}
+
+int32 FPreparedWeightedDistribution::FindIndexByCumulative(float CumulativeProbability) const
+{
+	if (!IsValid())
+	{
+		return INDEX_NONE;
+	}
+
+	// 第一个累积概率严格大于查询值的位置，零权重元素的区间长度为0，不会被命中
+	const float Target = FMath::Clamp(CumulativeProbability, 0.0f, 1.0f);
+	const int32 Index = Algo::UpperBound(Cumulative, Target);
+	if (Index < Cumulative.Num())
+	{
+		return Index;
+	}
+
+	// Target == 1 时落在最后一个正权重元素上
+	for (int32 i = Weights.Num() - 1; i >= 0; --i)
+	{
+		if (Weights[i] > 0.0f)
+		{
+			return i;
+		}
+	}
+	return INDEX_NONE;
+}
+
+void FPreparedWeightedDistribution::SampleWithReplacement(int32 Count, TArray<int32>& OutIndices, FRandomStream* Stream) const
+{
+	OutIndices.Reset();
+	if (!IsValid() || Count <= 0)
+	{
+		return;
+	}
+
+	OutIndices.SetNumUninitialized(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const float ColumnUniform = PreparedWeightedDistribution_Private::GetUniform(Stream);
+		OutIndices[i] = SampleFromUniform(ColumnUniform, PreparedWeightedDistribution_Private::GetUniform(Stream));
+	}
+}
+
+void FPreparedWeightedDistribution::SampleWithoutReplacement(int32 Count, TArray<int32>& OutIndices, FRandomStream* Stream) const
+{
+	using namespace PreparedWeightedDistribution_Private;
+
+	OutIndices.Reset();
+	if (!IsValid() || Count <= 0)
+	{
+		return;
+	}
+
+	Count = FMath::Min(Count, PositiveCount);
+
+	// 只保留键最大的 Count 个元素：堆顶为当前保留集合中的最小键
+	TArray<FSampleKey> Selected;
+	Selected.Reserve(Count);
+	const FSampleKeyLess Less;
+
+	for (int32 i = 0; i < Weights.Num(); ++i)
+	{
+		const float Weight = Weights[i];
+		if (Weight <= 0.0f)
+		{
+			continue;
+		}
+
+		// u 取 (0,1]，避免 ln(0)
+		const double Uniform = 1.0 - static_cast<double>(GetUniform(Stream));
+		const FSampleKey Entry{ FMath::Loge(Uniform) / Weight, i };
+
+		if (Selected.Num() < Count)
+		{
+			Selected.HeapPush(Entry, Less);
+		}
+		else if (Less(Selected.HeapTop(), Entry))
+		{
+#if XTOOLS_ENGINE_5_8_OR_LATER
+			Selected.HeapPopDiscard(Less, EAllowShrinking::No);
+#else
+			Selected.HeapPopDiscard(Less, false);
+#endif
+			Selected.HeapPush(Entry, Less);
+		}
+	}
+
+	// 键从大到小即为依次被抽中的顺序
+	Selected.Sort([&Less](const FSampleKey& A, const FSampleKey& B) { return Less(B, A); });
+
+	OutIndices.SetNumUninitialized(Selected.Num());
+	for (int32 i = 0; i < Selected.Num(); ++i)
+	{
+		OutIndices[i] = Selected[i].Index;
+	}
+}
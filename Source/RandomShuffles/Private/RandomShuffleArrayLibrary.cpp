@@ -5,9 +5,13 @@
 
 #include "RandomShuffleArrayLibrary.h"
 #include "Math/UnrealMathUtility.h"
+#include "HAL/PlatformTime.h"
 #include "RandomSample.h"
 #include "WeightPoolSample.h"
+#include "FastRandom.h"
 #include "RandomShuffleLog.h"
+#include "PRDConstants.h"
+#include "PRDStateSubsystem.h"
 
 namespace RandomShuffles {
 
@@ -251,98 +255,6 @@ namespace RandomShuffles {
     private:
         float Value;
     };
-
-    // DOTA2的PRD算法C值查找表 - 使用数组优化查找性能
-    // 来源：https://gaming.stackexchange.com/questions/161430/calculating-the-constant-c-in-dota-2-pseudo-random-distribution
-    struct FPRDEntry
-    {
-        float Probability;
-        float Constant;
-    };
-
-    // 按概率排序的PRD常数表，便于二分查找
-    static const FPRDEntry PRDConstantTable[] = {
-        {0.01f, 0.000156f}, {0.02f, 0.000620f}, {0.03f, 0.001386f}, {0.04f, 0.002449f}, {0.05f, 0.003802f},
-        {0.06f, 0.005440f}, {0.07f, 0.007359f}, {0.08f, 0.009552f}, {0.09f, 0.012016f}, {0.10f, 0.014746f},
-        {0.11f, 0.017736f}, {0.12f, 0.020983f}, {0.13f, 0.024482f}, {0.14f, 0.028230f}, {0.15f, 0.032221f},
-        {0.16f, 0.036452f}, {0.17f, 0.040920f}, {0.18f, 0.045620f}, {0.19f, 0.050549f}, {0.20f, 0.055704f},
-        {0.21f, 0.061081f}, {0.22f, 0.066676f}, {0.23f, 0.072488f}, {0.24f, 0.078511f}, {0.25f, 0.084744f},
-        {0.26f, 0.091183f}, {0.27f, 0.097826f}, {0.28f, 0.104670f}, {0.29f, 0.111712f}, {0.30f, 0.118949f},
-        {0.31f, 0.126379f}, {0.32f, 0.134001f}, {0.33f, 0.141805f}, {0.34f, 0.149810f}, {0.35f, 0.157983f},
-        {0.36f, 0.166329f}, {0.37f, 0.174909f}, {0.38f, 0.183625f}, {0.39f, 0.192486f}, {0.40f, 0.201547f},
-        {0.41f, 0.210920f}, {0.42f, 0.220365f}, {0.43f, 0.229899f}, {0.44f, 0.239540f}, {0.45f, 0.249307f},
-        {0.46f, 0.259872f}, {0.47f, 0.270453f}, {0.48f, 0.281008f}, {0.49f, 0.291552f}, {0.50f, 0.302103f},
-        {0.51f, 0.312677f}, {0.52f, 0.323291f}, {0.53f, 0.334120f}, {0.54f, 0.347370f}, {0.55f, 0.360398f},
-        {0.56f, 0.373217f}, {0.57f, 0.385840f}, {0.58f, 0.398278f}, {0.59f, 0.410545f}, {0.60f, 0.422650f},
-        {0.61f, 0.434604f}, {0.62f, 0.446419f}, {0.63f, 0.458104f}, {0.64f, 0.469670f}, {0.65f, 0.481125f},
-        {0.66f, 0.492481f}, {0.67f, 0.507463f}, {0.68f, 0.529412f}, {0.69f, 0.550725f}, {0.70f, 0.571429f},
-        {0.71f, 0.591549f}, {0.72f, 0.611111f}, {0.73f, 0.630137f}, {0.74f, 0.648649f}, {0.75f, 0.666667f},
-        {0.76f, 0.684211f}, {0.77f, 0.701299f}, {0.78f, 0.717949f}, {0.79f, 0.734177f}, {0.80f, 0.750000f},
-        {0.81f, 0.765432f}, {0.82f, 0.780488f}, {0.83f, 0.795181f}, {0.84f, 0.809524f}, {0.85f, 0.823529f},
-        {0.86f, 0.837209f}, {0.87f, 0.850575f}, {0.88f, 0.863636f}, {0.89f, 0.876404f}, {0.90f, 0.888889f},
-        {0.91f, 0.901099f}, {0.92f, 0.913043f}, {0.93f, 0.924731f}, {0.94f, 0.936170f}, {0.95f, 0.947368f},
-        {0.96f, 0.958333f}, {0.97f, 0.969072f}, {0.98f, 0.979592f}, {0.99f, 0.989899f}
-    };
-
-    // 获取最接近的PRD常数C - 使用二分查找优化性能
-    float GetPRDConstant(float P)
-    {
-        // 边界检查
-        if (P <= 0.f) return 0.f;
-        if (P >= 1.f) return 1.f;
-
-        // 低概率区间（P < 0.01）使用二次近似，避免直接贴边到0.01导致偏差过大
-        // 基于表首项拟合：C ~= k * P^2, 其中 k = 0.000156 / (0.01^2) = 1.56
-        constexpr float MinTableP = 0.01f;
-        constexpr float MinTableC = 0.000156f;
-        if (P < MinTableP)
-        {
-            constexpr float QuadraticK = MinTableC / (MinTableP * MinTableP);
-            return FMath::Min(QuadraticK * P * P, MinTableC);
-        }
-
-        // 使用二分查找找到合适的区间
-        int32 Left = 0;
-        int32 Right = UE_ARRAY_COUNT(PRDConstantTable) - 1;
-
-        // 检查是否完全匹配
-        while (Left <= Right)
-        {
-            int32 Mid = (Left + Right) / 2;
-            const float MidP = PRDConstantTable[Mid].Probability;
-
-            if (FMath::IsNearlyEqual(MidP, P, 0.001f))
-            {
-                return PRDConstantTable[Mid].Constant;
-            }
-            else if (MidP < P)
-            {
-                Left = Mid + 1;
-            }
-            else
-            {
-                Right = Mid - 1;
-            }
-        }
-
-        // 找到插值区间
-        int32 LowerIndex = FMath::Clamp(Right, 0, (int32)UE_ARRAY_COUNT(PRDConstantTable) - 1);
-        int32 UpperIndex = FMath::Clamp(Left, 0, (int32)UE_ARRAY_COUNT(PRDConstantTable) - 1);
-
-        if (LowerIndex == UpperIndex)
-        {
-            return PRDConstantTable[LowerIndex].Constant;
-        }
-
-        // 线性插值
-        const float LowerP = PRDConstantTable[LowerIndex].Probability;
-        const float UpperP = PRDConstantTable[UpperIndex].Probability;
-        const float LowerC = PRDConstantTable[LowerIndex].Constant;
-        const float UpperC = PRDConstantTable[UpperIndex].Constant;
-
-        const float Alpha = (P - LowerP) / (UpperP - LowerP);
-        return LowerC + Alpha * (UpperC - LowerC);
-    }
 }
 
 void URandomShuffleArrayLibrary::GenericArray_RandomSample(
@@ -482,6 +394,106 @@ void URandomShuffleArrayLibrary::GenericArray_StrictWeightRandomSample(
     }
 }
 
+namespace RandomShuffles
+{
+    /** Fisher-Yates 原地打乱，通过 SwapValues 交换元素，不复制也不分配 */
+    template <typename RandIntFunc>
+    void ShuffleScriptArray(FScriptArrayHelper& ArrayHelper, RandIntFunc&& RandInt)
+    {
+        for (int32 i = ArrayHelper.Num() - 1; i > 0; --i)
+        {
+            const int32 j = RandInt(i);
+            if (i != j)
+            {
+                ArrayHelper.SwapValues(i, j);
+            }
+        }
+    }
+}
+
+void URandomShuffleArrayLibrary::GenericArray_ShuffleInPlace(void* TargetArray, const FArrayProperty* ArrayProp, FRandomStream* Stream)
+{
+    if (!TargetArray || !ArrayProp)
+    {
+        return;
+    }
+
+    FScriptArrayHelper ArrayHelper(ArrayProp, TargetArray);
+    if (Stream)
+    {
+        RandomShuffles::ShuffleScriptArray(ArrayHelper, [Stream](int32 Max) { return Stream->RandRange(0, Max); });
+    }
+    else
+    {
+        RandomShuffles::ShuffleScriptArray(ArrayHelper, [](int32 Max) { return FMath::RandRange(0, Max); });
+    }
+}
+
+void URandomShuffleArrayLibrary::GenericArray_ShuffleInPlaceFast(void* TargetArray, const FArrayProperty* ArrayProp, int64 Seed)
+{
+    if (!TargetArray || !ArrayProp)
+    {
+        return;
+    }
+
+    const uint64 ActualSeed = Seed != 0
+        ? static_cast<uint64>(Seed)
+        : FPlatformTime::Cycles64() ^ (static_cast<uint64>(FMath::Rand()) << 32);
+    RandomShuffles::FXoshiro256 Random(ActualSeed);
+
+    FScriptArrayHelper ArrayHelper(ArrayProp, TargetArray);
+    RandomShuffles::ShuffleScriptArray(ArrayHelper, [&Random](int32 Max) { return Random.RandRange(0, Max); });
+}
+
+bool URandomShuffleArrayLibrary::PrepareWeightedDistribution(const TArray<float>& Weights, FPreparedWeightedDistribution& Distribution)
+{
+    return Distribution.Build(Weights);
+}
+
+bool URandomShuffleArrayLibrary::IsWeightedDistributionValid(const FPreparedWeightedDistribution& Distribution)
+{
+    return Distribution.IsValid();
+}
+
+float URandomShuffleArrayLibrary::GetWeightedDistributionProbability(const FPreparedWeightedDistribution& Distribution, int32 Index)
+{
+    return Distribution.GetProbability(Index);
+}
+
+int32 URandomShuffleArrayLibrary::SampleIndexFromDistribution(const FPreparedWeightedDistribution& Distribution)
+{
+    return Distribution.IsValid() ? Distribution.Sample() : INDEX_NONE;
+}
+
+int32 URandomShuffleArrayLibrary::SampleIndexFromDistributionFromStream(const FPreparedWeightedDistribution& Distribution, FRandomStream& Stream)
+{
+    return Distribution.IsValid() ? Distribution.Sample(Stream) : INDEX_NONE;
+}
+
+void URandomShuffleArrayLibrary::SampleIndicesFromDistribution(const FPreparedWeightedDistribution& Distribution, int32 Count, bool bWithReplacement, TArray<int32>& Indices)
+{
+    if (bWithReplacement)
+    {
+        Distribution.SampleWithReplacement(Count, Indices);
+    }
+    else
+    {
+        Distribution.SampleWithoutReplacement(Count, Indices);
+    }
+}
+
+void URandomShuffleArrayLibrary::SampleIndicesFromDistributionFromStream(const FPreparedWeightedDistribution& Distribution, int32 Count, bool bWithReplacement, FRandomStream& Stream, TArray<int32>& Indices)
+{
+    if (bWithReplacement)
+    {
+        Distribution.SampleWithReplacement(Count, Indices, &Stream);
+    }
+    else
+    {
+        Distribution.SampleWithoutReplacement(Count, Indices, &Stream);
+    }
+}
+
 namespace RandomShuffles
 {
     // 通用PRD计算逻辑，避免重复代码
@@ -677,6 +689,147 @@ void URandomShuffleArrayLibrary::ClearAllPRDStates()
     }
 }
 
+// PRD句柄实现 - 状态保存在世界子系统的无锁存储中
+FPRDHandle URandomShuffleArrayLibrary::AcquirePRDHandle(const UObject* WorldContextObject, UObject* Owner, FName StatName)
+{
+    if (UPRDStateSubsystem* Subsystem = UPRDStateSubsystem::Get(WorldContextObject))
+    {
+        return Subsystem->AcquireHandle(Owner, StatName);
+    }
+    return FPRDHandle();
+}
+
+void URandomShuffleArrayLibrary::ReleasePRDHandle(const FPRDHandle& Handle)
+{
+    if (UPRDStateSubsystem* Subsystem = Handle.Store.Get())
+    {
+        Subsystem->ReleaseHandle(Handle);
+    }
+}
+
+bool URandomShuffleArrayLibrary::IsPRDHandleValid(const FPRDHandle& Handle)
+{
+    const UPRDStateSubsystem* Subsystem = Handle.Store.Get();
+    const FPRDStateStore* Store = Subsystem ? Subsystem->GetStore() : nullptr;
+    return Store && Store->IsSlotValid(Handle.Index, Handle.Generation);
+}
+
+void URandomShuffleArrayLibrary::ResetPRDHandle(const FPRDHandle& Handle)
+{
+    const UPRDStateSubsystem* Subsystem = Handle.Store.Get();
+    if (FPRDStateStore* Store = Subsystem ? Subsystem->GetStore() : nullptr)
+    {
+        Store->ResetSlot(Handle.Index, Handle.Generation);
+    }
+}
+
+bool URandomShuffleArrayLibrary::PseudoRandomBoolWithHandle(const FPRDHandle& Handle, float BaseChance)
+{
+    UPRDStateSubsystem* Subsystem = Handle.Store.Get();
+    if (!Subsystem)
+    {
+        return false;
+    }
+
+    int32 FailureCount = 0;
+    float ActualChance = 0.0f;
+    return Subsystem->Roll(Handle, BaseChance, nullptr, FailureCount, ActualChance);
+}
+
+bool URandomShuffleArrayLibrary::PseudoRandomBoolWithHandleFromStream(const FPRDHandle& Handle, float BaseChance, FRandomStream& Stream)
+{
+    UPRDStateSubsystem* Subsystem = Handle.Store.Get();
+    if (!Subsystem)
+    {
+        return false;
+    }
+
+    int32 FailureCount = 0;
+    float ActualChance = 0.0f;
+    return Subsystem->Roll(Handle, BaseChance, &Stream, FailureCount, ActualChance);
+}
+
+void URandomShuffleArrayLibrary::PseudoRandomBoolBatch(TArrayView<const FPRDHandle> Handles, TArrayView<const float> Chances, TBitArray<>& Results, FRandomStream* Stream)
+{
+    const int32 Count = Handles.Num();
+    Results.Init(false, Count);
+
+    const bool bSharedChance = Chances.Num() == 1;
+    if (Count == 0 || (!bSharedChance && Chances.Num() != Count))
+    {
+        ensureMsgf(Count == 0, TEXT("PseudoRandomBoolBatch expected %d chances (or 1 shared chance) but found %d"), Count, Chances.Num());
+        return;
+    }
+
+    // 缓存上一次解析的存储和查到的常数，常见情况下整批只解析一次
+    TWeakObjectPtr<UPRDStateSubsystem> CachedSubsystem;
+    FPRDStateStore* CachedStore = nullptr;
+    bool bHasCachedSubsystem = false;
+    float CachedChance = -1.0f;
+    float CachedP = 0.0f;
+    float CachedC = 0.0f;
+
+    for (int32 i = 0; i < Count; ++i)
+    {
+        const FPRDHandle& Handle = Handles[i];
+        if (!bHasCachedSubsystem || Handle.Store != CachedSubsystem)
+        {
+            const UPRDStateSubsystem* Subsystem = Handle.Store.Get();
+            CachedSubsystem = Handle.Store;
+            CachedStore = Subsystem ? Subsystem->GetStore() : nullptr;
+            bHasCachedSubsystem = true;
+        }
+        if (!CachedStore)
+        {
+            continue;
+        }
+
+        const float Chance = bSharedChance ? Chances[0] : Chances[i];
+        if (Chance != CachedChance)
+        {
+            CachedChance = Chance;
+            CachedP = FMath::Clamp(Chance, 0.0f, RandomShuffles::Config::MaxValidChance);
+            CachedC = RandomShuffles::GetPRDConstant(CachedP);
+        }
+
+        int32 FailureCount = 0;
+        float ActualChance = 0.0f;
+        const float Uniform = RandomShuffles::GetRand(Stream);
+        if (CachedStore->RollWithConstant(Handle.Index, Handle.Generation, CachedP, CachedC, Uniform, FailureCount, ActualChance))
+        {
+            Results[i] = true;
+        }
+    }
+}
+
+void URandomShuffleArrayLibrary::PseudoRandomBoolBatchWithHandles(const TArray<FPRDHandle>& Handles, const TArray<float>& Chances, TArray<bool>& Results)
+{
+    TBitArray<> BatchResults;
+    PseudoRandomBoolBatch(Handles, Chances, BatchResults);
+
+    Results.SetNumUninitialized(BatchResults.Num());
+    for (int32 i = 0; i < BatchResults.Num(); ++i)
+    {
+        Results[i] = BatchResults[i];
+    }
+}
+
+FPRDPerformanceStats URandomShuffleArrayLibrary::GetPRDHandleStats(const UObject* WorldContextObject)
+{
+    const UPRDStateSubsystem* Subsystem = UPRDStateSubsystem::Get(WorldContextObject);
+    const FPRDStateStore* Store = Subsystem ? Subsystem->GetStore() : nullptr;
+    return Store ? Store->GetStats() : FPRDPerformanceStats();
+}
+
+void URandomShuffleArrayLibrary::ResetPRDHandleStats(const UObject* WorldContextObject)
+{
+    const UPRDStateSubsystem* Subsystem = UPRDStateSubsystem::Get(WorldContextObject);
+    if (FPRDStateStore* Store = Subsystem ? Subsystem->GetStore() : nullptr)
+    {
+        Store->ResetStats();
+    }
+}
+
 // 性能统计实现
 FPRDPerformanceStats URandomShuffleArrayLibrary::GetPRDPerformanceStats()
 {
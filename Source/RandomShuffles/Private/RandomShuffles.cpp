@@ -5,10 +5,12 @@
 
 #include "RandomShuffles.h"
 #include "Modules/ModuleManager.h"
+#include "PRDConstants.h"
 
 void FRandomShufflesModule::StartupModule()
 {
-	// 模块启动时的初始化逻辑
+	// 预先求解PRD常数表，避免首次判定时卡顿
+	RandomShuffles::InitializePRDConstantTable();
 }
 
 void FRandomShufflesModule::ShutdownModule()
@@ -6,7 +6,11 @@
 #if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
 
 #include "Misc/AutomationTest.h"
+#include "FastRandom.h"
 #include "RandomSample.h"
+#include "PRDConstants.h"
+#include "PreparedWeightedDistribution.h"
+#include "PRDStateSubsystem.h"
 #include "RandomShuffleArrayLibrary.h"
 #include "WeightPoolSample.h"
 
@@ -136,6 +140,131 @@ bool FRandomShuffle_StrictWeightSamplingMatchesAllocation::RunTest(const FString
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRandomShuffle_LargestRemainderApportionsExactly,
+	"XTools.RandomShuffles.Sampling.LargestRemainderApportionsExactly",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRandomShuffle_LargestRemainderApportionsExactly::RunTest(const FString& Parameters)
+{
+	TArray<int32> Counts;
+	RandomShuffles::ApportionLargestRemainder({ 1.0f, 1.0f, 1.0f }, 3.0, 10, Counts);
+	TestEqual(TEXT("余数相同时应优先分配给索引小的元素"), Counts, TArray<int32>{ 4, 3, 3 });
+
+	RandomShuffles::ApportionLargestRemainder({ 0.5f, 0.0f, 2.5f }, 3.0, 7, Counts);
+	TestEqual(TEXT("零权重元素不应分配名额"), Counts[1], 0);
+	TestEqual(TEXT("名额总和应等于请求数量"), Counts[0] + Counts[2], 7);
+	TestEqual(TEXT("最大余数应获得剩余名额"), Counts[2], 6);
+
+	// 大规模严格权重采样：10k 元素，100k 次
+	constexpr int32 PoolSize = 10000;
+	constexpr int32 DrawCount = 100000;
+	TArray<int32> Input;
+	TArray<float> Weights;
+	Input.SetNumUninitialized(PoolSize);
+	Weights.SetNumUninitialized(PoolSize);
+	double TotalWeight = 0.0;
+	for (int32 i = 0; i < PoolSize; ++i)
+	{
+		Input[i] = i;
+		Weights[i] = 1.0f + (i % 7);
+		TotalWeight += Weights[i];
+	}
+
+	TArray<int32> Result;
+	Result.SetNumUninitialized(DrawCount);
+	RandomShuffles::FXoshiro256 Random(2024);
+	RandomShuffles::WeightPoolSample(Input.GetData(), Input.GetData() + PoolSize, Weights.GetData(), Result.GetData(), DrawCount, Random);
+
+	TArray<int32> Occurrences;
+	Occurrences.SetNumZeroed(PoolSize);
+	for (const int32 Value : Result)
+	{
+		++Occurrences[Value];
+	}
+
+	bool bWithinOne = true;
+	for (int32 i = 0; i < PoolSize && bWithinOne; ++i)
+	{
+		const double Quota = Weights[i] / TotalWeight * DrawCount;
+		bWithinOne = FMath::Abs(Occurrences[i] - Quota) < 1.0;
+	}
+	TestTrue(TEXT("每个元素的次数与精确配额之差应小于1"), bWithinOne);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRandomShuffle_FastRandomIsReproducible,
+	"XTools.RandomShuffles.Sampling.FastRandomIsReproducible",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRandomShuffle_FastRandomIsReproducible::RunTest(const FString& Parameters)
+{
+	RandomShuffles::FXoshiro256 First(99);
+	RandomShuffles::FXoshiro256 Second(99);
+	bool bSameSequence = true;
+	bool bInRange = true;
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		bSameSequence &= First.Next() == Second.Next();
+
+		const float Uniform = First.FRand();
+		const int32 Ranged = First.RandRange(-3, 3);
+		bInRange &= Uniform >= 0.0f && Uniform < 1.0f && Ranged >= -3 && Ranged <= 3;
+		Second.FRand();
+		Second.RandRange(-3, 3);
+	}
+	TestTrue(TEXT("相同种子应生成相同序列"), bSameSequence);
+	TestTrue(TEXT("随机数应落在请求的范围内"), bInRange);
+
+	RandomShuffles::FXoshiro256 ZeroSeed(0);
+	TestNotEqual(TEXT("种子为0时状态也应有效"), ZeroSeed.Next(), 0ull);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRandomShuffle_PreparedDistributionSamplesByWeight,
+	"XTools.RandomShuffles.Sampling.PreparedDistributionSamplesByWeight",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRandomShuffle_PreparedDistributionSamplesByWeight::RunTest(const FString& Parameters)
+{
+	FPreparedWeightedDistribution Invalid;
+	TestFalse(TEXT("负权重不应构建成功"), Invalid.Build(TArray<float>{ 1.0f, -1.0f }));
+	TestFalse(TEXT("全零权重不应构建成功"), Invalid.Build(TArray<float>{ 0.0f, 0.0f }));
+	TestEqual(TEXT("无效分布采样应返回-1"), URandomShuffleArrayLibrary::SampleIndexFromDistribution(Invalid), INDEX_NONE);
+
+	FPreparedWeightedDistribution Distribution;
+	TestTrue(TEXT("有效权重应构建成功"),
+		URandomShuffleArrayLibrary::PrepareWeightedDistribution({ 1.0f, 0.0f, 3.0f, 0.0f }, Distribution));
+	TestEqual(TEXT("正权重数量应正确"), Distribution.NumPositive(), 2);
+	TestEqual(TEXT("概率应按权重归一化"), Distribution.GetProbability(2), 0.75f);
+
+	FRandomStream FirstStream(97531);
+	FRandomStream SecondStream(97531);
+	TArray<int32> FirstResult;
+	TArray<int32> SecondResult;
+	Distribution.SampleWithReplacement(8000, FirstResult, &FirstStream);
+	Distribution.SampleWithReplacement(8000, SecondResult, &SecondStream);
+
+	TestEqual(TEXT("固定随机流的预处理分布采样应可重现"), FirstResult, SecondResult);
+	TestTrue(TEXT("零权重元素不应被选中"), ContainsOnly(FirstResult, { 0, 2 }));
+	const float Ratio = static_cast<float>(CountValue(FirstResult, 2)) / FMath::Max(CountValue(FirstResult, 0), 1);
+	TestTrue(TEXT("采样频率应接近权重比例3:1"), Ratio > 2.6f && Ratio < 3.4f);
+
+	TestEqual(TEXT("累积概率0.5应落在权重3的元素上"), Distribution.FindIndexByCumulative(0.5f), 2);
+	TestEqual(TEXT("累积概率1应落在最后一个正权重元素上"), Distribution.FindIndexByCumulative(1.0f), 2);
+
+	TArray<int32> WithoutReplacement;
+	Distribution.SampleWithoutReplacement(10, WithoutReplacement, &FirstStream);
+	TestEqual(TEXT("无放回采样数量不应超过正权重元素数量"), WithoutReplacement.Num(), 2);
+	TestTrue(TEXT("无放回采样应覆盖全部正权重元素"), WithoutReplacement.Contains(0) && WithoutReplacement.Contains(2));
+
+	return true;
+}
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
 	FRandomShuffle_PRDStateAndBoundsAreControlled,
 	"XTools.RandomShuffles.PRD.StateAndBoundsAreControlled",
@@ -178,4 +307,72 @@ bool FRandomShuffle_PRDStateAndBoundsAreControlled::RunTest(const FString& Param
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRandomShuffle_PRDStateStoreHandlesAreGenerational,
+	"XTools.RandomShuffles.PRD.StateStoreHandlesAreGenerational",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRandomShuffle_PRDStateStoreHandlesAreGenerational::RunTest(const FString& Parameters)
+{
+	FPRDStateStore Store;
+	int32 Index = INDEX_NONE;
+	int32 Generation = 0;
+	TestTrue(TEXT("应能分配槽位"), Store.AllocateSlot(Index, Generation));
+	TestTrue(TEXT("新分配的槽位应有效"), Store.IsSlotValid(Index, Generation));
+
+	int32 FailureCount = INDEX_NONE;
+	float ActualChance = -1.0f;
+	TestFalse(TEXT("随机数接近1时低概率PRD不应触发"), Store.Roll(Index, Generation, 0.25f, 0.99f, FailureCount, ActualChance));
+	TestFalse(TEXT("随机数接近1时低概率PRD不应触发"), Store.Roll(Index, Generation, 0.25f, 0.99f, FailureCount, ActualChance));
+	TestEqual(TEXT("失败次数应在槽位中累积"), Store.GetFailureCount(Index, Generation), 2);
+	TestTrue(TEXT("全概率PRD应始终触发"), Store.Roll(Index, Generation, 1.0f, 0.99f, FailureCount, ActualChance));
+	TestEqual(TEXT("触发后失败次数应重置"), FailureCount, 0);
+
+	const FPRDPerformanceStats Stats = Store.GetStats();
+	TestEqual(TEXT("统计应记录全部调用"), Stats.TotalCalls, 3);
+	TestEqual(TEXT("统计应记录最大失败次数"), Stats.MaxFailureCount, 2);
+	TestEqual(TEXT("已分配句柄数量应为1"), Stats.StateMapSize, 1);
+
+	Store.ReleaseSlot(Index, Generation);
+	TestFalse(TEXT("释放后旧句柄应失效"), Store.IsSlotValid(Index, Generation));
+	TestFalse(TEXT("失效句柄判定应返回false"), Store.Roll(Index, Generation, 1.0f, 0.0f, FailureCount, ActualChance));
+
+	int32 ReusedIndex = INDEX_NONE;
+	int32 ReusedGeneration = 0;
+	TestTrue(TEXT("应能重新分配槽位"), Store.AllocateSlot(ReusedIndex, ReusedGeneration));
+	TestEqual(TEXT("释放的槽位应被复用"), ReusedIndex, Index);
+	TestNotEqual(TEXT("复用的槽位应使用新的代数"), ReusedGeneration, Generation);
+	TestEqual(TEXT("复用的槽位失败次数应为0"), Store.GetFailureCount(ReusedIndex, ReusedGeneration), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRandomShuffle_PRDConstantsMatchNominalChance,
+	"XTools.RandomShuffles.PRD.ConstantsMatchNominalChance",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRandomShuffle_PRDConstantsMatchNominalChance::RunTest(const FString& Parameters)
+{
+	TestTrue(TEXT("25%概率的PRD常数应与已知值一致"),
+		FMath::IsNearlyEqual(RandomShuffles::GetPRDConstant(0.25f), 0.084744f, 1e-4f));
+	TestTrue(TEXT("50%概率的PRD常数应与已知值一致"),
+		FMath::IsNearlyEqual(RandomShuffles::GetPRDConstant(0.5f), 0.302103f, 1e-4f));
+
+	for (const float Chance : { 0.0003f, 0.01f, 0.137f, 0.5f, 0.731f, 0.99f })
+	{
+		const double Achieved = RandomShuffles::CalculatePRDProbabilityFromConstant(RandomShuffles::GetPRDConstant(Chance));
+		TestTrue(FString::Printf(TEXT("插值常数的长期触发概率应接近名义概率 %.4f"), Chance),
+			FMath::IsNearlyEqual(Achieved, static_cast<double>(Chance), 1e-3));
+	}
+
+	TBitArray<> Results;
+	const TArray<FPRDHandle> UnsetHandles = { FPRDHandle(), FPRDHandle(), FPRDHandle() };
+	URandomShuffleArrayLibrary::PseudoRandomBoolBatch(UnsetHandles, TArray<float>{ 1.0f }, Results);
+	TestEqual(TEXT("批量判定结果数量应与句柄数量一致"), Results.Num(), 3);
+	TestEqual(TEXT("无效句柄的批量判定结果应为false"), Results.CountSetBits(), 0);
+
+	return true;
+}
+
 #endif
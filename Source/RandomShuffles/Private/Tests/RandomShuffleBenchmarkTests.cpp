@@ -0,0 +1,395 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+#include "FastRandom.h"
+#include "PRDStateSubsystem.h"
+#include "PreparedWeightedDistribution.h"
+#include "RandomSample.h"
+#include "RandomShuffleArrayLibrary.h"
+#include "WeightPoolSample.h"
+#include "XToolsBenchmark.h"
+
+namespace RandomShuffleBenchmark_Private
+{
+	struct FStreamRandom
+	{
+		explicit FStreamRandom(FRandomStream& InStream)
+			: Stream(InStream)
+		{
+		}
+
+		float operator()(float Min, float Max) const
+		{
+			return Stream.FRandRange(Min, Max);
+		}
+
+		FRandomStream& Stream;
+	};
+
+	/** 卡方检验使用的桶数量 */
+	constexpr int32 NumBuckets = 32;
+
+	/** 卡方检验的抽样次数 */
+	constexpr int32 NumQualityDraws = 320000;
+
+	/** 蓝图 CustomThunk 节点的数组参数，用于直接测量通用数组入口 */
+	const FArrayProperty* FindLibraryArrayParam(FName FunctionName, FName ParamName)
+	{
+		const UFunction* Function = URandomShuffleArrayLibrary::StaticClass()->FindFunctionByName(FunctionName);
+		return Function ? FindFProperty<FArrayProperty>(Function, ParamName) : nullptr;
+	}
+
+	/** 各桶权重互不相同，且包含一个零权重桶 */
+	TArray<float> MakeBucketWeights()
+	{
+		TArray<float> Weights;
+		for (int32 i = 0; i < NumBuckets; ++i)
+		{
+			Weights.Add(i == 3 ? 0.0f : static_cast<float>(1 + i % 7));
+		}
+		return Weights;
+	}
+
+	TArray<double> MakeExpectedCounts(const TArray<float>& Weights, int32 Draws)
+	{
+		double Total = 0.0;
+		for (const float Weight : Weights)
+		{
+			Total += Weight;
+		}
+
+		TArray<double> Expected;
+		for (const float Weight : Weights)
+		{
+			Expected.Add(Draws * Weight / Total);
+		}
+		return Expected;
+	}
+
+	TArray<int64> CountBuckets(const TArray<int32>& Samples, int32 BucketCount)
+	{
+		TArray<int64> Counts;
+		Counts.SetNumZeroed(BucketCount);
+		for (const int32 Sample : Samples)
+		{
+			if (Counts.IsValidIndex(Sample))
+			{
+				++Counts[Sample];
+			}
+		}
+		return Counts;
+	}
+
+	/** 非零期望的桶数减一 */
+	int32 GetDegreesOfFreedom(const TArray<double>& Expected)
+	{
+		int32 NonZero = 0;
+		for (const double Value : Expected)
+		{
+			NonZero += Value > 0.0 ? 1 : 0;
+		}
+		return NonZero - 1;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRandomShuffleBenchmark_Sampling,
+	"XTools.RandomShuffles.Benchmark.Sampling",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FRandomShuffleBenchmark_Sampling::RunTest(const FString& Parameters)
+{
+	using namespace RandomShuffleBenchmark_Private;
+
+	FXToolsBenchmarkReport Report(TEXT("RandomShuffles.Sampling"));
+	FRandomStream Stream(8675309);
+
+	const FArrayProperty* InputProp = FindLibraryArrayParam(TEXT("Array_RandomSample"), TEXT("InputArray"));
+	const FArrayProperty* WeightsProp = FindLibraryArrayParam(TEXT("Array_RandomSample"), TEXT("Weights"));
+	FArrayProperty* ResultProp = const_cast<FArrayProperty*>(FindLibraryArrayParam(TEXT("Array_RandomSample"), TEXT("Result")));
+	const FArrayProperty* ShuffleProp = FindLibraryArrayParam(TEXT("Array_ShuffleInPlace"), TEXT("TargetArray"));
+	if (!TestTrue(TEXT("应能找到随机节点的数组参数"), InputProp && WeightsProp && ResultProp && ShuffleProp))
+	{
+		return false;
+	}
+
+	for (const int32 Size : FXToolsBenchmarkReport::GetStandardSizes())
+	{
+		TArray<int32> Input;
+		TArray<float> Weights;
+		Input.SetNumUninitialized(Size);
+		Weights.SetNumUninitialized(Size);
+		for (int32 i = 0; i < Size; ++i)
+		{
+			Input[i] = i;
+			Weights[i] = Stream.FRandRange(0.1f, 10.0f);
+		}
+
+		// 抽样数量与规模相同，每元素耗时即每次抽样耗时
+		TArray<int32> Result;
+		Result.SetNumUninitialized(Size);
+		FStreamRandom Random(Stream);
+
+		Report.Measure(TEXT("UniformRandomSample"), Size, [&]()
+		{
+			RandomShuffles::UniformRandomSample(Input.GetData(), Input.GetData() + Size, Result.GetData(), Size, Random);
+		});
+		Report.Measure(TEXT("RandomSample"), Size, [&]()
+		{
+			RandomShuffles::RandomSample(Input.GetData(), Input.GetData() + Size, Weights.GetData(), Result.GetData(), Size, Random);
+		});
+		Report.Measure(TEXT("WeightPoolSample"), Size, [&]()
+		{
+			RandomShuffles::WeightPoolSample(Input.GetData(), Input.GetData() + Size, Weights.GetData(), Result.GetData(), Size, Random);
+		});
+
+		TArray<int32> GenericResult;
+		Report.Measure(TEXT("GenericArray_RandomSample"), Size, [&]()
+		{
+			URandomShuffleArrayLibrary::GenericArray_RandomSample(&Input, InputProp, &Weights, WeightsProp, Size, &Stream, &GenericResult, ResultProp);
+		});
+		Report.Measure(TEXT("GenericArray_StrictWeightRandomSample"), Size, [&]()
+		{
+			URandomShuffleArrayLibrary::GenericArray_StrictWeightRandomSample(&Input, InputProp, &Weights, WeightsProp, Size, &Stream, &GenericResult, ResultProp);
+		});
+
+		TArray<int32> Shuffled = Input;
+		Report.Measure(TEXT("GenericArray_ShuffleInPlace"), Size, [&]()
+		{
+			URandomShuffleArrayLibrary::GenericArray_ShuffleInPlace(&Shuffled, ShuffleProp, &Stream);
+		});
+		Report.Measure(TEXT("GenericArray_ShuffleInPlaceFast"), Size, [&]()
+		{
+			URandomShuffleArrayLibrary::GenericArray_ShuffleInPlaceFast(&Shuffled, ShuffleProp, 0);
+		});
+
+		FPreparedWeightedDistribution Distribution;
+		Report.Measure(TEXT("PrepareWeightedDistribution"), Size, [&]()
+		{
+			URandomShuffleArrayLibrary::PrepareWeightedDistribution(Weights, Distribution);
+		});
+
+		TArray<int32> Indices;
+		Report.Measure(TEXT("SampleIndexFromDistribution"), Size, [&]()
+		{
+			for (int32 i = 0; i < Size; ++i)
+			{
+				Result[i] = URandomShuffleArrayLibrary::SampleIndexFromDistributionFromStream(Distribution, Stream);
+			}
+		});
+		Report.Measure(TEXT("SampleIndicesFromDistribution.WithReplacement"), Size, [&]()
+		{
+			URandomShuffleArrayLibrary::SampleIndicesFromDistributionFromStream(Distribution, Size, true, Stream, Indices);
+		});
+		Report.Measure(TEXT("SampleIndicesFromDistribution.WithoutReplacement"), Size, [&]()
+		{
+			URandomShuffleArrayLibrary::SampleIndicesFromDistributionFromStream(Distribution, Size, false, Stream, Indices);
+		});
+	}
+
+	TestTrue(TEXT("基准测试结果应写入JSON"), Report.Save());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRandomShuffleBenchmark_SamplingQuality,
+	"XTools.RandomShuffles.Benchmark.SamplingQuality",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FRandomShuffleBenchmark_SamplingQuality::RunTest(const FString& Parameters)
+{
+	using namespace RandomShuffleBenchmark_Private;
+
+	FXToolsBenchmarkReport Report(TEXT("RandomShuffles.SamplingQuality"));
+	FRandomStream Stream(20250101);
+	FStreamRandom Random(Stream);
+
+	TArray<int32> Buckets;
+	for (int32 i = 0; i < NumBuckets; ++i)
+	{
+		Buckets.Add(i);
+	}
+	const TArray<float> Weights = MakeBucketWeights();
+	const TArray<double> WeightedExpected = MakeExpectedCounts(Weights, NumQualityDraws);
+
+	TArray<float> UniformWeights;
+	UniformWeights.Init(1.0f, NumBuckets);
+	const TArray<double> UniformExpected = MakeExpectedCounts(UniformWeights, NumQualityDraws);
+
+	auto CheckChiSquare = [this, &Report](const TCHAR* Name, const TArray<int32>& Samples, const TArray<double>& Expected)
+	{
+		const double Statistic = FXToolsBenchmarkReport::ChiSquareStatistic(CountBuckets(Samples, Expected.Num()), Expected);
+		const double Critical = FXToolsBenchmarkReport::ChiSquareCriticalValue(GetDegreesOfFreedom(Expected));
+		Report.AddMetric(FString::Printf(TEXT("%s.ChiSquare"), Name), Statistic);
+		Report.AddMetric(FString::Printf(TEXT("%s.ChiSquareCritical"), Name), Critical);
+		TestTrue(FString::Printf(TEXT("%s 的抽样频率应与权重一致 (卡方 %.2f < %.2f)"), Name, Statistic, Critical), Statistic < Critical);
+	};
+
+	TArray<int32> Samples;
+	Samples.SetNumUninitialized(NumQualityDraws);
+
+	RandomShuffles::UniformRandomSample(Buckets.GetData(), Buckets.GetData() + NumBuckets, Samples.GetData(), NumQualityDraws, Random);
+	CheckChiSquare(TEXT("UniformRandomSample"), Samples, UniformExpected);
+
+	RandomShuffles::RandomSample(Buckets.GetData(), Buckets.GetData() + NumBuckets, Weights.GetData(), Samples.GetData(), NumQualityDraws, Random);
+	CheckChiSquare(TEXT("RandomSample"), Samples, WeightedExpected);
+	TestEqual(TEXT("RandomSample 不应选中零权重元素"), CountBuckets(Samples, NumBuckets)[3], static_cast<int64>(0));
+
+	FPreparedWeightedDistribution Distribution;
+	Distribution.Build(Weights);
+	Distribution.SampleWithReplacement(NumQualityDraws, Samples, &Stream);
+	CheckChiSquare(TEXT("PreparedDistribution.Alias"), Samples, WeightedExpected);
+
+	// 逆CDF查表使用分层均匀输入，频率应几乎精确等于权重
+	for (int32 i = 0; i < NumQualityDraws; ++i)
+	{
+		Samples[i] = Distribution.FindIndexByCumulative(Stream.FRand());
+	}
+	CheckChiSquare(TEXT("PreparedDistribution.Cumulative"), Samples, WeightedExpected);
+
+	// 无放回采样的首个结果服从权重分布
+	constexpr int32 NumFirstPickDraws = 40000;
+	TArray<int32> FirstPicks;
+	TArray<int32> Picked;
+	FirstPicks.Reserve(NumFirstPickDraws);
+	for (int32 i = 0; i < NumFirstPickDraws; ++i)
+	{
+		Distribution.SampleWithoutReplacement(4, Picked, &Stream);
+		FirstPicks.Add(Picked[0]);
+	}
+	CheckChiSquare(TEXT("PreparedDistribution.WithoutReplacement"), FirstPicks, MakeExpectedCounts(Weights, NumFirstPickDraws));
+
+	// 洗牌后元素0落在每个位置的概率应相同
+	constexpr int32 ShuffleLength = 8;
+	constexpr int32 NumShuffles = 80000;
+	const FArrayProperty* ShuffleProp = FindLibraryArrayParam(TEXT("Array_ShuffleInPlace"), TEXT("TargetArray"));
+	if (TestNotNull(TEXT("应能找到洗牌节点的数组参数"), ShuffleProp))
+	{
+		TArray<float> PositionWeights;
+		PositionWeights.Init(1.0f, ShuffleLength);
+		const TArray<double> PositionExpected = MakeExpectedCounts(PositionWeights, NumShuffles);
+
+		TArray<int32> StreamPositions;
+		TArray<int32> FastPositions;
+		TArray<int32> Deck;
+		for (int32 i = 0; i < NumShuffles; ++i)
+		{
+			Deck = { 0, 1, 2, 3, 4, 5, 6, 7 };
+			URandomShuffleArrayLibrary::GenericArray_ShuffleInPlace(&Deck, ShuffleProp, &Stream);
+			StreamPositions.Add(Deck.Find(0));
+
+			Deck = { 0, 1, 2, 3, 4, 5, 6, 7 };
+			URandomShuffleArrayLibrary::GenericArray_ShuffleInPlaceFast(&Deck, ShuffleProp, 1 + i);
+			FastPositions.Add(Deck.Find(0));
+		}
+		CheckChiSquare(TEXT("ShuffleInPlace"), StreamPositions, PositionExpected);
+		CheckChiSquare(TEXT("ShuffleInPlaceFast"), FastPositions, PositionExpected);
+	}
+
+	TestTrue(TEXT("质量检测结果应写入JSON"), Report.Save());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRandomShuffleBenchmark_PRD,
+	"XTools.RandomShuffles.Benchmark.PRD",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FRandomShuffleBenchmark_PRD::RunTest(const FString& Parameters)
+{
+	FXToolsBenchmarkReport Report(TEXT("RandomShuffles.PRD"));
+	FRandomStream Stream(31415926);
+
+	// 句柄接口依赖世界子系统，使用临时世界
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	UPRDStateSubsystem* Subsystem = World ? World->GetSubsystem<UPRDStateSubsystem>() : nullptr;
+	if (!TestNotNull(TEXT("临时世界应创建PRD子系统"), Subsystem))
+	{
+		if (World)
+		{
+			World->DestroyWorld(false);
+		}
+		return false;
+	}
+
+	constexpr int32 MaxPRDSize = 65536;
+	for (const int32 Size : FXToolsBenchmarkReport::GetStandardSizes())
+	{
+		Report.Measure(TEXT("PseudoRandomBoolFromStream"), Size, [&]()
+		{
+			for (int32 i = 0; i < Size; ++i)
+			{
+				URandomShuffleArrayLibrary::PseudoRandomBoolFromStream(0.25f, Stream, TEXT("Benchmark.Legacy"));
+			}
+		});
+
+		const FPRDHandle SingleHandle = URandomShuffleArrayLibrary::AcquirePRDHandle(World, World, TEXT("Benchmark.Single"));
+		Report.Measure(TEXT("PseudoRandomBoolWithHandleFromStream"), Size, [&]()
+		{
+			for (int32 i = 0; i < Size; ++i)
+			{
+				URandomShuffleArrayLibrary::PseudoRandomBoolWithHandleFromStream(SingleHandle, 0.25f, Stream);
+			}
+		});
+
+		// 每个句柄对应一个独立目标，槽位数量有上限，批量规模截断
+		const int32 NumHandles = FMath::Min(Size, MaxPRDSize);
+		TArray<FPRDHandle> Handles;
+		Handles.Reserve(NumHandles);
+		for (int32 i = 0; i < NumHandles; ++i)
+		{
+			Handles.Add(URandomShuffleArrayLibrary::AcquirePRDHandle(World, World, FName(TEXT("Benchmark.Batch"), i + 1)));
+		}
+
+		TBitArray<> Results;
+		const float SharedChance = 0.25f;
+		Report.Measure(TEXT("PseudoRandomBoolBatch"), NumHandles, [&]()
+		{
+			URandomShuffleArrayLibrary::PseudoRandomBoolBatch(Handles, MakeArrayView(&SharedChance, 1), Results, &Stream);
+		});
+
+		for (const FPRDHandle& Handle : Handles)
+		{
+			URandomShuffleArrayLibrary::ReleasePRDHandle(Handle);
+		}
+		URandomShuffleArrayLibrary::ReleasePRDHandle(SingleHandle);
+	}
+	URandomShuffleArrayLibrary::ClearPRDState(TEXT("Benchmark.Legacy"));
+
+	// 长期触发率应等于名义概率；PRD方差小于伯努利分布，使用伯努利标准差作为宽松上界
+	constexpr int32 NumRolls = 400000;
+	const FPRDHandle RateHandle = URandomShuffleArrayLibrary::AcquirePRDHandle(World, World, TEXT("Benchmark.Rate"));
+	for (const float Chance : { 0.05f, 0.1f, 0.25f, 0.5f, 0.75f })
+	{
+		FPRDStateStore* Store = Subsystem->GetStore();
+		RandomShuffles::FXoshiro256 Random(static_cast<uint64>(Chance * 1000.0f) + 1);
+		int32 Successes = 0;
+		int32 FailureCount = 0;
+		float ActualChance = 0.0f;
+		Store->ResetSlot(RateHandle.Index, RateHandle.Generation);
+		for (int32 i = 0; i < NumRolls; ++i)
+		{
+			Successes += Store->Roll(RateHandle.Index, RateHandle.Generation, Chance, Random.FRand(), FailureCount, ActualChance) ? 1 : 0;
+		}
+
+		const double Rate = static_cast<double>(Successes) / NumRolls;
+		const double Tolerance = 4.0 * FMath::Sqrt(Chance * (1.0 - Chance) / NumRolls) + 1e-3;
+		Report.AddMetric(FString::Printf(TEXT("PRD.EmpiricalRate.%.2f"), Chance), Rate);
+		TestTrue(FString::Printf(TEXT("PRD长期触发率 %.4f 应接近名义概率 %.2f"), Rate, Chance),
+			FMath::Abs(Rate - Chance) <= Tolerance);
+	}
+	URandomShuffleArrayLibrary::ReleasePRDHandle(RateHandle);
+
+	World->DestroyWorld(false);
+
+	TestTrue(TEXT("基准测试结果应写入JSON"), Report.Save());
+	return true;
+}
+
+#endif
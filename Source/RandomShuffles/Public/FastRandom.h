@@ -0,0 +1,87 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace RandomShuffles {
+
+/**
+ * xoshiro256** 64位伪随机数生成器
+ * 比 FRandomStream 周期更长、统计质量更好且更快，适合大数组打乱和大量采样。
+ * 提供与采样模板兼容的 operator()(Min, Max)，可直接替代 FRandomStream 作为随机源。
+ * 算法来源：https://prng.di.unimi.it/
+ */
+class FXoshiro256
+{
+public:
+	explicit FXoshiro256(uint64 Seed = 0)
+	{
+		Initialize(Seed);
+	}
+
+	/** 使用 SplitMix64 展开种子，保证任意种子（包括0）都能得到有效状态 */
+	void Initialize(uint64 Seed)
+	{
+		for (uint64& Word : State)
+		{
+			Seed += 0x9E3779B97F4A7C15ull;
+			uint64 Z = Seed;
+			Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+			Word = Z ^ (Z >> 31);
+		}
+	}
+
+	uint64 Next()
+	{
+		const uint64 Result = RotateLeft(State[1] * 5, 7) * 9;
+		const uint64 T = State[1] << 17;
+
+		State[2] ^= State[0];
+		State[3] ^= State[1];
+		State[1] ^= State[2];
+		State[0] ^= State[3];
+		State[2] ^= T;
+		State[3] = RotateLeft(State[3], 45);
+
+		return Result;
+	}
+
+	/** [0,1) 均匀浮点数 */
+	float FRand()
+	{
+		return static_cast<float>(Next() >> 40) * (1.0f / 16777216.0f);
+	}
+
+	/** [0, Bound) 均匀整数，使用乘法映射避免取模 */
+	uint32 NextBounded(uint32 Bound)
+	{
+		return static_cast<uint32>(((Next() >> 32) * static_cast<uint64>(Bound)) >> 32);
+	}
+
+	/** [Min, Max] 均匀整数 */
+	int32 RandRange(int32 Min, int32 Max)
+	{
+		return Max > Min ? Min + static_cast<int32>(NextBounded(static_cast<uint32>(Max) - static_cast<uint32>(Min) + 1u)) : Min;
+	}
+
+	/** 与采样模板的随机函数签名兼容 */
+	float operator()(float Min, float Max)
+	{
+		return Min + (Max - Min) * FRand();
+	}
+
+private:
+	static uint64 RotateLeft(uint64 Value, int32 Shift)
+	{
+		return (Value << Shift) | (Value >> (64 - Shift));
+	}
+
+	uint64 State[4];
+};
+
+}
@@ -0,0 +1,145 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "PRDTypes.h"
+#include <atomic>
+#include "PRDStateSubsystem.generated.h"
+
+/**
+ * 无锁PRD状态存储
+ * 状态保存在分块的原子槽位数组中，每个槽位将代数和失败次数打包为一个64位原子量。
+ * - 判定：无锁，只做一次加载和CAS，失败时用同一个随机数按新状态重算
+ * - 分配/释放：低频操作，使用锁保护空闲列表
+ * - 统计：按线程分片计数，避免所有线程争用同一缓存行
+ * 分块一经分配不再移动，因此判定路径不需要与分配路径同步。
+ */
+class RANDOMSHUFFLES_API FPRDStateStore : public FNoncopyable
+{
+public:
+	static constexpr int32 SlotsPerChunk = 1024;
+	static constexpr int32 MaxChunks = 256;
+	static constexpr int32 MaxSlots = SlotsPerChunk * MaxChunks;
+
+	FPRDStateStore();
+	~FPRDStateStore();
+
+	/** 分配槽位，超过 MaxSlots 时返回 false */
+	bool AllocateSlot(int32& OutIndex, int32& OutGeneration);
+
+	/** 释放槽位，旧代数的句柄随即失效 */
+	void ReleaseSlot(int32 Index, int32 Generation);
+
+	/** 槽位是否仍属于该代数 */
+	bool IsSlotValid(int32 Index, int32 Generation) const;
+
+	/**
+	 * 执行一次PRD判定并原子地更新失败次数
+	 * @param Uniform [0,1) 均匀随机数
+	 * @return 是否触发；句柄失效时返回 false 且 OutActualChance 为0
+	 */
+	bool Roll(int32 Index, int32 Generation, float BaseChance, float Uniform, int32& OutFailureCount, float& OutActualChance);
+
+	/**
+	 * 使用已查好的PRD常数执行判定，批量判定时同一概率只需查表一次
+	 * @param P 已限制在 [0,1] 的基础概率
+	 * @param C P 对应的PRD常数
+	 */
+	bool RollWithConstant(int32 Index, int32 Generation, float P, float C, float Uniform, int32& OutFailureCount, float& OutActualChance);
+
+	/** 清零失败次数 */
+	bool ResetSlot(int32 Index, int32 Generation);
+
+	/** 当前失败次数，句柄失效时返回0 */
+	int32 GetFailureCount(int32 Index, int32 Generation) const;
+
+	/** 已分配的槽位数量 */
+	int32 NumLiveSlots() const { return LiveSlots.load(std::memory_order_relaxed); }
+
+	/** 汇总各线程的统计 */
+	FPRDPerformanceStats GetStats() const;
+
+	void ResetStats();
+
+private:
+	struct FSlotChunk
+	{
+		std::atomic<uint64> States[SlotsPerChunk];
+	};
+
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FStatsShard
+	{
+		std::atomic<int64> Calls{ 0 };
+		std::atomic<int64> FailureSum{ 0 };
+		std::atomic<int32> MaxFailure{ 0 };
+	};
+
+	static constexpr int32 NumStatsShards = 16;
+
+	static uint64 PackState(uint32 Generation, uint32 FailureCount)
+	{
+		return (static_cast<uint64>(Generation) << 32) | FailureCount;
+	}
+	static uint32 UnpackGeneration(uint64 State) { return static_cast<uint32>(State >> 32); }
+	static uint32 UnpackFailureCount(uint64 State) { return static_cast<uint32>(State); }
+
+	std::atomic<uint64>* FindSlot(int32 Index) const;
+
+	void RecordCall(int32 FailureCount);
+
+	std::atomic<FSlotChunk*> Chunks[MaxChunks];
+	FStatsShard StatsShards[NumStatsShards];
+
+	FCriticalSection AllocationLock;
+	TArray<int32> FreeSlots;
+	int32 NextSlot = 0;
+	std::atomic<int32> LiveSlots{ 0 };
+};
+
+/**
+ * PRD状态子系统
+ * 为每个世界提供一个无锁PRD状态存储，世界销毁时所有句柄一并失效。
+ * 相比按 StateID 字符串管理状态的全局接口，适合每次命中都要判定的高频场景（暴击、闪避等）。
+ */
+UCLASS()
+class RANDOMSHUFFLES_API UPRDStateSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	static UPRDStateSubsystem* Get(const UObject* WorldContext);
+
+	/**
+	 * 获取 (所有者, 属性) 对应的句柄，同一组合重复获取返回同一个句柄
+	 * 仅需在初始化时调用一次并缓存结果
+	 */
+	FPRDHandle AcquireHandle(const UObject* Owner, FName StatName);
+
+	/** 释放句柄及其状态 */
+	void ReleaseHandle(const FPRDHandle& Handle);
+
+	/** 使用句柄执行PRD判定，Stream 为空时使用全局随机源；句柄不属于本子系统时返回 false */
+	bool Roll(const FPRDHandle& Handle, float BaseChance, FRandomStream* Stream, int32& OutFailureCount, float& OutActualChance);
+
+	FPRDStateStore* GetStore() const { return Store.Get(); }
+
+private:
+	TUniquePtr<FPRDStateStore> Store;
+
+	/** 仅在获取/释放句柄时使用 */
+	using FOwnerStatKey = TTuple<TObjectKey<UObject>, FName>;
+	TMap<FOwnerStatKey, FPRDHandle> HandleByOwner;
+
+	/** 槽位 -> 所有者键，释放句柄时用于移除映射 */
+	TArray<FOwnerStatKey> OwnerKeyBySlot;
+	FCriticalSection HandleMapLock;
+};
@@ -0,0 +1,79 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "PRDTypes.generated.h"
+
+class UPRDStateSubsystem;
+
+/**
+ * RandomShuffles 模块配置常量
+ * 集中管理性能参数和配置选项
+ */
+namespace RandomShuffles
+{
+    namespace Config
+    {
+        // PRD 算法配置
+        constexpr float MinValidChance = 0.0001f;      // 最小有效概率
+        constexpr float MaxValidChance = 1.0f;         // 最大有效概率
+        constexpr int32 MaxFailureCount = 10000;      // 最大失败次数限制
+
+        // 性能配置
+        constexpr int32 DefaultStateMapReserve = 64;  // 默认状态映射预分配大小
+        constexpr int32 MaxStateMapSize = 1000;       // 状态映射最大大小
+    }
+}
+
+/**
+ * PRD 性能统计结构
+ * 用于监控和调试PRD算法性能
+ */
+USTRUCT(BlueprintType)
+struct RANDOMSHUFFLES_API FPRDPerformanceStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "性能统计", meta = (DisplayName = "总调用次数"))
+    int32 TotalCalls = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "性能统计", meta = (DisplayName = "状态映射大小"))
+    int32 StateMapSize = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "性能统计", meta = (DisplayName = "最大失败次数"))
+    int32 MaxFailureCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "性能统计", meta = (DisplayName = "平均失败次数"))
+    float AverageFailureCount = 0.0f;
+};
+
+/**
+ * PRD状态句柄
+ * 每个 (所有者, 属性) 获取一次并缓存，之后每次判定只需索引 + CAS，不再做字符串/FName查找。
+ * 句柄随所属世界销毁而失效；释放后的旧句柄会因代数不匹配而失效，不会误用被复用的槽位。
+ */
+USTRUCT(BlueprintType, meta = (DisplayName = "PRD句柄"))
+struct RANDOMSHUFFLES_API FPRDHandle
+{
+    GENERATED_BODY()
+
+    /** 所属的状态存储 */
+    UPROPERTY()
+    TWeakObjectPtr<UPRDStateSubsystem> Store;
+
+    /** 槽位索引 */
+    UPROPERTY()
+    int32 Index = INDEX_NONE;
+
+    /** 槽位代数，释放后递增 */
+    UPROPERTY()
+    int32 Generation = 0;
+
+    /** 句柄是否已分配（不检查所属世界是否仍然存在） */
+    bool IsSet() const { return Index != INDEX_NONE; }
+};
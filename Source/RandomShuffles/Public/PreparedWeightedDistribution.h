@@ -0,0 +1,117 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "PreparedWeightedDistribution.generated.h"
+
+/**
+ * 预处理的加权分布
+ * 由权重数组一次性构建 Vose 别名表与累积概率表，之后可反复采样：
+ * - 有放回采样：别名法，每次 O(1)
+ * - 无放回采样：Efraimidis-Spirakis 随机键 + 部分选择，O(N log K)
+ * - 按累积概率查找：二分查找，O(log N)
+ * 构建后只读，可在多个线程间共享（随机源由调用者提供）。
+ * 表数据属于运行时缓存，不参与序列化。
+ */
+USTRUCT(BlueprintType, meta = (DisplayName = "预处理加权分布"))
+struct RANDOMSHUFFLES_API FPreparedWeightedDistribution
+{
+	GENERATED_BODY()
+
+	/**
+	 * 由权重构建分布
+	 * @param InWeights 权重数组，必须全部有限且非负，并至少包含一个正权重
+	 * @return 是否构建成功，失败时分布被清空
+	 */
+	bool Build(TArrayView<const float> InWeights);
+
+	/** 清空分布 */
+	void Reset();
+
+	/** 是否已成功构建 */
+	bool IsValid() const { return TotalWeight > 0.0; }
+
+	/** 分布中的元素数量（包含零权重元素） */
+	int32 Num() const { return Weights.Num(); }
+
+	/** 正权重元素数量，即无放回采样能返回的最大数量 */
+	int32 NumPositive() const { return PositiveCount; }
+
+	/** 指定元素被选中的概率 */
+	float GetProbability(int32 Index) const;
+
+	/**
+	 * 别名法采样，列选择与别名判定各用一个独立的均匀随机数
+	 * 单个float拆成两部分时，元素较多的分布留给别名判定的有效位不足，概率会被量化
+	 * @param ColumnUniform [0,1) 均匀随机数，选择别名表的列
+	 * @param AliasUniform [0,1) 均匀随机数，决定取该列自身还是其别名
+	 */
+	int32 SampleFromUniform(float ColumnUniform, float AliasUniform) const
+	{
+		const int32 Count = Weights.Num();
+		if (Count == 0)
+		{
+			return INDEX_NONE;
+		}
+
+		const int32 Column = FMath::Min(FMath::FloorToInt32(FMath::Clamp(ColumnUniform, 0.0f, 1.0f) * Count), Count - 1);
+		return AliasUniform < AliasProbabilities[Column] ? Column : Aliases[Column];
+	}
+
+	/** 有放回采样一个索引 */
+	int32 Sample(FRandomStream& Stream) const
+	{
+		const float ColumnUniform = Stream.FRand();
+		return SampleFromUniform(ColumnUniform, Stream.FRand());
+	}
+
+	/** 有放回采样一个索引（全局随机源） */
+	int32 Sample() const
+	{
+		const float ColumnUniform = FMath::FRand();
+		return SampleFromUniform(ColumnUniform, FMath::FRand());
+	}
+
+	/**
+	 * 按累积概率查找索引（逆CDF），单调映射，适合分层采样或确定性查表
+	 * @param CumulativeProbability [0,1] 累积概率
+	 */
+	int32 FindIndexByCumulative(float CumulativeProbability) const;
+
+	/**
+	 * 有放回采样
+	 * @param Count 采样数量
+	 * @param OutIndices 输出索引，会被覆盖
+	 * @param Stream 随机流，为空时使用全局随机源
+	 */
+	void SampleWithReplacement(int32 Count, TArray<int32>& OutIndices, FRandomStream* Stream = nullptr) const;
+
+	/**
+	 * 无放回采样，结果按被抽中的先后顺序排列
+	 * @param Count 采样数量，超过正权重元素数量时截断
+	 * @param OutIndices 输出索引，会被覆盖
+	 * @param Stream 随机流，为空时使用全局随机源
+	 */
+	void SampleWithoutReplacement(int32 Count, TArray<int32>& OutIndices, FRandomStream* Stream = nullptr) const;
+
+private:
+	/** 原始权重，无放回采样使用 */
+	TArray<float> Weights;
+
+	/** 别名表：每列保留自身的概率 */
+	TArray<float> AliasProbabilities;
+
+	/** 别名表：每列的别名索引 */
+	TArray<int32> Aliases;
+
+	/** 归一化的累积概率，最后一项为1 */
+	TArray<float> Cumulative;
+
+	double TotalWeight = 0.0;
+	int32 PositiveCount = 0;
+};
@@ -6,6 +6,7 @@
 // 只使用UE核心头文件
 #include "CoreMinimal.h"
 #include "MinIndexQueue.h"
+#include "RandomShuffleScratch.h"
 
 namespace RandomShuffles {
 
@@ -22,13 +23,6 @@ Out UniformRandomSample(It begin, It end, Out out, int32 count, Rand randFunc) {
         return out;
     }
 
-    // 使用UE容器 - 创建索引数组
-    TArray<int32> indices;
-    indices.Reserve(sampleSize);
-    for(int32 i = 0; i < sampleSize; ++i) {
-        indices.Add(i);  // 使用UE容器方法
-    }
-
     // 进行count次采样
     for(int32 i = 0; i < count; ++i) {
         // 生成随机索引
@@ -39,7 +33,7 @@ Out UniformRandomSample(It begin, It end, Out out, int32 count, Rand randFunc) {
         }
 
         // 使用UE算法 - 输出选中的元素
-        *out++ = *(begin + indices[selectedIdx]);
+        *out++ = *(begin + selectedIdx);
     }
     
     return out;
@@ -54,8 +48,9 @@ Out RandomSample(It begin, It end, Wt weightBegin, Out out, int32 count, Rand ra
         ++sampleSize;
     }
     
-    // 使用UE容器 - 保存所有权重
-    TArray<float> weights;
+    // 使用线程局部缓冲区保存所有权重，反复调用时不再分配
+    TScratchArray<float> scratchWeights;
+    TArray<float>& weights = *scratchWeights;
     weights.Reserve(sampleSize);
     
     // 第一遍：保存权重并检查是否均匀分布
@@ -107,8 +102,9 @@ Out RandomSample(It begin, It end, Wt weightBegin, Out out, int32 count, Rand ra
         }
     }
 
-    // 使用UE容器 - 进行count次采样
-    TArray<int32> indices;
+    // 进行count次采样
+    TScratchArray<int32> scratchIndices;
+    TArray<int32>& indices = *scratchIndices;
     indices.Reserve(count);
     
     for(int32 sampleIdx = 0; sampleIdx < count; ++sampleIdx) {
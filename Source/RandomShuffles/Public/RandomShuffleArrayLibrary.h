@@ -8,49 +8,10 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "MinIndexQueue.h"
+#include "PreparedWeightedDistribution.h"
+#include "PRDTypes.h"
 #include "RandomShuffleArrayLibrary.generated.h"
 
-/**
- * RandomShuffles 模块配置常量
- * 集中管理性能参数和配置选项
- */
-namespace RandomShuffles
-{
-    namespace Config
-    {
-        // PRD 算法配置
-        constexpr float MinValidChance = 0.0001f;      // 最小有效概率
-        constexpr float MaxValidChance = 1.0f;         // 最大有效概率
-        constexpr int32 MaxFailureCount = 10000;      // 最大失败次数限制
-
-        // 性能配置
-        constexpr int32 DefaultStateMapReserve = 64;  // 默认状态映射预分配大小
-        constexpr int32 MaxStateMapSize = 1000;       // 状态映射最大大小
-    }
-}
-
-/**
- * PRD 性能统计结构
- * 用于监控和调试PRD算法性能
- */
-USTRUCT(BlueprintType)
-struct RANDOMSHUFFLES_API FPRDPerformanceStats
-{
-    GENERATED_BODY()
-
-    UPROPERTY(BlueprintReadOnly, Category = "性能统计", meta = (DisplayName = "总调用次数"))
-    int32 TotalCalls = 0;
-
-    UPROPERTY(BlueprintReadOnly, Category = "性能统计", meta = (DisplayName = "状态映射大小"))
-    int32 StateMapSize = 0;
-
-    UPROPERTY(BlueprintReadOnly, Category = "性能统计", meta = (DisplayName = "最大失败次数"))
-    int32 MaxFailureCount = 0;
-
-    UPROPERTY(BlueprintReadOnly, Category = "性能统计", meta = (DisplayName = "平均失败次数"))
-    float AverageFailureCount = 0.0f;
-};
-
 UCLASS(meta=(BlueprintThreadSafe))
 class RANDOMSHUFFLES_API URandomShuffleArrayLibrary : public UBlueprintFunctionLibrary 
 {
@@ -184,6 +145,139 @@ class RANDOMSHUFFLES_API URandomShuffleArrayLibrary : public UBlueprintFunctionL
 		ToolTip="使用指定的随机流从数组中随机选择指定数量的元素，严格保证选中次数与权重比例一致。\n使用说明：输入源数组、权重数组、采样数量和随机流，可以通过相同的随机流获得相同的采样结果"))
 	static void Array_StrictWeightRandomSampleFromStream(const TArray<int32>& InputArray, const TArray<float> Weights, int32 Count, UPARAM(Ref) FRandomStream& Stream, TArray<int32>& Result);
 
+	/** 
+	 * 原地均匀打乱数组（Fisher-Yates），直接交换数组元素，不创建新数组。
+	 *
+	 *@param	TargetArray		要打乱的数组
+	*/
+	UFUNCTION(BlueprintCallable, CustomThunk, meta=(DisplayName = "原地随机打乱", 
+		ArrayParm = "TargetArray", 
+		Category="XTools|随机", 
+		Keywords = "打乱,洗牌,Shuffle",
+		ToolTip="原地将数组均匀随机打乱, 不创建新数组也不分配内存. \n使用说明：直接修改传入的数组变量"))
+	static void Array_ShuffleInPlace(const TArray<int32>& TargetArray);
+
+	/** 
+	 * 使用指定的随机流原地均匀打乱数组（Fisher-Yates）。
+	 *
+	 *@param	TargetArray		要打乱的数组
+	 *@param	Stream			要使用的随机流，用于控制随机数生成
+	*/
+	UFUNCTION(BlueprintCallable, CustomThunk, meta=(DisplayName = "流送中的原地随机打乱", 
+		ArrayParm = "TargetArray", 
+		Category="XTools|随机", 
+		Keywords = "打乱,洗牌,Shuffle",
+		ToolTip="使用指定随机流原地将数组均匀随机打乱, 相同的随机流可获得相同的打乱结果"))
+	static void Array_ShuffleInPlaceFromStream(const TArray<int32>& TargetArray, UPARAM(Ref) FRandomStream& Stream);
+
+	/** 
+	 * 使用 xoshiro256** 快速64位随机数生成器原地均匀打乱数组，适合大数组。
+	 *
+	 *@param	TargetArray		要打乱的数组
+	 *@param	Seed			随机种子，相同种子得到相同结果；为0时使用随机种子
+	*/
+	UFUNCTION(BlueprintCallable, CustomThunk, meta=(DisplayName = "快速原地随机打乱", 
+		ArrayParm = "TargetArray", 
+		Category="XTools|随机", 
+		Keywords = "打乱,洗牌,Shuffle,xoshiro",
+		ToolTip="使用快速64位随机数生成器(xoshiro256**)原地打乱数组, 适合大数组. \n• 相同种子得到相同结果 \n• 种子为0时使用随机种子"))
+	static void Array_ShuffleInPlaceFast(const TArray<int32>& TargetArray, int64 Seed = 0);
+
+public:
+	/**
+	 * 由权重数组构建可复用的预处理加权分布。
+	 * 权重不变时只需构建一次，之后每次采样不再重新处理权重。
+	 *
+	 *@param	Weights			权重数组，必须全部有限且非负，并至少包含一个正权重
+	 *@param	Distribution	输出的预处理分布
+	 *@return	是否构建成功
+	*/
+	UFUNCTION(BlueprintCallable, Category="XTools|随机|预处理分布", meta=(
+		DisplayName = "构建预处理加权分布",
+		Keywords = "别名,Alias,掉落表,权重,预处理",
+		ToolTip="由权重数组构建可复用的加权分布(别名表+累积表). \n• 权重不变时只需构建一次 \n• 之后有放回采样每次O(1) \n• 适合掉落表等频繁采样同一组权重的场景"))
+	static bool PrepareWeightedDistribution(
+		UPARAM(DisplayName="权重数组") const TArray<float>& Weights,
+		UPARAM(DisplayName="预处理分布") FPreparedWeightedDistribution& Distribution);
+
+	/** 预处理分布是否可用 */
+	UFUNCTION(BlueprintPure, Category="XTools|随机|预处理分布", meta=(
+		DisplayName = "预处理分布是否有效",
+		ToolTip="预处理分布是否已成功构建"))
+	static bool IsWeightedDistributionValid(
+		UPARAM(DisplayName="预处理分布") const FPreparedWeightedDistribution& Distribution);
+
+	/** 获取预处理分布中指定索引被选中的概率 */
+	UFUNCTION(BlueprintPure, Category="XTools|随机|预处理分布", meta=(
+		DisplayName = "获取预处理分布概率",
+		ToolTip="获取指定索引在预处理分布中被选中的概率, 索引无效时返回0"))
+	static float GetWeightedDistributionProbability(
+		UPARAM(DisplayName="预处理分布") const FPreparedWeightedDistribution& Distribution,
+		UPARAM(DisplayName="索引") int32 Index);
+
+	/**
+	 * 从预处理分布中采样一个索引（别名法，O(1)）。
+	 *
+	 *@param	Distribution	预处理分布
+	 *@return	采样到的索引，分布无效时返回-1
+	*/
+	UFUNCTION(BlueprintCallable, Category="XTools|随机|预处理分布", meta=(
+		DisplayName = "预处理分布采样索引",
+		ToolTip="从预处理分布中按权重随机选择一个索引, 每次O(1). \n分布无效时返回-1"))
+	static int32 SampleIndexFromDistribution(
+		UPARAM(DisplayName="预处理分布") const FPreparedWeightedDistribution& Distribution);
+
+	/**
+	 * 使用指定的随机流从预处理分布中采样一个索引（别名法，O(1)）。
+	 *
+	 *@param	Distribution	预处理分布
+	 *@param	Stream			要使用的随机流，每次采样消耗两个随机数
+	 *@return	采样到的索引，分布无效时返回-1
+	*/
+	UFUNCTION(BlueprintCallable, Category="XTools|随机|预处理分布", meta=(
+		DisplayName = "流送预处理分布采样索引",
+		ToolTip="使用指定随机流从预处理分布中按权重随机选择一个索引, 每次O(1). \n相同的随机流可获得相同的结果, 分布无效时返回-1"))
+	static int32 SampleIndexFromDistributionFromStream(
+		UPARAM(DisplayName="预处理分布") const FPreparedWeightedDistribution& Distribution,
+		UPARAM(Ref, DisplayName="随机流") FRandomStream& Stream);
+
+	/**
+	 * 从预处理分布中批量采样索引。
+	 * 有放回时使用别名法，每个O(1)；无放回时使用Efraimidis-Spirakis随机键并只保留前Count个，结果按抽中顺序排列。
+	 *
+	 *@param	Distribution		预处理分布
+	 *@param	Count				采样数量，无放回时不超过正权重元素数量
+	 *@param	bWithReplacement	是否有放回
+	 *@param	Indices				输出的索引数组
+	*/
+	UFUNCTION(BlueprintCallable, Category="XTools|随机|预处理分布", meta=(
+		DisplayName = "预处理分布批量采样",
+		ToolTip="从预处理分布中按权重批量选择索引. \n• 有放回: 每个O(1), 可重复 \n• 无放回: 不重复, 按抽中顺序排列, 数量不超过正权重元素数量"))
+	static void SampleIndicesFromDistribution(
+		UPARAM(DisplayName="预处理分布") const FPreparedWeightedDistribution& Distribution,
+		UPARAM(DisplayName="采样数量") int32 Count,
+		UPARAM(DisplayName="有放回") bool bWithReplacement,
+		UPARAM(DisplayName="索引数组") TArray<int32>& Indices);
+
+	/**
+	 * 使用指定的随机流从预处理分布中批量采样索引。
+	 *
+	 *@param	Distribution		预处理分布
+	 *@param	Count				采样数量，无放回时不超过正权重元素数量
+	 *@param	bWithReplacement	是否有放回
+	 *@param	Stream				要使用的随机流
+	 *@param	Indices				输出的索引数组
+	*/
+	UFUNCTION(BlueprintCallable, Category="XTools|随机|预处理分布", meta=(
+		DisplayName = "流送预处理分布批量采样",
+		ToolTip="使用指定随机流从预处理分布中按权重批量选择索引, 相同的随机流可获得相同的结果. \n• 有放回: 每个O(1), 可重复 \n• 无放回: 不重复, 按抽中顺序排列"))
+	static void SampleIndicesFromDistributionFromStream(
+		UPARAM(DisplayName="预处理分布") const FPreparedWeightedDistribution& Distribution,
+		UPARAM(DisplayName="采样数量") int32 Count,
+		UPARAM(DisplayName="有放回") bool bWithReplacement,
+		UPARAM(Ref, DisplayName="随机流") FRandomStream& Stream,
+		UPARAM(DisplayName="索引数组") TArray<int32>& Indices);
+
 public:
 	/**
 	 * 使用PRD(伪随机分布)算法生成布尔值 - 简单版本，自动管理状态。
@@ -296,6 +390,109 @@ public:
 		ToolTip="清理所有PRD状态, 重置所有累积的失败次数. \n• 用于重大状态变化(玩家死亡、关卡切换、游戏重启) \n• 释放所有内存, 避免状态污染 \n• 让所有PRD系统重新开始"))
 	static void ClearAllPRDStates();
 
+	/**
+	 * 获取PRD句柄，同一 (所有者, 属性) 重复获取返回同一个句柄。
+	 * 句柄状态保存在所属世界的无锁存储中，之后每次判定不再做字符串查找和全局加锁。
+	 * 建议在初始化时获取一次并缓存，世界销毁时句柄自动失效。
+	 *
+	 *@param	Owner		状态所有者（如角色）
+	 *@param	StatName	属性名（如"暴击"、"闪避"）
+	 *@return	PRD句柄，获取失败时为无效句柄
+	*/
+	UFUNCTION(BlueprintCallable, Category="XTools|随机|PRD句柄", meta=(
+		WorldContext = "WorldContextObject",
+		DefaultToSelf = "Owner",
+		DisplayName = "获取PRD句柄",
+		Keywords = "PRD,句柄,暴击,闪避,高频",
+		ToolTip="为 (所有者, 属性) 获取PRD句柄, 用于高频PRD判定. \n• 获取一次并缓存, 之后每次判定只需一次原子操作 \n• 状态随世界销毁自动清理 \n• 适合每次命中都要判定的暴击、闪避等系统"))
+	static FPRDHandle AcquirePRDHandle(
+		const UObject* WorldContextObject,
+		UPARAM(DisplayName="所有者") UObject* Owner,
+		UPARAM(DisplayName="属性名") FName StatName);
+
+	/** 释放PRD句柄及其状态，释放后旧句柄失效 */
+	UFUNCTION(BlueprintCallable, Category="XTools|随机|PRD句柄", meta=(
+		DisplayName = "释放PRD句柄",
+		ToolTip="释放PRD句柄及其状态, 所有者销毁前调用可回收槽位"))
+	static void ReleasePRDHandle(
+		UPARAM(DisplayName="PRD句柄") const FPRDHandle& Handle);
+
+	/** PRD句柄是否仍然有效 */
+	UFUNCTION(BlueprintPure, Category="XTools|随机|PRD句柄", meta=(
+		DisplayName = "PRD句柄是否有效",
+		ToolTip="句柄所属世界仍存在且句柄未被释放时返回true"))
+	static bool IsPRDHandleValid(
+		UPARAM(DisplayName="PRD句柄") const FPRDHandle& Handle);
+
+	/** 清零PRD句柄的失败次数 */
+	UFUNCTION(BlueprintCallable, Category="XTools|随机|PRD句柄", meta=(
+		DisplayName = "重置PRD句柄状态",
+		ToolTip="清零句柄累积的失败次数, 用于换装备、技能重置等场景"))
+	static void ResetPRDHandle(
+		UPARAM(DisplayName="PRD句柄") const FPRDHandle& Handle);
+
+	/**
+	 * 使用PRD句柄执行PRD判定，状态由句柄自动维护。
+	 * 判定过程无锁且不做字符串处理，可在多个线程中并发调用。
+	 *
+	 *@param	Handle		PRD句柄
+	 *@param	BaseChance	基础触发概率[0,1]
+	 *@return	是否触发，句柄无效时返回false
+	*/
+	UFUNCTION(BlueprintCallable, Category="XTools|随机|PRD句柄", meta=(
+		DisplayName = "PRD句柄随机判定",
+		ToolTip="使用PRD句柄执行DOTA2 PRD判定, 状态由句柄维护. \n• 无锁、无字符串查找 \n• 句柄无效时返回false"))
+	static bool PseudoRandomBoolWithHandle(
+		UPARAM(DisplayName="PRD句柄") const FPRDHandle& Handle,
+		UPARAM(DisplayName="触发概率") float BaseChance);
+
+	/**
+	 * 使用PRD句柄和指定的随机流执行PRD判定。
+	 *
+	 *@param	Handle		PRD句柄
+	 *@param	BaseChance	基础触发概率[0,1]
+	 *@param	Stream		要使用的随机流，每次判定只消耗一个随机数
+	 *@return	是否触发，句柄无效时返回false
+	*/
+	UFUNCTION(BlueprintCallable, Category="XTools|随机|PRD句柄", meta=(
+		DisplayName = "流送PRD句柄随机判定",
+		ToolTip="使用PRD句柄和指定随机流执行DOTA2 PRD判定, 支持可重现的随机序列. \n句柄无效时返回false"))
+	static bool PseudoRandomBoolWithHandleFromStream(
+		UPARAM(DisplayName="PRD句柄") const FPRDHandle& Handle,
+		UPARAM(DisplayName="触发概率") float BaseChance,
+		UPARAM(Ref, DisplayName="随机流") FRandomStream& Stream);
+
+	/**
+	 * 批量PRD判定，一次遍历完成全部独立判定（如AoE命中的每个目标）。
+	 * 连续相同的概率只查一次PRD常数表，连续属于同一世界的句柄只解析一次存储。
+	 *
+	 *@param	Handles		PRD句柄数组
+	 *@param	Chances		基础触发概率，数量与句柄相同；只有一个元素时所有句柄共用该概率
+	 *@param	Results		输出判定结果，数量与句柄相同，无效句柄结果为false
+	 *@param	Stream		要使用的随机流，为空时使用全局随机源
+	*/
+	static void PseudoRandomBoolBatch(
+		TArrayView<const FPRDHandle> Handles,
+		TArrayView<const float> Chances,
+		TBitArray<>& Results,
+		FRandomStream* Stream = nullptr);
+
+	/**
+	 * 批量PRD判定（蓝图版本）。
+	 *
+	 *@param	Handles		PRD句柄数组
+	 *@param	Chances		基础触发概率，数量与句柄相同；只有一个元素时所有句柄共用该概率
+	 *@param	Results		输出判定结果
+	*/
+	UFUNCTION(BlueprintCallable, Category="XTools|随机|PRD句柄", meta=(
+		DisplayName = "PRD句柄批量判定",
+		Keywords = "PRD,批量,AoE,句柄",
+		ToolTip="一次完成多个PRD句柄的独立判定, 适合AoE每帧对大量目标判定. \n• 概率数组只有一个元素时所有句柄共用该概率 \n• 无效句柄的结果为false"))
+	static void PseudoRandomBoolBatchWithHandles(
+		UPARAM(DisplayName="PRD句柄数组") const TArray<FPRDHandle>& Handles,
+		UPARAM(DisplayName="触发概率数组") const TArray<float>& Chances,
+		UPARAM(DisplayName="判定结果") TArray<bool>& Results);
+
 	static void GenericArray_RandomSample(
         void* InputArray, const FArrayProperty* ArrayProp, 
         void* Weights, const FArrayProperty* WeightsProp, 
@@ -308,6 +505,12 @@ public:
         int32 Count, FRandomStream* Stream,
         void* OutputArray, FArrayProperty* OutputProp);
 
+	/** 原地打乱任意类型数组，Stream 为空时使用全局随机源 */
+	static void GenericArray_ShuffleInPlace(void* TargetArray, const FArrayProperty* ArrayProp, FRandomStream* Stream);
+
+	/** 使用 xoshiro256** 原地打乱任意类型数组，Seed 为0时使用随机种子 */
+	static void GenericArray_ShuffleInPlaceFast(void* TargetArray, const FArrayProperty* ArrayProp, int64 Seed);
+
 public:
 
     DECLARE_FUNCTION(execArray_UnweightedRandomSample)
@@ -501,6 +704,66 @@ public:
 		P_NATIVE_END;
 	}
 
+	DECLARE_FUNCTION(execArray_ShuffleInPlace)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(NULL);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+		FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericArray_ShuffleInPlace(ArrayAddr, ArrayProperty, nullptr);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execArray_ShuffleInPlaceFromStream)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(NULL);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+		FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FProperty>(nullptr);
+		FRandomStream* RandomStream = (FRandomStream*)Stack.MostRecentPropertyAddress;
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericArray_ShuffleInPlace(ArrayAddr, ArrayProperty, RandomStream);
+		P_NATIVE_END;
+	}
+
+	DECLARE_FUNCTION(execArray_ShuffleInPlaceFast)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(NULL);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+		FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_PROPERTY(FInt64Property, Seed);
+
+		P_FINISH;
+		P_NATIVE_BEGIN;
+		GenericArray_ShuffleInPlaceFast(ArrayAddr, ArrayProperty, Seed);
+		P_NATIVE_END;
+	}
+
 	DECLARE_FUNCTION(execArray_StrictWeightRandomSample)
 	{
 		Stack.MostRecentProperty = nullptr;
@@ -584,6 +847,24 @@ public:
 		ToolTip = "重置PRD算法的性能统计计数器"))
 	static void ResetPRDPerformanceStats();
 
+	/**
+	 * 获取当前世界PRD句柄的统计信息（按线程分片汇总）
+	 * StateMapSize 为已分配的句柄数量，AverageFailureCount 为全部调用的平均失败次数
+	 */
+	UFUNCTION(BlueprintCallable, Category = "XTools|随机|调试", meta = (
+		WorldContext = "WorldContextObject",
+		DisplayName = "获取PRD句柄统计",
+		ToolTip = "获取当前世界PRD句柄的统计信息，用于性能监控和调试",
+		ReturnDisplayName = "性能统计数据"))
+	static FPRDPerformanceStats GetPRDHandleStats(const UObject* WorldContextObject);
+
+	/** 重置当前世界PRD句柄的统计 */
+	UFUNCTION(BlueprintCallable, Category = "XTools|随机|调试", meta = (
+		WorldContext = "WorldContextObject",
+		DisplayName = "重置PRD句柄统计",
+		ToolTip = "重置当前世界PRD句柄的统计计数器"))
+	static void ResetPRDHandleStats(const UObject* WorldContextObject);
+
  private:
 	// PRD状态管理 - 线程安全的状态管理系统
 	static TMap<FName, int32> PRDStateMap;
@@ -0,0 +1,65 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "XToolsVersionCompat.h"
+
+namespace RandomShuffles {
+
+/**
+ * 线程局部的临时数组
+ * 构造时从当前线程的缓冲池借出一个数组，析构时归还并保留容量，
+ * 采样、打乱等函数反复调用时不再为临时数据分配内存。
+ * 支持嵌套使用（每个实例借出独立的数组），过大的数组归还时直接释放，避免长期占用内存。
+ */
+template<typename T>
+class TScratchArray
+{
+public:
+	/** 归还时保留容量的上限（字节） */
+	static constexpr SIZE_T MaxRetainedBytes = 4 * 1024 * 1024;
+
+	TScratchArray()
+	{
+		TArray<TArray<T>>& Pool = GetPool();
+		if (Pool.Num() > 0)
+		{
+#if XTOOLS_ENGINE_5_8_OR_LATER
+			Array = Pool.Pop(EAllowShrinking::No);
+#else
+			Array = Pool.Pop(false);
+#endif
+		}
+	}
+
+	~TScratchArray()
+	{
+		if (static_cast<SIZE_T>(Array.Max()) * sizeof(T) <= MaxRetainedBytes)
+		{
+			Array.Reset();
+			GetPool().Add(MoveTemp(Array));
+		}
+	}
+
+	TScratchArray(const TScratchArray&) = delete;
+	TScratchArray& operator=(const TScratchArray&) = delete;
+
+	TArray<T>& Get() { return Array; }
+	TArray<T>* operator->() { return &Array; }
+	TArray<T>& operator*() { return Array; }
+
+private:
+	static TArray<TArray<T>>& GetPool()
+	{
+		static thread_local TArray<TArray<T>> Pool;
+		return Pool;
+	}
+
+	TArray<T> Array;
+};
+
+}
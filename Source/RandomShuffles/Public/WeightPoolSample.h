@@ -1,9 +1,68 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "RandomShuffleScratch.h"
 
 namespace RandomShuffles {
 
+/**
+ * 最大余数法分配名额：每个元素先取 floor(配额)，剩余名额按小数部分从大到小补足。
+ * 结果总和严格等于 count，且每个元素与精确配额的差都小于1。
+ * 复杂度 O(N log N)（只对有余数的候选排序），不再反复扫描最大值。
+ */
+inline void ApportionLargestRemainder(const TArray<float>& weights, double totalWeight, int32 count, TArray<int32>& outCounts) {
+    const int32 sampleSize = weights.Num();
+    outCounts.SetNumUninitialized(sampleSize);
+
+    TScratchArray<TPair<double, int32>> remainders;
+    remainders->Reserve(sampleSize);
+
+    int64 assigned = 0;
+    for(int32 idx = 0; idx < sampleSize; ++idx) {
+        const float weight = weights[idx];
+        if(weight <= 0.0f) {
+            outCounts[idx] = 0;
+            continue;
+        }
+
+        const double quota = static_cast<double>(weight) / totalWeight * count;
+        const double floorQuota = FMath::FloorToDouble(quota);
+        outCounts[idx] = static_cast<int32>(floorQuota);
+        assigned += outCounts[idx];
+        remainders->Emplace(quota - floorQuota, idx);
+    }
+
+    int32 remaining = static_cast<int32>(count - assigned);
+    if(remaining == 0) {
+        return;
+    }
+
+    // 浮点误差导致 floor 之和超出时，从余数最小（最接近向下取整）的元素扣回
+    if(remaining < 0) {
+        remainders->Sort([](const TPair<double, int32>& a, const TPair<double, int32>& b) {
+            return a.Key < b.Key || (a.Key == b.Key && a.Value > b.Value);
+        });
+        for(int32 i = 0; remaining < 0 && i < remainders->Num(); ++i) {
+            int32& expected = outCounts[(*remainders)[i].Value];
+            if(expected > 0) {
+                --expected;
+                ++remaining;
+            }
+        }
+        return;
+    }
+
+    // 余数相同时优先索引小的元素，保证结果可重现
+    remainders->Sort([](const TPair<double, int32>& a, const TPair<double, int32>& b) {
+        return a.Key > b.Key || (a.Key == b.Key && a.Value < b.Value);
+    });
+
+    // remaining 理论上小于候选数量，浮点误差时循环分配
+    for(int32 i = 0; remaining > 0; i = (i + 1) % remainders->Num(), --remaining) {
+        ++outCounts[(*remainders)[i].Value];
+    }
+}
+
 template<typename It, typename Wt, typename Out, typename Rand>
 Out WeightPoolSample(It begin, It end, Wt weightBegin, Out out, int32 count, Rand randFunc) {
     //  使用UE兼容的迭代器计算方式
@@ -12,98 +71,53 @@ Out WeightPoolSample(It begin, It end, Wt weightBegin, Out out, int32 count, Ran
         ++sampleSize;
     }
 
-    //  使用UE容器替代STL - 计算权重总和并存储权重
-    TArray<float> weights;
-    weights.Reserve(sampleSize);
-    float totalWeight = 0.0f;
+    // 临时数据从线程局部缓冲区借用，反复调用时不再分配
+    TScratchArray<float> weights;
+    weights->SetNumUninitialized(sampleSize);
+    double totalWeight = 0.0;
     
     // 保存权重并计算总和
     for(int32 idx = 0; idx < sampleSize; ++idx) {
-        float weight = static_cast<float>(*weightBegin++);
-        weights.Add(weight);  //  使用UE容器方法
+        const float weight = static_cast<float>(*weightBegin++);
+        (*weights)[idx] = weight;
         if(weight > 0.0f) {
             totalWeight += weight;
         }
     }
     
-    if(totalWeight <= 0.0f || count == 0) {
+    if(totalWeight <= 0.0 || count <= 0) {
         return out;
     }
 
-    //  使用UE容器 - 计算每个元素应该出现的次数
-    TArray<int32> expectedCounts;
-    expectedCounts.Reserve(sampleSize);
-    int32 totalCount = 0;
-
-    for(int32 idx = 0; idx < sampleSize; ++idx) {
-        float weight = weights[idx];
-        // 计算期望的出现次数，四舍五入
-        int32 expectedCount = static_cast<int32>((weight / totalWeight) * count + 0.5f);
-        expectedCounts.Add(expectedCount);  //  使用UE容器方法
-        totalCount += expectedCount;
-    }
-
-    //  使用UE算法 - 调整总数以匹配要求的count
-    while(totalCount > count) {
-        // 找到最大的非零计数并减1
-        int32 maxIdx = 0;
-        int32 maxValue = expectedCounts[0];
-        for(int32 i = 1; i < expectedCounts.Num(); ++i) {
-            if(expectedCounts[i] > maxValue) {
-                maxValue = expectedCounts[i];
-                maxIdx = i;
-            }
-        }
-        if(maxValue > 0) {
-            expectedCounts[maxIdx]--;
-            totalCount--;
-        } else {
-            break; // 防止无限循环
-        }
-    }
-
-    // 预先找到权重最大的元素索引，避免重复查找
-    int32 maxWeightIdx = 0;
-    if(totalCount < count) {
-        float maxWeight = weights[0];
-        for(int32 i = 1; i < sampleSize; ++i) {
-            if(weights[i] > maxWeight) {
-                maxWeight = weights[i];
-                maxWeightIdx = i;
-            }
-        }
-    }
-
-    while(totalCount < count) {
-        expectedCounts[maxWeightIdx]++;
-        totalCount++;
-    }
-
-    //  使用UE容器 - 创建结果数组
-    TArray<int32> resultIndices;
-    resultIndices.Reserve(count);
+    // 计算每个元素应该出现的次数
+    TScratchArray<int32> expectedCounts;
+    ApportionLargestRemainder(*weights, totalWeight, count, *expectedCounts);
 
-    // 按照计算的次数添加索引
+    // 按照计算的次数填充索引
+    TScratchArray<int32> resultIndices;
+    resultIndices->SetNumUninitialized(count);
+    int32 writeIdx = 0;
     for(int32 idx = 0; idx < sampleSize; ++idx) {
-        for(int32 j = 0; j < expectedCounts[idx]; ++j) {
-            resultIndices.Add(idx);  //  使用UE容器方法
+        for(int32 j = 0; j < (*expectedCounts)[idx]; ++j) {
+            (*resultIndices)[writeIdx++] = idx;
         }
     }
 
-    //  使用UE算法 - 打乱结果数组
-    for(int32 i = resultIndices.Num() - 1; i > 0; --i) {
+    // Fisher-Yates 打乱结果
+    int32* indices = resultIndices->GetData();
+    for(int32 i = count - 1; i > 0; --i) {
         float r = randFunc(0.0f, 1.0f);
         int32 j = static_cast<int32>(r * (i + 1));
         if(j > i) j = i;
-        resultIndices.Swap(i, j);  //  使用UE容器方法
+        Swap(indices[i], indices[j]);
     }
 
     // 输出结果
-    for(int32 idx : resultIndices) {
-        *out++ = *(begin + idx);  // 使用 operator+ 替代 std::next (O(1))
+    for(int32 i = 0; i < count; ++i) {
+        *out++ = *(begin + indices[i]);  // 使用 operator+ 替代 std::next (O(1))
     }
     
     return out;
 }
 
-} 
\ No newline at end of file
+} 
@@ -10,6 +10,7 @@
 #include "UObject/UnrealType.h"
 #include "UObject/TextProperty.h"
 #include "Algo/Reverse.h"
+#include "Async/ParallelFor.h"
 #include "SortAPI.h"
 #include "XToolsErrorReporter.h"
 #include "XToolsVersionCompat.h"
@@ -440,6 +441,303 @@ void USortLibrary::SortActorsByAngleAndDistance(const TArray<AActor*>& Actors, c
     }
 }
 
+//~ Actor Top-K 查询函数
+// =================================================================================================
+
+namespace SortLibrary_Private
+{
+    /** 有效Actor的位置，按SoA布局存放以便批量计算距离 */
+    struct FActorLocationSoA
+    {
+        TArray<float> X;
+        TArray<float> Y;
+        TArray<float> Z;
+        TArray<int32> SourceIndices;
+
+        int32 Num() const { return SourceIndices.Num(); }
+    };
+
+    /**
+     * 收集有效Actor的位置。
+     * CachedLocations 数量与 Actors 一致时直接使用缓存位置，否则逐个调用 GetActorLocation。
+     */
+    void GatherActorLocations(const TArray<AActor*>& Actors, const TArray<FVector>& CachedLocations, FActorLocationSoA& Out)
+    {
+        const bool bUseCache = CachedLocations.Num() == Actors.Num();
+        if (!bUseCache && CachedLocations.Num() > 0)
+        {
+            UE_LOG(LogSort, Warning, TEXT("预计算位置数量(%d)与Actor数量(%d)不一致，已忽略缓存位置"),
+                CachedLocations.Num(), Actors.Num());
+        }
+
+        Out.X.Reset(Actors.Num());
+        Out.Y.Reset(Actors.Num());
+        Out.Z.Reset(Actors.Num());
+        Out.SourceIndices.Reset(Actors.Num());
+
+        for (int32 i = 0; i < Actors.Num(); ++i)
+        {
+            if (!IsValid(Actors[i]))
+            {
+                continue;
+            }
+
+            const FVector ActorLocation = bUseCache ? CachedLocations[i] : Actors[i]->GetActorLocation();
+            Out.X.Add(static_cast<float>(ActorLocation.X));
+            Out.Y.Add(static_cast<float>(ActorLocation.Y));
+            Out.Z.Add(static_cast<float>(ActorLocation.Z));
+            Out.SourceIndices.Add(i);
+        }
+    }
+
+    /** 对SoA位置批量计算到原点的距离平方，每次处理4个元素 */
+    void ComputeSquaredDistances(const FActorLocationSoA& Locations, const FVector& Origin, bool b2D, TArray<float>& OutDistSq)
+    {
+        const int32 Num = Locations.Num();
+        OutDistSq.SetNumUninitialized(Num);
+
+        const float* XData = Locations.X.GetData();
+        const float* YData = Locations.Y.GetData();
+        const float* ZData = Locations.Z.GetData();
+        float* OutData = OutDistSq.GetData();
+
+        const VectorRegister4Float OriginX = VectorSetFloat1(static_cast<float>(Origin.X));
+        const VectorRegister4Float OriginY = VectorSetFloat1(static_cast<float>(Origin.Y));
+        const VectorRegister4Float OriginZ = VectorSetFloat1(static_cast<float>(Origin.Z));
+
+        int32 i = 0;
+        for (; i + 4 <= Num; i += 4)
+        {
+            const VectorRegister4Float DX = VectorSubtract(VectorLoad(XData + i), OriginX);
+            const VectorRegister4Float DY = VectorSubtract(VectorLoad(YData + i), OriginY);
+            VectorRegister4Float DistSq = VectorMultiplyAdd(DX, DX, VectorMultiply(DY, DY));
+            if (!b2D)
+            {
+                const VectorRegister4Float DZ = VectorSubtract(VectorLoad(ZData + i), OriginZ);
+                DistSq = VectorMultiplyAdd(DZ, DZ, DistSq);
+            }
+            VectorStore(DistSq, OutData + i);
+        }
+
+        for (; i < Num; ++i)
+        {
+            const float DX = XData[i] - static_cast<float>(Origin.X);
+            const float DY = YData[i] - static_cast<float>(Origin.Y);
+            const float DZ = b2D ? 0.0f : ZData[i] - static_cast<float>(Origin.Z);
+            OutData[i] = DX * DX + DY * DY + DZ * DZ;
+        }
+    }
+
+    /** 有界堆中的候选项，Key 相同时按原始索引打破并列以保证结果确定 */
+    struct FTopKEntry
+    {
+        float Key;
+        int32 Slot;
+        int32 OriginalIndex;
+
+        bool operator<(const FTopKEntry& Other) const
+        {
+            if (Key != Other.Key)
+            {
+                return Key < Other.Key;
+            }
+            return OriginalIndex < Other.OriginalIndex;
+        }
+    };
+
+    /**
+     * 有界最大堆：只保留Key最小的K个候选，复杂度O(N log K)。
+     * 结束时按Key升序输出。
+     */
+    class FBoundedTopK
+    {
+    public:
+        explicit FBoundedTopK(int32 InK)
+            : K(InK)
+        {
+            Heap.Reserve(InK);
+        }
+
+        void Offer(const FTopKEntry& Entry)
+        {
+            if (K <= 0)
+            {
+                return;
+            }
+            if (Heap.Num() < K)
+            {
+                Heap.HeapPush(Entry, FGreater());
+            }
+            else if (Entry < Heap.HeapTop())
+            {
+#if XTOOLS_ENGINE_5_8_OR_LATER
+                Heap.HeapPopDiscard(FGreater(), EAllowShrinking::No);
+#else
+                Heap.HeapPopDiscard(FGreater(), false);
+#endif
+                Heap.HeapPush(Entry, FGreater());
+            }
+        }
+
+        TArray<FTopKEntry>& Finish()
+        {
+            Heap.Sort();
+            return Heap;
+        }
+
+    private:
+        // TArray 的堆以谓词"较小"者为堆顶，反向谓词即得到最大堆
+        struct FGreater
+        {
+            bool operator()(const FTopKEntry& A, const FTopKEntry& B) const { return B < A; }
+        };
+
+        int32 K;
+        TArray<FTopKEntry> Heap;
+    };
+} // namespace SortLibrary_Private
+
+void USortLibrary::FindNearestKActors(const TArray<AActor*>& Actors, const FVector& Location, int32 K, float MaxDistance,
+    const TArray<FVector>& CachedLocations, TArray<AActor*>& NearestActors, TArray<int32>& OriginalIndices,
+    TArray<float>& Distances, bool b2DDistance)
+{
+    NearestActors.Reset();
+    OriginalIndices.Reset();
+    Distances.Reset();
+    if (K <= 0 || Actors.IsEmpty())
+    {
+        return;
+    }
+
+    SortLibrary_Private::FActorLocationSoA Locations;
+    SortLibrary_Private::GatherActorLocations(Actors, CachedLocations, Locations);
+
+    TArray<float> DistSq;
+    SortLibrary_Private::ComputeSquaredDistances(Locations, Location, b2DDistance, DistSq);
+
+    const bool bLimitRadius = MaxDistance > 0.0f;
+    const float MaxDistSq = MaxDistance * MaxDistance;
+
+    SortLibrary_Private::FBoundedTopK TopK(FMath::Min(K, Locations.Num()));
+    for (int32 Slot = 0; Slot < Locations.Num(); ++Slot)
+    {
+        if (bLimitRadius && DistSq[Slot] > MaxDistSq)
+        {
+            continue;
+        }
+        TopK.Offer({DistSq[Slot], Slot, Locations.SourceIndices[Slot]});
+    }
+
+    const TArray<SortLibrary_Private::FTopKEntry>& Result = TopK.Finish();
+    NearestActors.Reserve(Result.Num());
+    OriginalIndices.Reserve(Result.Num());
+    Distances.Reserve(Result.Num());
+    for (const SortLibrary_Private::FTopKEntry& Entry : Result)
+    {
+        NearestActors.Add(Actors[Entry.OriginalIndex]);
+        OriginalIndices.Add(Entry.OriginalIndex);
+        Distances.Add(FMath::Sqrt(Entry.Key));
+    }
+}
+
+void USortLibrary::FindActorsInConeTopK(const TArray<AActor*>& Actors, const FVector& Center, const FVector& Direction,
+    float MaxAngle, float MaxDistance, float AngleWeight, float DistanceWeight, int32 K,
+    const TArray<FVector>& CachedLocations, TArray<AActor*>& SelectedActors, TArray<int32>& OriginalIndices,
+    TArray<float>& Angles, TArray<float>& Distances, bool b2DAngle)
+{
+    SelectedActors.Reset();
+    OriginalIndices.Reset();
+    Angles.Reset();
+    Distances.Reset();
+    if (K <= 0 || Actors.IsEmpty())
+    {
+        return;
+    }
+
+    SortLibrary_Private::FActorLocationSoA Locations;
+    SortLibrary_Private::GatherActorLocations(Actors, CachedLocations, Locations);
+
+    TArray<float> DistSq;
+    SortLibrary_Private::ComputeSquaredDistances(Locations, Center, b2DAngle, DistSq);
+
+    const FVector NormalizedDirection = b2DAngle ? FVector(Direction.X, Direction.Y, 0).GetSafeNormal() : Direction.GetSafeNormal();
+    const bool bLimitRadius = MaxDistance > 0.0f;
+    const float MaxDistSq = MaxDistance * MaxDistance;
+
+    // 第一遍: 过滤并计算夹角与距离（与 SortActorsByAngleAndDistance 的计算方式保持一致）
+    TArray<int32> CandidateSlots;
+    TArray<float> CandidateAngles;
+    TArray<float> CandidateDistances;
+    CandidateSlots.Reserve(Locations.Num());
+    CandidateAngles.Reserve(Locations.Num());
+    CandidateDistances.Reserve(Locations.Num());
+
+    float MaxFoundAngle = 0.0f;
+    float MaxFoundDistance = 0.0f;
+    for (int32 Slot = 0; Slot < Locations.Num(); ++Slot)
+    {
+        if (bLimitRadius && DistSq[Slot] > MaxDistSq)
+        {
+            continue;
+        }
+
+        FVector ToActor(Locations.X[Slot] - Center.X, Locations.Y[Slot] - Center.Y, b2DAngle ? 0.0 : Locations.Z[Slot] - Center.Z);
+        ToActor.Normalize();
+        const float Dot = FVector::DotProduct(NormalizedDirection, ToActor);
+        float Angle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(Dot, -1.0f, 1.0f)));
+        if (b2DAngle)
+        {
+            const float CrossZ = NormalizedDirection.X * ToActor.Y - NormalizedDirection.Y * ToActor.X;
+            if (CrossZ < 0.0f) Angle = 360.0f - Angle;
+        }
+        if (MaxAngle > 0.0f && Angle > MaxAngle)
+        {
+            continue;
+        }
+
+        const float Distance = FMath::Sqrt(DistSq[Slot]);
+        CandidateSlots.Add(Slot);
+        CandidateAngles.Add(Angle);
+        CandidateDistances.Add(Distance);
+        MaxFoundAngle = FMath::Max(MaxFoundAngle, Angle);
+        MaxFoundDistance = FMath::Max(MaxFoundDistance, Distance);
+    }
+
+    if (CandidateSlots.IsEmpty())
+    {
+        return;
+    }
+
+    // 第二遍: 归一化评分并维护有界堆
+    if (FMath::IsNearlyZero(MaxFoundAngle)) MaxFoundAngle = 1.0f;
+    if (FMath::IsNearlyZero(MaxFoundDistance)) MaxFoundDistance = 1.0f;
+
+    const float TotalWeight = AngleWeight + DistanceWeight;
+    const bool bUseDefaultScore = FMath::IsNearlyZero(TotalWeight);
+
+    SortLibrary_Private::FBoundedTopK TopK(FMath::Min(K, CandidateSlots.Num()));
+    for (int32 Candidate = 0; Candidate < CandidateSlots.Num(); ++Candidate)
+    {
+        const float NormAngle = CandidateAngles[Candidate] / MaxFoundAngle;
+        const float NormDistance = CandidateDistances[Candidate] / MaxFoundDistance;
+        const float Score = bUseDefaultScore ? NormAngle : (NormAngle * AngleWeight + NormDistance * DistanceWeight) / TotalWeight;
+        TopK.Offer({Score, Candidate, Locations.SourceIndices[CandidateSlots[Candidate]]});
+    }
+
+    const TArray<SortLibrary_Private::FTopKEntry>& Result = TopK.Finish();
+    SelectedActors.Reserve(Result.Num());
+    OriginalIndices.Reserve(Result.Num());
+    Angles.Reserve(Result.Num());
+    Distances.Reserve(Result.Num());
+    for (const SortLibrary_Private::FTopKEntry& Entry : Result)
+    {
+        SelectedActors.Add(Actors[Entry.OriginalIndex]);
+        OriginalIndices.Add(Entry.OriginalIndex);
+        Angles.Add(CandidateAngles[Entry.Slot]);
+        Distances.Add(CandidateDistances[Entry.Slot]);
+    }
+}
+
 //~ 基础类型排序函数
 // =================================================================================================
 
@@ -882,28 +1180,194 @@ void USortLibrary::RemoveDuplicateStrings(const TArray<FString>& InArray, TArray
     }
 }
 
-void USortLibrary::RemoveDuplicateVectors(const TArray<FVector>& InArray, TArray<FVector>& OutArray, float Tolerance)
+namespace SortLibrary_Private
 {
-    OutArray.Empty();
-    if (InArray.IsEmpty()) return;
+    /** 超过该数量时并行量化向量与查询邻居 */
+    constexpr int32 VectorDedupParallelThreshold = 100000;
 
-    TArray<FVector> SortedCopy = InArray;
-    SortedCopy.Sort([](const FVector& A, const FVector& B) {
-        if (A.X != B.X) return A.X < B.X;
-        if (A.Y != B.Y) return A.Y < B.Y;
-        return A.Z < B.Z;
-    });
+    /** 网格坐标，使用 int64 避免极小容差下的溢出 */
+    struct FVectorCellKey
+    {
+        int64 X;
+        int64 Y;
+        int64 Z;
 
-    OutArray.Reserve(SortedCopy.Num());
-    OutArray.Add(SortedCopy[0]);
-    for (int32 i = 1; i < SortedCopy.Num(); ++i)
+        bool operator==(const FVectorCellKey& Other) const
+        {
+            return X == Other.X && Y == Other.Y && Z == Other.Z;
+        }
+
+        friend uint32 GetTypeHash(const FVectorCellKey& Key)
+        {
+            return HashCombine(HashCombine(GetTypeHash(Key.X), GetTypeHash(Key.Y)), GetTypeHash(Key.Z));
+        }
+    };
+
+    /**
+     * 以容差为格子大小的空间哈希。
+     * 各分量差值不超过容差的两个点必然落在彼此周围的27个格子内，因此只需检查相邻格子即可得到精确的容差判定。
+     * 构造时量化全部点（大数组并行），但只有通过 Insert 加入的点才能被查询到。
+     */
+    class FVectorSpatialHash
     {
-        if (!SortedCopy[i].Equals(OutArray.Last(), Tolerance))
+    public:
+        FVectorSpatialHash(const TArray<FVector>& InPoints, float InTolerance)
+            : Points(InPoints)
+            , Tolerance(FMath::Max(InTolerance, 0.0f))
         {
-            OutArray.Add(SortedCopy[i]);
+            // 格子略大于容差，防止边界上的浮点舍入把容差内的点分到相隔两格的位置
+            const double CellSize = FMath::Max(static_cast<double>(Tolerance), UE_KINDA_SMALL_NUMBER) * 1.0001;
+            InvCellSize = 1.0 / CellSize;
+
+            const int32 Num = Points.Num();
+            Keys.SetNumUninitialized(Num);
+            NextInCell.Init(INDEX_NONE, Num);
+
+            if (Num > VectorDedupParallelThreshold)
+            {
+                ParallelFor(Num, [this](int32 Index) { Keys[Index] = ToCell(Points[Index]); });
+            }
+            else
+            {
+                for (int32 Index = 0; Index < Num; ++Index)
+                {
+                    Keys[Index] = ToCell(Points[Index]);
+                }
+            }
         }
+
+        void Reserve(int32 NumCells)
+        {
+            CellHeads.Reserve(NumCells);
+        }
+
+        void Insert(int32 Index)
+        {
+            int32& Head = CellHeads.FindOrAdd(Keys[Index], INDEX_NONE);
+            NextInCell[Index] = Head;
+            Head = Index;
+        }
+
+        /** 遍历点 Index 周围27个格子中已插入的所有点（可能包含自身） */
+        template<typename FuncType>
+        void ForEachNeighbour(int32 Index, FuncType&& Func) const
+        {
+            const FVectorCellKey& Center = Keys[Index];
+            for (int64 DX = -1; DX <= 1; ++DX)
+            {
+                for (int64 DY = -1; DY <= 1; ++DY)
+                {
+                    for (int64 DZ = -1; DZ <= 1; ++DZ)
+                    {
+                        const int32* Head = CellHeads.Find({Center.X + DX, Center.Y + DY, Center.Z + DZ});
+                        for (int32 Other = Head ? *Head : INDEX_NONE; Other != INDEX_NONE; Other = NextInCell[Other])
+                        {
+                            Func(Other);
+                        }
+                    }
+                }
+            }
+        }
+
+        bool IsWithinTolerance(int32 A, int32 B) const
+        {
+            return Points[A].Equals(Points[B], Tolerance);
+        }
+
+    private:
+        FVectorCellKey ToCell(const FVector& Point) const
+        {
+            return {
+                static_cast<int64>(FMath::FloorToDouble(Point.X * InvCellSize)),
+                static_cast<int64>(FMath::FloorToDouble(Point.Y * InvCellSize)),
+                static_cast<int64>(FMath::FloorToDouble(Point.Z * InvCellSize))
+            };
+        }
+
+        const TArray<FVector>& Points;
+        float Tolerance;
+        double InvCellSize = 1.0;
+        TArray<FVectorCellKey> Keys;
+        TArray<int32> NextInCell;
+        TMap<FVectorCellKey, int32> CellHeads;
+    };
+
+    /**
+     * 按输入顺序贪心分组：每个点归入容差内最早出现的代表点所在的组，否则成为新组的代表。
+     * 组ID按首次出现顺序分配，OutRepresentatives[GroupId] 为该组代表点的原始索引。
+     */
+    void BuildVectorGroups(const TArray<FVector>& Points, float Tolerance, TArray<int32>& OutGroupIds, TArray<int32>& OutRepresentatives)
+    {
+        const int32 Num = Points.Num();
+        OutGroupIds.SetNumUninitialized(Num);
+        OutRepresentatives.Reset();
+
+        // 只有代表点进入哈希，查询代价与重复程度无关
+        FVectorSpatialHash Hash(Points, Tolerance);
+        Hash.Reserve(Num);
+
+        for (int32 Index = 0; Index < Num; ++Index)
+        {
+            int32 BestGroup = INDEX_NONE;
+            Hash.ForEachNeighbour(Index, [&](int32 Representative)
+            {
+                const int32 Group = OutGroupIds[Representative];
+                if ((BestGroup == INDEX_NONE || Group < BestGroup) && Hash.IsWithinTolerance(Index, Representative))
+                {
+                    BestGroup = Group;
+                }
+            });
+
+            if (BestGroup == INDEX_NONE)
+            {
+                BestGroup = OutRepresentatives.Add(Index);
+                Hash.Insert(Index);
+            }
+            OutGroupIds[Index] = BestGroup;
+        }
+    }
+} // namespace SortLibrary_Private
+
+void USortLibrary::RemoveDuplicateVectors(const TArray<FVector>& InArray, TArray<FVector>& OutArray, float Tolerance, bool bPreserveOrder)
+{
+    OutArray.Empty();
+    if (InArray.IsEmpty()) return;
+
+    TArray<int32> GroupIds;
+    TArray<int32> Representatives;
+    SortLibrary_Private::BuildVectorGroups(InArray, Tolerance, GroupIds, Representatives);
+
+    OutArray.Reserve(Representatives.Num());
+    for (const int32 Index : Representatives)
+    {
+        OutArray.Add(InArray[Index]);
+    }
+
+    if (!bPreserveOrder)
+    {
+        // 保持旧版本的输出顺序：按坐标字典序，只对去重后的结果排序
+        OutArray.Sort([](const FVector& A, const FVector& B) {
+            if (A.X != B.X) return A.X < B.X;
+            if (A.Y != B.Y) return A.Y < B.Y;
+            return A.Z < B.Z;
+        });
+    }
+}
+
+void USortLibrary::GroupDuplicateVectors(const TArray<FVector>& InArray, TArray<int32>& GroupIds, TArray<FVector>& UniqueVectors, float Tolerance)
+{
+    GroupIds.Empty();
+    UniqueVectors.Empty();
+    if (InArray.IsEmpty()) return;
+
+    TArray<int32> Representatives;
+    SortLibrary_Private::BuildVectorGroups(InArray, Tolerance, GroupIds, Representatives);
+
+    UniqueVectors.Reserve(Representatives.Num());
+    for (const int32 Index : Representatives)
+    {
+        UniqueVectors.Add(InArray[Index]);
     }
-    OutArray.Shrink();
 }
 
 void USortLibrary::FindDuplicateVectors(const TArray<FVector>& InArray, TArray<int32>& DuplicateIndices, TArray<FVector>& DuplicateValues, float Tolerance)
@@ -912,38 +1376,42 @@ void USortLibrary::FindDuplicateVectors(const TArray<FVector>& InArray, TArray<i
     DuplicateValues.Empty();
     if (InArray.Num() < 2) return;
 
-    struct FVectorIndexPair { FVector Vector; int32 Index; };
-    TArray<FVectorIndexPair> Pairs;
-    Pairs.Reserve(InArray.Num());
-    for(int32 i=0; i<InArray.Num(); ++i)
+    const int32 Num = InArray.Num();
+    SortLibrary_Private::FVectorSpatialHash Hash(InArray, Tolerance);
+    Hash.Reserve(Num);
+    for (int32 Index = 0; Index < Num; ++Index)
     {
-        Pairs.Add({InArray[i], i});
+        Hash.Insert(Index);
     }
 
-    Pairs.Sort([](const FVectorIndexPair& A, const FVectorIndexPair& B) {
-        const FVector& V1 = A.Vector;
-        const FVector& V2 = B.Vector;
-        if (V1.X != V2.X) return V1.X < V2.X;
-        if (V1.Y != V2.Y) return V1.Y < V2.Y;
-        return V1.Z < V2.Z;
-    });
-
+    // 哈希构建完成后只读，查询可以安全并行
     TArray<bool> IsDuplicate;
-    IsDuplicate.Init(false, InArray.Num());
-    bool bInDuplicateGroup = false;
+    IsDuplicate.Init(false, Num);
+    auto CheckPoint = [&Hash, &IsDuplicate](int32 Index)
+    {
+        bool bFound = false;
+        Hash.ForEachNeighbour(Index, [&](int32 Other)
+        {
+            bFound = bFound || (Other != Index && Hash.IsWithinTolerance(Index, Other));
+        });
+        IsDuplicate[Index] = bFound;
+    };
 
-    for (int32 i = 0; i < Pairs.Num() - 1; ++i)
+    if (Num > SortLibrary_Private::VectorDedupParallelThreshold)
+    {
+        ParallelFor(Num, CheckPoint);
+    }
+    else
     {
-        if (Pairs[i].Vector.Equals(Pairs[i+1].Vector, Tolerance))
+        for (int32 Index = 0; Index < Num; ++Index)
         {
-            IsDuplicate[Pairs[i].Index] = true;
-            IsDuplicate[Pairs[i+1].Index] = true;
+            CheckPoint(Index);
         }
     }
-    
-    for(int32 i=0; i < IsDuplicate.Num(); ++i)
+
+    for (int32 i = 0; i < IsDuplicate.Num(); ++i)
     {
-        if(IsDuplicate[i])
+        if (IsDuplicate[i])
         {
             DuplicateIndices.Add(i);
             DuplicateValues.Add(InArray[i]);
@@ -0,0 +1,312 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#include "SortedActorView.h"
+#include "Algo/StableSort.h"
+#include "UObject/Package.h"
+#include "SortAPI.h"
+#include "XToolsVersionCompat.h"
+
+namespace SortedActorView_Private
+{
+    /** 乱序位置（相邻逆序对）超过该比例时，插入排序不再划算，改为完整稳定排序 */
+    constexpr int32 MaxDescentRatioDenominator = 8;
+
+    /** 不超过该数量时总是使用插入排序 */
+    constexpr int32 AlwaysInsertionSortCount = 32;
+}
+
+USortedActorView* USortedActorView::CreateSortedActorView(UObject* Outer, const TArray<AActor*>& Actors,
+    EActorSortMode SortMode, ECoordinateAxis Axis, bool bAscending, bool b2D)
+{
+    USortedActorView* View = NewObject<USortedActorView>(Outer ? Outer : GetTransientPackage());
+    View->SetSortSettings(SortMode, Axis, bAscending, b2D);
+    View->AddActors(Actors);
+    return View;
+}
+
+void USortedActorView::SetSortSettings(EActorSortMode InSortMode, ECoordinateAxis InAxis, bool bInAscending, bool bIn2D)
+{
+    SortMode = InSortMode;
+    Axis = InAxis;
+    bAscending = bInAscending;
+    b2D = bIn2D;
+}
+
+void USortedActorView::AddActors(const TArray<AActor*>& Actors)
+{
+    for (AActor* Actor : Actors)
+    {
+        if (!IsValid(Actor) || SlotByActor.Contains(Actor))
+        {
+            continue;
+        }
+
+        const int32 Slot = Slots.Add(Actor);
+        SlotKeys.Add(0.0f);
+        SlotByActor.Add(Actor, Slot);
+        // 新元素追加到末尾，下一次更新时由插入排序放到正确位置
+        Order.Add(Slot);
+        SortedActors.Add(Actor);
+    }
+}
+
+void USortedActorView::RemoveActors(const TArray<AActor*>& Actors)
+{
+    bool bRemovedAny = false;
+    for (AActor* Actor : Actors)
+    {
+        if (const int32* Slot = SlotByActor.Find(Actor))
+        {
+            Slots[*Slot] = nullptr;
+            bRemovedAny = true;
+        }
+    }
+
+    if (bRemovedAny)
+    {
+        CompactInvalidSlots();
+        RebuildSortedActors();
+    }
+}
+
+void USortedActorView::ClearActors()
+{
+    Slots.Reset();
+    SlotKeys.Reset();
+    Order.Reset();
+    SortedActors.Reset();
+    SlotByActor.Reset();
+}
+
+void USortedActorView::UpdateSort(const FVector& Location, const FVector& Direction)
+{
+    CompactInvalidSlots();
+
+    const FVector NormalizedDirection = Direction.GetSafeNormal();
+    for (int32 Slot = 0; Slot < Slots.Num(); ++Slot)
+    {
+        SlotKeys[Slot] = ComputeSortKey(Slots[Slot]->GetActorLocation(), Location, NormalizedDirection);
+    }
+
+    AdaptiveSortOrder();
+    RebuildSortedActors();
+}
+
+AActor* USortedActorView::GetActorAt(int32 SortedIndex) const
+{
+    return SortedActors.IsValidIndex(SortedIndex) ? SortedActors[SortedIndex] : nullptr;
+}
+
+float USortedActorView::GetSortKeyAt(int32 SortedIndex) const
+{
+    return Order.IsValidIndex(SortedIndex) ? SlotKeys[Order[SortedIndex]] : 0.0f;
+}
+
+float USortedActorView::ComputeSortKey(const FVector& ActorLocation, const FVector& Location, const FVector& NormalizedDirection) const
+{
+    // 与 USortLibrary 中对应排序函数的键计算保持一致
+    switch (SortMode)
+    {
+    case EActorSortMode::ByHeight:
+        return ActorLocation.Z;
+    case EActorSortMode::ByAxis:
+        switch (Axis)
+        {
+            case ECoordinateAxis::X: return ActorLocation.X;
+            case ECoordinateAxis::Y: return ActorLocation.Y;
+            case ECoordinateAxis::Z: return ActorLocation.Z;
+            default: return 0.0f;
+        }
+    case EActorSortMode::ByAngle:
+    {
+        const FVector Forward = b2D ? FVector(NormalizedDirection.X, NormalizedDirection.Y, 0).GetSafeNormal() : NormalizedDirection;
+        FVector ToActor = ActorLocation - Location;
+        if (b2D)
+        {
+            ToActor.Z = 0.0f;
+        }
+        ToActor.Normalize();
+
+        const float Dot = FVector::DotProduct(Forward, ToActor);
+        float AngleDegrees = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(Dot, -1.0f, 1.0f)));
+        if (b2D)
+        {
+            const float CrossZ = Forward.X * ToActor.Y - Forward.Y * ToActor.X;
+            if (CrossZ < 0.0f)
+            {
+                AngleDegrees = 360.0f - AngleDegrees;
+            }
+        }
+        return AngleDegrees;
+    }
+    case EActorSortMode::ByAzimuth:
+    {
+        const FVector ToActor = ActorLocation - Location;
+        float Azimuth = 90.0f - FMath::RadiansToDegrees(FMath::Atan2(ToActor.Y, ToActor.X));
+        if (Azimuth < 0.0f)
+        {
+            Azimuth += 360.0f;
+        }
+        return Azimuth;
+    }
+    case EActorSortMode::ByDistance:
+    default:
+        return b2D ? FVector::Dist2D(ActorLocation, Location) : FVector::Dist(ActorLocation, Location);
+    }
+}
+
+void USortedActorView::CompactInvalidSlots()
+{
+    const int32 NumSlots = Slots.Num();
+#if XTOOLS_ENGINE_5_8_OR_LATER
+    SlotRemap.SetNumUninitialized(NumSlots, EAllowShrinking::No);
+#else
+    SlotRemap.SetNumUninitialized(NumSlots, false);
+#endif
+
+    // 压缩槽位，保留的槽位保持原有相对次序
+    int32 WriteSlot = 0;
+    for (int32 ReadSlot = 0; ReadSlot < NumSlots; ++ReadSlot)
+    {
+        AActor* Actor = Slots[ReadSlot];
+        if (!IsValid(Actor))
+        {
+            SlotRemap[ReadSlot] = INDEX_NONE;
+            continue;
+        }
+
+        SlotRemap[ReadSlot] = WriteSlot;
+        if (WriteSlot != ReadSlot)
+        {
+            Slots[WriteSlot] = Actor;
+            SlotKeys[WriteSlot] = SlotKeys[ReadSlot];
+        }
+        ++WriteSlot;
+    }
+
+    if (WriteSlot == NumSlots)
+    {
+        return;
+    }
+
+#if XTOOLS_ENGINE_5_8_OR_LATER
+    Slots.SetNum(WriteSlot, EAllowShrinking::No);
+    SlotKeys.SetNum(WriteSlot, EAllowShrinking::No);
+#else
+    Slots.SetNum(WriteSlot, false);
+    SlotKeys.SetNum(WriteSlot, false);
+#endif
+
+    // 排列中去掉被移除的槽位，其余元素的相对顺序不变
+    int32 WriteOrder = 0;
+    for (int32 ReadOrder = 0; ReadOrder < Order.Num(); ++ReadOrder)
+    {
+        const int32 NewSlot = SlotRemap[Order[ReadOrder]];
+        if (NewSlot != INDEX_NONE)
+        {
+            Order[WriteOrder++] = NewSlot;
+        }
+    }
+#if XTOOLS_ENGINE_5_8_OR_LATER
+    Order.SetNum(WriteOrder, EAllowShrinking::No);
+#else
+    Order.SetNum(WriteOrder, false);
+#endif
+
+    // 失效Actor的键可能已无法解析，直接按槽位重建索引
+    SlotByActor.Reset();
+    for (int32 Slot = 0; Slot < Slots.Num(); ++Slot)
+    {
+        SlotByActor.Add(Slots[Slot], Slot);
+    }
+}
+
+void USortedActorView::AdaptiveSortOrder()
+{
+    const int32 Count = Order.Num();
+    bLastUpdateFullSort = false;
+    if (Count < 2)
+    {
+        return;
+    }
+
+    const float* Keys = SlotKeys.GetData();
+    const bool bAsc = bAscending;
+    auto InOrder = [Keys, bAsc](int32 SlotA, int32 SlotB)
+    {
+        const float KeyA = Keys[SlotA];
+        const float KeyB = Keys[SlotB];
+        // NaN 总是排在末尾
+        if (FMath::IsNaN(KeyA)) return false;
+        if (FMath::IsNaN(KeyB)) return true;
+        return bAsc ? KeyA < KeyB : KeyB < KeyA;
+    };
+
+    // 统计相邻逆序数量，判断数据是否接近有序
+    int32 Descents = 0;
+    for (int32 i = 1; i < Count; ++i)
+    {
+        if (InOrder(Order[i], Order[i - 1]))
+        {
+            ++Descents;
+        }
+    }
+
+    if (Descents == 0)
+    {
+        return;
+    }
+
+    if (Count > SortedActorView_Private::AlwaysInsertionSortCount
+        && Descents * SortedActorView_Private::MaxDescentRatioDenominator > Count)
+    {
+        Algo::StableSort(Order, InOrder);
+        bLastUpdateFullSort = true;
+        return;
+    }
+
+    // 稳定插入排序：键相等时保留上一帧的顺序，几乎有序时接近O(N)
+    // 逆序数少但单个元素移动很远时（如一个元素从末尾移到开头）移动次数可达O(N²)，
+    // 因此限制总移动次数，超过约 N·logN 时改为完整稳定排序
+    const bool bLimitShifts = Count > SortedActorView_Private::AlwaysInsertionSortCount;
+    const int64 MaxShifts = static_cast<int64>(Count) * FMath::CeilLogTwo(static_cast<uint32>(Count));
+    int64 Shifts = 0;
+    int32* OrderData = Order.GetData();
+    for (int32 i = 1; i < Count; ++i)
+    {
+        const int32 Current = OrderData[i];
+        int32 j = i - 1;
+        while (j >= 0 && InOrder(Current, OrderData[j]))
+        {
+            OrderData[j + 1] = OrderData[j];
+            --j;
+        }
+        OrderData[j + 1] = Current;
+
+        Shifts += i - 1 - j;
+        if (bLimitShifts && Shifts > MaxShifts)
+        {
+            // 插入排序是稳定的，已处理部分中键相等元素的相对顺序不变，
+            // 在当前排列上继续做稳定排序仍保留上一帧的顺序
+            Algo::StableSort(Order, InOrder);
+            bLastUpdateFullSort = true;
+            return;
+        }
+    }
+}
+
+void USortedActorView::RebuildSortedActors()
+{
+#if XTOOLS_ENGINE_5_8_OR_LATER
+    SortedActors.SetNumUninitialized(Order.Num(), EAllowShrinking::No);
+#else
+    SortedActors.SetNumUninitialized(Order.Num(), false);
+#endif
+    for (int32 i = 0; i < Order.Num(); ++i)
+    {
+        SortedActors[i] = Slots[Order[i]];
+    }
+}
@@ -0,0 +1,194 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+
+#include "SortLibrary.h"
+#include "XToolsBenchmark.h"
+#include "Components/SceneComponent.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+namespace SortBenchmark_Private
+{
+	/** 逐个创建Actor的开销远大于被测函数，Actor相关用例只测到该规模 */
+	constexpr int32 MaxActorCount = 4096;
+
+	/** 字符串/名称的自然排序比较开销较大，限制规模以控制总耗时 */
+	constexpr int32 MaxStringCount = 65536;
+
+	template<typename T, typename PredicateType>
+	bool IsSortedBy(const TArray<T>& Values, PredicateType Less)
+	{
+		for (int32 i = 1; i < Values.Num(); ++i)
+		{
+			if (Less(Values[i], Values[i - 1]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	TArray<AActor*> MakeActors(int32 Count, FRandomStream& Stream, TArray<FVector>& OutLocations)
+	{
+		TArray<AActor*> Actors;
+		Actors.Reserve(Count);
+		OutLocations.Reset(Count);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			AActor* Actor = NewObject<AActor>(GetTransientPackage());
+			Actor->SetRootComponent(NewObject<USceneComponent>(Actor));
+			const FVector Location = Stream.VRand() * Stream.FRandRange(0.0f, 10000.0f);
+			Actor->SetActorLocation(Location);
+			Actors.Add(Actor);
+			OutLocations.Add(Location);
+		}
+		return Actors;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSortBenchmark_BasicTypes,
+	"XTools.Sort.Benchmark.BasicTypes",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FSortBenchmark_BasicTypes::RunTest(const FString& Parameters)
+{
+	using namespace SortBenchmark_Private;
+
+	FXToolsBenchmarkReport Report(TEXT("Sort.BasicTypes"));
+	FRandomStream Stream(12345);
+
+	for (const int32 Size : FXToolsBenchmarkReport::GetStandardSizes())
+	{
+		TArray<int32> Integers;
+		TArray<float> Floats;
+		TArray<FVector> Vectors;
+		Integers.SetNumUninitialized(Size);
+		Floats.SetNumUninitialized(Size);
+		Vectors.SetNumUninitialized(Size);
+		for (int32 i = 0; i < Size; ++i)
+		{
+			// 取值范围小于规模，保证去重与按值截取有实际工作量
+			Integers[i] = Stream.RandRange(0, Size / 2);
+			Floats[i] = Stream.FRandRange(-1000.0f, 1000.0f);
+			Vectors[i] = FVector(Stream.RandRange(0, 255), Stream.RandRange(0, 255), Stream.RandRange(0, 255));
+		}
+
+		TArray<int32> SortedIntegers;
+		TArray<float> SortedFloats;
+		TArray<FVector> SortedVectors;
+		TArray<float> SortedKeys;
+		TArray<int32> Indices;
+
+		Report.Measure(TEXT("SortIntegerArray"), Size, [&]() { USortLibrary::SortIntegerArray(Integers, SortedIntegers, Indices); });
+		TestTrue(FString::Printf(TEXT("整数排序结果应有序 (N=%d)"), Size), IsSortedBy(SortedIntegers, TLess<int32>()));
+
+		Report.Measure(TEXT("SortFloatArray"), Size, [&]() { USortLibrary::SortFloatArray(Floats, SortedFloats, Indices); });
+		TestTrue(FString::Printf(TEXT("浮点排序结果应有序 (N=%d)"), Size), IsSortedBy(SortedFloats, TLess<float>()));
+
+		Report.Measure(TEXT("SortVectorsByLength"), Size, [&]() { USortLibrary::SortVectorsByLength(Vectors, SortedVectors, Indices, SortedKeys); });
+		TestTrue(FString::Printf(TEXT("向量按长度排序结果应有序 (N=%d)"), Size), IsSortedBy(SortedKeys, TLess<float>()));
+
+		Report.Measure(TEXT("SortVectorsByProjection"), Size, [&]() { USortLibrary::SortVectorsByProjection(Vectors, FVector(1.0f, 2.0f, 3.0f), SortedVectors, Indices, SortedKeys); });
+		Report.Measure(TEXT("SortVectorsByAxis"), Size, [&]() { USortLibrary::SortVectorsByAxis(Vectors, ECoordinateAxis::Y, SortedVectors, Indices, SortedKeys); });
+		Report.Measure(TEXT("SortVectorsUnified"), Size, [&]() { USortLibrary::SortVectorsUnified(Vectors, EVectorSortMode::ByAxis, FVector::ForwardVector, ECoordinateAxis::Z, SortedVectors, Indices); });
+
+		Report.Measure(TEXT("SliceIntegerArrayByIndices"), Size, [&]() { USortLibrary::SliceIntegerArrayByIndices(Integers, Size / 4, Size * 3 / 4, SortedIntegers); });
+		Report.Measure(TEXT("SliceFloatArrayByIndices"), Size, [&]() { USortLibrary::SliceFloatArrayByIndices(Floats, Size / 4, Size * 3 / 4, SortedFloats); });
+		Report.Measure(TEXT("SliceVectorArrayByIndices"), Size, [&]() { USortLibrary::SliceVectorArrayByIndices(Vectors, Size / 4, Size * 3 / 4, SortedVectors); });
+		Report.Measure(TEXT("SliceIntegerArrayByValue"), Size, [&]() { USortLibrary::SliceIntegerArrayByValue(Integers, Size / 8, Size / 4, SortedIntegers, Indices); });
+		Report.Measure(TEXT("SliceFloatArrayByValue"), Size, [&]() { USortLibrary::SliceFloatArrayByValue(Floats, -500.0f, 500.0f, SortedFloats, Indices); });
+		Report.Measure(TEXT("SliceVectorArrayByLength"), Size, [&]() { USortLibrary::SliceVectorArrayByLength(Vectors, 100.0f, 300.0f, SortedVectors, Indices, SortedKeys); });
+		Report.Measure(TEXT("SliceVectorArrayByComponent"), Size, [&]() { USortLibrary::SliceVectorArrayByComponent(Vectors, ECoordinateAxis::X, 64.0f, 192.0f, SortedVectors, Indices, SortedKeys); });
+
+		Report.Measure(TEXT("ReverseIntegerArray"), Size, [&]() { USortLibrary::ReverseIntegerArray(Integers, SortedIntegers); });
+		Report.Measure(TEXT("ReverseFloatArray"), Size, [&]() { USortLibrary::ReverseFloatArray(Floats, SortedFloats); });
+		Report.Measure(TEXT("ReverseVectorArray"), Size, [&]() { USortLibrary::ReverseVectorArray(Vectors, SortedVectors); });
+
+		Report.Measure(TEXT("RemoveDuplicateIntegers"), Size, [&]() { USortLibrary::RemoveDuplicateIntegers(Integers, SortedIntegers); });
+		Report.Measure(TEXT("RemoveDuplicateFloats"), Size, [&]() { USortLibrary::RemoveDuplicateFloats(Floats, SortedFloats); });
+		Report.Measure(TEXT("RemoveDuplicateVectors"), Size, [&]() { USortLibrary::RemoveDuplicateVectors(Vectors, SortedVectors); });
+		Report.Measure(TEXT("RemoveDuplicateVectorsPreserveOrder"), Size, [&]() { USortLibrary::RemoveDuplicateVectors(Vectors, SortedVectors, 0.0001f, true); });
+
+		TArray<FVector> UniqueVectors;
+		Report.Measure(TEXT("GroupDuplicateVectors"), Size, [&]() { USortLibrary::GroupDuplicateVectors(Vectors, Indices, UniqueVectors); });
+		Report.Measure(TEXT("FindDuplicateVectors"), Size, [&]() { USortLibrary::FindDuplicateVectors(Vectors, Indices, SortedVectors); });
+
+		if (Size <= MaxStringCount)
+		{
+			TArray<FString> Strings;
+			TArray<FName> Names;
+			Strings.Reserve(Size);
+			Names.Reserve(Size);
+			for (int32 i = 0; i < Size; ++i)
+			{
+				Strings.Add(FString::Printf(TEXT("Item%d"), Integers[i]));
+				Names.Add(FName(*Strings.Last()));
+			}
+
+			TArray<FString> SortedStrings;
+			TArray<FName> SortedNames;
+			Report.Measure(TEXT("SortStringArray"), Size, [&]() { USortLibrary::SortStringArray(Strings, SortedStrings, Indices); });
+			Report.Measure(TEXT("SortNameArray"), Size, [&]() { USortLibrary::SortNameArray(Names, SortedNames, Indices); });
+			Report.Measure(TEXT("ReverseStringArray"), Size, [&]() { USortLibrary::ReverseStringArray(Strings, SortedStrings); });
+			Report.Measure(TEXT("RemoveDuplicateStrings"), Size, [&]() { USortLibrary::RemoveDuplicateStrings(Strings, SortedStrings); });
+		}
+	}
+
+	TestTrue(TEXT("基准测试结果应写入JSON"), Report.Save());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSortBenchmark_Actors,
+	"XTools.Sort.Benchmark.Actors",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FSortBenchmark_Actors::RunTest(const FString& Parameters)
+{
+	using namespace SortBenchmark_Private;
+
+	FXToolsBenchmarkReport Report(TEXT("Sort.Actors"));
+	FRandomStream Stream(54321);
+
+	for (const int32 Size : FXToolsBenchmarkReport::GetStandardSizes(MaxActorCount))
+	{
+		TArray<FVector> Locations;
+		const TArray<AActor*> Actors = MakeActors(Size, Stream, Locations);
+		const FVector Center = FVector::ZeroVector;
+		const FVector Direction = FVector::ForwardVector;
+
+		TArray<AActor*> SortedActors;
+		TArray<int32> Indices;
+		TArray<float> Keys;
+		TArray<float> SecondaryKeys;
+
+		Report.Measure(TEXT("SortActorsByDistance"), Size, [&]() { USortLibrary::SortActorsByDistance(Actors, Center, SortedActors, Indices, Keys); });
+		TestTrue(FString::Printf(TEXT("Actor按距离排序结果应有序 (N=%d)"), Size), IsSortedBy(Keys, TLess<float>()));
+
+		Report.Measure(TEXT("SortActorsByHeight"), Size, [&]() { USortLibrary::SortActorsByHeight(Actors, SortedActors, Indices); });
+		Report.Measure(TEXT("SortActorsByAxis"), Size, [&]() { USortLibrary::SortActorsByAxis(Actors, ECoordinateAxis::X, SortedActors, Indices, Keys); });
+		Report.Measure(TEXT("SortActorsByAngle"), Size, [&]() { USortLibrary::SortActorsByAngle(Actors, Center, Direction, SortedActors, Indices, Keys); });
+		Report.Measure(TEXT("SortActorsByAzimuth"), Size, [&]() { USortLibrary::SortActorsByAzimuth(Actors, Center, SortedActors, Indices, Keys); });
+		Report.Measure(TEXT("SortActorsByAngleAndDistance"), Size, [&]() { USortLibrary::SortActorsByAngleAndDistance(Actors, Center, Direction, SortedActors, Indices, Keys, SecondaryKeys); });
+		Report.Measure(TEXT("SortActorsUnified"), Size, [&]() { USortLibrary::SortActorsUnified(Actors, EActorSortMode::ByDistance, Center, Direction, ECoordinateAxis::X, SortedActors, Indices); });
+
+		const int32 K = FMath::Min(Size, 16);
+		Report.Measure(TEXT("FindNearestKActors"), Size, [&]() { USortLibrary::FindNearestKActors(Actors, Center, K, 0.0f, TArray<FVector>(), SortedActors, Indices, Keys); });
+		Report.Measure(TEXT("FindNearestKActorsCached"), Size, [&]() { USortLibrary::FindNearestKActors(Actors, Center, K, 0.0f, Locations, SortedActors, Indices, Keys); });
+		Report.Measure(TEXT("FindActorsInConeTopK"), Size, [&]() { USortLibrary::FindActorsInConeTopK(Actors, Center, Direction, 60.0f, 0.0f, 0.5f, 0.5f, K, Locations, SortedActors, Indices, Keys, SecondaryKeys); });
+
+		Report.Measure(TEXT("SliceActorArrayByIndices"), Size, [&]() { USortLibrary::SliceActorArrayByIndices(Actors, Size / 4, Size * 3 / 4, SortedActors); });
+		Report.Measure(TEXT("ReverseActorArray"), Size, [&]() { USortLibrary::ReverseActorArray(Actors, SortedActors); });
+		Report.Measure(TEXT("RemoveDuplicateActors"), Size, [&]() { USortLibrary::RemoveDuplicateActors(Actors, SortedActors); });
+	}
+
+	TestTrue(TEXT("基准测试结果应写入JSON"), Report.Save());
+	return true;
+}
+
+#endif
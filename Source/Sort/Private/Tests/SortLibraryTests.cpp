@@ -6,6 +6,8 @@
 #if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
 
 #include "SortLibrary.h"
+#include "SortedActorView.h"
+#include "Components/SceneComponent.h"
 #include "Misc/AutomationTest.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
@@ -87,6 +89,130 @@ bool FSortLibrary_SortsAndSlicesVectors::RunTest(const FString& Parameters)
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSortLibrary_FindsTopKActors,
+	"XTools.Sort.Library.FindsTopKActors",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSortLibrary_FindsTopKActors::RunTest(const FString& Parameters)
+{
+	TArray<AActor*> Actors;
+	for (int32 Index = 0; Index < 6; ++Index)
+	{
+		Actors.Add(NewObject<AActor>(GetTransientPackage()));
+	}
+	const TArray<FVector> Locations = {
+		FVector(500.0f, 0.0f, 0.0f),
+		FVector(100.0f, 0.0f, 0.0f),
+		FVector(-200.0f, 0.0f, 0.0f),
+		FVector(300.0f, 0.0f, 0.0f),
+		FVector(0.0f, 50.0f, 0.0f),
+		FVector(100.0f, 0.0f, 0.0f)
+	};
+
+	TArray<AActor*> NearestActors;
+	TArray<int32> OriginalIndices;
+	TArray<float> Distances;
+	USortLibrary::FindNearestKActors(Actors, FVector::ZeroVector, 3, 0.0f, Locations, NearestActors, OriginalIndices, Distances);
+	TestTrue(TEXT("最近K个Actor应按距离升序并以原始索引打破并列"),
+		OriginalIndices == TArray<int32>({4, 1, 5}) && NearestActors[0] == Actors[4]);
+	TestTrue(TEXT("最近K个Actor应输出真实距离"), FMath::IsNearlyEqual(Distances[1], 100.0f));
+
+	USortLibrary::FindNearestKActors(Actors, FVector::ZeroVector, 10, 250.0f, Locations, NearestActors, OriginalIndices, Distances);
+	TestTrue(TEXT("半径限制应过滤远处Actor"), OriginalIndices == TArray<int32>({4, 1, 5, 2}));
+
+	TArray<AActor*> SelectedActors;
+	TArray<float> Angles;
+	USortLibrary::FindActorsInConeTopK(Actors, FVector::ZeroVector, FVector::ForwardVector, 45.0f, 0.0f, 0.5f, 0.5f, 2,
+		Locations, SelectedActors, OriginalIndices, Angles, Distances);
+	TestTrue(TEXT("锥形TopK应过滤锥外Actor并按综合评分取前K项"),
+		OriginalIndices == TArray<int32>({1, 5}) && SelectedActors[0] == Actors[1] && FMath::IsNearlyZero(Angles[0]));
+
+	USortLibrary::FindNearestKActors(Actors, FVector::ZeroVector, 0, 0.0f, Locations, NearestActors, OriginalIndices, Distances);
+	TestTrue(TEXT("K为0时应返回空结果"), NearestActors.IsEmpty() && OriginalIndices.IsEmpty());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSortedActorView_UpdatesIncrementally,
+	"XTools.Sort.SortedActorView.UpdatesIncrementally",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSortedActorView_UpdatesIncrementally::RunTest(const FString& Parameters)
+{
+	auto MakeActorAt = [](float Height)
+	{
+		AActor* Actor = NewObject<AActor>(GetTransientPackage());
+		Actor->SetRootComponent(NewObject<USceneComponent>(Actor));
+		Actor->SetActorLocation(FVector(0.0f, 0.0f, Height));
+		return Actor;
+	};
+
+	AActor* Low = MakeActorAt(0.0f);
+	AActor* Mid = MakeActorAt(100.0f);
+	AActor* High = MakeActorAt(200.0f);
+
+	USortedActorView* View = USortedActorView::CreateSortedActorView(nullptr, {High, Low, Mid}, EActorSortMode::ByHeight);
+	View->UpdateSort(FVector::ZeroVector, FVector::ForwardVector);
+	TestTrue(TEXT("排序视图首次更新应得到完整顺序"),
+		View->GetActorAt(0) == Low && View->GetActorAt(1) == Mid && View->GetActorAt(2) == High);
+
+	Mid->SetActorLocation(FVector(0.0f, 0.0f, 300.0f));
+	View->UpdateSort(FVector::ZeroVector, FVector::ForwardVector);
+	TestTrue(TEXT("键值小幅变化时应增量重排"),
+		View->GetActorAt(2) == Mid && !View->WasLastUpdateFullSort());
+
+	AActor* Lowest = MakeActorAt(-100.0f);
+	View->AddActors({Lowest, Low});
+	View->RemoveActors({High});
+	View->UpdateSort(FVector::ZeroVector, FVector::ForwardVector);
+	TestTrue(TEXT("增删Actor后应保持正确顺序且不重复"),
+		View->Num() == 3 && View->GetActorAt(0) == Lowest && View->GetActorAt(1) == Low && View->GetActorAt(2) == Mid);
+	TestTrue(TEXT("排序键应与位置对应"), FMath::IsNearlyEqual(View->GetSortKeyAt(2), 300.0f));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSortedActorView_FallsBackWhenShiftsExplode,
+	"XTools.Sort.SortedActorView.FallsBackWhenShiftsExplode",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSortedActorView_FallsBackWhenShiftsExplode::RunTest(const FString& Parameters)
+{
+	constexpr int32 Count = 256;
+	TArray<AActor*> Actors;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		AActor* Actor = NewObject<AActor>(GetTransientPackage());
+		Actor->SetRootComponent(NewObject<USceneComponent>(Actor));
+		Actor->SetActorLocation(FVector(0.0f, 0.0f, static_cast<float>(i)));
+		Actors.Add(Actor);
+	}
+
+	USortedActorView* View = USortedActorView::CreateSortedActorView(nullptr, Actors, EActorSortMode::ByHeight);
+	View->UpdateSort(FVector::ZeroVector, FVector::ForwardVector);
+
+	// 前后两半整体交换：只有一处相邻逆序，但插入排序需要 O(N²) 次移动
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const float Height = static_cast<float>(i < Count / 2 ? i + Count : i);
+		Actors[i]->SetActorLocation(FVector(0.0f, 0.0f, Height));
+	}
+	View->UpdateSort(FVector::ZeroVector, FVector::ForwardVector);
+	TestTrue(TEXT("插入排序移动次数过多时应改为完整稳定排序"), View->WasLastUpdateFullSort());
+
+	bool bSorted = true;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		bSorted &= View->GetActorAt(i) == Actors[(i + Count / 2) % Count];
+	}
+	TestTrue(TEXT("回退为完整排序后顺序应正确"), bSorted);
+
+	return true;
+}
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
 	FSortLibrary_ReversesAndDeduplicatesValues,
 	"XTools.Sort.Library.ReversesAndDeduplicatesValues",
@@ -129,6 +255,23 @@ bool FSortLibrary_ReversesAndDeduplicatesValues::RunTest(const FString& Paramete
 	TestTrue(TEXT("重复向量检测应报告重复组的全部成员"),
 		DuplicateIndices == TArray<int32>({0, 1}) && DuplicateValues.Num() == 2);
 
+	// 字典序下被其他点隔开的近似重复项
+	const TArray<FVector> StraddlingVectors = {
+		FVector(0.0f, 0.005f, 0.0f),
+		FVector(0.001f, 1.0f, 0.0f),
+		FVector(0.002f, 0.0f, 0.0f)
+	};
+	USortLibrary::RemoveDuplicateVectors(StraddlingVectors, UniqueVectors, 0.01f, true);
+	TestTrue(TEXT("向量去重应合并排序顺序上不相邻的近似重复项并保持首次出现顺序"),
+		UniqueVectors.Num() == 2 && UniqueVectors[0] == StraddlingVectors[0] && UniqueVectors[1] == StraddlingVectors[1]);
+
+	TArray<int32> GroupIds;
+	USortLibrary::GroupDuplicateVectors(StraddlingVectors, GroupIds, UniqueVectors, 0.01f);
+	TestTrue(TEXT("向量分组应返回每个元素的组ID"), GroupIds == TArray<int32>({0, 1, 0}) && UniqueVectors.Num() == 2);
+
+	USortLibrary::FindDuplicateVectors(StraddlingVectors, DuplicateIndices, DuplicateValues, 0.01f);
+	TestTrue(TEXT("重复向量检测不应受排序顺序影响"), DuplicateIndices == TArray<int32>({0, 2}));
+
 	return true;
 }
 
@@ -158,7 +158,55 @@ public:
         UPARAM(DisplayName="已排序距离") TArray<float>& SortedDistances,
         UPARAM(DisplayName="升序排序") bool bAscending = true,
         UPARAM(DisplayName="2D夹角") bool b2DAngle = false);
-    
+
+    //~ Actor Top-K 查询函数（有界堆，O(N log K)，不做完整排序）
+    // =================================================================================================
+
+    /** 查找距离指定位置最近的K个Actor */
+    UFUNCTION(BlueprintPure,
+        Category = "XTools|排序|Actor",
+        meta = (
+            DisplayName = "查找最近的K个Actor",
+            Keywords = "最近,TopK,距离,半径,Actor,索引,目标选择",
+            AutoCreateRefTerm = "Location,CachedLocations",
+            ToolTip = "使用有界最大堆查找距离参考位置最近的K个Actor，复杂度O(N log K)，不会对整个数组排序。\n参数:\nActors - 候选Actor数组\nLocation - 参考位置\nK - 最多返回的数量（<=0 时返回空）\nMaxDistance - 半径限制，<=0 表示不限制\nCachedLocations - 可选的预计算位置，数量与Actors一致时直接使用，避免逐个调用GetActorLocation\nb2DDistance - true则忽略Z轴计算距离\n返回值:\nNearestActors - 由近到远的结果\nOriginalIndices - 结果在原数组中的索引\nDistances - 结果到参考位置的距离"
+        ))
+    static void FindNearestKActors(
+        UPARAM(DisplayName="Actor数组") const TArray<AActor*>& Actors,
+        UPARAM(DisplayName="参考位置") const FVector& Location,
+        UPARAM(DisplayName="数量K", meta=(ClampMin="0", UIMin="1")) int32 K,
+        UPARAM(DisplayName="最大距离", meta=(ClampMin="0.0", UIMin="0.0")) float MaxDistance,
+        UPARAM(DisplayName="预计算位置") const TArray<FVector>& CachedLocations,
+        UPARAM(DisplayName="最近Actor") TArray<AActor*>& NearestActors,
+        UPARAM(DisplayName="原始索引") TArray<int32>& OriginalIndices,
+        UPARAM(DisplayName="距离") TArray<float>& Distances,
+        UPARAM(DisplayName="2D距离") bool b2DDistance = false);
+
+    /** 查找锥形范围内得分最优的K个Actor */
+    UFUNCTION(BlueprintPure,
+        Category = "XTools|排序|Actor",
+        meta = (
+            DisplayName = "查找锥形范围内最优的K个Actor",
+            Keywords = "锥形,TopK,夹角,距离,权重,Actor,索引,目标选择",
+            AutoCreateRefTerm = "Center,Direction,CachedLocations",
+            ToolTip = "使用有界最大堆在锥形范围内查找得分最低（最优）的K个Actor，评分规则与“根据夹角和距离排序Actor数组”一致，结果等价于其升序结果的前K项。\n参数:\nActors - 候选Actor数组\nCenter - 锥形顶点\nDirection - 锥形朝向\nMaxAngle - 最大夹角，<=0 表示不限制\nMaxDistance - 最大距离，<=0 表示不限制\nAngleWeight/DistanceWeight - 评分权重，均为0时只按夹角\nK - 最多返回的数量\nCachedLocations - 可选的预计算位置，数量与Actors一致时直接使用\nb2DAngle - true则在XY平面上计算\n返回值:\nSelectedActors - 按得分从优到劣的结果\nOriginalIndices - 结果在原数组中的索引\nAngles/Distances - 结果对应的夹角与距离"
+        ))
+    static void FindActorsInConeTopK(
+        UPARAM(DisplayName="Actor数组") const TArray<AActor*>& Actors,
+        UPARAM(DisplayName="中心点") const FVector& Center,
+        UPARAM(DisplayName="参考方向") const FVector& Direction,
+        UPARAM(DisplayName="最大夹角", meta=(UIMin="0.0", UIMax="180.0", ClampMin="0.0", ClampMax="180.0")) float MaxAngle,
+        UPARAM(DisplayName="最大距离", meta=(UIMin="0.0", ClampMin="0.0")) float MaxDistance,
+        UPARAM(DisplayName="夹角权重", meta=(UIMin="0.0", UIMax="1.0", ClampMin="0.0")) float AngleWeight,
+        UPARAM(DisplayName="距离权重", meta=(UIMin="0.0", UIMax="1.0", ClampMin="0.0")) float DistanceWeight,
+        UPARAM(DisplayName="数量K", meta=(ClampMin="0", UIMin="1")) int32 K,
+        UPARAM(DisplayName="预计算位置") const TArray<FVector>& CachedLocations,
+        UPARAM(DisplayName="选中Actor") TArray<AActor*>& SelectedActors,
+        UPARAM(DisplayName="原始索引") TArray<int32>& OriginalIndices,
+        UPARAM(DisplayName="夹角") TArray<float>& Angles,
+        UPARAM(DisplayName="距离") TArray<float>& Distances,
+        UPARAM(DisplayName="2D夹角") bool b2DAngle = false);
+
     //~ 基础类型排序函数
     // =================================================================================================
 
@@ -548,11 +596,26 @@ public:
         meta = (
             DisplayName = "清除向量数组重复项",
             Keywords = "去重,重复,向量,数组",
-            ToolTip = "清除向量数组中的重复项。\n参数:\nInArray - 要处理的向量数组\nTolerance - 判断相等的容差值（默认为KindaSmallNumber）\n返回值:\nOutArray - 去重后的数组"
+            ToolTip = "清除向量数组中的重复项（空间哈希实现，期望复杂度O(N)）。\n每个向量归入容差内最早出现的保留项，不受排序顺序影响。\n参数:\nInArray - 要处理的向量数组\nTolerance - 判断相等的容差值（各分量差值均不超过该值视为相等）\nbPreserveOrder - true按首次出现顺序输出，false按坐标字典序输出\n返回值:\nOutArray - 去重后的数组"
         ))
     static void RemoveDuplicateVectors(
         UPARAM(DisplayName="输入数组") const TArray<FVector>& InArray,
         UPARAM(DisplayName="输出数组") TArray<FVector>& OutArray,
+        UPARAM(DisplayName="容差值", meta=(ClampMin="0.0", UIMin="0.0", UIMax="1.0")) float Tolerance = 0.0001f,
+        UPARAM(DisplayName="保持原顺序") bool bPreserveOrder = false);
+
+    /** 按容差对向量分组，返回每个元素所属的组 */
+    UFUNCTION(BlueprintPure,
+        Category = "XTools|数组操作|去重",
+        meta = (
+            DisplayName = "按容差分组向量",
+            Keywords = "去重,重复,向量,分组,合并,组ID",
+            ToolTip = "使用空间哈希按容差对向量分组，可用于合并重复点的属性。\n参数:\nInArray - 要处理的向量数组\nTolerance - 判断相等的容差值\n返回值:\nGroupIds - 与输入等长，每个元素所属组的ID\nUniqueVectors - 每个组的代表向量（组内首次出现的元素），按首次出现顺序排列，UniqueVectors[GroupId] 即该组代表"
+        ))
+    static void GroupDuplicateVectors(
+        UPARAM(DisplayName="输入数组") const TArray<FVector>& InArray,
+        UPARAM(DisplayName="组ID") TArray<int32>& GroupIds,
+        UPARAM(DisplayName="代表向量") TArray<FVector>& UniqueVectors,
         UPARAM(DisplayName="容差值", meta=(ClampMin="0.0", UIMin="0.0", UIMax="1.0")) float Tolerance = 0.0001f);
 
     /** 查找向量数组中的重复向量 */
@@ -561,7 +624,7 @@ public:
         meta = (
             DisplayName = "查找重复向量",
             Keywords = "查找,重复,向量,数组,索引",
-            ToolTip = "查找向量数组中完全相同的向量。\n参数:\nInArray - 要处理的向量数组\nTolerance - 判断相等的容差值（默认为KindaSmallNumber）\n返回值:\nDuplicateIndices - 重复向量的索引\nDuplicateValues - 对应的向量值"
+            ToolTip = "查找向量数组中与其他任一元素在容差内相等的向量（空间哈希实现）。\n参数:\nInArray - 要处理的向量数组\nTolerance - 判断相等的容差值（默认为KindaSmallNumber）\n返回值:\nDuplicateIndices - 重复向量的索引\nDuplicateValues - 对应的向量值"
         ))
     static void FindDuplicateVectors(
         UPARAM(DisplayName="输入数组") const TArray<FVector>& InArray,
@@ -0,0 +1,134 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UObject/ObjectKey.h"
+#include "SortLibrary.h"
+#include "SortedActorView.generated.h"
+
+/**
+ * 持久化的Actor排序视图。
+ * 在多次更新之间保留排序后的排列，每次更新只重新计算排序键并做自适应重排：
+ * 顺序变化很小时使用稳定插入排序（接近O(N)），乱序较多或插入排序移动次数超过约 N·logN 时回退为完整稳定排序。
+ * 适合每帧对几乎相同的Actor集合、缓慢变化的排序键重复排序的场景，稳定后更新过程不再分配内存。
+ */
+UCLASS(BlueprintType, meta = (DisplayName = "Actor排序视图"))
+class SORT_API USortedActorView : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    /** 创建排序视图并设置初始Actor集合 */
+    UFUNCTION(BlueprintCallable,
+        Category = "XTools|排序|Actor",
+        meta = (
+            DisplayName = "创建Actor排序视图",
+            Keywords = "排序,视图,增量,持久,Actor",
+            DefaultToSelf = "Outer",
+            ToolTip = "创建一个在多帧之间保留排序结果的Actor排序视图。\n之后每帧调用“更新排序视图”即可增量重排，避免重复分配和完整排序。\n参数:\nOuter - 视图的所有者\nActors - 初始Actor集合\nSortMode - 排序模式\nAxis - 按坐标轴排序时使用的轴\nbAscending - 是否升序\nb2D - 距离和夹角是否忽略Z轴"
+        ))
+    static USortedActorView* CreateSortedActorView(
+        UPARAM(DisplayName="所有者") UObject* Outer,
+        UPARAM(DisplayName="Actor数组") const TArray<AActor*>& Actors,
+        UPARAM(DisplayName="排序模式") EActorSortMode SortMode = EActorSortMode::ByDistance,
+        UPARAM(DisplayName="坐标轴") ECoordinateAxis Axis = ECoordinateAxis::X,
+        UPARAM(DisplayName="升序排序") bool bAscending = true,
+        UPARAM(DisplayName="2D计算") bool b2D = false);
+
+    /** 修改排序配置，下一次更新时生效 */
+    UFUNCTION(BlueprintCallable, Category = "XTools|排序|Actor", meta = (DisplayName = "设置排序视图模式"))
+    void SetSortSettings(
+        UPARAM(DisplayName="排序模式") EActorSortMode InSortMode,
+        UPARAM(DisplayName="坐标轴") ECoordinateAxis InAxis,
+        UPARAM(DisplayName="升序排序") bool bInAscending = true,
+        UPARAM(DisplayName="2D计算") bool bIn2D = false);
+
+    /** 添加Actor（已存在或无效的Actor会被忽略），新Actor在下一次更新时排入正确位置 */
+    UFUNCTION(BlueprintCallable, Category = "XTools|排序|Actor", meta = (DisplayName = "向排序视图添加Actor"))
+    void AddActors(UPARAM(DisplayName="Actor数组") const TArray<AActor*>& Actors);
+
+    /** 移除Actor，其余Actor的相对顺序保持不变 */
+    UFUNCTION(BlueprintCallable, Category = "XTools|排序|Actor", meta = (DisplayName = "从排序视图移除Actor"))
+    void RemoveActors(UPARAM(DisplayName="Actor数组") const TArray<AActor*>& Actors);
+
+    /** 清空视图 */
+    UFUNCTION(BlueprintCallable, Category = "XTools|排序|Actor", meta = (DisplayName = "清空排序视图"))
+    void ClearActors();
+
+    /**
+     * 重新计算排序键并增量重排。
+     * 已销毁的Actor会被自动移除。Location/Direction 的含义与“智能排序Actor数组”一致。
+     */
+    UFUNCTION(BlueprintCallable,
+        Category = "XTools|排序|Actor",
+        meta = (
+            DisplayName = "更新排序视图",
+            AutoCreateRefTerm = "Location,Direction"
+        ))
+    void UpdateSort(
+        UPARAM(DisplayName="参考位置") const FVector& Location,
+        UPARAM(DisplayName="参考方向") const FVector& Direction);
+
+    /** 获取排序结果（C++ 中返回引用，不产生拷贝） */
+    UFUNCTION(BlueprintPure, Category = "XTools|排序|Actor", meta = (DisplayName = "获取排序视图结果"))
+    const TArray<TObjectPtr<AActor>>& GetSortedActors() const { return SortedActors; }
+
+    /** 按排序位置获取Actor，越界返回空 */
+    UFUNCTION(BlueprintPure, Category = "XTools|排序|Actor", meta = (DisplayName = "获取排序视图元素"))
+    AActor* GetActorAt(UPARAM(DisplayName="位置") int32 SortedIndex) const;
+
+    /** 按排序位置获取排序键（距离、高度、坐标或角度），越界返回0 */
+    UFUNCTION(BlueprintPure, Category = "XTools|排序|Actor", meta = (DisplayName = "获取排序视图键值"))
+    float GetSortKeyAt(UPARAM(DisplayName="位置") int32 SortedIndex) const;
+
+    /** 视图中的Actor数量 */
+    UFUNCTION(BlueprintPure, Category = "XTools|排序|Actor", meta = (DisplayName = "获取排序视图数量"))
+    int32 Num() const { return Slots.Num(); }
+
+    /** 上一次更新是否回退为完整排序（用于调试性能） */
+    UFUNCTION(BlueprintPure, Category = "XTools|排序|Actor", meta = (DisplayName = "上次是否完整排序"))
+    bool WasLastUpdateFullSort() const { return bLastUpdateFullSort; }
+
+    /** C++ 使用的只读视图 */
+    TArrayView<const TObjectPtr<AActor>> GetSortedView() const { return SortedActors; }
+
+private:
+    float ComputeSortKey(const FVector& ActorLocation, const FVector& Location, const FVector& NormalizedDirection) const;
+
+    /** 移除已失效的槽位并同步修正排列 */
+    void CompactInvalidSlots();
+
+    /** 对 Order 做自适应稳定排序 */
+    void AdaptiveSortOrder();
+
+    void RebuildSortedActors();
+
+    UPROPERTY()
+    TArray<TObjectPtr<AActor>> Slots;
+
+    /** 每个槽位的排序键 */
+    TArray<float> SlotKeys;
+
+    /** 排序后的槽位排列，Order[i] 为排在第 i 位的槽位 */
+    TArray<int32> Order;
+
+    /** 对外暴露的排序结果 */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<AActor>> SortedActors;
+
+    /** 槽位压缩时复用的映射表 */
+    TArray<int32> SlotRemap;
+
+    TMap<TObjectKey<AActor>, int32> SlotByActor;
+
+    EActorSortMode SortMode = EActorSortMode::ByDistance;
+    ECoordinateAxis Axis = ECoordinateAxis::X;
+    bool bAscending = true;
+    bool b2D = false;
+    bool bLastUpdateFullSort = false;
+};
@@ -0,0 +1,157 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#include "XToolsBenchmark.h"
+#include "XToolsCore.h"
+
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProperties.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    FString EscapeJsonString(const FString& Value)
+    {
+        FString Result = Value;
+        Result.ReplaceInline(TEXT("\\"), TEXT("\\\\"));
+        Result.ReplaceInline(TEXT("\""), TEXT("\\\""));
+        Result.ReplaceInline(TEXT("\n"), TEXT("\\n"));
+        return Result;
+    }
+
+    /** JSON 不支持 NaN/Inf，统一写为 null */
+    FString FormatJsonNumber(double Value)
+    {
+        return FMath::IsFinite(Value) ? FString::Printf(TEXT("%.6f"), Value) : FString(TEXT("null"));
+    }
+}
+
+FXToolsBenchmarkReport::FXToolsBenchmarkReport(const FString& InSuiteName)
+    : SuiteName(InSuiteName)
+{
+}
+
+const FXToolsBenchmarkSample& FXToolsBenchmarkReport::AddSample(const FString& CaseName, int32 Size, int32 Iterations, double Seconds, int64 MemoryDelta)
+{
+    FXToolsBenchmarkSample& Sample = Samples.AddDefaulted_GetRef();
+    Sample.Case = CaseName;
+    Sample.Size = Size;
+    Sample.Iterations = Iterations;
+    Sample.NsPerIteration = Iterations > 0 ? Seconds * 1e9 / Iterations : 0.0;
+    Sample.NsPerElement = Size > 0 ? Sample.NsPerIteration / Size : Sample.NsPerIteration;
+    Sample.MemoryDeltaBytes = MemoryDelta;
+
+    UE_LOG(LogXToolsCore, Display, TEXT("[%s] %s N=%d: %.2f ns/elem (%d iters, mem %+lld B)"),
+        *SuiteName, *CaseName, Size, Sample.NsPerElement, Iterations, MemoryDelta);
+    return Sample;
+}
+
+void FXToolsBenchmarkReport::AddMetric(const FString& Name, double Value)
+{
+    Metrics.Emplace(Name, Value);
+    UE_LOG(LogXToolsCore, Display, TEXT("[%s] %s = %f"), *SuiteName, *Name, Value);
+}
+
+int64 FXToolsBenchmarkReport::GetUsedPhysicalMemory()
+{
+    return static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+}
+
+FString FXToolsBenchmarkReport::ToJson() const
+{
+    FString Json;
+    Json += TEXT("{\n");
+    Json += FString::Printf(TEXT("  \"suite\": \"%s\",\n"), *EscapeJsonString(SuiteName));
+    Json += FString::Printf(TEXT("  \"timestamp\": \"%s\",\n"), *FDateTime::UtcNow().ToIso8601());
+    Json += FString::Printf(TEXT("  \"platform\": \"%s\",\n"), ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()));
+    Json += FString::Printf(TEXT("  \"buildConfiguration\": \"%s\",\n"), LexToString(FApp::GetBuildConfiguration()));
+
+    Json += TEXT("  \"samples\": [\n");
+    for (int32 i = 0; i < Samples.Num(); ++i)
+    {
+        const FXToolsBenchmarkSample& Sample = Samples[i];
+        Json += FString::Printf(
+            TEXT("    { \"case\": \"%s\", \"size\": %d, \"iterations\": %d, \"nsPerIteration\": %s, \"nsPerElement\": %s, \"memoryDeltaBytes\": %lld }%s\n"),
+            *EscapeJsonString(Sample.Case), Sample.Size, Sample.Iterations,
+            *FormatJsonNumber(Sample.NsPerIteration), *FormatJsonNumber(Sample.NsPerElement),
+            Sample.MemoryDeltaBytes, i + 1 < Samples.Num() ? TEXT(",") : TEXT(""));
+    }
+    Json += TEXT("  ],\n");
+
+    Json += TEXT("  \"metrics\": {");
+    for (int32 i = 0; i < Metrics.Num(); ++i)
+    {
+        Json += FString::Printf(TEXT("%s\n    \"%s\": %s"), i > 0 ? TEXT(",") : TEXT(""),
+            *EscapeJsonString(Metrics[i].Key), *FormatJsonNumber(Metrics[i].Value));
+    }
+    Json += Metrics.Num() > 0 ? TEXT("\n  }\n") : TEXT("}\n");
+    Json += TEXT("}\n");
+    return Json;
+}
+
+bool FXToolsBenchmarkReport::Save(FString* OutFilePath) const
+{
+    FString Directory;
+    if (!FParse::Value(FCommandLine::Get(), TEXT("XToolsBenchmarkDir="), Directory))
+    {
+        Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Automation"), TEXT("XToolsBenchmarks"));
+    }
+
+    const FString FilePath = FPaths::Combine(Directory, SuiteName + TEXT(".json"));
+    const bool bSaved = FFileHelper::SaveStringToFile(ToJson(), *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+    if (bSaved)
+    {
+        UE_LOG(LogXToolsCore, Display, TEXT("[%s] 基准测试结果已写入 %s"), *SuiteName, *FilePath);
+    }
+    else
+    {
+        UE_LOG(LogXToolsCore, Warning, TEXT("[%s] 基准测试结果写入失败: %s"), *SuiteName, *FilePath);
+    }
+
+    if (OutFilePath)
+    {
+        *OutFilePath = FilePath;
+    }
+    return bSaved;
+}
+
+TArray<int32> FXToolsBenchmarkReport::GetStandardSizes(int32 MaxSize)
+{
+    TArray<int32> Sizes;
+    for (int32 Size = 16; Size <= MaxSize; Size *= 16)
+    {
+        Sizes.Add(Size);
+    }
+    return Sizes;
+}
+
+double FXToolsBenchmarkReport::ChiSquareStatistic(TArrayView<const int64> Observed, TArrayView<const double> Expected)
+{
+    double Statistic = 0.0;
+    const int32 Count = FMath::Min(Observed.Num(), Expected.Num());
+    for (int32 i = 0; i < Count; ++i)
+    {
+        if (Expected[i] > 0.0)
+        {
+            const double Diff = static_cast<double>(Observed[i]) - Expected[i];
+            Statistic += Diff * Diff / Expected[i];
+        }
+    }
+    return Statistic;
+}
+
+double FXToolsBenchmarkReport::ChiSquareCriticalValue(int32 DegreesOfFreedom)
+{
+    // 标准正态分布 0.999 分位数
+    constexpr double Z = 3.090232;
+    const double K = FMath::Max(DegreesOfFreedom, 1);
+    const double Term = 2.0 / (9.0 * K);
+    return K * FMath::Pow(1.0 - Term + Z * FMath::Sqrt(Term), 3.0);
+}
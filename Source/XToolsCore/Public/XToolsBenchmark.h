@@ -0,0 +1,106 @@
+/*
+* Copyright (c) 2025 XIYBHK
+* Licensed under UE_XTools License
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+/**
+ * 单个基准测试结果
+ */
+struct XTOOLSCORE_API FXToolsBenchmarkSample
+{
+    /** 用例名称，如 "SortFloatArray" */
+    FString Case;
+
+    /** 输入规模 */
+    int32 Size = 0;
+
+    /** 计时的迭代次数 */
+    int32 Iterations = 0;
+
+    /** 每次迭代的平均耗时（纳秒） */
+    double NsPerIteration = 0.0;
+
+    /** 每个元素的平均耗时（纳秒） */
+    double NsPerElement = 0.0;
+
+    /** 计时期间进程已用物理内存的变化（字节），用于粗略观察临时分配，受其他线程影响 */
+    int64 MemoryDeltaBytes = 0;
+};
+
+/**
+ * XTools 基准测试报告
+ * 供各模块的性能自动化测试使用：计时、记录质量指标，并导出 JSON 便于 CI 做回归对比。
+ *
+ * 导出路径：<Project>/Saved/Automation/XToolsBenchmarks/<Suite>.json，
+ * 可通过命令行参数 -XToolsBenchmarkDir=<目录> 覆盖。
+ */
+class XTOOLSCORE_API FXToolsBenchmarkReport
+{
+public:
+    explicit FXToolsBenchmarkReport(const FString& InSuiteName);
+
+    /**
+     * 计时一个用例：先预热一次，再重复执行直到累计耗时达到 MinSeconds 或次数达到 MaxIterations
+     * @param Size 输入规模，用于计算每元素耗时
+     * @param Body 被测代码，每次调用视为一次迭代
+     */
+    template<typename FuncType>
+    const FXToolsBenchmarkSample& Measure(const FString& CaseName, int32 Size, FuncType&& Body,
+        double MinSeconds = 0.02, int32 MaxIterations = 1000)
+    {
+        Body();
+
+        const int64 MemoryBefore = GetUsedPhysicalMemory();
+        int32 Iterations = 0;
+        double Elapsed = 0.0;
+        const double StartTime = FPlatformTime::Seconds();
+        do
+        {
+            Body();
+            ++Iterations;
+            Elapsed = FPlatformTime::Seconds() - StartTime;
+        }
+        while (Elapsed < MinSeconds && Iterations < MaxIterations);
+
+        return AddSample(CaseName, Size, Iterations, Elapsed, GetUsedPhysicalMemory() - MemoryBefore);
+    }
+
+    /** 记录计时以外的指标（如卡方统计量、经验触发率） */
+    void AddMetric(const FString& Name, double Value);
+
+    const TArray<FXToolsBenchmarkSample>& GetSamples() const { return Samples; }
+
+    /** 生成 JSON 文本 */
+    FString ToJson() const;
+
+    /** 写入 JSON 文件并输出日志，返回是否成功 */
+    bool Save(FString* OutFilePath = nullptr) const;
+
+    /** 基准测试的标准输入规模：16 到 1M */
+    static TArray<int32> GetStandardSizes(int32 MaxSize = 1 << 20);
+
+    /**
+     * 卡方统计量 sum((O-E)^2/E)，跳过期望为0的项
+     */
+    static double ChiSquareStatistic(TArrayView<const int64> Observed, TArrayView<const double> Expected);
+
+    /**
+     * 卡方分布在显著性水平 0.001 下的临界值（Wilson-Hilferty 近似）
+     * 统计量超过该值说明分布与期望显著不符
+     */
+    static double ChiSquareCriticalValue(int32 DegreesOfFreedom);
+
+private:
+    const FXToolsBenchmarkSample& AddSample(const FString& CaseName, int32 Size, int32 Iterations, double Seconds, int64 MemoryDelta);
+
+    static int64 GetUsedPhysicalMemory();
+
+    FString SuiteName;
+    TArray<FXToolsBenchmarkSample> Samples;
+    TArray<TPair<FString, double>> Metrics;
+};
@@ -15,6 +15,7 @@ using UnrealBuildTool;
  * - XToolsVersionCompat.h: UE 5.3-5.8 版本兼容性宏
  * - XToolsErrorReporter.h: 统一错误/日志处理
  * - XToolsDefines.h: 插件版本和通用宏定义
+ * - XToolsBenchmark.h: 性能自动化测试的计时与 JSON 报告
  */
 public class XToolsCore : ModuleRules
 {